@@ -0,0 +1,304 @@
+#!/usr/bin/env python3
+#
+# Copyright 2020 Comcast Cable Communications Management, LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+
+"""
+Generates the OVSDB table codecs, source/OvsDbApi/json_parser/ovsdb_schema.[ch],
+from the OVSDB schema and the table structs of the public API.
+
+A schema column is encoded and decoded when the table's struct has a field
+of the same name: char arrays hold strings, bool booleans and int or enum
+fields integers. Other columns, e.g. sets and maps, are left alone.
+
+Table and column names are looked up through perfect hashes found at
+generation time, so a lookup is one multiply, one slot and one compare no
+matter how many tables and columns there are.
+
+The generated files are checked in, run 'make regen-codecs' in
+source/OvsDbApi after changing the schema or one of the structs.
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+# tables that have a struct in the public API: struct, OVS_TABLE id and the
+# members always written ahead of the columns when inserting a row
+TABLES = {
+    "Gateway_Config": ("Gateway_Config", "OVS_GW_CONFIG_TABLE", '"gre_ifname":"null",'),
+    "Feedback": ("Feedback", "OVS_FEEDBACK_TABLE", None),
+}
+
+LICENSE = """/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+"""
+
+NOTICE = "/** Generated by scripts/ovsdb_codegen.py from {schema}, do not edit. **/\n"
+
+
+def fnv1a(name):
+    h = 0x811c9dc5
+    for b in name.encode("utf-8"):
+        h = ((h ^ b) * 0x01000193) & 0xffffffff
+    return h
+
+
+def column_type(column):
+    """Returns the atomic type of a column holding at most one value, else None."""
+    t = column["type"]
+    if isinstance(t, str):
+        return t
+    if "value" in t or t.get("max", 1) != 1:
+        return None
+    key = t["key"]
+    return key if isinstance(key, str) else key["type"]
+
+
+def strip_comments(text):
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    return re.sub(r"//[^\n]*", "", text)
+
+
+def parse_enum(body):
+    """Returns the value of every enumerator, None where it is not a plain number."""
+    values = {}
+    value = 0
+    for item in body.split(","):
+        e = re.match(r"\s*(\w+)\s*(?:=\s*(.+?))?\s*$", item)
+        if not e:
+            continue
+        if e.group(2) is not None:
+            try:
+                value = int(e.group(2), 0)
+            except ValueError:
+                value = None
+        values[e.group(1)] = value
+        value = value + 1 if value is not None else None
+    return values
+
+
+def parse_headers(include_dir):
+    """Returns the enumerators of every enum typedef and the fields of every struct typedef."""
+    enums = {}
+    structs = {}
+    for name in sorted(os.listdir(include_dir)):
+        if not name.endswith(".h"):
+            continue
+        with open(os.path.join(include_dir, name)) as f:
+            text = strip_comments(f.read())
+        for m in re.finditer(r"typedef\s+enum\s*\w*\s*\{([^}]*)\}\s*(\w+)\s*;", text):
+            enums[m.group(2)] = parse_enum(m.group(1))
+        for m in re.finditer(r"typedef\s+struct\s*\w*\s*\{([^}]*)\}\s*(\w+)\s*;", text):
+            fields = {}
+            for decl in m.group(1).split(";"):
+                d = re.match(r"\s*([\w\s\*]+?)\s*(\w+)\s*(\[[^\]]+\])?\s*$", decl)
+                if d:
+                    fields[d.group(2)] = (d.group(1).strip(), d.group(3) is not None)
+            structs[m.group(2)] = fields
+    return enums, structs
+
+
+def field_type(ctype, is_array, enums):
+    if is_array and ctype == "char":
+        return "string"
+    if not is_array and ctype == "bool":
+        return "boolean"
+    if not is_array and (ctype == "int" or ctype in enums):
+        return "integer"
+    return None
+
+
+def table_id_values(enums, tables):
+    ids = {}
+    for values in enums.values():
+        ids.update(values)
+    for table in tables:
+        if ids.get(table[2]) is None:
+            sys.exit("value of %s not found in the headers" % table[2])
+    return ids
+
+
+def build_tables(schema, enums, structs):
+    tables = []
+    for table, (struct, table_id, insert_prefix) in TABLES.items():
+        if table not in schema["tables"]:
+            sys.exit("table %s is not in the schema" % table)
+        if struct not in structs:
+            sys.exit("struct %s not found in the headers" % struct)
+        fields = structs[struct]
+        columns = []
+        for name, column in schema["tables"][table]["columns"].items():
+            if name not in fields:
+                continue
+            ctype, is_array = fields[name]
+            stype = column_type(column)
+            if stype is None or field_type(ctype, is_array, enums) != stype:
+                sys.exit("column %s.%s of type %s does not fit field '%s %s'"
+                         % (table, name, stype, ctype, name))
+            columns.append((name, stype))
+        if len(columns) > 32:
+            # monitor updates report the changed columns as a 32 bit mask
+            sys.exit("table %s has more than 32 columns" % table)
+        for name in fields:
+            if name not in schema["tables"][table]["columns"]:
+                print("note: %s.%s has no column in the schema" % (struct, name),
+                      file=sys.stderr)
+        tables.append((table, struct, table_id, insert_prefix, columns))
+    return tables
+
+
+def perfect_hash(names):
+    """
+    Finds a multiplier and a number of bits for which (hash * mult) >> (32 - bits)
+    maps the FNV-1a hash of every name to a slot of its own. Returns the
+    multiplier, the shift and the slot table, holding 1 + the position of the
+    name in each slot and 0 in the empty ones.
+    """
+    hashes = [fnv1a(name) for name in names]
+    if len(set(hashes)) != len(hashes):
+        sys.exit("FNV-1a collision among %s" % ", ".join(names))
+    if len(names) > 255:
+        sys.exit("too many names for 8 bit slots: %d" % len(names))
+    bits = max(1, (len(names) - 1).bit_length())
+    while True:
+        for k in range(1 << 16):
+            mult = (0x9e3779b1 + 2 * k) & 0xffffffff
+            slots = [(((h * mult) & 0xffffffff) >> (32 - bits)) for h in hashes]
+            if len(set(slots)) == len(slots):
+                table = [0] * (1 << bits)
+                for i, slot in enumerate(slots):
+                    table[slot] = i + 1
+                return mult, 32 - bits, table
+        bits += 1
+
+
+def c_array(values, indent="    ", per_line=16):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append(indent + ", ".join(str(v) for v in values[i:i + per_line]))
+    return ",\n".join(lines)
+
+
+def c_string(value):
+    return '"' + value.replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+
+def member_name(struct):
+    return struct.lower()
+
+
+def write_header(path, schema_name, schema, tables, ids):
+    with open(path, "w") as f:
+        f.write(LICENSE + "\n" + NOTICE.format(schema=schema_name) + "\n")
+        f.write("#ifndef OVSDB_SCHEMA_H\n#define OVSDB_SCHEMA_H\n\n")
+        f.write('#include "OvsConfig.h"\n#include "table_desc.h"\n\n')
+        f.write("#define OVSDB_SCHEMA_VERSION     %s\n" % c_string(schema["version"]))
+        f.write("#define OVSDB_SCHEMA_TABLE_COUNT %d\n" % len(tables))
+        f.write("#define OVSDB_SCHEMA_ID_SLOTS    %d\n\n"
+                % (max(ids[t[2]] for t in tables) + 1))
+        f.write("/** Storage for one row of any table we decode, e.g. on the stack **/\n")
+        f.write("typedef union ovsdb_table_row\n{\n")
+        for _, struct, _, _, _ in tables:
+            f.write("    %s %s;\n" % (struct, member_name(struct)))
+        f.write("} ovsdb_table_row;\n\n")
+        f.write("extern const table_desc ovsdb_schema_tables[OVSDB_SCHEMA_TABLE_COUNT];\n")
+        f.write("/** Perfect hash of the table names into ovsdb_schema_tables **/\n")
+        f.write("extern const table_name_index ovsdb_schema_table_index;\n")
+        f.write("/** 1 + position in ovsdb_schema_tables by OVS_TABLE id, 0 if there is no codec **/\n")
+        f.write("extern const uint8_t ovsdb_schema_table_ids[OVSDB_SCHEMA_ID_SLOTS];\n\n")
+        f.write("#endif\n")
+
+
+def write_source(path, schema_name, tables, ids):
+    kinds = {"string": "TABLE_COLUMN_STRING", "integer": "TABLE_COLUMN_INTEGER",
+             "boolean": "TABLE_COLUMN_BOOLEAN"}
+    with open(path, "w") as f:
+        f.write(LICENSE + "\n" + NOTICE.format(schema=schema_name) + "\n")
+        f.write("#include <stddef.h>\n#include \"ovsdb_schema.h\"\n")
+        for _, struct, _, _, columns in tables:
+            f.write("\nstatic const table_column %s_columns[] = {\n" % member_name(struct))
+            rows = []
+            for name, stype in columns:
+                rows.append("    { %s, 0x%08xu, %s,\n      offsetof(%s, %s), sizeof(((%s*)0)->%s) }"
+                            % (c_string(name), fnv1a(name), kinds[stype],
+                               struct, name, struct, name))
+            f.write(",\n".join(rows) + "\n};\n")
+            _, _, slots = perfect_hash([name for name, _ in columns])
+            f.write("\nstatic const uint8_t %s_slots[%d] = {\n%s\n};\n"
+                    % (member_name(struct), len(slots), c_array(slots)))
+        f.write("\nconst table_desc ovsdb_schema_tables[OVSDB_SCHEMA_TABLE_COUNT] = {\n")
+        rows = []
+        for table, struct, table_id, insert_prefix, columns in tables:
+            mult, shift, _ = perfect_hash([name for name, _ in columns])
+            rows.append("    { %s, 0x%08xu, %s, sizeof(%s),\n"
+                        "      %s_columns, %d, { %s_slots, 0x%08xu, %d },\n      %s }"
+                        % (c_string(table), fnv1a(table), table_id, struct,
+                           member_name(struct), len(columns), member_name(struct),
+                           mult, shift, c_string(insert_prefix) if insert_prefix else "NULL"))
+        f.write(",\n".join(rows) + "\n};\n")
+
+        mult, shift, slots = perfect_hash([t[0] for t in tables])
+        f.write("\nstatic const uint8_t table_slots[%d] = {\n%s\n};\n" % (len(slots), c_array(slots)))
+        f.write("\nconst table_name_index ovsdb_schema_table_index = { table_slots, 0x%08xu, %d };\n"
+                % (mult, shift))
+
+        positions = [0] * (max(ids[t[2]] for t in tables) + 1)
+        for i, t in enumerate(tables):
+            positions[ids[t[2]]] = i + 1
+        f.write("\nconst uint8_t ovsdb_schema_table_ids[OVSDB_SCHEMA_ID_SLOTS] = {\n%s\n};\n"
+                % c_array(positions))
+
+
+def main():
+    root = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--schema", default=os.path.join(root, "source/emulator/ovs.ovschema"))
+    parser.add_argument("--include", default=os.path.join(root, "source/include"))
+    parser.add_argument("--out", default=os.path.join(root, "source/OvsDbApi/json_parser"))
+    args = parser.parse_args()
+
+    with open(args.schema) as f:
+        schema = json.load(f)
+    enums, structs = parse_headers(args.include)
+    tables = build_tables(schema, enums, structs)
+    ids = table_id_values(enums, tables)
+
+    schema_name = os.path.relpath(os.path.abspath(args.schema), root)
+    write_header(os.path.join(args.out, "ovsdb_schema.h"), schema_name, schema, tables, ids)
+    write_source(os.path.join(args.out, "ovsdb_schema.c"), schema_name, tables, ids)
+
+
+if __name__ == "__main__":
+    main()
@@ -31,76 +31,26 @@
 
 #define MAX_RID_LEN                 12
 #define OVS_BLOCK_MODE_TIMEOUT_SECS 3    // wait for OvsDbApi to respond back
+// a batch waits for all its Feedbacks, which the transaction manager times out
+#define OVS_BLOCK_MODE_BATCH_TIMEOUT_SECS \
+    (TRANSACTION_TIMEOUT_MSECS / 1000 + OVS_BLOCK_MODE_TIMEOUT_SECS)
 #define OVS_STARTING_ID_MULTIPLIER  1000 // multiplier used to generate range of rId's
 
 // Context structure used to generate a handle to this context
 typedef struct ovs_agent_api_context
 {
     OVS_COMPONENT_ID cid; // Component ID enum.
-    pthread_cond_t  condition;
-    pthread_mutex_t mutex;
-    bool            blocked; // true if in a blocked state
     bool            monitorFeedback; // true if successfully sent a monitor Feedback request
+    completion_queue * completions; // of the requests sent with ovs_agent_api_interact_queued
 } ovs_agent_api_context;
 
 static ovs_agent_api_context * g_handle = NULL;
 static const char* const g_cids[] = {"Unknown", "TestApp", "OvsAgent", "BridgeUtils", "MeshAgent"};
 
-static void signal_callback_completion()
-{
-    if (g_handle->blocked)
-    {
-        pthread_mutex_lock(&g_handle->mutex);
-        g_handle->blocked = false;
-        pthread_cond_signal(&g_handle->condition);
-        pthread_mutex_unlock(&g_handle->mutex);
-    }
-}
-
-// wait for both callbacks or timeout to occur
-static OVS_STATUS wait_for_callback_completion(int timeoutSecs)
-{
-    OVS_STATUS status = OVS_FAILED_STATUS;
-    struct timespec ts;
-    struct timespec now;
-    int result;
-
-    memset(&ts, 0, sizeof(struct timespec));
-    memset(&now, 0, sizeof(struct timespec));
-
-    pthread_mutex_lock(&g_handle->mutex);
-
-    clock_gettime(CLOCK_REALTIME, &now);
-    ts.tv_sec = now.tv_sec + timeoutSecs;
-
-    OvsAgentApiDebug("%s waiting for %d secs...\n", __FUNCTION__, timeoutSecs);
-    while (g_handle->blocked)
-    {
-        result = pthread_cond_timedwait(&g_handle->condition, &g_handle->mutex, &ts);
-        if (result == ETIMEDOUT)
-        {
-            OvsAgentApiError("%s pthread_cond_timedwait TIMED OUT!!!\n", __FUNCTION__);
-            g_handle->blocked = false;
-            status = OVS_TIMED_OUT_STATUS;
-        }
-        else if (result == 0)
-        {
-            OvsAgentApiDebug("%s pthread_cond_timedwait SIGNALLED OK!!!\n", __FUNCTION__);
-            status = OVS_SUCCESS_STATUS;
-        }
-        else
-        {
-            OvsAgentApiError("%s pthread_cond_timedwait ERROR!!!\n", __FUNCTION__);
-            g_handle->blocked = false;
-            status = OVS_TIMED_WAIT_ERROR_STATUS;
-        }
-    }
-
-    pthread_mutex_unlock(&g_handle->mutex);
-    return status;
-}
-
-// TODO: in non-blocked scenario, the DB Abstraction layer needs to call this callback in case of a timeout or no response from the OVS DB.
+/**
+ * Completes the transaction a Feedback row is for. The Feedback table is
+ * shared, rows of other components' transactions are left alone.
+**/
 static void ovs_agent_api_monitor_feedback_callback(OVS_STATUS status,
     Rdkb_Table_Config * table_config)
 {
@@ -108,18 +58,15 @@ static void ovs_agent_api_monitor_feedback_callback(OVS_STATUS status,
     OvsAgentApiDebug("%s Rcvd monitor callback with Status: %d, Table Config: %p\n",
         __func__, status, table_config);
 
-    // TODO: delete a completed transaction or keep a completed transaction entry and instead set its transaction id to unused value
     if (!table_config || !table_config->config)
     {
         OvsAgentApiError("%s failed as table config is NULL!\n", __func__);
-        //callback(OVS_FAILED_STATUS); // TODO Call callback to notify RDKB Component and update transaction as failed and free transaction
         return;
     }
 
     if (table_config->table.id != OVS_FEEDBACK_TABLE)
     {
         OvsAgentApiError("%s failed as table config is NOT Feedback table!\n", __func__);
-        //callback(OVS_FAILED_STATUS); // TODO Call callback to notify RDKB Component and update transaction as failed and free transaction
         return;
     }
 
@@ -131,7 +78,6 @@ static void ovs_agent_api_monitor_feedback_callback(OVS_STATUS status,
     {
         OvsAgentApiError("%s failed to complete transaction for Table: %d, Status: %d, Uuid: %s\n",
             __func__, table_config->table.id, feedback->status, feedback->req_uuid);
-        //callback(OVS_FAILED_STATUS); // TODO Call callback to notify RDKB Component and update transaction as failed and free transaction
         return;
     }
 
@@ -156,13 +102,16 @@ static void ovs_agent_api_monitor_feedback_callback(OVS_STATUS status,
             table_config->table.id);
         return;
     }
-
-    signal_callback_completion();
 }
 
 static bool send_monitor_feedback_request()
 {
-    OVS_STATUS status = ovsdb_monitor(OVS_FEEDBACK_TABLE,
+    // the callback only reads these, and deletes the row once it has seen it
+    static const char * const columns[] = {FEEDBACK_REQ_UUID, "status"};
+    static const OvsDb_Monitor_Select select = {columns, 2,
+        OVSDB_SELECT_INSERT | OVSDB_SELECT_MODIFY};
+
+    OVS_STATUS status = ovsdb_monitor_select(OVS_FEEDBACK_TABLE, &select,
         ovs_agent_api_monitor_feedback_callback, NULL);
     if (status != OVS_SUCCESS_STATUS)
     {
@@ -191,7 +140,10 @@ static bool send_monitor_feedback_cancel_request()
     return true;
 }
 
-// TODO: in non-blocked scenario, the DB Abstraction layer needs to call this callback in case of a timeout or no response from the OVS DB.
+/**
+ * A write that OVSDB refused, or did not answer in time, will not get a
+ * Feedback, its transaction fails with the status of the receipt.
+**/
 static void ovs_agent_api_write_callback(const char * rid, const OvsDb_Base_Receipt* receipt_result)
 {
     OvsDb_Insert_Receipt * receipt = (OvsDb_Insert_Receipt *)receipt_result;
@@ -202,14 +154,72 @@ static void ovs_agent_api_write_callback(const char * rid, const OvsDb_Base_Rece
     if (!receipt || receipt->receipt_id != OVSDB_INSERT_RECEIPT_ID)
     {
         OvsAgentApiWarning("%s received invalid receipt\n", __func__);
-        //callback(OVS_FAILED_STATUS); // TODO Call callback to notify RDKB Component and update transaction as failed and free transaction
+        if (rid)
+        {
+            fail_transaction(rid, OVS_FAILED_STATUS);
+        }
+        return;
+    }
+    if (receipt->status != OVS_SUCCESS_STATUS)
+    {
+        OvsAgentApiError("%s write for rId: %s failed with status %d: %s\n", __func__,
+            (rid ? rid : "NULL"), receipt->status, receipt->error);
+        if (rid)
+        {
+            fail_transaction(rid, receipt->status);
+        }
         return;
     }
     if (!update_transaction(rid, receipt->uuid))
     {
         OvsAgentApiError("%s failed to update transaction for rId: %s, Uuid: %s\n",
             __func__, (rid ? rid : "NULL"), receipt->uuid);
-        //callback(OVS_FAILED_STATUS); // TODO Call callback to notify RDKB Component and update transaction as failed and free transaction
+        if (rid)
+        {   // unless it has timed out already
+            fail_transaction(rid, OVS_FAILED_STATUS);
+        }
+        return;
+    }
+
+    if (!g_handle->monitorFeedback)
+    {
+        g_handle->monitorFeedback = send_monitor_feedback_request();
+    }
+}
+
+/** Same as ovs_agent_api_write_callback() for the rows of a batch **/
+static void ovs_agent_api_write_batch_callback(const char * rid,
+    const OvsDb_Base_Receipt* receipt_result)
+{
+    OvsDb_Insert_Batch_Receipt * receipt = (OvsDb_Insert_Batch_Receipt *)receipt_result;
+
+    OvsAgentApiDebug("%s Rcvd write callback for rId: %s, Receipt Id: %d\n", __func__,
+        (rid ? rid : "NULL"), (receipt ? receipt->receipt_id : -1));
+
+    if (!rid)
+    {
+        OvsAgentApiWarning("%s received receipt without rId\n", __func__);
+        return;
+    }
+    if (!receipt || receipt->receipt_id != OVSDB_INSERT_BATCH_RECEIPT_ID)
+    {
+        OvsAgentApiWarning("%s received invalid receipt\n", __func__);
+        fail_transaction(rid, OVS_FAILED_STATUS);
+        return;
+    }
+    if (receipt->status != OVS_SUCCESS_STATUS)
+    {
+        OvsAgentApiError("%s write for rId: %s failed at row %d with status %d: %s\n",
+            __func__, rid, receipt->failed_row, receipt->status, receipt->error);
+        fail_transaction(rid, receipt->status);
+        return;
+    }
+    if (!update_batch_transaction(rid, (const char (*)[MAX_UUID_LEN + 1])receipt->uuids,
+        receipt->count))
+    {
+        OvsAgentApiError("%s failed to update transaction for rId: %s with %zu Uuids\n",
+            __func__, rid, receipt->count);
+        fail_transaction(rid, OVS_FAILED_STATUS);
         return;
     }
 
@@ -231,7 +241,6 @@ static const char * component_id_enum_to_string(OVS_COMPONENT_ID cid)
 bool ovs_agent_api_init(OVS_COMPONENT_ID cid)
 {
     OVS_STATUS status;
-    pthread_condattr_t condition_attr;
 
     if (g_handle)
     {
@@ -255,7 +264,6 @@ bool ovs_agent_api_init(OVS_COMPONENT_ID cid)
     }
 
     g_handle->cid = cid;
-    g_handle->blocked = OVS_DISABLE_BLOCK_MODE;
     g_handle->monitorFeedback = false;
     if ((access(OVSAGENT_DEBUG_ENABLE, F_OK) != -1) &&
         set_log_level(LOG_DEBUG_LEVEL))
@@ -263,6 +271,13 @@ bool ovs_agent_api_init(OVS_COMPONENT_ID cid)
         OvsAgentApiInfo("%s successfully set debug log level.\n", __func__);
     }
 
+    // every monitor of the agent resumes after a restart, e.g. Gateway_Config and Feedback
+    if (cid == OVS_AGENT_COMPONENT_ID &&
+        ovsdb_set_state_file(OVSAGENT_STATE_FILE) != OVS_SUCCESS_STATUS)
+    {
+        OvsAgentApiWarning("%s monitors will not resume after a restart.\n", __func__);
+    }
+
     status = ovsdb_init(cid * OVS_STARTING_ID_MULTIPLIER);
     if (status != OVS_SUCCESS_STATUS)
     {
@@ -273,34 +288,11 @@ bool ovs_agent_api_init(OVS_COMPONENT_ID cid)
         return false;
     }
 
-    if (pthread_mutex_init(&g_handle->mutex, NULL) != 0) {
-        OvsAgentApiError("%s failed to initialize mutex\n", __func__);
-        // TODO: deinit database connection
-        close_log();
-        free(g_handle);
-        g_handle = NULL;
-        return false;
-    }
-
-    pthread_condattr_init(&condition_attr);
-    if (pthread_cond_init (&g_handle->condition, &condition_attr) != 0) {
-       OvsAgentApiError("%s failed to create intialize condition\n",__func__);
-
-       pthread_mutex_destroy(&g_handle->mutex);
-        // TODO: deinit database connection
-       close_log();
-       free(g_handle);
-       g_handle = NULL;
-       return false;
-    }
-
     // TODO: Store ptr to transaction table within handle
     if (!init_transaction_manager())
     {
         OvsAgentApiError("%s failed to initialize transaction manager!\n", __func__);
 
-        pthread_cond_destroy(&g_handle->condition);
-        pthread_mutex_destroy(&g_handle->mutex);
         // TODO: deinit database connection
         close_log();
         free(g_handle);
@@ -308,6 +300,17 @@ bool ovs_agent_api_init(OVS_COMPONENT_ID cid)
         return false;
     }
 
+    if ((g_handle->completions = completion_queue_create()) == NULL)
+    {
+        OvsAgentApiError("%s failed to create the completion queue!\n", __func__);
+        deinit_transaction_manager();
+        ovsdb_deinit();
+        close_log();
+        free(g_handle);
+        g_handle = NULL;
+        return false;
+    }
+
     OvsAgentApiInfo("%s successfully initialized for cid %u.\n", __func__, cid);
     return true;
 }
@@ -335,10 +338,9 @@ bool ovs_agent_api_deinit(void)
             __func__);
     }
 
+    // fails those still in flight, into the completion queue too
     deinit_transaction_manager();
-
-    pthread_cond_destroy(&g_handle->condition);
-    pthread_mutex_destroy(&g_handle->mutex);
+    completion_queue_destroy(g_handle->completions);
 
     if (!close_log())
     {
@@ -408,13 +410,42 @@ void print_rdkb_table_config(Rdkb_Table_Config * table_config)
     }
 }
 
-static bool handle_transact_insert_request(ovs_interact_request * request, ovs_interact_cb callback)
+/**
+ * Waits up to 'timeoutSecs' for the transaction of a blocked caller and
+ * returns its final status, the completion can be dropped afterwards.
+**/
+static OVS_STATUS wait_for_transaction(char * rid, transaction_completion * waiter,
+    int timeoutSecs)
+{
+    OVS_STATUS status = wait_transaction_completion(waiter, timeoutSecs);
+
+    if (status != OVS_SUCCESS_STATUS && !delete_transaction(rid))
+    {   // taken for completion meanwhile, which signals the waiter right after
+        while (wait_transaction_completion(waiter, OVS_BLOCK_MODE_TIMEOUT_SECS) !=
+            OVS_SUCCESS_STATUS)
+        {
+            OvsAgentApiWarning("%s still waiting for rId: %s to complete\n", __func__, rid);
+        }
+        status = OVS_SUCCESS_STATUS;
+    }
+    if (status == OVS_SUCCESS_STATUS)
+    {   // the final Feedback status
+        status = waiter->status;
+    }
+    destroy_transaction_completion(waiter);
+    return status;
+}
+
+static bool handle_transact_insert_request(ovs_interact_request * request, ovs_interact_cb callback,
+    completion_queue * queue, uint64_t user_data)
 {
     bool rtn = false;
     char rid[MAX_RID_LEN] = "";
     int len = 0;
     OVS_STATUS status;
     ovsdb_receipt_cb cb = NULL;
+    transaction_completion completion;
+    transaction_completion * waiter = NULL; // set in block mode only
 
     if (!request)
     {
@@ -427,15 +458,27 @@ static bool handle_transact_insert_request(ovs_interact_request * request, ovs_i
         return false;
     }
 
-    if (callback || request->block_mode == OVS_ENABLE_BLOCK_MODE)
+    if (request->block_mode == OVS_ENABLE_BLOCK_MODE)
+    {
+        if (!init_transaction_completion(&completion))
+        {
+            OvsAgentApiError("%s failed to create completion for rId %s!\n",
+                __func__, rid);
+            return false;
+        }
+        waiter = &completion;
+    }
+
+    if (callback || waiter || queue)
     {   // RDKB Component case only
-        g_handle->blocked = (request->block_mode == OVS_ENABLE_BLOCK_MODE) ? true : false;
         cb = ovs_agent_api_write_callback;
 
-        if (!insert_transaction(rid, callback, &request->table_config))
+        if (!(queue ? insert_queued_transaction(rid, &request->table_config, queue, user_data) :
+            insert_transaction(rid, callback, &request->table_config, waiter)))
         {
             OvsAgentApiError("%s failed to create transaction with rId %s!\n",
                 __func__, rid);
+            destroy_transaction_completion(waiter);
             return false;
         }
     }
@@ -448,34 +491,25 @@ static bool handle_transact_insert_request(ovs_interact_request * request, ovs_i
     {
         OvsAgentApiError("%s failed to do a OVS DB write operation for rId %s!\n",
             __func__, rid);
-        // TODO: Update failed transaction status, complete and free transaction, return
-        if (g_handle->blocked)
+        // reported by the return value, the callback is not called
+        if (cb && !delete_transaction(rid))
         {
-            g_handle->blocked = false;
+            OvsAgentApiError("%s failed to delete transaction with rId: %s!\n",
+                __func__, rid);
         }
+        destroy_transaction_completion(waiter);
         goto cleanup;
     }
 
-    if (request->block_mode != OVS_ENABLE_BLOCK_MODE)
+    if (!waiter)
     {
         return true;
     } // else block mode is enabled
-    else
-    {
-        status = wait_for_callback_completion(OVS_BLOCK_MODE_TIMEOUT_SECS);
-    }
 
-cleanup:
-    if (status == OVS_SUCCESS_STATUS)
-    {
-        rtn = true;
-    }
-    else if (!delete_transaction(rid))
-    {
-        OvsAgentApiError("%s failed to delete transaction with rId: %s!\n",
-            __func__, rid);
-    }
+    status = wait_for_transaction(rid, waiter, OVS_BLOCK_MODE_TIMEOUT_SECS);
 
+cleanup:
+    rtn = (status == OVS_SUCCESS_STATUS);
     OvsAgentApiInfo("%s rId: %s, status: %d, rtn: %s\n", __func__, rid, status,
         (rtn?"SUCCESS":"ERROR"));
     return rtn;
@@ -526,7 +560,7 @@ bool ovs_agent_api_interact(ovs_interact_request * request, ovs_interact_cb call
     {
         if (request->method == OVS_TRANSACT_METHOD)
         {
-            return handle_transact_insert_request(request, callback);
+            return handle_transact_insert_request(request, callback, NULL, 0);
         }
         else if (request->method == OVS_MONITOR_METHOD)
         { // OVS Agent case
@@ -538,6 +572,168 @@ bool ovs_agent_api_interact(ovs_interact_request * request, ovs_interact_cb call
     return false;
 }
 
+static bool handle_transact_batch_request(ovs_interact_request * requests, size_t count,
+    ovs_interact_batch_cb callback)
+{
+    char rid[MAX_RID_LEN] = "";
+    int len = 0;
+    OVS_STATUS status;
+    ovsdb_receipt_cb cb = NULL;
+    Rdkb_Table_Config * table_configs = NULL;
+    transaction_completion completion;
+    transaction_completion * waiter = NULL; // set in block mode only
+    size_t i;
+
+    len = snprintf(rid, MAX_RID_LEN, "%u", id_generate());
+    if (len <= 0 || len >= MAX_RID_LEN)
+    {
+        return false;
+    }
+
+    // ovsdb_write_batch() takes the rows side by side
+    if ((table_configs = (Rdkb_Table_Config *)malloc(count * sizeof(Rdkb_Table_Config))) == NULL)
+    {
+        OvsAgentApiError("%s failed to allocate %zu table configs!\n", __func__, count);
+        return false;
+    }
+    for (i = 0; i < count; i++)
+    {
+        table_configs[i] = requests[i].table_config;
+    }
+
+    if (requests[0].block_mode == OVS_ENABLE_BLOCK_MODE)
+    {
+        if (!init_transaction_completion(&completion))
+        {
+            OvsAgentApiError("%s failed to create completion for rId %s!\n",
+                __func__, rid);
+            free(table_configs);
+            return false;
+        }
+        waiter = &completion;
+    }
+
+    if (callback || waiter)
+    {   // RDKB Component case only
+        cb = ovs_agent_api_write_batch_callback;
+
+        if (!insert_batch_transaction(rid, callback, table_configs, count, waiter))
+        {
+            OvsAgentApiError("%s failed to create transaction with rId %s!\n",
+                __func__, rid);
+            destroy_transaction_completion(waiter);
+            free(table_configs);
+            return false;
+        }
+    }
+
+    OvsAgentApiDebug("%s Doing a %s ovsdb_write_batch of %zu rows with rId: %s, Callback: %s\n",
+        __func__, (waiter ? "BLOCKED" : "UNBLOCKED"), count, rid, (cb ? "NON-NULL" : "NULL"));
+    status = ovsdb_write_batch(rid, table_configs, count, cb);
+    free(table_configs);
+    if (status != OVS_SUCCESS_STATUS)
+    {
+        OvsAgentApiError("%s failed to do a OVS DB write operation for rId %s!\n",
+            __func__, rid);
+        // reported by the return value, the callback is not called
+        if (cb && !delete_transaction(rid))
+        {
+            OvsAgentApiError("%s failed to delete transaction with rId: %s!\n",
+                __func__, rid);
+        }
+        destroy_transaction_completion(waiter);
+    }
+    else if (waiter)
+    {
+        status = wait_for_transaction(rid, waiter, OVS_BLOCK_MODE_BATCH_TIMEOUT_SECS);
+    }
+
+    OvsAgentApiInfo("%s rId: %s, rows: %zu, status: %d\n", __func__, rid, count, status);
+    return (status == OVS_SUCCESS_STATUS);
+}
+
+bool ovs_agent_api_interact_batch(ovs_interact_request * requests, size_t count,
+    ovs_interact_batch_cb callback)
+{
+    size_t i;
+
+    if (!requests || count == 0)
+    {
+        return false;
+    }
+
+    if (!g_handle)
+    {
+        OvsAgentApiError("%s failed as the Ovs Agent Api was not initialized!\n",
+            __func__);
+        return false;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        if (requests[i].operation != OVS_INSERT_OPERATION ||
+            requests[i].method != OVS_TRANSACT_METHOD ||
+            requests[i].block_mode != requests[0].block_mode ||
+            !requests[i].table_config.config)
+        {
+            OvsAgentApiDebug("%s Unsupported request %zu operation=%d, method=%d, block mode=%d\n",
+                __func__, i, requests[i].operation, requests[i].method,
+                requests[i].block_mode);
+            return false;
+        }
+        print_rdkb_table_config(&requests[i].table_config);
+    }
+
+    return handle_transact_batch_request(requests, count, callback);
+}
+
+bool ovs_agent_api_interact_queued(ovs_interact_request * request, uint64_t user_data)
+{
+    if (!request)
+    {
+        return false;
+    }
+
+    if (!g_handle)
+    {
+        OvsAgentApiError("%s failed as the Ovs Agent Api was not initialized!\n",
+            __func__);
+        return false;
+    }
+
+    if (request->operation != OVS_INSERT_OPERATION ||
+        request->method != OVS_TRANSACT_METHOD ||
+        request->block_mode == OVS_ENABLE_BLOCK_MODE)
+    {
+        OvsAgentApiDebug("%s Unsupported request operation=%d, method=%d, block mode=%d\n",
+            __func__, request->operation, request->method, request->block_mode);
+        return false;
+    }
+
+    print_rdkb_table_config(&request->table_config);
+    return handle_transact_insert_request(request, NULL, g_handle->completions, user_data);
+}
+
+int ovs_agent_api_get_completion_fd(void)
+{
+    if (!g_handle)
+    {
+        OvsAgentApiError("%s failed as the Ovs Agent Api was not initialized!\n",
+            __func__);
+        return -1;
+    }
+    return completion_queue_fd(g_handle->completions);
+}
+
+size_t ovs_agent_api_reap_completions(ovs_agent_api_completion * completions, size_t max)
+{
+    if (!completions || !g_handle)
+    {
+        return 0;
+    }
+    return completion_queue_reap(g_handle->completions, completions, max);
+}
+
 static bool initialize_gateway_config(Gateway_Config * config)
 {
     if (!config)
@@ -0,0 +1,171 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include "common/OvsAgentLog.h"
+#include "OvsAgentApi/completion_queue.h"
+
+completion_queue * completion_queue_create(void)
+{
+    completion_queue * queue = NULL;
+
+    if ((queue = (completion_queue *)calloc(1, sizeof(completion_queue))) == NULL)
+    {
+        return NULL;
+    }
+
+    queue->size = COMPLETION_QUEUE_MIN_SIZE;
+    queue->ring = (ovs_agent_api_completion *)malloc(
+        queue->size * sizeof(ovs_agent_api_completion));
+    queue->event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (!queue->ring || queue->event_fd < 0)
+    {
+        OvsAgentApiError("%s failed to create the completion queue!\n", __func__);
+        if (queue->event_fd >= 0)
+        {
+            close(queue->event_fd);
+        }
+        free(queue->ring);
+        free(queue);
+        return NULL;
+    }
+
+    pthread_mutex_init(&queue->mutex, NULL);
+    return queue;
+}
+
+void completion_queue_destroy(completion_queue * queue)
+{
+    size_t i;
+
+    if (!queue)
+    {
+        return;
+    }
+
+    for (i = 0; i < queue->count; i++)
+    {
+        free(queue->ring[(queue->head + i) & (queue->size - 1)].table_config.config);
+    }
+    if (queue->count)
+    {
+        OvsAgentApiDebug("%s dropped %zu completions\n", __func__, queue->count);
+    }
+    close(queue->event_fd);
+    pthread_mutex_destroy(&queue->mutex);
+    free(queue->ring);
+    free(queue);
+}
+
+int completion_queue_fd(const completion_queue * queue)
+{
+    return queue->event_fd;
+}
+
+/** Doubles the ring, unwrapping what it holds. Called with the queue locked. **/
+static bool grow_completion_queue(completion_queue * queue)
+{
+    ovs_agent_api_completion * ring = NULL;
+    size_t size = queue->size * 2;
+    size_t first = queue->size - queue->head; // those up to the end of the ring
+
+    if ((ring = (ovs_agent_api_completion *)malloc(
+        size * sizeof(ovs_agent_api_completion))) == NULL)
+    {
+        return false;
+    }
+    if (first > queue->count)
+    {
+        first = queue->count;
+    }
+    memcpy(ring, &queue->ring[queue->head], first * sizeof(ovs_agent_api_completion));
+    memcpy(&ring[first], queue->ring, (queue->count - first) * sizeof(ovs_agent_api_completion));
+
+    free(queue->ring);
+    queue->ring = ring;
+    queue->size = size;
+    queue->head = 0;
+    return true;
+}
+
+bool completion_queue_push(completion_queue * queue,
+    const ovs_agent_api_completion * completion)
+{
+    const uint64_t one = 1;
+    bool pushed = true;
+
+    pthread_mutex_lock(&queue->mutex);
+    if (queue->count == queue->size && !grow_completion_queue(queue))
+    {
+        pushed = false;
+    }
+    else
+    {
+        queue->ring[(queue->head + queue->count) & (queue->size - 1)] = *completion;
+        // readable from the first one on, until all are reaped
+        if (queue->count++ == 0 &&
+            write(queue->event_fd, &one, sizeof(one)) != sizeof(one))
+        {
+            OvsAgentApiError("%s failed to signal the completion queue!\n", __func__);
+        }
+    }
+    pthread_mutex_unlock(&queue->mutex);
+
+    if (!pushed)
+    {
+        OvsAgentApiError("%s failed to grow the completion queue beyond %zu!\n",
+            __func__, queue->size);
+    }
+    return pushed;
+}
+
+size_t completion_queue_reap(completion_queue * queue,
+    ovs_agent_api_completion * completions, size_t max)
+{
+    uint64_t events = 0;
+    size_t reaped = 0;
+    size_t first = 0;
+
+    pthread_mutex_lock(&queue->mutex);
+    reaped = (max < queue->count) ? max : queue->count;
+    if (reaped)
+    {
+        first = queue->size - queue->head;
+        if (first > reaped)
+        {
+            first = reaped;
+        }
+        memcpy(completions, &queue->ring[queue->head],
+            first * sizeof(ovs_agent_api_completion));
+        memcpy(&completions[first], queue->ring,
+            (reaped - first) * sizeof(ovs_agent_api_completion));
+        queue->head = (queue->head + reaped) & (queue->size - 1);
+        queue->count -= reaped;
+        if (queue->count == 0 &&
+            read(queue->event_fd, &events, sizeof(events)) != sizeof(events))
+        {
+            OvsAgentApiWarning("%s failed to clear the completion queue event\n", __func__);
+        }
+    }
+    pthread_mutex_unlock(&queue->mutex);
+    return reaped;
+}
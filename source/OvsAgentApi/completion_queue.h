@@ -0,0 +1,95 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+#ifndef COMPLETION_QUEUE_H_
+#define COMPLETION_QUEUE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <pthread.h>
+#include "OvsConfig.h"
+
+#define COMPLETION_QUEUE_MIN_SIZE 64 // a power of 2
+
+/**
+ * @brief Completions waiting to be reaped by an RDKB Component.
+ *
+ * A ring that grows as needed, with an eventfd that is readable while the
+ * ring is not empty, so that a component can watch it in its own event loop.
+ */
+typedef struct completion_queue
+{
+    pthread_mutex_t mutex;
+    ovs_agent_api_completion * ring;
+    size_t size;            // a power of 2
+    size_t head;            // next one to reap
+    size_t count;
+    int event_fd;
+} completion_queue;
+
+/**
+ * @brief Creates a completion queue.
+ *
+ * @return The queue, or NULL on failure.
+ */
+completion_queue * completion_queue_create(void);
+
+/**
+ * @brief Destroys a completion queue, free'ing the configs not reaped.
+ *
+ * @param[in] queue The queue to destroy, can be NULL.
+ */
+void completion_queue_destroy(completion_queue * queue);
+
+/**
+ * @brief Returns the eventfd that is readable while completions are queued.
+ *
+ * @param[in] queue The queue.
+ *
+ * @return The fd.
+ */
+int completion_queue_fd(const completion_queue * queue);
+
+/**
+ * @brief Queues a completion, taking over its table config.
+ *
+ * Only the first completion queued into an empty queue writes the eventfd.
+ *
+ * @param[in] queue The queue.
+ * @param[in] completion The completion to copy into the queue.
+ *
+ * @return boolean true indicating success, false if it could not grow.
+ */
+bool completion_queue_push(completion_queue * queue,
+    const ovs_agent_api_completion * completion);
+
+/**
+ * @brief Takes up to max completions, oldest first.
+ *
+ * The eventfd is cleared once the queue is empty.
+ *
+ * @param[in] queue The queue.
+ * @param[out] completions Where to copy the completions.
+ * @param[in] max The number of completions that fit.
+ *
+ * @return The number of completions taken.
+ */
+size_t completion_queue_reap(completion_queue * queue,
+    ovs_agent_api_completion * completions, size_t max);
+
+#endif /* COMPLETION_QUEUE_H_ */
@@ -21,10 +21,28 @@
 #define TRANSACTION_INTERFACE_H_
 
 #include <stdbool.h>
+#include <pthread.h>
 #include "OvsConfig.h"
+#include "OvsAgentApi/completion_queue.h"
 
 // TODO have rid be a char* instead of int in interface function definitions
 
+#define TRANSACTION_TIMEOUT_MSECS 30000 // for the Feedback of a transaction
+
+/**
+ * @brief Lets a blocked caller wait for its own transaction.
+ *
+ * Each blocking request has its own, so that any number of them can wait
+ * side by side.
+ */
+typedef struct transaction_completion
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t  condition; // waits on CLOCK_MONOTONIC
+    bool            done;
+    OVS_STATUS      status;    // the final Feedback status once done
+} transaction_completion;
+
 /**
  * @brief Initializes the Transaction Manager.
  *
@@ -49,11 +67,42 @@ void deinit_transaction_manager(void);
  * @param[in] rid Unique identifier associated with the request.
  * @param[in] callback Callback that is invoked when the transaction has completed.
  * @param[in] table_config Pointer to a suplied RDKB table configuration.
+ * @param[in] completion Signalled when the transaction has completed, can be NULL.
  *
  * @return boolean true indicating success, false indicating failure.
  */
 bool insert_transaction(char * rid, ovs_interact_cb callback,
-    Rdkb_Table_Config * table_config);
+    Rdkb_Table_Config * table_config, transaction_completion * completion);
+
+/**
+ * @brief Create and adds a new transaction entry that ends in a completion queue.
+ *
+ * @param[in] rid Unique identifier associated with the request.
+ * @param[in] table_config Pointer to a suplied RDKB table configuration.
+ * @param[in] queue Where the completion is queued, with the table config.
+ * @param[in] user_data Passed back in the completion.
+ *
+ * @return boolean true indicating success, false indicating failure.
+ */
+bool insert_queued_transaction(char * rid, Rdkb_Table_Config * table_config,
+    completion_queue * queue, uint64_t user_data);
+
+/**
+ * @brief Create and adds a transaction for rows written in one transact.
+ *
+ * The batch completes once every row has its Feedback, or fails, times out
+ * or is deleted as a whole like any transaction.
+ *
+ * @param[in] rid Unique identifier associated with the request.
+ * @param[in] callback Callback that is invoked when the batch has completed.
+ * @param[in] table_configs The RDKB table configuration of each row, copied.
+ * @param[in] count Number of rows.
+ * @param[in] completion Signalled when the batch has completed, can be NULL.
+ *
+ * @return boolean true indicating success, false indicating failure.
+ */
+bool insert_batch_transaction(char * rid, ovs_interact_batch_cb callback,
+    Rdkb_Table_Config * table_configs, size_t count, transaction_completion * completion);
 
 /**
  * @brief Deletes a transaction and frees its resources.
@@ -74,9 +123,23 @@ bool delete_transaction(char * rid);
  */
 bool update_transaction(const char * rid, const char * uuid);
 
+/**
+ * @brief Updates a batch with the UUIDs of its rows, in the order of the rows.
+ *
+ * @param[in] rid Unique identifier associated with the request.
+ * @param[in] uuids The UUID of each row.
+ * @param[in] count Number of UUIDs, must be the number of rows.
+ *
+ * @return boolean true indicating success, false indicating failure.
+ */
+bool update_batch_transaction(const char * rid, const char (*uuids)[MAX_UUID_LEN + 1],
+    size_t count);
+
 /**
  * @brief Completes a transaction, calling its callback and free'ing resources.
  *
+ * For a row of a batch, the batch completes with its last row.
+ *
  * @param[in] uuid The UUID associated with the DB transaction.
  * @param[in] status The returned status code of the DB transaction.
  *
@@ -84,4 +147,55 @@ bool update_transaction(const char * rid, const char * uuid);
 */
 bool complete_transaction(char * uuid, OVS_STATUS status);
 
+/**
+ * @brief Fails a transaction that will not get a Feedback, calling its
+ * callback and free'ing resources.
+ *
+ * A transaction ends once, by complete_transaction(), fail_transaction(),
+ * delete_transaction() or timing out, whichever comes first. Those that
+ * get no Feedback within the timeout end with OVS_TIMED_OUT_STATUS.
+ *
+ * @param[in] rid Unique identifier associated with the request.
+ * @param[in] status The status the callback is called with.
+ *
+ * @return boolean true indicating success, false if the transaction had
+ * already ended.
+ */
+bool fail_transaction(const char * rid, OVS_STATUS status);
+
+/**
+ * @brief Sets how long a transaction waits for its Feedback.
+ *
+ * @param[in] msecs The timeout, 0 restores TRANSACTION_TIMEOUT_MSECS.
+ */
+void set_transaction_timeout(unsigned int msecs);
+
+/**
+ * @brief Prepares a completion for one blocking request.
+ *
+ * @param[out] completion The completion to initialize.
+ *
+ * @return boolean true indicating success, false indicating failure.
+ */
+bool init_transaction_completion(transaction_completion * completion);
+
+/**
+ * @brief Releases a completion once nothing can signal it anymore.
+ *
+ * @param[in] completion The completion to destroy.
+ */
+void destroy_transaction_completion(transaction_completion * completion);
+
+/**
+ * @brief Waits until the completion is signalled or the timeout passes.
+ *
+ * @param[in] completion The completion to wait for.
+ * @param[in] timeoutSecs How long to wait at most, measured on CLOCK_MONOTONIC.
+ *
+ * @return OVS_SUCCESS_STATUS once signalled, with the final status in the
+ * completion, OVS_TIMED_OUT_STATUS or OVS_TIMED_WAIT_ERROR_STATUS otherwise.
+ */
+OVS_STATUS wait_transaction_completion(transaction_completion * completion,
+    int timeoutSecs);
+
 #endif /* TRANSACTION_INTERFACE_H_ */
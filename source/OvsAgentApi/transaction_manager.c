@@ -17,94 +17,380 @@
 */
 
 #include <stdio.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <pthread.h>
 #include "common/OvsAgentLog.h"
 #include "OvsAgentApi/transaction_interface.h"
 
-#define MAX_TABLE_SIZE 5
+#define TRANSACTION_INDEX_MIN_SIZE  16      // a power of 2
+#define TRANSACTION_POOL_CHUNK      32
+#define MSECS_PER_SEC               1000
+#define NSECS_PER_MSEC              1000000
 
 typedef enum transaction_state
 {
     TRANSACTION_INIT_ST = 0,
     TRANSACTION_UUID_RECV_ST,
     TRANSACTION_COMPLETE_ST,
-    TRANSACTION_TIMEOUT_ST // TODO: use somewhere
+    TRANSACTION_TIMEOUT_ST
 } TRANSACTION_STATE;
 
-// TODO: add timestamp
 typedef struct Transaction_Entry
 {
     unsigned int id;
     char uuid[MAX_UUID_LEN + 1];
     TRANSACTION_STATE state;
     ovs_interact_cb callback;
+    transaction_completion * completion; // of a blocked caller, can be NULL
+    completion_queue * queue;           // of a queued request, can be NULL
+    uint64_t user_data;                 // passed back through the queue
+    struct Transaction_Batch * batch;   // of a batch, which owns the rows' configs
+    struct Transaction_Entry * parent;  // of a row of a batch, only indexed by uuid
+    size_t row;                         // index of the row in its batch
     Rdkb_Table_Config table_config;
     OVS_STATUS status;
+    struct timespec created;            // CLOCK_MONOTONIC
+    struct timespec updated;            // when the state last changed
+    struct Transaction_Entry * next_free; // in the pool while not in use
+    struct Transaction_Entry * prev_pending; // oldest first, as they time out
+    struct Transaction_Entry * next_pending;
 } Transaction_Entry;
 
+/**
+ * The rows of a batch, written in one transact, each waiting for its own
+ * Feedback. The batch completes once all of them have theirs.
+**/
+typedef struct Transaction_Batch
+{
+    ovs_interact_batch_cb callback;
+    size_t count;
+    size_t remaining;                   // rows still waiting for their Feedback
+    Rdkb_Table_Config * table_configs;
+    Transaction_Entry ** rows;          // NULL until the uuids arrive and once completed
+    OVS_STATUS * statuses;              // OVS_UNKNOWN_STATUS until completed
+} Transaction_Batch;
+
+// marks a slot whose entry was removed, lookups probe past it
+#define TRANSACTION_TOMBSTONE (&g_transaction_tombstone)
+
+/**
+ * Open addressing with linear probing, slots hold entries, NULL or
+ * TRANSACTION_TOMBSTONE. Grows before a third of the slots are left.
+ * A hash picks its home slot with its top bits, the well mixed ones.
+**/
+typedef struct Transaction_Index
+{
+    Transaction_Entry ** slots;
+    unsigned int size;                  // a power of 2
+    unsigned int shift;                 // 32 - log2(size)
+    unsigned int count;
+    unsigned int used;                  // entries and tombstones
+} Transaction_Index;
+
+typedef struct Transaction_Pool_Chunk
+{
+    struct Transaction_Pool_Chunk * next;
+    Transaction_Entry entries[TRANSACTION_POOL_CHUNK];
+} Transaction_Pool_Chunk;
+
 typedef struct Transaction_Table
 {
-    unsigned int size;
-    Transaction_Entry **elements; // An array of pointers to Transaction_Entry structures
+    pthread_mutex_t mutex;              // inserted by API callers, completed by the OVSDB thread
+    Transaction_Index by_id;            // every transaction, by request id
+    Transaction_Index by_uuid;          // those that got their OVSDB uuid
+    Transaction_Entry * free_entries;
+    Transaction_Pool_Chunk * chunks;
+    Transaction_Entry * oldest;         // every transaction, in the order created
+    Transaction_Entry * newest;
+    unsigned int timeout_msecs;
+    pthread_cond_t expiry_condition;    // wakes the expiry thread, on CLOCK_MONOTONIC
+    pthread_t expiry_thread;
+    bool running;
 } Transaction_Table;
 
+typedef unsigned int (*index_hash_fn)(const void * key);
+typedef bool (*index_match_fn)(const Transaction_Entry * transaction, const void * key);
+
+static Transaction_Entry g_transaction_tombstone;
 static Transaction_Table * g_transaction_table = NULL;
 
-// TODO: DOM Cleanup entire transaction table
-// TODO: DOM Unit test cases
+static void * expire_transactions(void * arg);
+static Transaction_Entry * remove_transaction_table(Transaction_Entry ** slot);
+static bool finish_transaction(Transaction_Entry * transaction, OVS_STATUS status);
+
 // TODO: DOM Keep id as char* instead of unsigned int. Do atoi in hash_code(char* id, size)
 
-static unsigned int hash_code(unsigned int key, unsigned int tableSize)
+static unsigned int hash_code(const void * key)
+{
+    // Fibonacci hashing, consecutive request ids differ in the top bits
+    return *(const unsigned int *)key * 2654435761u;
+}
+
+static unsigned int uuid_hash_code(const void * key)
+{
+    const unsigned char * c = (const unsigned char *)key;
+    uint32_t hash = 2166136261u;
+
+    for (; *c; c++)
+    {
+        hash = (hash ^ *c) * 16777619u;
+    }
+    return hash;
+}
+
+static bool match_id(const Transaction_Entry * transaction, const void * key)
+{
+    return transaction->id == *(const unsigned int *)key;
+}
+
+static bool match_uuid(const Transaction_Entry * transaction, const void * key)
+{
+    return strncmp(transaction->uuid, (const char *)key, MAX_UUID_LEN) == 0;
+}
+
+static unsigned int elapsed_msecs(const struct timespec * since)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned int)((now.tv_sec - since->tv_sec) * 1000 +
+        (now.tv_nsec - since->tv_nsec) / 1000000);
+}
+
+static bool init_transaction_index(Transaction_Index * index, unsigned int size)
+{
+    index->slots = (Transaction_Entry **)calloc(size, sizeof(Transaction_Entry *));
+    if (!index->slots)
+    {
+        return false;
+    }
+    index->size = size;
+    for (index->shift = 32; size > 1; size >>= 1)
+    {
+        index->shift--;
+    }
+    index->count = 0;
+    index->used = 0;
+    return true;
+}
+
+/** Returns the slot holding the entry matching 'key', or NULL **/
+static Transaction_Entry ** find_transaction_slot(Transaction_Index * index,
+    unsigned int hash, index_match_fn match, const void * key)
+{
+    unsigned int mask = index->size - 1;
+    unsigned int i = (uint32_t)hash >> index->shift;
+    Transaction_Entry * slot = NULL;
+
+    while ((slot = index->slots[i]) != NULL)
+    {
+        if (slot != TRANSACTION_TOMBSTONE && match(slot, key))
+        {
+            return &index->slots[i];
+        }
+        i = (i + 1) & mask;
+    }
+    return NULL;
+}
+
+/** Puts 'transaction' in the first free slot, the caller made sure there is one **/
+static void place_transaction(Transaction_Index * index, unsigned int hash,
+    Transaction_Entry * transaction)
 {
-    return (key % tableSize); // the hash function returns a number bounded by the number of table slots.
+    unsigned int mask = index->size - 1;
+    unsigned int i = (uint32_t)hash >> index->shift;
+
+    while (index->slots[i] != NULL && index->slots[i] != TRANSACTION_TOMBSTONE)
+    {
+        i = (i + 1) & mask;
+    }
+    if (index->slots[i] == NULL)
+    {
+        index->used++;
+    }
+    index->slots[i] = transaction;
+    index->count++;
 }
 
-static void init_transaction_table(Transaction_Table * transactionTable)
+/**
+ * Rehashes into a table twice the size, or the same size when it is mostly
+ * tombstones, which drops them.
+**/
+static bool grow_transaction_index(Transaction_Index * index, index_hash_fn hash,
+    bool by_uuid)
 {
+    Transaction_Index grown;
+    unsigned int size = (index->count * 2 >= index->size) ? index->size * 2 : index->size;
     unsigned int i;
-    OvsAgentApiDebug("%s Table: %p(%p), Size: %u\n", __func__,
-        transactionTable, transactionTable->elements, transactionTable->size);
-    for (i=0; i<transactionTable->size; i++)
+
+    if (!init_transaction_index(&grown, size))
     {
-        transactionTable->elements[i] = NULL;
+        OvsAgentApiError("%s failed to allocate %u slots\n", __func__, size);
+        return false;
+    }
+
+    for (i = 0; i < index->size; i++)
+    {
+        Transaction_Entry * transaction = index->slots[i];
+        if (transaction && transaction != TRANSACTION_TOMBSTONE)
+        {
+            place_transaction(&grown, hash(by_uuid ? (const void *)transaction->uuid :
+                (const void *)&transaction->id), transaction);
+        }
     }
+
+    free(index->slots);
+    *index = grown;
+    return true;
+}
+
+static bool add_transaction_index(Transaction_Index * index, index_hash_fn hash,
+    bool by_uuid, Transaction_Entry * transaction)
+{
+    // keeps at least a third of the slots empty so that probes stay short
+    if ((index->used + 1) * 3 > index->size * 2 &&
+        !grow_transaction_index(index, hash, by_uuid))
+    {
+        return false;
+    }
+    place_transaction(index, hash(by_uuid ? (const void *)transaction->uuid :
+        (const void *)&transaction->id), transaction);
+    return true;
+}
+
+static void remove_transaction_slot(Transaction_Index * index, Transaction_Entry ** slot)
+{
+    *slot = TRANSACTION_TOMBSTONE;
+    index->count--;
+}
+
+/** Takes an entry from the pool, which grows a chunk at a time **/
+static Transaction_Entry * alloc_transaction(Transaction_Table * table)
+{
+    Transaction_Pool_Chunk * chunk = NULL;
+    Transaction_Entry * transaction = NULL;
+    unsigned int i;
+
+    if (!table->free_entries)
+    {
+        if ((chunk = (Transaction_Pool_Chunk *)malloc(sizeof(Transaction_Pool_Chunk))) == NULL)
+        {
+            return NULL;
+        }
+        chunk->next = table->chunks;
+        table->chunks = chunk;
+        for (i = 0; i < TRANSACTION_POOL_CHUNK; i++)
+        {
+            chunk->entries[i].next_free = table->free_entries;
+            table->free_entries = &chunk->entries[i];
+        }
+    }
+
+    transaction = table->free_entries;
+    table->free_entries = transaction->next_free;
+    transaction->next_free = NULL;
+    return transaction;
+}
+
+static void release_transaction(Transaction_Table * table, Transaction_Entry * transaction)
+{
+    transaction->next_free = table->free_entries;
+    table->free_entries = transaction;
+}
+
+/** Called with the table locked, wakes the expiry thread for a first one **/
+static void append_pending_transaction(Transaction_Table * table,
+    Transaction_Entry * transaction)
+{
+    transaction->next_pending = NULL;
+    transaction->prev_pending = table->newest;
+    if (table->newest)
+    {
+        table->newest->next_pending = transaction;
+    }
+    else
+    {
+        table->oldest = transaction;
+        pthread_cond_signal(&table->expiry_condition);
+    }
+    table->newest = transaction;
+}
+
+static void unlink_pending_transaction(Transaction_Table * table,
+    Transaction_Entry * transaction)
+{
+    if (transaction->prev_pending)
+    {
+        transaction->prev_pending->next_pending = transaction->next_pending;
+    }
+    else
+    {
+        table->oldest = transaction->next_pending;
+    }
+    if (transaction->next_pending)
+    {
+        transaction->next_pending->prev_pending = transaction->prev_pending;
+    }
+    else
+    {
+        table->newest = transaction->prev_pending;
+    }
+    transaction->prev_pending = NULL;
+    transaction->next_pending = NULL;
 }
 
 /* Create a new transaction table. */
 static Transaction_Table * create_transaction_table(unsigned int size)
 {
     Transaction_Table * transactionTable = NULL;
+    pthread_condattr_t condition_attr;
+    bool initialized = false;
 
-    if (size < 1 || size > MAX_TABLE_SIZE)
+    /* Allocate the table itself. */
+    if ((transactionTable =
+        (Transaction_Table *)calloc(1, sizeof(Transaction_Table))) == NULL)
     {
         return NULL;
     }
 
-    /* Allocate the table itself. */
-    if ((transactionTable =
-        (Transaction_Table *)malloc(sizeof(Transaction_Table))) == NULL)
+    if (!init_transaction_index(&transactionTable->by_id, size) ||
+        !init_transaction_index(&transactionTable->by_uuid, size))
     {
+        free(transactionTable->by_id.slots);
+        free(transactionTable);
         return NULL;
     }
 
-    // Allocate pointers to the entries.*/
-    if ((transactionTable->elements =
-        (Transaction_Entry **)malloc(sizeof(Transaction_Entry *) * size)) == NULL)
+    // deadlines must not move with the wall clock
+    pthread_condattr_init(&condition_attr);
+    initialized = pthread_condattr_setclock(&condition_attr, CLOCK_MONOTONIC) == 0 &&
+        pthread_cond_init(&transactionTable->expiry_condition, &condition_attr) == 0;
+    pthread_condattr_destroy(&condition_attr);
+    if (!initialized)
     {
+        free(transactionTable->by_id.slots);
+        free(transactionTable->by_uuid.slots);
         free(transactionTable);
-        transactionTable = NULL;
         return NULL;
     }
 
-    transactionTable->size = size;
-    OvsAgentApiDebug("%s Table: %p, Elements: %p, Size: %u\n", __func__,
-        transactionTable, transactionTable->elements, transactionTable->size);
+    pthread_mutex_init(&transactionTable->mutex, NULL);
+    transactionTable->timeout_msecs = TRANSACTION_TIMEOUT_MSECS;
+    OvsAgentApiDebug("%s Table: %p, Size: %u\n", __func__,
+        transactionTable, transactionTable->by_id.size);
     return transactionTable;
 }
 
+/** Frees the config the transaction owns and returns the entry to the pool **/
 static bool destroy_transaction(Transaction_Entry * transaction)
 {
+    Transaction_Batch * batch = NULL;
+    size_t i;
+
     if (!transaction)
     {
         OvsAgentApiWarning("%s transaction is NULL\n", __func__);
@@ -119,14 +405,34 @@ static bool destroy_transaction(Transaction_Entry * transaction)
         free(transaction->table_config.config);
         transaction->table_config.config = NULL;
     }
-    free(transaction);
-    transaction = NULL;
+
+    if ((batch = transaction->batch) != NULL)
+    {
+        transaction->batch = NULL;
+        for (i = 0; i < batch->count; i++)
+        {
+            free(batch->table_configs[i].config);
+        }
+    }
+
+    pthread_mutex_lock(&g_transaction_table->mutex);
+    for (i = 0; batch && i < batch->count; i++)
+    {   // rows not completed, already out of the uuid index
+        if (batch->rows[i])
+        {
+            release_transaction(g_transaction_table, batch->rows[i]);
+        }
+    }
+    release_transaction(g_transaction_table, transaction);
+    pthread_mutex_unlock(&g_transaction_table->mutex);
+
+    free(batch);
     return true;
 }
 
 bool init_transaction_manager(void)
 {
-    unsigned int size = MAX_TABLE_SIZE;
+    unsigned int size = TRANSACTION_INDEX_MIN_SIZE;
     Transaction_Table * table = NULL;
 
     if (g_transaction_table)
@@ -142,18 +448,28 @@ bool init_transaction_manager(void)
         return false;
     }
 
-    init_transaction_table(table);
+    table->running = true;
+    if (pthread_create(&table->expiry_thread, NULL, expire_transactions, table) != 0)
+    {
+        OvsAgentApiError("%s failed to start the transaction expiry thread!\n", __func__);
+        pthread_cond_destroy(&table->expiry_condition);
+        pthread_mutex_destroy(&table->mutex);
+        free(table->by_id.slots);
+        free(table->by_uuid.slots);
+        free(table);
+        return false;
+    }
 
     g_transaction_table = table;
-    OvsAgentApiDebug("%s Table: %p, Elements: %p, Size: %u\n", __func__,
-        g_transaction_table, g_transaction_table->elements, g_transaction_table->size);
+    OvsAgentApiDebug("%s Table: %p, Size: %u\n", __func__,
+        g_transaction_table, g_transaction_table->by_id.size);
     return true;
 }
 
 void deinit_transaction_manager(void)
 {
-    unsigned int i;
     Transaction_Entry * transaction = NULL;
+    Transaction_Pool_Chunk * chunk = NULL;
 
     if (!g_transaction_table)
     {
@@ -161,113 +477,194 @@ void deinit_transaction_manager(void)
         return;
     }
 
-    // Delete Transaction Entries
-    for (i=0; i<g_transaction_table->size; i++)
-    {
-        transaction = g_transaction_table->elements[i];
-        if (transaction)
-        {
-            (void)destroy_transaction(transaction);
-        }
-    }
+    pthread_mutex_lock(&g_transaction_table->mutex);
+    g_transaction_table->running = false;
+    pthread_cond_signal(&g_transaction_table->expiry_condition);
+    pthread_mutex_unlock(&g_transaction_table->mutex);
+    pthread_join(g_transaction_table->expiry_thread, NULL);
 
-    // Delete Transaction Table's array of pointers to structures
-    if (g_transaction_table->elements)
+    // those still in flight will not get a Feedback anymore, fail them
+    pthread_mutex_lock(&g_transaction_table->mutex);
+    while ((transaction = g_transaction_table->oldest) != NULL)
     {
-        OvsAgentApiDebug("%s table elements %p\n", __func__, g_transaction_table->elements);
-        free(g_transaction_table->elements);
-        g_transaction_table->elements = NULL;
+        transaction = remove_transaction_table(find_transaction_slot(
+            &g_transaction_table->by_id, hash_code(&transaction->id), match_id,
+            &transaction->id));
+        pthread_mutex_unlock(&g_transaction_table->mutex);
+        OvsAgentApiDebug("%s dropping Id: %u, pending for %u msecs\n", __func__,
+            transaction->id, elapsed_msecs(&transaction->created));
+        finish_transaction(transaction, OVS_FAILED_STATUS);
+        pthread_mutex_lock(&g_transaction_table->mutex);
     }
+    pthread_mutex_unlock(&g_transaction_table->mutex);
 
-    // Delete the table structure
-    if (g_transaction_table)
+    while ((chunk = g_transaction_table->chunks) != NULL)
     {
-        g_transaction_table->size = 0;
-        OvsAgentApiDebug("%s table %p\n", __func__, g_transaction_table);
-        free(g_transaction_table);
-        g_transaction_table = NULL;
+        g_transaction_table->chunks = chunk->next;
+        free(chunk);
     }
+
+    free(g_transaction_table->by_id.slots);
+    free(g_transaction_table->by_uuid.slots);
+    pthread_cond_destroy(&g_transaction_table->expiry_condition);
+    pthread_mutex_destroy(&g_transaction_table->mutex);
+    OvsAgentApiDebug("%s table %p\n", __func__, g_transaction_table);
+    free(g_transaction_table);
+    g_transaction_table = NULL;
 }
 
 static void print_transaction(unsigned int index)
 {
-    Transaction_Entry * transaction = NULL;
-    unsigned int key = hash_code(index, g_transaction_table->size);
-    transaction = g_transaction_table->elements[key];
-    if (!transaction)
+    Transaction_Entry * transaction = g_transaction_table->by_id.slots[index];
+    if (!transaction || transaction == TRANSACTION_TOMBSTONE)
     {
-        OvsAgentApiDebug("%s: Key: %u EMPTY\n", __func__, key);
+        OvsAgentApiDebug("%s: Key: %u EMPTY\n", __func__, index);
         return;
     }
-    OvsAgentApiDebug("%s: Key: %u, Id: %u, Uuid: %s\n", __func__,
-        key, transaction->id, transaction->uuid);
+    OvsAgentApiDebug("%s: Key: %u, Id: %u, Uuid: %s, Age: %u msecs\n", __func__,
+        index, transaction->id, transaction->uuid, elapsed_msecs(&transaction->created));
 }
 
 static void print_transaction_table(void)
 {
     unsigned int idx;
-    for (idx=0; idx<g_transaction_table->size; idx++)
+    for (idx=0; idx<g_transaction_table->by_id.size; idx++)
     {
         print_transaction(idx);
     }
 }
 
-static bool find_transaction_key(char * uuid, unsigned int * key)
+bool init_transaction_completion(transaction_completion * completion)
 {
-    unsigned int i;
-    Transaction_Entry * transaction = NULL;
-    if (!uuid || !key)
+    pthread_condattr_t condition_attr;
+    bool initialized = false;
+
+    if (!completion)
     {
         return false;
     }
-    for (i=0; i<g_transaction_table->size; i++)
+
+    completion->done = false;
+    completion->status = OVS_UNKNOWN_STATUS;
+    if (pthread_mutex_init(&completion->mutex, NULL) != 0)
     {
-        transaction = g_transaction_table->elements[i];
-        if (transaction && !strncmp(transaction->uuid, uuid, MAX_UUID_LEN))
-        {
-            OvsAgentApiDebug("%s Found Uuid %s at key %u.\n", __func__, uuid, i);
-            *key = i;
-            return true;
-        }
+        return false;
     }
-    OvsAgentApiWarning("%s failed to find Uuid %s!\n", __func__, uuid);
-    return false;
+
+    // deadlines must not move with the wall clock
+    pthread_condattr_init(&condition_attr);
+    initialized = pthread_condattr_setclock(&condition_attr, CLOCK_MONOTONIC) == 0 &&
+        pthread_cond_init(&completion->condition, &condition_attr) == 0;
+    pthread_condattr_destroy(&condition_attr);
+    if (!initialized)
+    {
+        pthread_mutex_destroy(&completion->mutex);
+    }
+    return initialized;
 }
 
-// Returns a ptr to the transaction
-static Transaction_Entry * get_transaction(unsigned int id)
+void destroy_transaction_completion(transaction_completion * completion)
 {
-    unsigned int key = hash_code(id, g_transaction_table->size);
-    if (!g_transaction_table->elements[key])
+    if (completion)
     {
-        return NULL;
+        pthread_cond_destroy(&completion->condition);
+        pthread_mutex_destroy(&completion->mutex);
     }
-    return g_transaction_table->elements[key];
 }
 
-// Removes the transaction ptr from the table, and set its key to NULL.$
-// Returns a ptr to the removed transaction.
-static Transaction_Entry * remove_transaction_table(unsigned int key)
+static void signal_transaction_completion(transaction_completion * completion,
+    OVS_STATUS status)
 {
-    Transaction_Entry * transaction = NULL;
-    if (!g_transaction_table->elements[key])
+    pthread_mutex_lock(&completion->mutex);
+    completion->status = status;
+    completion->done = true;
+    pthread_cond_signal(&completion->condition);
+    pthread_mutex_unlock(&completion->mutex);
+}
+
+OVS_STATUS wait_transaction_completion(transaction_completion * completion,
+    int timeoutSecs)
+{
+    OVS_STATUS status = OVS_SUCCESS_STATUS;
+    struct timespec ts;
+    int result = 0;
+
+    if (!completion)
     {
-        OvsAgentApiWarning("%s: transaction NULL at key: %u\n", __func__, key);
-        return NULL;
+        return OVS_FAILED_STATUS;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    ts.tv_sec += timeoutSecs;
+
+    pthread_mutex_lock(&completion->mutex);
+    while (!completion->done && status == OVS_SUCCESS_STATUS)
+    {
+        result = pthread_cond_timedwait(&completion->condition, &completion->mutex, &ts);
+        if (result == ETIMEDOUT)
+        {
+            status = completion->done ? OVS_SUCCESS_STATUS : OVS_TIMED_OUT_STATUS;
+        }
+        else if (result != 0)
+        {
+            OvsAgentApiError("%s pthread_cond_timedwait ERROR %d!!!\n", __func__, result);
+            status = OVS_TIMED_WAIT_ERROR_STATUS;
+        }
+    }
+    pthread_mutex_unlock(&completion->mutex);
+    return status;
+}
+
+/**
+ * Removes the transaction from both indexes, the caller owns it afterwards.
+ * Called with the table locked.
+**/
+static Transaction_Entry * remove_transaction_table(Transaction_Entry ** slot)
+{
+    Transaction_Entry * transaction = *slot;
+    Transaction_Entry ** uuid_slot = NULL;
+    Transaction_Entry * row = NULL;
+    size_t i;
+
+    remove_transaction_slot(&g_transaction_table->by_id, slot);
+    unlink_pending_transaction(g_transaction_table, transaction);
+    if (transaction->uuid[0] &&
+        (uuid_slot = find_transaction_slot(&g_transaction_table->by_uuid,
+            uuid_hash_code(transaction->uuid), match_uuid, transaction->uuid)) != NULL &&
+        *uuid_slot == transaction)
+    {
+        remove_transaction_slot(&g_transaction_table->by_uuid, uuid_slot);
+    }
+    for (i = 0; transaction->batch && i < transaction->batch->count; i++)
+    {
+        row = transaction->batch->rows[i];
+        if (row && (uuid_slot = find_transaction_slot(&g_transaction_table->by_uuid,
+            uuid_hash_code(row->uuid), match_uuid, row->uuid)) != NULL &&
+            *uuid_slot == row)
+        {
+            remove_transaction_slot(&g_transaction_table->by_uuid, uuid_slot);
+        }
     }
-    transaction = g_transaction_table->elements[key];
-    g_transaction_table->elements[key] = NULL;
     return transaction;
 }
 
 static bool remove_transaction(unsigned int id)
 {
+    Transaction_Entry ** slot = NULL;
+    Transaction_Entry * transaction = NULL;
     OvsAgentApiDebug("%s: Id: %u\n", __func__, id);
-    unsigned int key = hash_code(id, g_transaction_table->size);
-    Transaction_Entry * transaction = remove_transaction_table(key);
+
+    pthread_mutex_lock(&g_transaction_table->mutex);
+    slot = find_transaction_slot(&g_transaction_table->by_id, hash_code(&id), match_id, &id);
+    if (slot)
+    {
+        transaction = remove_transaction_table(slot);
+    }
+    pthread_mutex_unlock(&g_transaction_table->mutex);
+
     if (!transaction)
     {
-        OvsAgentApiError("%s: failed for Id: %u at key %u\n", __func__, id, key);
+        OvsAgentApiError("%s: failed for Id: %u\n", __func__, id);
         return false;
     }
     return destroy_transaction(transaction);
@@ -283,74 +680,68 @@ bool delete_transaction(char * rid)
         OvsAgentApiError("%s: rId is NULL\n", __func__);
         return false;
     }
+    if (!g_transaction_table)
+    {
+        OvsAgentApiError("%s: transaction manager is not initialized\n", __func__);
+        return false;
+    }
 
     id = atoi(rid);
     return remove_transaction(id);
 }
 
-// TODO: Handle collisions in non-block mode for non-timed out transactions or in
-// the case when the table is full.
+/**
+ * Adds the transaction unless one with the same id is still in flight,
+ * which is left alone.
+**/
 static bool insert_transaction_table(Transaction_Entry * transaction)
 {
-    unsigned int id = 0;
-    unsigned int key = 0;
+    Transaction_Entry ** slot = NULL;
+    unsigned int id = transaction->id;
+    bool inserted = false;
 
-    if (!transaction)
+    slot = find_transaction_slot(&g_transaction_table->by_id, hash_code(&id), match_id, &id);
+    if (slot)
     {
+        OvsAgentApiError("%s Id: %u is already in flight for %u msecs\n",
+            __func__, id, elapsed_msecs(&(*slot)->created));
         return false;
     }
-    id = transaction->id;
-    key = hash_code(id, g_transaction_table->size);
-    if (g_transaction_table->elements[key])
-    {
-        // Entry already exists, as callback was not received, and it was never removed.
-        // Remove transaction, delete it, and reuse key.
-        // TODO: Destroy transaction only if the transaction has timed out.
-        OvsAgentApiWarning("%s removing existing Transaction at key %u\n",
-            __func__, key);
-        if (!destroy_transaction(remove_transaction_table(key)))
-        {
-            OvsAgentApiError("%s failed to destroy existing Transaction at key %u\n",
-                __func__, key);
-            return false;
-        }
-    }
-    g_transaction_table->elements[key] = transaction;
-    OvsAgentApiDebug("%s for Id: %u at key %u\n", __func__, id, key);
-    return true;
+
+    inserted = add_transaction_index(&g_transaction_table->by_id, hash_code, false,
+        transaction);
+    OvsAgentApiDebug("%s for Id: %u, %u in flight\n", __func__, id,
+        g_transaction_table->by_id.count);
+    return inserted;
 }
 
-static Transaction_Entry * create_transaction(unsigned int id, ovs_interact_cb callback,
-    Rdkb_Table_Config * table_config)
+static void init_transaction(Transaction_Entry * transaction, unsigned int id,
+    ovs_interact_cb callback, Rdkb_Table_Config * table_config,
+    transaction_completion * completion)
 {
-    Transaction_Entry * transaction = NULL;
-    OvsAgentApiDebug("%s: Id: %u\n", __func__, id);
-
-    if (!table_config)
-    {
-        return NULL;
-    }
-    if ((transaction = (Transaction_Entry *)malloc(sizeof(Transaction_Entry))) == NULL)
-    {
-        return NULL;
-    }
     transaction->id = id;
     memset(transaction->uuid, 0, sizeof(transaction->uuid));
     transaction->state = TRANSACTION_INIT_ST;
     transaction->callback = callback; // Can be NULL
+    transaction->completion = completion; // Can be NULL
+    transaction->queue = NULL;
+    transaction->user_data = 0;
+    transaction->batch = NULL;
+    transaction->parent = NULL;
+    transaction->row = 0;
     transaction->table_config = *table_config; // shallow copy, transfers ownership of config ptr member
     transaction->status = OVS_UNKNOWN_STATUS;
-
-    OvsAgentApiDebug("%s: created Transaction %p Id: %u, Table %d, Config %p\n",
-        __func__, transaction, id, table_config->table.id, table_config->config);
-    return transaction;
+    clock_gettime(CLOCK_MONOTONIC, &transaction->created);
+    transaction->updated = transaction->created;
 }
 
-bool insert_transaction(char * rid, ovs_interact_cb callback,
-    Rdkb_Table_Config * table_config)
+static bool add_transaction(char * rid, ovs_interact_cb callback,
+    Rdkb_Table_Config * table_config, transaction_completion * completion,
+    completion_queue * queue, uint64_t user_data, Transaction_Batch * batch)
 {
     unsigned int id = 0;
     Transaction_Entry * transaction = NULL;
+    bool inserted = false;
     OvsAgentApiDebug("%s: rId: %s\n", __func__, (rid ? rid : "NULL"));
 
     if (!rid || !table_config)
@@ -358,18 +749,41 @@ bool insert_transaction(char * rid, ovs_interact_cb callback,
         OvsAgentApiError("%s: rId or table config is NULL\n", __func__);
         return false;
     }
+    if (!g_transaction_table)
+    {
+        OvsAgentApiError("%s: transaction manager is not initialized\n", __func__);
+        return false;
+    }
 
     id = atoi(rid);
-    transaction = create_transaction(id, callback, table_config);
+    pthread_mutex_lock(&g_transaction_table->mutex);
+    transaction = alloc_transaction(g_transaction_table);
+    if (transaction)
+    {
+        init_transaction(transaction, id, callback, table_config, completion);
+        transaction->queue = queue;
+        transaction->user_data = user_data;
+        transaction->batch = batch;
+        if (!(inserted = insert_transaction_table(transaction)))
+        {   // the config stays with the caller
+            transaction->batch = NULL;
+            release_transaction(g_transaction_table, transaction);
+        }
+        else
+        {
+            append_pending_transaction(g_transaction_table, transaction);
+        }
+    }
+    pthread_mutex_unlock(&g_transaction_table->mutex);
+
     if (!transaction)
     {
         OvsAgentApiError("%s: NULL transaction for Id: %u\n", __func__, id);
         return false;
     }
-    if (!insert_transaction_table(transaction))
+    if (!inserted)
     {
         OvsAgentApiError("%s: failed for Id: %u\n", __func__, id);
-        free(transaction);
         return false;
     }
     OvsAgentApiDebug("%s: succeeded for Transaction %p Id: %u\n",
@@ -377,9 +791,71 @@ bool insert_transaction(char * rid, ovs_interact_cb callback,
     return true;
 }
 
+bool insert_transaction(char * rid, ovs_interact_cb callback,
+    Rdkb_Table_Config * table_config, transaction_completion * completion)
+{
+    return add_transaction(rid, callback, table_config, completion, NULL, 0, NULL);
+}
+
+bool insert_queued_transaction(char * rid, Rdkb_Table_Config * table_config,
+    completion_queue * queue, uint64_t user_data)
+{
+    if (!queue)
+    {
+        OvsAgentApiError("%s: completion queue is NULL\n", __func__);
+        return false;
+    }
+    return add_transaction(rid, NULL, table_config, NULL, queue, user_data, NULL);
+}
+
+bool insert_batch_transaction(char * rid, ovs_interact_batch_cb callback,
+    Rdkb_Table_Config * table_configs, size_t count, transaction_completion * completion)
+{
+    Transaction_Batch * batch = NULL;
+    Rdkb_Table_Config table_config;
+    size_t i;
+
+    if (!table_configs || count == 0)
+    {
+        OvsAgentApiError("%s: no table configs\n", __func__);
+        return false;
+    }
+
+    // one allocation, the arrays follow the batch
+    batch = (Transaction_Batch *)calloc(1, sizeof(Transaction_Batch) +
+        count * (sizeof(Rdkb_Table_Config) + sizeof(Transaction_Entry *) + sizeof(OVS_STATUS)));
+    if (!batch)
+    {
+        OvsAgentApiError("%s: failed to allocate a batch of %zu\n", __func__, count);
+        return false;
+    }
+    batch->callback = callback;
+    batch->count = count;
+    batch->remaining = count;
+    batch->table_configs = (Rdkb_Table_Config *)(batch + 1);
+    batch->rows = (Transaction_Entry **)(batch->table_configs + count);
+    batch->statuses = (OVS_STATUS *)(batch->rows + count);
+    for (i = 0; i < count; i++)
+    {
+        batch->table_configs[i] = table_configs[i]; // transfers ownership of config ptr members
+        batch->statuses[i] = OVS_UNKNOWN_STATUS;
+    }
+
+    table_config.table.id = table_configs[0].table.id;
+    table_config.config = NULL; // the batch has them
+    if (!add_transaction(rid, NULL, &table_config, completion, NULL, 0, batch))
+    {   // the configs stay with the caller
+        free(batch);
+        return false;
+    }
+    return true;
+}
+
 static bool update_transaction_uuid(unsigned int id, const char * uuid)
 {
+    Transaction_Entry ** slot = NULL;
     Transaction_Entry * transaction = NULL;
+    bool indexed = false;
     OvsAgentApiDebug("%s: Id: %d, %s\n", __func__, id, (uuid ? uuid : "NULL"));
 
     if (!uuid)
@@ -387,19 +863,41 @@ static bool update_transaction_uuid(unsigned int id, const char * uuid)
         return false;
     }
 
-    transaction = get_transaction(id);
-    if (!transaction)
+    pthread_mutex_lock(&g_transaction_table->mutex);
+    slot = find_transaction_slot(&g_transaction_table->by_id, hash_code(&id), match_id, &id);
+    if (!slot)
     {
+        pthread_mutex_unlock(&g_transaction_table->mutex);
         OvsAgentApiError("%s failed to find transaction with Id: %u, Uuid: %s\n",
             __func__, id, uuid);
         return false;
     }
+
+    transaction = *slot;
+    if (transaction->uuid[0] &&
+        (slot = find_transaction_slot(&g_transaction_table->by_uuid,
+            uuid_hash_code(transaction->uuid), match_uuid, transaction->uuid)) != NULL &&
+        *slot == transaction)
+    {
+        remove_transaction_slot(&g_transaction_table->by_uuid, slot);
+    }
     strncpy(transaction->uuid, uuid, MAX_UUID_LEN);
     transaction->uuid[MAX_UUID_LEN] = '\0';
     transaction->state = TRANSACTION_UUID_RECV_ST;
+    clock_gettime(CLOCK_MONOTONIC, &transaction->updated);
+    indexed = add_transaction_index(&g_transaction_table->by_uuid, uuid_hash_code, true,
+        transaction);
+    pthread_mutex_unlock(&g_transaction_table->mutex);
 
-    OvsAgentApiDebug("%s: succeeded for Transaction %p Id: %u, Uuid: %s\n",
-        __func__, transaction, id, (uuid ? uuid : "NULL"));
+    if (!indexed)
+    {
+        OvsAgentApiError("%s failed to index Uuid: %s of Id: %u\n", __func__, uuid, id);
+        return false;
+    }
+
+    OvsAgentApiDebug("%s: succeeded for Transaction %p Id: %u, Uuid: %s after %u msecs\n",
+        __func__, transaction, id, (uuid ? uuid : "NULL"),
+        elapsed_msecs(&transaction->created));
     return true;
 }
 
@@ -414,15 +912,105 @@ bool update_transaction(const char * rid, const char * uuid)
         OvsAgentApiError("%s rId or Uuid is NULL\n", __func__);
         return false;
     }
+    if (!g_transaction_table)
+    {
+        OvsAgentApiError("%s: transaction manager is not initialized\n", __func__);
+        return false;
+    }
 
     id = atoi(rid);
     return update_transaction_uuid(id, uuid);
 }
 
+bool update_batch_transaction(const char * rid, const char (*uuids)[MAX_UUID_LEN + 1],
+    size_t count)
+{
+    Transaction_Entry ** slot = NULL;
+    Transaction_Entry * transaction = NULL;
+    Transaction_Entry * row = NULL;
+    unsigned int id = 0;
+    bool indexed = false;
+    size_t i;
+    OvsAgentApiDebug("%s: rId: %s, Rows: %zu\n", __func__, (rid ? rid : "NULL"), count);
+
+    if (!rid || !uuids)
+    {
+        OvsAgentApiError("%s rId or Uuids is NULL\n", __func__);
+        return false;
+    }
+    if (!g_transaction_table)
+    {
+        OvsAgentApiError("%s: transaction manager is not initialized\n", __func__);
+        return false;
+    }
+
+    id = atoi(rid);
+    pthread_mutex_lock(&g_transaction_table->mutex);
+    slot = find_transaction_slot(&g_transaction_table->by_id, hash_code(&id), match_id, &id);
+    if (slot && (transaction = *slot)->batch && transaction->batch->count == count &&
+        transaction->state == TRANSACTION_INIT_ST)
+    {
+        transaction->state = TRANSACTION_UUID_RECV_ST;
+        clock_gettime(CLOCK_MONOTONIC, &transaction->updated);
+        for (i = 0, indexed = true; i < count && indexed; i++)
+        {
+            if ((row = alloc_transaction(g_transaction_table)) == NULL)
+            {
+                indexed = false;
+                break;
+            }
+            init_transaction(row, id, NULL, &transaction->table_config, NULL);
+            row->parent = transaction;
+            row->row = i;
+            strncpy(row->uuid, uuids[i], MAX_UUID_LEN);
+            row->uuid[MAX_UUID_LEN] = '\0';
+            row->state = TRANSACTION_UUID_RECV_ST;
+            // failing the batch releases those added so far
+            transaction->batch->rows[i] = row;
+            indexed = add_transaction_index(&g_transaction_table->by_uuid, uuid_hash_code,
+                true, row);
+        }
+    }
+    pthread_mutex_unlock(&g_transaction_table->mutex);
+
+    if (!indexed)
+    {
+        OvsAgentApiError("%s failed to index %zu Uuids of Id: %u\n", __func__, count, id);
+        return false;
+    }
+    OvsAgentApiDebug("%s: succeeded for Transaction %p Id: %u after %u msecs\n",
+        __func__, transaction, id, elapsed_msecs(&transaction->created));
+    return true;
+}
+
+/**
+ * Records the status of a row of a batch and takes the row out, the batch
+ * is returned once it has no rows left. Called with the table locked.
+**/
+static Transaction_Entry * complete_transaction_row(Transaction_Entry ** uuid_slot,
+    OVS_STATUS status)
+{
+    Transaction_Entry * row = *uuid_slot;
+    Transaction_Entry * transaction = row->parent;
+    Transaction_Batch * batch = transaction->batch;
+
+    remove_transaction_slot(&g_transaction_table->by_uuid, uuid_slot);
+    batch->rows[row->row] = NULL;
+    batch->statuses[row->row] = status;
+    release_transaction(g_transaction_table, row);
+    if (--batch->remaining > 0)
+    {
+        return NULL;
+    }
+    return remove_transaction_table(find_transaction_slot(&g_transaction_table->by_id,
+        hash_code(&transaction->id), match_id, &transaction->id));
+}
+
 bool complete_transaction(char * uuid, OVS_STATUS status)
 {
-    unsigned key = 0;
+    Transaction_Entry ** slot = NULL;
     Transaction_Entry * transaction = NULL;
+    bool found = false;
     OvsAgentApiDebug("%s: Uuid: %s, Status: %d\n", __func__,
         (uuid ? uuid : "NULL"), status);
     if (!uuid)
@@ -430,30 +1018,210 @@ bool complete_transaction(char * uuid, OVS_STATUS status)
         OvsAgentApiError("%s Uuid is NULL\n", __func__);
         return false;
     }
-    if (!find_transaction_key(uuid, &key))
+    if (!g_transaction_table)
     {
-        OvsAgentApiError("%s failed to find Uuid %s\n", __func__, uuid);
+        OvsAgentApiError("%s: transaction manager is not initialized\n", __func__);
         return false;
     }
+
     // Get the transaction entry, update it, call callback and finally remove it
-    transaction = remove_transaction_table(key);
+    pthread_mutex_lock(&g_transaction_table->mutex);
+    slot = find_transaction_slot(&g_transaction_table->by_uuid, uuid_hash_code(uuid),
+        match_uuid, uuid);
+    if (slot && (*slot)->parent)
+    {
+        found = true;
+        transaction = complete_transaction_row(slot, status);
+    }
+    else if (slot)
+    {
+        found = true;
+        transaction = *slot;
+        slot = find_transaction_slot(&g_transaction_table->by_id,
+            hash_code(&transaction->id), match_id, &transaction->id);
+        transaction = remove_transaction_table(slot);
+    }
+    pthread_mutex_unlock(&g_transaction_table->mutex);
+
+    if (!found)
+    {
+        OvsAgentApiError("%s failed to find Uuid %s\n", __func__, uuid);
+        return false;
+    }
     if (!transaction)
+    {   // a row of a batch still waiting for others
+        OvsAgentApiDebug("%s: row with Uuid: %s completed\n", __func__, uuid);
+        return true;
+    }
+    OvsAgentApiDebug("%s: Transaction %p Id: %u, Uuid: %s, completed after %u msecs\n",
+        __func__, transaction, transaction->id, transaction->uuid,
+        elapsed_msecs(&transaction->created));
+    transaction->state = TRANSACTION_COMPLETE_ST;
+    return finish_transaction(transaction, status);
+}
+
+bool fail_transaction(const char * rid, OVS_STATUS status)
+{
+    Transaction_Entry ** slot = NULL;
+    Transaction_Entry * transaction = NULL;
+    unsigned int id = 0;
+    OvsAgentApiDebug("%s: rId: %s, Status: %d\n", __func__,
+        (rid ? rid : "NULL"), status);
+
+    if (!rid)
     {
-        OvsAgentApiError("%s failed to extract transaction with Uuid %s at key %u\n",
-            __func__, uuid, key);
+        OvsAgentApiError("%s: rId is NULL\n", __func__);
         return false;
     }
-    OvsAgentApiDebug("%s: Transaction %p Id: %u, Uuid: %s\n", __func__,
-        transaction, transaction->id, transaction->uuid);
-    transaction->status = status;
+    if (!g_transaction_table)
+    {
+        OvsAgentApiError("%s: transaction manager is not initialized\n", __func__);
+        return false;
+    }
+
+    id = atoi(rid);
+    pthread_mutex_lock(&g_transaction_table->mutex);
+    slot = find_transaction_slot(&g_transaction_table->by_id, hash_code(&id), match_id, &id);
+    if (slot)
+    {
+        transaction = remove_transaction_table(slot);
+    }
+    pthread_mutex_unlock(&g_transaction_table->mutex);
+
+    if (!transaction)
+    {   // already completed, timed out or deleted
+        OvsAgentApiDebug("%s failed to find Id: %u\n", __func__, id);
+        return false;
+    }
+    OvsAgentApiDebug("%s: Transaction %p Id: %u failed after %u msecs\n",
+        __func__, transaction, id, elapsed_msecs(&transaction->created));
     transaction->state = TRANSACTION_COMPLETE_ST;
+    return finish_transaction(transaction, status);
+}
+
+void set_transaction_timeout(unsigned int msecs)
+{
+    if (!g_transaction_table)
+    {
+        OvsAgentApiError("%s: transaction manager is not initialized\n", __func__);
+        return;
+    }
+
+    pthread_mutex_lock(&g_transaction_table->mutex);
+    g_transaction_table->timeout_msecs = msecs ? msecs : TRANSACTION_TIMEOUT_MSECS;
+    pthread_cond_signal(&g_transaction_table->expiry_condition);
+    pthread_mutex_unlock(&g_transaction_table->mutex);
+}
+
+/**
+ * Delivers the final status of a transaction the caller removed from the
+ * table, so this happens once whichever way it ended.
+**/
+static bool finish_transaction(Transaction_Entry * transaction, OVS_STATUS status)
+{
+    Transaction_Batch * batch = transaction->batch;
+    size_t i;
+
+    if (batch)
+    {   // rows still waiting end like the batch, which fails if any of them did
+        for (i = 0; i < batch->count; i++)
+        {
+            if (batch->statuses[i] == OVS_UNKNOWN_STATUS)
+            {
+                batch->statuses[i] = status;
+            }
+        }
+        for (i = 0, status = OVS_SUCCESS_STATUS; i < batch->count; i++)
+        {
+            if (batch->statuses[i] != OVS_SUCCESS_STATUS)
+            {
+                status = batch->statuses[i];
+                break;
+            }
+        }
+        if (batch->callback)
+        {
+            OvsAgentApiDebug("%s calling callback for Id: %u, Rows: %zu, Status: %d\n",
+                __func__, transaction->id, batch->count, status);
+            batch->callback(status, batch->statuses, batch->table_configs, batch->count);
+        }
+    }
+
+    transaction->status = status;
+    clock_gettime(CLOCK_MONOTONIC, &transaction->updated);
+    // called without the lock held, the callback may start a new transaction
     if (transaction->callback)
     {
         OvsAgentApiDebug(
             "%s calling callback for Id: %u, Uuid: %s, Status: %d, Table %d, Config: %p\n",
-            __func__, transaction->id, uuid, status, transaction->table_config.table.id,
-            transaction->table_config.config);
+            __func__, transaction->id, transaction->uuid, status,
+            transaction->table_config.table.id, transaction->table_config.config);
         transaction->callback(status, &transaction->table_config);
     }
+    if (transaction->completion)
+    {
+        signal_transaction_completion(transaction->completion, status);
+    }
+    if (transaction->queue)
+    {
+        ovs_agent_api_completion completion;
+
+        completion.user_data = transaction->user_data;
+        completion.status = status;
+        completion.table_config = transaction->table_config;
+        if (completion_queue_push(transaction->queue, &completion))
+        {   // the config now belongs to whoever reaps it
+            transaction->table_config.config = NULL;
+        }
+    }
     return destroy_transaction(transaction);
 }
+
+/**
+ * Times out the transactions that got no Feedback in time. They all have
+ * the same timeout, so the oldest one is always the next to expire.
+**/
+static void * expire_transactions(void * arg)
+{
+    Transaction_Table * table = (Transaction_Table *)arg;
+    Transaction_Entry * transaction = NULL;
+    struct timespec deadline;
+    struct timespec now;
+
+    pthread_mutex_lock(&table->mutex);
+    while (table->running)
+    {
+        if (!(transaction = table->oldest))
+        {
+            pthread_cond_wait(&table->expiry_condition, &table->mutex);
+            continue;
+        }
+
+        deadline = transaction->created;
+        deadline.tv_sec += table->timeout_msecs / MSECS_PER_SEC;
+        deadline.tv_nsec += (long)(table->timeout_msecs % MSECS_PER_SEC) * NSECS_PER_MSEC;
+        if (deadline.tv_nsec >= (long)MSECS_PER_SEC * NSECS_PER_MSEC)
+        {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= (long)MSECS_PER_SEC * NSECS_PER_MSEC;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        if (now.tv_sec < deadline.tv_sec ||
+            (now.tv_sec == deadline.tv_sec && now.tv_nsec < deadline.tv_nsec))
+        {
+            pthread_cond_timedwait(&table->expiry_condition, &table->mutex, &deadline);
+            continue;
+        }
+
+        transaction = remove_transaction_table(find_transaction_slot(&table->by_id,
+            hash_code(&transaction->id), match_id, &transaction->id));
+        pthread_mutex_unlock(&table->mutex);
+        OvsAgentApiWarning("%s: Id: %u, Uuid: %s timed out after %u msecs\n", __func__,
+            transaction->id, transaction->uuid, elapsed_msecs(&transaction->created));
+        transaction->state = TRANSACTION_TIMEOUT_ST;
+        finish_transaction(transaction, OVS_TIMED_OUT_STATUS);
+        pthread_mutex_lock(&table->mutex);
+    }
+    pthread_mutex_unlock(&table->mutex);
+    return NULL;
+}
@@ -16,368 +16,1856 @@
 * SPDX-License-Identifier: Apache-2.0
 */
 
+#include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 #include <pthread.h>
 #include <stdio.h>
+#include <time.h>
+#include <unistd.h>
 #include "OvsDbApi/OvsDbDefs.h"
 #include "OvsDbApi/OvsDbApi.h"
 #include "OvsDbApi/ovsdb_parser.h"
 #include "OvsDbApi/receipt_list.h"
 #include "OvsDbApi/mon_update_list.h"
 #include "OvsDbApi/ovsdb_socket.h"
+#include "OvsDbApi/ovsdb_framer.h"
+#include "OvsDbApi/ovsdb_reactor.h"
+#include "OvsDbApi/ovsdb_txq.h"
+#include "OvsDbApi/ovsdb_echo.h"
+#include "OvsDbApi/json_parser/table_desc.h"
 #include "common/OvsAgentLog.h"
 
-#define OVSDB_SOCKET_LISTEN_TIMEOUT_MSECS 100
+#define OVSDB_SOCKET_EVENTS (EPOLLIN | EPOLLRDHUP)
+#define OVSDB_RECONNECT_MIN_MSECS 50
+#define OVSDB_RECONNECT_MAX_MSECS 8000
+#define OVSDB_MAX_READS_PER_EVENT 4   // lets a busy session yield to the others
+
+// session 0 carries monitors, the others transactions so that a large
+// monitor dump does not delay transact replies
+#define OVSDB_MONITOR_SESSION   0
+#define OVSDB_TRANSACT_SESSIONS 1
+#define OVSDB_SESSION_COUNT     (1 + OVSDB_TRANSACT_SESSIONS)
+
+// resumes from the beginning, i.e. a transaction the server never has
+#define OVSDB_ZERO_TXN_ID "00000000-0000-0000-0000-000000000000"
+#define OVSDB_STATE_SAVE_MSECS 1000     // the state file is written at most this often
 
 static void dummy_receipt_cb(const char* rid, const OvsDb_Base_Receipt* result);
 
-// TODO: Context structure used to generate a handle to this context
-/*typedef struct ovs_db_sock_context
+/** One connection to ovsdb-server, the sessions of a context share its reactor thread **/
+typedef struct ovsdb_session
 {
+    struct ovsdb_ctx * ctx;
+    int index;
     int fd;
-    int timeout;
-    int status;
-} ovs_db_sock_context;*/
+    pthread_mutex_t mutex;              // guards fd
+    ovsdb_framer framer;
+    ovsdb_txq txq;
+    ovsdb_msg_target target;            // where received messages go
+    int reconnect_timer;
+    unsigned int reconnect_backoff;
 
-static unsigned int id = 0;
-static pthread_t listen_thread;
-static int ovsdb_sock_fd = -1;
-static volatile bool g_terminate = false;
+    // echo keepalive, only touched on the reactor thread
+    int echo_timer;
+    bool echo_pending;
+    unsigned int echo_missed;           // consecutive intervals without a reply
+    char echo_rid[MAX_UUID_LEN+1];
+    struct timespec echo_sent;
+} ovsdb_session;
 
-static void* ovsdb_listen(void* data)
+struct ovsdb_ctx
+{
+    unsigned int id;                    // request id generator
+    pthread_t listen_thread;
+    ovsdb_reactor * reactor;
+    ovsdb_session sessions[OVSDB_SESSION_COUNT];
+    unsigned int next_transact;
+    receipt_list * receipts;
+    int request_timer;                  // ticks the receipt deadlines
+    bool request_timer_running;         // set while receipts have a deadline
+    mon_list * monitors;
+    unsigned int echo_interval;
+
+    pthread_mutex_t monitor_mutex;      // guards session_monitor, tables join and leave one at a time
+    char session_monitor[MAX_UUID_LEN+1];   // shared by the plain monitors, empty until the first
+
+    pthread_mutex_t state_mutex;        // guards state_file, last_txn_id and state_dirty
+    char * state_file;                  // monitors resume when set
+    char last_txn_id[MAX_UUID_LEN+1];
+    bool state_dirty;                   // last_txn_id is newer than the state file
+    int state_timer;                    // writes the state file once armed
+
+    pthread_mutex_t echo_mutex;         // guards echo_stats and rtt_window
+    OvsDb_Echo_Stats echo_stats;
+    ovsdb_rtt_window rtt_window;
+};
+
+// context behind the ovsdb_init()/ovsdb_write()/... API
+static ovsdb_ctx * default_ctx = NULL;
+static size_t default_send_queue_limit = OVSDB_TXQ_DEFAULT_HIGH_WATER;
+static unsigned int default_echo_interval = OVSDB_ECHO_INTERVAL_MSECS;
+static unsigned int default_request_timeout = RECEIPT_LIST_TIMEOUT_MSECS;
+static char * default_state_file = NULL;
+
+static ovsdb_session * ovsdb_monitor_session(ovsdb_ctx * ctx)
+{
+    return &ctx->sessions[OVSDB_MONITOR_SESSION];
+}
+
+/**
+ * Spreads transactions over the transact sessions. Requests that depend on
+ * each other's order must not be in flight on different sessions, which is
+ * why there is only one of them by default.
+**/
+static ovsdb_session * ovsdb_transact_session(ovsdb_ctx * ctx)
+{
+    return &ctx->sessions[1 + (ctx->next_transact++ % OVSDB_TRANSACT_SESSIONS)];
+}
+
+static void ovsdb_request_timer_start(ovsdb_ctx * ctx)
+{
+    if (!__atomic_exchange_n(&ctx->request_timer_running, true, __ATOMIC_ACQ_REL)){
+        (void)ovsdb_reactor_timer_arm(ctx->request_timer, RECEIPT_LIST_TICK_MSECS,
+            RECEIPT_LIST_TICK_MSECS);
+    }
+}
+
+/**
+ * Times out the requests whose deadline passed. The timer only runs while
+ * some receipt has a deadline, an idle context does not wake up for it.
+**/
+static void ovsdb_request_timer_event(int fd, uint32_t events, void * data)
+{
+    ovsdb_ctx * ctx = (ovsdb_ctx *)data;
+    size_t pending = 0;
+
+    (void)receipt_list_expire(ctx->receipts, &pending);
+    if (pending > 0){
+        return;
+    }
+
+    (void)ovsdb_reactor_timer_arm(ctx->request_timer, 0, 0);
+    __atomic_store_n(&ctx->request_timer_running, false, __ATOMIC_RELEASE);
+    // a receipt added meanwhile may have found the timer still running
+    (void)receipt_list_expire(ctx->receipts, &pending);
+    if (pending > 0){
+        ovsdb_request_timer_start(ctx);
+    }
+}
+
+/** Registers the receipt of request 'rID', which times out unless answered in time **/
+static OVS_STATUS ovsdb_add_receipt(ovsdb_ctx * ctx, const char * rID,
+    OVSDB_RECEIPT_ID receipt_id, ovsdb_receipt_cb receipt_cb, int session)
+{
+    OVS_STATUS status = receipt_list_add(ctx->receipts, rID, receipt_id,
+        receipt_cb, session);
+
+    if (status == OVS_SUCCESS_STATUS){
+        ovsdb_request_timer_start(ctx);
+    }
+    return status;
+}
+
+static void ovsdb_process_msg(const char * msg, size_t len, void * data)
+{
+    ovsdb_session * s = (ovsdb_session *)data;
+
+    if (ovsdb_parse_msg(msg, len, &s->target) != OVS_SUCCESS_STATUS)
+    {
+        OvsDbApiError("%s failed to parse json message: %.*s\n",
+            __func__, (int)len, msg);
+    }
+}
+
+/**
+ * Sends a complete JSON-RPC message, leaving whatever the socket does not
+ * take right away to the reactor thread. Returns OVS_BUSY_STATUS when the
+ * send queue is full.
+**/
+static OVS_STATUS ovsdb_send(ovsdb_session * s, const char * msg, size_t len)
+{
+    bool queued = false;
+    OVS_STATUS status = OVS_SUCCESS_STATUS;
+
+    pthread_mutex_lock(&s->mutex);
+    if (s->fd < 0){
+        // fail fast rather than queue for a connection that may never return
+        pthread_mutex_unlock(&s->mutex);
+        OvsDbApiError("%s session %d not connected to OVSDB.\n", __func__, s->index);
+        return OVS_FAILED_STATUS;
+    }
+
+    status = ovsdb_txq_send(&s->txq, s->fd, msg, len, &queued);
+    if (status == OVS_SUCCESS_STATUS && queued){
+        (void)ovsdb_reactor_modify(s->ctx->reactor, s->fd,
+            OVSDB_SOCKET_EVENTS | EPOLLOUT);
+    }
+    pthread_mutex_unlock(&s->mutex);
+    return status;
+}
+
+/** Answers a request from ovsdb-server on the session it arrived on **/
+static OVS_STATUS ovsdb_send_reply(void * data, const char * msg, size_t len)
 {
-    char recv_buffer[128 * 1024] = {0};
+    return ovsdb_send((ovsdb_session *)data, msg, len);
+}
+
+/**
+ * Writes the last transaction id next to 'path' and renames it over, so a
+ * crash leaves either the old or the new id behind.
+**/
+static OVS_STATUS ovsdb_state_save(const char * path, const char * txn_id)
+{
+    char tmp_path[PATH_MAX];
+    FILE * file = NULL;
     int ret = 0;
+
+    if (snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path) >= (int)sizeof(tmp_path) ||
+        (file = fopen(tmp_path, "w")) == NULL){
+        OvsDbApiError("%s unable to create %s.tmp\n", __func__, path);
+        return OVS_FAILED_STATUS;
+    }
+
+    ret = (fprintf(file, "%s\n", txn_id) < 0 || fflush(file) != 0 || fsync(fileno(file)) != 0);
+    if (fclose(file) != 0 || ret || rename(tmp_path, path) != 0){
+        OvsDbApiError("%s unable to write %s\n", __func__, path);
+        (void)unlink(tmp_path);
+        return OVS_FAILED_STATUS;
+    }
+    return OVS_SUCCESS_STATUS;
+}
+
+/** Reads the id saved by ovsdb_state_save(), 'txn_id' is left empty if there is none **/
+static void ovsdb_state_load(const char * path, char * txn_id, size_t size)
+{
+    FILE * file = fopen(path, "r");
+
+    txn_id[0] = '\0';
+    if (!file){
+        OvsDbApiInfo("%s no saved state in %s, monitors start from scratch.\n",
+            __func__, path);
+        return;
+    }
+
+    if (!fgets(txn_id, size, file)){
+        txn_id[0] = '\0';
+    }
+    txn_id[strcspn(txn_id, "\r\n")] = '\0';
+    fclose(file);
+    OvsDbApiInfo("%s monitors resume after transaction '%s'\n", __func__, txn_id);
+}
+
+/** Writes the last transaction id to the state file unless it already has it **/
+static void ovsdb_state_flush(ovsdb_ctx * ctx)
+{
+    char path[PATH_MAX];
+    char txn_id[MAX_UUID_LEN+1];
+    bool dirty = false;
+
+    pthread_mutex_lock(&ctx->state_mutex);
+    dirty = ctx->state_dirty && ctx->state_file &&
+        snprintf(path, sizeof(path), "%s", ctx->state_file) < (int)sizeof(path);
+    snprintf(txn_id, sizeof(txn_id), "%s", ctx->last_txn_id);
+    ctx->state_dirty = false;
+    pthread_mutex_unlock(&ctx->state_mutex);
+
+    // without the lock, the file system must not hold up other threads
+    if (dirty){
+        (void)ovsdb_state_save(path, txn_id);
+    }
+}
+
+static void ovsdb_state_timer_event(int fd, uint32_t events, void * data)
+{
+    ovsdb_state_flush((ovsdb_ctx *)data);
+}
+
+/**
+ * Keeps the last transaction id reported by the server, called on the
+ * reactor thread once the updates it comes with have been delivered. It is
+ * written to the state file OVSDB_STATE_SAVE_MSECS later, with whatever
+ * came in meanwhile, and when the context is destroyed.
+**/
+static void ovsdb_record_txn(void * data, const char * txn_id)
+{
+    ovsdb_ctx * ctx = (ovsdb_ctx *)data;
+    bool arm = false;
+
+    pthread_mutex_lock(&ctx->state_mutex);
+    if (strcmp(ctx->last_txn_id, txn_id) != 0){
+        snprintf(ctx->last_txn_id, sizeof(ctx->last_txn_id), "%s", txn_id);
+        arm = (ctx->state_file && !ctx->state_dirty);
+        ctx->state_dirty = true;
+    }
+    pthread_mutex_unlock(&ctx->state_mutex);
+
+    if (arm){
+        (void)ovsdb_reactor_timer_arm(ctx->state_timer, OVSDB_STATE_SAVE_MSECS, 0);
+    }
+}
+
+/**
+ * Whether monitors are sent as monitor_cond_since, with the transaction
+ * they start from copied to 'last_txn_id' that must hold MAX_UUID_LEN + 1
+ * characters. That is the last one seen if 'resume', else they ask for
+ * every row.
+**/
+static bool ovsdb_monitor_since(ovsdb_ctx * ctx, bool resume, char * last_txn_id)
+{
+    bool since = false;
+
+    pthread_mutex_lock(&ctx->state_mutex);
+    if (ctx->state_file){
+        snprintf(last_txn_id, MAX_UUID_LEN+1, "%s",
+            (resume && ctx->last_txn_id[0]) ? ctx->last_txn_id : OVSDB_ZERO_TXN_ID);
+        since = true;
+    }
+    pthread_mutex_unlock(&ctx->state_mutex);
+    return since;
+}
+
+/** Registers the receipt of the monitor request 'rID' and sends it on the monitor session **/
+static OVS_STATUS ovsdb_send_monitor_request(ovsdb_ctx * ctx, const json_writer * writer,
+    const char * rID, OVSDB_RECEIPT_ID receipt_id, ovsdb_receipt_cb receipt_cb)
+{
     OVS_STATUS status = OVS_SUCCESS_STATUS;
-    int timeout = OVSDB_SOCKET_LISTEN_TIMEOUT_MSECS;
+    ovsdb_session * s = ovsdb_monitor_session(ctx);
+
+    OvsDbApiDebug("%s generated monitor json string: %s\n",
+        __func__, writer->buf);
 
-    if (!data){
-        timeout = *(int*)data;
+    status = ovsdb_add_receipt(ctx, rID, receipt_id,
+            (receipt_cb != NULL) ? receipt_cb : dummy_receipt_cb, s->index);
+    if(status != OVS_SUCCESS_STATUS){
+        OvsDbApiError("%s failed to register receipt callback.\n", __func__);
+        return status;
     }
-    OvsDbApiDebug("%s thread timeout %d\n", __func__, timeout);
 
-    while(!g_terminate){
-        ret = ovsdb_socket_listen(ovsdb_sock_fd, recv_buffer,
-                                  sizeof(recv_buffer), timeout);
-        if(ret < 0){
-            OvsDbApiError("%s thread received ret=%d\n", __func__, ret);
-            status = OVS_FAILED_STATUS;
-            break;
+    //Write it to the OVSDB socket
+    status = ovsdb_send(s, writer->buf, writer->len);
+    if(status != OVS_SUCCESS_STATUS){
+        OvsDbApiError("%s failed to write to OVSDB socket, status %d.\n",
+            __func__, status);
+        (void)receipt_list_remove(ctx->receipts, rID);
+        return status;
+    }
+
+    OvsDbApiInfo("%s successfully sent %zu bytes for rId %s.\n",
+        __func__, writer->len, rID);
+    return status;
+}
+
+/**
+ * Sends a monitor request for 'unique_id', which must already be in the
+ * monitor list. 'select' is the encoded columns and updates it asks for,
+ * NULL for all, 'where' the encoded condition of a conditional monitor,
+ * NULL for a plain one. With a state file set it is a monitor_cond_since,
+ * sent with 'unique_id' as its request id so the changes in the reply can
+ * be routed to the monitor. It resumes from the last transaction seen
+ * only if 'resume', see mon_list_can_resume().
+**/
+static OVS_STATUS ovsdb_send_monitor(ovsdb_ctx * ctx, OVS_TABLE ovsdb_table,
+    const char * select, const char * where, const char * rID, const char * unique_id,
+    bool resume, ovsdb_receipt_cb receipt_cb)
+{
+    OVS_STATUS status = OVS_SUCCESS_STATUS;
+    char buf[JSON_WRITER_STACK_SIZE];
+    json_writer writer;
+    OVSDB_RECEIPT_ID receipt_id = OVSDB_MONITOR_RECEIPT_ID;
+    char last_txn_id[MAX_UUID_LEN+1] = { 0 };
+
+    if (ovsdb_monitor_since(ctx, resume, last_txn_id)){
+        receipt_id = OVSDB_MONITOR_COND_SINCE_RECEIPT_ID;
+        rID = unique_id;
+    }
+
+    //Create the JSON string
+    json_writer_init(&writer, buf, sizeof(buf));
+    if (receipt_id == OVSDB_MONITOR_COND_SINCE_RECEIPT_ID){
+        status = ovsdb_monitor_cond_since_to_json(&writer, ovsdb_table, select, where,
+            last_txn_id, rID, unique_id);
+    }
+    else if (where){
+        status = ovsdb_monitor_cond_to_json(&writer, ovsdb_table, select, where, rID,
+            unique_id);
+    }
+    else{
+        status = ovsdb_monitor_to_json(&writer, ovsdb_table, select, rID, unique_id);
+    }
+    if (status != OVS_SUCCESS_STATUS){
+        OvsDbApiError("%s unable to convert to JSON string.\n", __func__);
+        json_writer_release(&writer);
+        return OVS_FAILED_STATUS;
+    }
+
+    status = ovsdb_send_monitor_request(ctx, &writer, rID, receipt_id, receipt_cb);
+    json_writer_release(&writer);
+    return status;
+}
+
+/**
+ * Sends the session monitor request for the 'tables' that are part of it,
+ * see ovsdb_monitor_tables_to_json(). As for ovsdb_send_monitor() it is a
+ * monitor_cond_since, with the monitor's id as request id, when a state
+ * file is set. ctx->monitor_mutex must be held.
+**/
+static OVS_STATUS ovsdb_send_session_monitor(ovsdb_ctx * ctx, uint32_t tables,
+    const char * rID, ovsdb_receipt_cb receipt_cb)
+{
+    OVS_STATUS status = OVS_SUCCESS_STATUS;
+    char buf[JSON_WRITER_STACK_SIZE];
+    json_writer writer;
+    OVSDB_RECEIPT_ID receipt_id = OVSDB_MONITOR_RECEIPT_ID;
+    char last_txn_id[MAX_UUID_LEN+1] = { 0 };
+
+    if (ovsdb_monitor_since(ctx, mon_list_can_resume(ctx->monitors, ctx->session_monitor),
+            last_txn_id)){
+        receipt_id = OVSDB_MONITOR_COND_SINCE_RECEIPT_ID;
+        rID = ctx->session_monitor;
+    }
+
+    json_writer_init(&writer, buf, sizeof(buf));
+    if (ovsdb_monitor_tables_to_json(&writer, tables,
+            (receipt_id == OVSDB_MONITOR_COND_SINCE_RECEIPT_ID) ? last_txn_id : NULL,
+            rID, ctx->session_monitor) != OVS_SUCCESS_STATUS){
+        OvsDbApiError("%s unable to convert to JSON string.\n", __func__);
+        json_writer_release(&writer);
+        return OVS_FAILED_STATUS;
+    }
+
+    status = ovsdb_send_monitor_request(ctx, &writer, rID, receipt_id, receipt_cb);
+    json_writer_release(&writer);
+    return status;
+}
+
+/** A mon_list_foreach() callback, the list stays locked while it sends **/
+static void ovsdb_replay_monitor(const char * unique_id, OVS_TABLE table,
+    const char * select, const char * where, bool resume, char * rID, void * data)
+{
+    ovsdb_ctx * ctx = (ovsdb_ctx *)data;
+
+    // the monitor keeps its id so updates still reach the registered callback
+    snprintf(rID, MAX_UUID_LEN+1, "%u", ovsdb_ctx_id_generate(ctx));
+    OvsDbApiInfo("%s re-issuing monitor %s for table %d, rId: %s\n",
+        __func__, unique_id, table, rID);
+    if (ovsdb_send_monitor(ctx, table, select, where, rID, unique_id, resume,
+            NULL) != OVS_SUCCESS_STATUS){
+        OvsDbApiError("%s failed to re-issue monitor %s\n", __func__, unique_id);
+    }
+}
+
+/**
+ * Re-issues the session monitor with the tables still part of it. Without
+ * any the next table to join sets it up again.
+**/
+static void ovsdb_replay_session_monitor(ovsdb_ctx * ctx)
+{
+    char rID[MAX_UUID_LEN+1] = { 0 };
+    uint32_t tables = 0;
+
+    pthread_mutex_lock(&ctx->monitor_mutex);
+    tables = mon_list_group_tables(ctx->monitors, ctx->session_monitor);
+    if (tables == 0){
+        ctx->session_monitor[0] = '\0';
+    }
+    else{
+        snprintf(rID, sizeof(rID), "%u", ovsdb_ctx_id_generate(ctx));
+        (void)mon_list_set_request(ctx->monitors, ctx->session_monitor, rID);
+        OvsDbApiInfo("%s re-issuing session monitor %s for tables 0x%x, rId: %s\n",
+            __func__, ctx->session_monitor, tables, rID);
+        if (ovsdb_send_session_monitor(ctx, tables, rID, NULL) != OVS_SUCCESS_STATUS){
+            OvsDbApiError("%s failed to re-issue session monitor %s\n", __func__,
+                ctx->session_monitor);
         }
-        if (ret != 0){
-            OvsDbApiDebug("%s thread read %d bytes\n", __func__, ret);
+    }
+    pthread_mutex_unlock(&ctx->monitor_mutex);
+}
+
+/** Which monitor ovsdb_reissue_monitor() looks for **/
+typedef struct ovsdb_reissue
+{
+    ovsdb_ctx * ctx;
+    const char * unique_id;
+} ovsdb_reissue;
+
+static void ovsdb_reissue_monitor(const char * unique_id, OVS_TABLE table,
+    const char * select, const char * where, bool resume, char * rID, void * data)
+{
+    ovsdb_reissue * reissue = (ovsdb_reissue *)data;
+
+    if (strcmp(unique_id, reissue->unique_id) == 0){
+        ovsdb_replay_monitor(unique_id, table, select, where, resume, rID, reissue->ctx);
+    }
+}
+
+/** Re-issues monitor 'monitor_id', the session monitor with all its tables **/
+static void ovsdb_replay_monitor_id(ovsdb_ctx * ctx, const char * monitor_id)
+{
+    ovsdb_reissue reissue = { ctx, monitor_id };
+
+    pthread_mutex_lock(&ctx->monitor_mutex);
+    if (strcmp(monitor_id, ctx->session_monitor) == 0){
+        pthread_mutex_unlock(&ctx->monitor_mutex);
+        ovsdb_replay_session_monitor(ctx);
+        return;
+    }
+    pthread_mutex_unlock(&ctx->monitor_mutex);
+    (void)mon_list_foreach(ctx->monitors, ovsdb_reissue_monitor, &reissue);
+}
+
+/**
+ * The server refused the monitor_cond_since of monitor 'monitor_id', e.g.
+ * an ovsdb-server release without it answering "unknown method". Monitors
+ * then stop resuming and the monitor is re-issued as a plain monitor or
+ * monitor_cond, the ones still to reply are re-issued as they are refused.
+ * Called on the reactor thread.
+**/
+static void ovsdb_monitor_since_refused(void * data, const char * monitor_id)
+{
+    ovsdb_ctx * ctx = (ovsdb_ctx *)data;
+    char * state_file = NULL;
+
+    pthread_mutex_lock(&ctx->state_mutex);
+    state_file = ctx->state_file;
+    ctx->state_file = NULL;
+    pthread_mutex_unlock(&ctx->state_mutex);
+    if (state_file){
+        OvsDbApiWarning("%s OVSDB does not resume monitors, %s is not used.\n",
+            __func__, state_file);
+        free(state_file);
+    }
+    ovsdb_replay_monitor_id(ctx, monitor_id);
+}
+
+/**
+ * The cache of monitor 'monitor_id' missed a modified row. The monitor is
+ * cancelled and re-issued under the same id, without resuming, so its
+ * contents fill the cache again. Called on the reactor thread.
+**/
+static void ovsdb_monitor_resync(void * data, const char * monitor_id)
+{
+    ovsdb_ctx * ctx = (ovsdb_ctx *)data;
+    char buf[JSON_WRITER_STACK_SIZE];
+    json_writer writer;
+    char rID[MAX_UUID_LEN+1] = { 0 };
+    OVS_STATUS status = OVS_SUCCESS_STATUS;
+
+    snprintf(rID, sizeof(rID), "%u", ovsdb_ctx_id_generate(ctx));
+    OvsDbApiWarning("%s re-syncing monitor %s, rId: %s\n", __func__, monitor_id, rID);
+
+    json_writer_init(&writer, buf, sizeof(buf));
+    status = ovsdb_monitor_cancel_to_json(&writer, monitor_id, rID);
+    if (status == OVS_SUCCESS_STATUS){
+        status = ovsdb_send_monitor_request(ctx, &writer, rID,
+            OVSDB_MONITOR_CANCEL_RECEIPT_ID, NULL);
+    }
+    json_writer_release(&writer);
+    if (status != OVS_SUCCESS_STATUS){
+        OvsDbApiError("%s failed to cancel monitor %s\n", __func__, monitor_id);
+        return;
+    }
+    ovsdb_replay_monitor_id(ctx, monitor_id);
+}
+
+static void ovsdb_socket_event(int fd, uint32_t events, void * data);
+
+static void ovsdb_reconnect_event(int fd, uint32_t events, void * data)
+{
+    ovsdb_session * s = (ovsdb_session *)data;
+    int sock_fd = ovsdb_socket_connect();
+
+    if (sock_fd < 0 ||
+        ovsdb_reactor_add(s->ctx->reactor, sock_fd, OVSDB_SOCKET_EVENTS,
+            ovsdb_socket_event, s) != OVS_SUCCESS_STATUS){
+        (void)ovsdb_socket_disconnect(sock_fd);
+        s->reconnect_backoff = (s->reconnect_backoff * 2 < OVSDB_RECONNECT_MAX_MSECS) ?
+            s->reconnect_backoff * 2 : OVSDB_RECONNECT_MAX_MSECS;
+        OvsDbApiWarning("%s session %d reconnect failed, retrying in %u msecs\n",
+            __func__, s->index, s->reconnect_backoff);
+        (void)ovsdb_reactor_timer_arm(s->reconnect_timer, s->reconnect_backoff, 0);
+        return;
+    }
+
+    pthread_mutex_lock(&s->mutex);
+    s->fd = sock_fd;
+    pthread_mutex_unlock(&s->mutex);
+    s->reconnect_backoff = OVSDB_RECONNECT_MIN_MSECS;
+
+    OvsDbApiInfo("%s session %d reconnected to OVSDB, fd=%d\n",
+        __func__, s->index, sock_fd);
+    if (s->index == OVSDB_MONITOR_SESSION){
+        (void)mon_list_foreach(s->ctx->monitors, ovsdb_replay_monitor, s->ctx);
+        ovsdb_replay_session_monitor(s->ctx);
+    }
+}
+
+/**
+ * Drops the broken connection, fails every request still waiting for a
+ * response on it and schedules a reconnect. Other sessions are not affected.
+**/
+static void ovsdb_connection_lost(ovsdb_session * s)
+{
+    OvsDbApiError("%s session %d lost connection to OVSDB, fd=%d\n",
+        __func__, s->index, s->fd);
+    (void)ovsdb_reactor_remove(s->ctx->reactor, s->fd);
+
+    pthread_mutex_lock(&s->mutex);
+    ovsdb_txq_reset(&s->txq);
+    (void)ovsdb_socket_disconnect(s->fd);
+    s->fd = -1;
+    pthread_mutex_unlock(&s->mutex);
+    ovsdb_framer_reset(&s->framer);
+
+    // requests are not resent, a transact may already have been committed
+    (void)receipt_list_fail_session(s->ctx->receipts, s->index, OVS_FAILED_STATUS,
+        "OVSDB connection lost");
+    s->echo_pending = false;
+    s->echo_missed = 0;
+
+    s->reconnect_backoff = OVSDB_RECONNECT_MIN_MSECS;
+    (void)ovsdb_reactor_timer_arm(s->reconnect_timer, s->reconnect_backoff, 0);
+}
+
+static OVS_STATUS ovsdb_socket_flush(ovsdb_session * s)
+{
+    bool empty = false;
+
+    if (ovsdb_txq_flush(&s->txq, s->fd, &empty) != OVS_SUCCESS_STATUS){
+        return OVS_FAILED_STATUS;
+    }
+
+    if (empty){
+        (void)ovsdb_reactor_modify(s->ctx->reactor, s->fd, OVSDB_SOCKET_EVENTS);
+        // a writer may have queued more after the flush emptied the queue
+        if (ovsdb_txq_pending(&s->txq) > 0){
+            (void)ovsdb_reactor_modify(s->ctx->reactor, s->fd,
+                OVSDB_SOCKET_EVENTS | EPOLLOUT);
         }
-        /**
-          TODO:
-        - READS ONE BYTE FROM SOCKET AT A TIME
-        - Doesn't support non-blocking sockets: https://github.com/akheron/jansson/issues/410
-        json_error_t error;
-        json_t* ovsdb_msg = json_loadfd(ovsdb_fd, JSON_DISABLE_EOF_CHECK, &error);
-        if(ovsdb_msg == NULL){
-            OvsDbApiError("%s Failed to load JRPC over socket: %s\n", __func__, error.text);
+    }
+    return OVS_SUCCESS_STATUS;
+}
+
+static void ovsdb_echo_receipt_cb(const char * rid, const OvsDb_Base_Receipt * result,
+    void * data)
+{
+    ovsdb_session * s = (ovsdb_session *)data;
+    ovsdb_ctx * ctx = s->ctx;
+    struct timespec now;
+    unsigned int usecs = 0;
+
+    if (!rid || !result || !s->echo_pending || strcmp(rid, s->echo_rid) != 0){
+        return;
+    }
+
+    if (result->status == OVS_TIMED_OUT_STATUS){
+        return;     // still unanswered, ovsdb_echo_event() counts the misses
+    }
+
+    s->echo_pending = false;
+    if (result->status != OVS_SUCCESS_STATUS){
+        return;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    usecs = (unsigned int)((now.tv_sec - s->echo_sent.tv_sec) * 1000000 +
+        (now.tv_nsec - s->echo_sent.tv_nsec) / 1000);
+    s->echo_missed = 0;
+
+    pthread_mutex_lock(&ctx->echo_mutex);
+    ctx->echo_stats.received++;
+    ovsdb_rtt_window_add(&ctx->rtt_window, usecs);
+    pthread_mutex_unlock(&ctx->echo_mutex);
+    OvsDbApiDebug("%s session %d rId: %s, rtt %u usecs\n",
+        __func__, s->index, rid, usecs);
+}
+
+static void ovsdb_send_echo(ovsdb_session * s)
+{
+    ovsdb_ctx * ctx = s->ctx;
+    char buf[JSON_WRITER_STACK_SIZE];
+    json_writer writer;
+
+    snprintf(s->echo_rid, sizeof(s->echo_rid), "%u", ovsdb_ctx_id_generate(ctx));
+    json_writer_init(&writer, buf, sizeof(buf));
+    if (ovsdb_echo_to_json(&writer, s->echo_rid) != OVS_SUCCESS_STATUS ||
+        receipt_list_add_data(ctx->receipts, s->echo_rid, OVSDB_ECHO_RECEIPT_ID,
+            ovsdb_echo_receipt_cb, s, s->index) != OVS_SUCCESS_STATUS){
+        json_writer_release(&writer);
+        return;
+    }
+
+    ovsdb_request_timer_start(ctx);
+    clock_gettime(CLOCK_MONOTONIC, &s->echo_sent);
+    s->echo_pending = true;
+    if (ovsdb_send(s, writer.buf, writer.len) != OVS_SUCCESS_STATUS){
+        s->echo_pending = false;
+        (void)receipt_list_remove(ctx->receipts, s->echo_rid);
+        json_writer_release(&writer);
+        return;
+    }
+    json_writer_release(&writer);
+
+    pthread_mutex_lock(&ctx->echo_mutex);
+    ctx->echo_stats.sent++;
+    pthread_mutex_unlock(&ctx->echo_mutex);
+}
+
+/**
+ * Sends an echo request every interval. A server that leaves
+ * OVSDB_ECHO_MAX_MISSED of them unanswered is considered wedged and the
+ * connection is re-established.
+**/
+static void ovsdb_echo_event(int fd, uint32_t events, void * data)
+{
+    ovsdb_session * s = (ovsdb_session *)data;
+    ovsdb_ctx * ctx = s->ctx;
+
+    if (s->fd < 0){
+        return;
+    }
+
+    if (!s->echo_pending){
+        ovsdb_send_echo(s);
+        return;
+    }
+
+    s->echo_missed++;
+    pthread_mutex_lock(&ctx->echo_mutex);
+    ctx->echo_stats.missed++;
+    pthread_mutex_unlock(&ctx->echo_mutex);
+    OvsDbApiWarning("%s session %d no reply to echo rId: %s for %u intervals\n",
+        __func__, s->index, s->echo_rid, s->echo_missed);
+
+    if (s->echo_missed >= OVSDB_ECHO_MAX_MISSED){
+        OvsDbApiError("%s ALARM: OVSDB did not answer echo requests for %u msecs, reconnecting\n",
+            __func__, s->echo_missed * ctx->echo_interval);
+        ovsdb_connection_lost(s);
+    }
+}
+
+/**
+ * Reads the OVSDB socket whenever epoll reports it readable and resumes
+ * queued writes once it is writable again. A socket that still has data
+ * after OVSDB_MAX_READS_PER_EVENT reads stays readable and is picked up
+ * again after the other sessions had their turn. A message that is too
+ * large or cannot be framed drops the connection, as the stream cannot be
+ * resynchronised.
+**/
+static void ovsdb_socket_event(int fd, uint32_t events, void * data)
+{
+    ovsdb_session * s = (ovsdb_session *)data;
+    char * space = NULL;
+    size_t avail = 0;
+    ssize_t ret = 0;
+    int reads = 0;
+
+    if ((events & EPOLLOUT) && ovsdb_socket_flush(s) != OVS_SUCCESS_STATUS){
+        ret = -1;
+    }
+
+    while (ret == 0 && (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)) &&
+        reads++ < OVSDB_MAX_READS_PER_EVENT){
+        // receive straight into the framer, messages are parsed in place
+        space = ovsdb_framer_get_space(&s->framer, OVSDB_FRAMER_MIN_READ, &avail);
+        if (!space){
+            // the rest of the message is still to come, the stream cannot be resynchronised
+            OvsDbApiError("%s session %d no receive buffer space for message.\n",
+                __func__, s->index);
+            ret = -1;
+            break;
+        }
+
+        ret = ovsdb_socket_read(fd, space, avail);
+        if (ret > 0){
+            OvsDbApiDebug("%s session %d read %zd bytes\n", __func__, s->index, ret);
+            // messages may span several reads, the framer hands over complete ones
+            if (ovsdb_framer_commit(&s->framer, ret,
+                    ovsdb_process_msg, s) != OVS_SUCCESS_STATUS){
+                OvsDbApiError("%s session %d failed to frame %zd bytes.\n",
+                    __func__, s->index, ret);
+                ret = -1;
+                break;
+            }
+            ret = 0;
             continue;
         }
-        **/
+        if (ret == 0){
+            // socket drained, give back memory grown for a large dump
+            ovsdb_framer_shrink(&s->framer);
+        }
+        break;
+    }
+
+    if (ret < 0 || (events & (EPOLLHUP | EPOLLERR))){
+        OvsDbApiError("%s socket fd=%d failed, ret=%zd, events=0x%x\n",
+            __func__, fd, ret, events);
+        ovsdb_connection_lost(s);
+    }
+}
+
+static void ovsdb_session_close(ovsdb_session * s)
+{
+    pthread_mutex_lock(&s->mutex);
+    if (s->fd >= 0){
+        (void)ovsdb_socket_disconnect(s->fd);
+    }
+    s->fd = -1;
+    pthread_mutex_unlock(&s->mutex);
+    pthread_mutex_destroy(&s->mutex);
+    ovsdb_framer_deinit(&s->framer);
+    ovsdb_txq_deinit(&s->txq);
+}
+
+static void* ovsdb_listen(void* data)
+{
+    ovsdb_ctx * ctx = (ovsdb_ctx *)data;
+    OVS_STATUS status = OVS_SUCCESS_STATUS;
+
+    OvsDbApiDebug("%s thread started\n", __func__);
+    status = ovsdb_reactor_run(ctx->reactor);
+
+    OvsDbApiDebug("%s thread exiting with status %d\n", __func__, status);
+    pthread_exit(&status);
+}
+
+/**
+ * Connects a session and registers its socket and timers with the reactor.
+**/
+static OVS_STATUS ovsdb_session_open(ovsdb_ctx * ctx, int index,
+    size_t send_queue_limit)
+{
+    ovsdb_session * s = &ctx->sessions[index];
+
+    (void)pthread_mutex_init(&s->mutex, NULL);
+    s->ctx = ctx;
+    s->index = index;
+    s->fd = -1;
+    s->reconnect_timer = -1;
+    s->reconnect_backoff = OVSDB_RECONNECT_MIN_MSECS;
+    s->echo_timer = -1;
+    (void)ovsdb_framer_init(&s->framer);
+    (void)ovsdb_txq_init(&s->txq, send_queue_limit);
+    s->target.receipts = ctx->receipts;
+    s->target.monitors = ctx->monitors;
+    s->target.reply_fn = ovsdb_send_reply;
+    s->target.reply_data = s;
+    s->target.txn_fn = ovsdb_record_txn;
+    s->target.since_fn = ovsdb_monitor_since_refused;
+    s->target.resync_fn = ovsdb_monitor_resync;
+    s->target.txn_data = ctx;
+
+    s->fd = ovsdb_socket_connect();
+    if (s->fd < 0){
+        OvsDbApiError("Failed to connect session %d to OVSDB socket.\n", index);
+        return OVS_FAILED_STATUS;
+    }
+
+    if (ovsdb_reactor_add(ctx->reactor, s->fd, OVSDB_SOCKET_EVENTS,
+            ovsdb_socket_event, s) != OVS_SUCCESS_STATUS ||
+        (s->reconnect_timer = ovsdb_reactor_timer_create(ctx->reactor,
+            ovsdb_reconnect_event, s)) < 0 ||
+        (s->echo_timer = ovsdb_reactor_timer_create(ctx->reactor,
+            ovsdb_echo_event, s)) < 0){
+        OvsDbApiError("Failed to add session %d to the OVSDB event loop.\n", index);
+        return OVS_FAILED_STATUS;
+    }
+
+    (void)ovsdb_reactor_timer_arm(s->echo_timer, ctx->echo_interval, ctx->echo_interval);
+    return OVS_SUCCESS_STATUS;
+}
+
+static void ovsdb_ctx_free(ovsdb_ctx * ctx, int sessions)
+{
+    int i = 0;
+
+    // the reactor owns and closes the session timers
+    ovsdb_reactor_destroy(ctx->reactor);
+    for (i = 0; i < sessions; i++){
+        ovsdb_session_close(&ctx->sessions[i]);
+    }
+    mon_list_destroy(ctx->monitors);
+    receipt_list_destroy(ctx->receipts);
+    pthread_mutex_destroy(&ctx->echo_mutex);
+    pthread_mutex_destroy(&ctx->state_mutex);
+    pthread_mutex_destroy(&ctx->monitor_mutex);
+    free(ctx->state_file);
+    free(ctx);
+}
+
+static ovsdb_ctx * ovsdb_ctx_open(unsigned int startingId, size_t send_queue_limit,
+    unsigned int echo_interval)
+{
+    ovsdb_ctx * ctx = NULL;
+    int i = 0;
+
+    ctx = calloc(1, sizeof(ovsdb_ctx));
+    if (!ctx){
+        OvsDbApiError("%s failed to allocate context.\n", __func__);
+        return NULL;
+    }
+
+    // sets the starting value for the id generator
+    ctx->id = startingId;
+    ctx->echo_interval = echo_interval;
+    ctx->request_timer = -1;
+    ctx->state_timer = -1;
+    ovsdb_rtt_window_reset(&ctx->rtt_window);
+    pthread_mutex_init(&ctx->echo_mutex, NULL);
+    pthread_mutex_init(&ctx->state_mutex, NULL);
+    pthread_mutex_init(&ctx->monitor_mutex, NULL);
+
+    ctx->reactor = ovsdb_reactor_create();
+    ctx->receipts = receipt_list_create();
+    ctx->monitors = mon_list_create();
+    if (!ctx->reactor || !ctx->receipts || !ctx->monitors ||
+        (ctx->request_timer = ovsdb_reactor_timer_create(ctx->reactor,
+            ovsdb_request_timer_event, ctx)) < 0 ||
+        (ctx->state_timer = ovsdb_reactor_timer_create(ctx->reactor,
+            ovsdb_state_timer_event, ctx)) < 0){
+        OvsDbApiError("Failed to set up the OVSDB event loop.\n");
+        ovsdb_ctx_free(ctx, 0);
+        return NULL;
+    }
+
+    for (i = 0; i < OVSDB_SESSION_COUNT; i++){
+        if (ovsdb_session_open(ctx, i, send_queue_limit) != OVS_SUCCESS_STATUS){
+            ovsdb_ctx_free(ctx, i + 1);
+            return NULL;
+        }
+    }
+
+    if (pthread_create(&ctx->listen_thread, NULL, ovsdb_listen, ctx) != 0){
+        OvsDbApiError("Failed to create ovsdb_listen thread.\n");
+        ovsdb_ctx_free(ctx, OVSDB_SESSION_COUNT);
+        return NULL;
+    }
+
+    return ctx;
+}
+
+/**
+ * Opens an independent set of connections to OVSDB with its own request
+ * ids, pending receipts and monitors, served by its own thread.
+**/
+ovsdb_ctx * ovsdb_ctx_create(unsigned int startingId)
+{
+    return ovsdb_ctx_open(startingId, OVSDB_TXQ_DEFAULT_HIGH_WATER,
+        OVSDB_ECHO_INTERVAL_MSECS);
+}
+
+OVS_STATUS ovsdb_ctx_destroy(ovsdb_ctx * ctx)
+{
+    int ret;
+    OVS_STATUS status = OVS_SUCCESS_STATUS;
+    void * ptrStatus = (void*)&status;
+
+    if (!ctx){
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    // wakes the listener right away, there is no polling timeout to wait for
+    (void)ovsdb_reactor_stop(ctx->reactor);
+
+    OvsDbApiDebug("%s calling join on thread...\n", __func__);
+    ret = pthread_join(ctx->listen_thread, (void**)&ptrStatus);
+    if (ret != 0){
+        OvsDbApiError("%s thread join error, ret=%d", __func__, ret);
+        status = OVS_FAILED_STATUS;
+    }
+    ovsdb_state_flush(ctx);
+
+    ovsdb_ctx_free(ctx, OVSDB_SESSION_COUNT);
+
+    OvsDbApiDebug("%s returning status %d\n", __func__, status);
+    return status;
+}
+
+/**
+ * Sends a message to the OVSDB table.  Calls the callback with the generated UUID when OVSDB responds.
+**/
+OVS_STATUS ovsdb_ctx_write(ovsdb_ctx * ctx, const char* rID, Rdkb_Table_Config* config,
+    ovsdb_receipt_cb receipt_cb)
+{
+    OVS_STATUS status = OVS_SUCCESS_STATUS;
+    char buf[JSON_WRITER_STACK_SIZE];
+    json_writer writer;
+    ovsdb_session * s = NULL;
+
+    if (!ctx || !rID || !config){
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+    s = ovsdb_transact_session(ctx);
+
+    OvsDbApiDebug("%s rId: %s\n", __func__, rID);
+
+    json_writer_init(&writer, buf, sizeof(buf));
+    if (ovsdb_insert_to_json(&writer, config, rID) != OVS_SUCCESS_STATUS){
+        OvsDbApiError("Failed to convert GW config to JSON string.\n");
+        json_writer_release(&writer);
+        return OVS_FAILED_STATUS;
+    }
+    OvsDbApiDebug("Successfully converted GC to JSON str: %s\n", writer.buf);
+
+    // Add to the receipt list before writing to socket to avoid any race condition issues
+    status = ovsdb_add_receipt(ctx, rID, OVSDB_INSERT_RECEIPT_ID,
+            (receipt_cb != NULL) ? receipt_cb : dummy_receipt_cb, s->index);
+    if(status != OVS_SUCCESS_STATUS){
+        OvsDbApiError("%s failed to add to the receipt list.\n", __func__);
+        json_writer_release(&writer);
+        return status;
+    }
+
+    status = ovsdb_send(s, writer.buf, writer.len);
+    json_writer_release(&writer);
+    if(status != OVS_SUCCESS_STATUS){
+        OvsDbApiError("Failed to write rId %s to socket, status %d.\n", rID, status);
+        (void)receipt_list_remove(ctx->receipts, rID);
+        return status;
+    }
+
+    OvsDbApiInfo("%s successfully sent %zu bytes for rId %s.\n",
+        __func__, writer.len, rID);
+    return status;
+}
+
+/**
+ * Sends the 'count' rows of 'configs' as one transact, OVSDB inserts all of
+ * them or none. Calls the callback with an OvsDb_Insert_Batch_Receipt.
+**/
+OVS_STATUS ovsdb_ctx_write_batch(ovsdb_ctx * ctx, const char* rID, Rdkb_Table_Config* configs,
+    size_t count, ovsdb_receipt_cb receipt_cb)
+{
+    OVS_STATUS status = OVS_SUCCESS_STATUS;
+    char buf[JSON_WRITER_STACK_SIZE];
+    json_writer writer;
+    ovsdb_session * s = NULL;
+
+    if (!ctx || !rID || !configs || count == 0){
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+    s = ovsdb_transact_session(ctx);
+
+    OvsDbApiDebug("%s rId: %s, Rows: %zu\n", __func__, rID, count);
+
+    json_writer_init(&writer, buf, sizeof(buf));
+    if (ovsdb_insert_batch_to_json(&writer, configs, count, rID) != OVS_SUCCESS_STATUS){
+        OvsDbApiError("Failed to convert %zu configs to JSON string.\n", count);
+        json_writer_release(&writer);
+        return OVS_FAILED_STATUS;
+    }
+    OvsDbApiDebug("Successfully converted batch to JSON str: %s\n", writer.buf);
+
+    status = ovsdb_add_receipt(ctx, rID, OVSDB_INSERT_BATCH_RECEIPT_ID,
+            (receipt_cb != NULL) ? receipt_cb : dummy_receipt_cb, s->index);
+    if(status != OVS_SUCCESS_STATUS){
+        OvsDbApiError("%s failed to add to the receipt list.\n", __func__);
+        json_writer_release(&writer);
+        return status;
+    }
+
+    status = ovsdb_send(s, writer.buf, writer.len);
+    json_writer_release(&writer);
+    if(status != OVS_SUCCESS_STATUS){
+        OvsDbApiError("Failed to write rId %s to socket, status %d.\n", rID, status);
+        (void)receipt_list_remove(ctx->receipts, rID);
+        return status;
+    }
+
+    OvsDbApiInfo("%s successfully sent %zu rows in %zu bytes for rId %s.\n",
+        __func__, count, writer.len, rID);
+    return status;
+}
+
+/**
+ * Send the monitor message to OVSDB and calls the callback whenever we get a response
+**/
+OVS_STATUS ovsdb_ctx_monitor(ovsdb_ctx * ctx, OVS_TABLE ovsdb_table, ovsdb_mon_cb mon_cb,
+    ovsdb_receipt_cb receipt_cb)
+{
+    return ovsdb_ctx_monitor_select(ctx, ovsdb_table, NULL, mon_cb, receipt_cb);
+}
+
+/** The OVSDB_MONITOR_SELECT mask of the updates 'select' asks for **/
+static unsigned int ovsdb_select_updates(const OvsDb_Monitor_Select * select)
+{
+    return (select && select->updates) ? select->updates : OVSDB_SELECT_ALL;
+}
+
+/**
+ * What to ask the server for when a monitor selects 'select': a monitor
+ * that caches rows is sent every kind of update, see mon_list_caches_rows(),
+ * using 'wire' for the copy of 'select' that asks for them.
+**/
+static const OvsDb_Monitor_Select * ovsdb_select_wire(const OvsDb_Monitor_Select * select,
+    bool row_cb, OvsDb_Monitor_Select * wire)
+{
+    unsigned int updates = ovsdb_select_updates(select);
+
+    if (!select || (updates & ~OVSDB_SELECT_ALL) || !mon_list_caches_rows(updates, row_cb)){
+        return select;
+    }
+    memcpy(wire, select, sizeof(OvsDb_Monitor_Select));
+    wire->updates = OVSDB_SELECT_ALL;
+    return wire;
+}
+
+/**
+ * Makes 'ovsdb_table' part of the session monitor, a single monitor of
+ * the monitor session that watches every table with plain monitors. The
+ * first table sets it up, the others are added by changing its condition
+ * and their current rows then arrive as inserts. 'joined' is cleared when
+ * the table is already part of it, the caller sets up a monitor of its own.
+**/
+static OVS_STATUS ovsdb_ctx_join_session_monitor(ovsdb_ctx * ctx, OVS_TABLE ovsdb_table,
+    ovsdb_mon_cb mon_cb, ovsdb_receipt_cb receipt_cb, bool * joined)
+{
+    OVS_STATUS status = OVS_SUCCESS_STATUS;
+    char buf[JSON_WRITER_STACK_SIZE];
+    json_writer writer;
+    char unique_id[MAX_UUID_LEN+1] = { 0 };
+    char rID[MAX_UUID_LEN+1] = { 0 };
+    uint32_t tables = 0;
+    bool first = false;
+
+    pthread_mutex_lock(&ctx->monitor_mutex);
+    tables = mon_list_group_tables(ctx->monitors, ctx->session_monitor);
+    *joined = !(tables & (1u << ovsdb_table));
+    if (!*joined){
+        pthread_mutex_unlock(&ctx->monitor_mutex);
+        return OVS_SUCCESS_STATUS;
+    }
+
+    if (!ctx->session_monitor[0]){
+        snprintf(ctx->session_monitor, sizeof(ctx->session_monitor), "%u",
+            ovsdb_ctx_id_generate(ctx));
+        first = true;
+    }
+    snprintf(rID, sizeof(rID), "%u", ovsdb_ctx_id_generate(ctx));
+    snprintf(unique_id, sizeof(unique_id), "%u", ovsdb_ctx_id_generate(ctx));
+    OvsDbApiDebug("%s table: %d, rId: %s, Unique Id: %s, session monitor: %s\n",
+        __func__, ovsdb_table, rID, unique_id, ctx->session_monitor);
+
+    status = mon_list_add_member(ctx->monitors, unique_id, ctx->session_monitor,
+        ovsdb_table, mon_cb);
+    if (status == OVS_SUCCESS_STATUS && first){
+        (void)mon_list_set_request(ctx->monitors, ctx->session_monitor, rID);
+        status = ovsdb_send_session_monitor(ctx, tables | (1u << ovsdb_table), rID,
+            receipt_cb);
+    }
+    else if (status == OVS_SUCCESS_STATUS){
+        // the reply has no rows, the monitor receipt tells of none
+        json_writer_init(&writer, buf, sizeof(buf));
+        status = ovsdb_monitor_cond_change_to_json(&writer, ovsdb_table, "[true]",
+            ctx->session_monitor, rID);
+        if (status == OVS_SUCCESS_STATUS){
+            status = ovsdb_send_monitor_request(ctx, &writer, rID, OVSDB_MONITOR_RECEIPT_ID,
+                receipt_cb);
+        }
+        json_writer_release(&writer);
+    }
+
+    if (status != OVS_SUCCESS_STATUS){
+        OvsDbApiError("%s failed to add table %d to session monitor.\n", __func__,
+            ovsdb_table);
+        (void)mon_list_remove(ctx->monitors, unique_id);
+        if (first){
+            ctx->session_monitor[0] = '\0';
+        }
+    }
+    pthread_mutex_unlock(&ctx->monitor_mutex);
+    return status;
+}
+
+/**
+ * Removes member 'unique_id' from the session monitor, the rows of its
+ * table then match no row. The session monitor is kept for the next table.
+**/
+static OVS_STATUS ovsdb_ctx_leave_session_monitor(ovsdb_ctx * ctx, const char * unique_id,
+    ovsdb_receipt_cb receipt_cb)
+{
+    OVS_STATUS status = OVS_SUCCESS_STATUS;
+    char buf[JSON_WRITER_STACK_SIZE];
+    json_writer writer;
+    char rID[MAX_UUID_LEN+1] = { 0 };
+    OVS_TABLE ovsdb_table = OVS_GW_CONFIG_TABLE;
 
-        if(ret > 0){
-            status = ovsdb_parse_msg(recv_buffer, ret);
-            if (status != OVS_SUCCESS_STATUS){
-                OvsDbApiError("%s failed to parse json message: %s\n",
-                    __func__, recv_buffer);
-            }
-        }
+    pthread_mutex_lock(&ctx->monitor_mutex);
+    if (mon_list_get_table(ctx->monitors, unique_id, &ovsdb_table) != OVS_SUCCESS_STATUS ||
+        mon_list_remove(ctx->monitors, unique_id) != OVS_SUCCESS_STATUS){
+        pthread_mutex_unlock(&ctx->monitor_mutex);
+        return OVS_FAILED_STATUS;
     }
 
-    if (ovsdb_socket_disconnect(ovsdb_sock_fd) < 0){
-        status = OVS_FAILED_STATUS;
+    snprintf(rID, sizeof(rID), "%u", ovsdb_ctx_id_generate(ctx));
+    json_writer_init(&writer, buf, sizeof(buf));
+    status = ovsdb_monitor_cond_change_to_json(&writer, ovsdb_table, "[false]",
+        ctx->session_monitor, rID);
+    if (status == OVS_SUCCESS_STATUS){
+        status = ovsdb_send_monitor_request(ctx, &writer, rID,
+            OVSDB_MONITOR_CANCEL_RECEIPT_ID, receipt_cb);
     }
-    ovsdb_sock_fd = -1;
-
-    OvsDbApiDebug("%s thread exiting with status %d\n", __func__, status);
-    pthread_exit(&status);
+    json_writer_release(&writer);
+    pthread_mutex_unlock(&ctx->monitor_mutex);
+    return status;
 }
 
 /**
- * Initialize the OVSDB Abstraction layer
- * Must use this function before any other OVSDB APIs
+ * Same as ovsdb_ctx_monitor() but the server only sends the columns and
+ * kinds of updates 'select' asks for, NULL for all of them. A monitor of
+ * modifies keeps its rows cached and is sent every kind, the callback is
+ * still only told of the ones asked for. A monitor of every column and
+ * kind of update is part of the session monitor.
 **/
-OVS_STATUS ovsdb_init(unsigned int startingId)
+OVS_STATUS ovsdb_ctx_monitor_select(ovsdb_ctx * ctx, OVS_TABLE ovsdb_table,
+    const OvsDb_Monitor_Select * select, ovsdb_mon_cb mon_cb, ovsdb_receipt_cb receipt_cb)
 {
-    int timeout = OVSDB_SOCKET_LISTEN_TIMEOUT_MSECS;
-
-    // sets the starting value for the id generator
-    id = startingId;
+    OVS_STATUS status = OVS_SUCCESS_STATUS;
+    char buf[JSON_WRITER_STACK_SIZE];
+    json_writer sel;
+    OvsDb_Monitor_Select wire;
+    char unique_id[MAX_UUID_LEN+1] = { 0 };
+    char rID[MAX_UUID_LEN+1] = { 0 };
+    bool joined = false;
 
-    if (ovsdb_sock_fd >= 0){
-        OvsDbApiDebug("%s socket already initialized, fd=%d\n", __func__, ovsdb_sock_fd);
-        return OVS_SUCCESS_STATUS;
+    if (!ctx || !mon_cb){
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
     }
 
-    int ret = ovsdb_socket_connect();
-    if(ret < 0){
-        OvsDbApiError("Failed to connect to OVSDB socket.\n");
+    json_writer_init(&sel, buf, sizeof(buf));
+    if (ovsdb_select_to_json(&sel, ovsdb_table,
+            ovsdb_select_wire(select, false, &wire)) != OVS_SUCCESS_STATUS){
+        OvsDbApiError("%s invalid monitor columns or updates.\n", __func__);
+        json_writer_release(&sel);
         return OVS_FAILED_STATUS;
     }
-    ovsdb_sock_fd = ret;
 
-    g_terminate = false;
-
-    ret = pthread_create(&listen_thread, NULL, ovsdb_listen, &timeout);
-    if(ret != 0){
-        OvsDbApiError("Failed to create ovsdb_listen thread.\n");
-        (void)ovsdb_socket_disconnect(ovsdb_sock_fd);
-        ovsdb_sock_fd = -1;
-        return OVS_FAILED_STATUS;
+    if (sel.len == 0 && ovsdb_select_updates(select) == OVSDB_SELECT_ALL){
+        status = ovsdb_ctx_join_session_monitor(ctx, ovsdb_table, mon_cb, receipt_cb,
+            &joined);
+        if (joined || status != OVS_SUCCESS_STATUS){
+            json_writer_release(&sel);
+            return status;
+        }
     }
 
-    return OVS_SUCCESS_STATUS;
+    snprintf(unique_id, sizeof(unique_id), "%u", ovsdb_ctx_id_generate(ctx));
+    snprintf(rID, sizeof(rID), "%u", ovsdb_ctx_id_generate(ctx));
+    OvsDbApiDebug("%s table: %d, rId: %s, Unique Id: %s\n",
+        __func__, ovsdb_table, rID, unique_id);
+
+    // registered monitors are re-issued automatically after a reconnect
+    status = mon_list_add_rows(ctx->monitors, unique_id, ovsdb_table,
+        (sel.len > 0) ? sel.buf : NULL, NULL, ovsdb_select_updates(select), mon_cb, NULL);
+    if(status == OVS_SUCCESS_STATUS){
+        // the response has the rows the monitor starts with
+        (void)mon_list_set_request(ctx->monitors, unique_id, rID);
+        status = ovsdb_send_monitor(ctx, ovsdb_table, (sel.len > 0) ? sel.buf : NULL, NULL,
+            rID, unique_id, mon_list_can_resume(ctx->monitors, unique_id), receipt_cb);
+        if(status != OVS_SUCCESS_STATUS){
+            mon_list_remove(ctx->monitors, unique_id);
+        }
+    }
+    else{
+        OvsDbApiError("%s failed to register monitor callback.\n", __func__);
+    }
+    json_writer_release(&sel);
+    return status;
 }
 
-OVS_STATUS ovsdb_deinit()
+/**
+ * Sets up a conditional monitor, 'where' NULL monitors every row. Its
+ * updates are update2 ones, whose modifies only carry the changed columns.
+ * A 'batch_cb' gets the rows instead of 'mon_cb' and 'row_cb'.
+**/
+static OVS_STATUS ovsdb_ctx_add_monitor_cond(ovsdb_ctx * ctx, OVS_TABLE ovsdb_table,
+    const OvsDb_Monitor_Select * select, const OvsDb_Condition * where, size_t num_where,
+    ovsdb_mon_cb mon_cb, ovsdb_row_cb row_cb, ovsdb_batch_cb batch_cb,
+    ovsdb_receipt_cb receipt_cb, char * monitor_id)
 {
-    int ret;
     OVS_STATUS status = OVS_SUCCESS_STATUS;
-    void * ptrStatus = (void*)&status;
-
-    g_terminate = true;
+    char sel_buf[JSON_WRITER_STACK_SIZE];
+    char buf[JSON_WRITER_STACK_SIZE];
+    json_writer sel;
+    json_writer cond;
+    OvsDb_Monitor_Select wire;
+    char unique_id[MAX_UUID_LEN+1] = { 0 };
+    char rID[MAX_UUID_LEN+1] = { 0 };
 
-    OvsDbApiDebug("%s calling join on thread...\n", __func__);
-    ret = pthread_join(listen_thread, (void**)&ptrStatus);
-    if (ret != 0){
-        OvsDbApiError("%s thread join error, ret=%d", __func__, ret);
-        status = OVS_FAILED_STATUS;
+    json_writer_init(&sel, sel_buf, sizeof(sel_buf));
+    json_writer_init(&cond, buf, sizeof(buf));
+    if (where == NULL){
+        json_writer_literal(&cond, "[true]");
+        status = json_writer_finish(&cond);
     }
-
-    if(mon_list_clear() != OVS_SUCCESS_STATUS){
-        status = OVS_FAILED_STATUS;
-        OvsDbApiError("%s failed to clear monitor list.\n", __func__);
+    else{
+        status = ovsdb_where_to_json(&cond, ovsdb_table, where, num_where);
     }
-
-    if(receipt_list_clear() != OVS_SUCCESS_STATUS){
-        status = OVS_FAILED_STATUS;
-        OvsDbApiError("%s failed to clear receipt list.\n", __func__);
+    if (status != OVS_SUCCESS_STATUS ||
+        ovsdb_select_to_json(&sel, ovsdb_table,
+            ovsdb_select_wire(select, row_cb || batch_cb, &wire)) != OVS_SUCCESS_STATUS){
+        OvsDbApiError("%s invalid monitor columns, updates or condition.\n", __func__);
+        json_writer_release(&sel);
+        json_writer_release(&cond);
+        return OVS_FAILED_STATUS;
     }
 
+    snprintf(unique_id, sizeof(unique_id), "%u", ovsdb_ctx_id_generate(ctx));
+    snprintf(rID, sizeof(rID), "%u", ovsdb_ctx_id_generate(ctx));
+    OvsDbApiDebug("%s table: %d, rId: %s, Unique Id: %s, where: %s\n",
+        __func__, ovsdb_table, rID, unique_id, cond.buf);
 
-    OvsDbApiDebug("%s returning status %d\n", __func__, status);
+    if (batch_cb){
+        status = mon_list_add_batch(ctx->monitors, unique_id, ovsdb_table,
+            (sel.len > 0) ? sel.buf : NULL, cond.buf, ovsdb_select_updates(select), batch_cb);
+    }
+    else{
+        status = mon_list_add_rows(ctx->monitors, unique_id, ovsdb_table,
+            (sel.len > 0) ? sel.buf : NULL, cond.buf, ovsdb_select_updates(select), mon_cb,
+            row_cb);
+    }
+    if(status == OVS_SUCCESS_STATUS){
+        (void)mon_list_set_request(ctx->monitors, unique_id, rID);
+        status = ovsdb_send_monitor(ctx, ovsdb_table, (sel.len > 0) ? sel.buf : NULL,
+            cond.buf, rID, unique_id, mon_list_can_resume(ctx->monitors, unique_id),
+            receipt_cb);
+        if(status != OVS_SUCCESS_STATUS){
+            mon_list_remove(ctx->monitors, unique_id);
+        }
+    }
+    else{
+        OvsDbApiError("%s failed to register monitor callback.\n", __func__);
+    }
+    json_writer_release(&sel);
+    json_writer_release(&cond);
+
+    if(status == OVS_SUCCESS_STATUS && monitor_id){
+        memcpy(monitor_id, unique_id, sizeof(unique_id));
+    }
     return status;
 }
 
 /**
- * Sends a message to the OVSDB table.  Calls the callback with the generated UUID when OVSDB responds.
+ * Monitors the rows of 'ovsdb_table' that match any of the 'num_where'
+ * clauses, the server filters the others out. 'select' is as for
+ * ovsdb_ctx_monitor_select(). 'monitor_id', if not NULL, receives the id
+ * to change the condition with, it must hold MAX_UUID_LEN + 1 characters.
 **/
-OVS_STATUS ovsdb_write(const char* rID, Rdkb_Table_Config* config, ovsdb_receipt_cb receipt_cb)
+OVS_STATUS ovsdb_ctx_monitor_cond(ovsdb_ctx * ctx, OVS_TABLE ovsdb_table,
+    const OvsDb_Monitor_Select * select, const OvsDb_Condition * where, size_t num_where,
+    ovsdb_mon_cb mon_cb, ovsdb_receipt_cb receipt_cb, char * monitor_id)
 {
-    size_t len = 0;
-    ssize_t size = 0;
-    OVS_STATUS status = OVS_SUCCESS_STATUS;
-    char * str_json = NULL;
+    static const OvsDb_Condition none = { 0 };
 
-    if (!rID || !config){
+    if (!ctx || !mon_cb || (!where && num_where > 0)){
         OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
         return OVS_FAILED_STATUS;
     }
 
-    OvsDbApiDebug("%s rId: %s\n", __func__, rID);
+    // no clause matches no row
+    return ovsdb_ctx_add_monitor_cond(ctx, ovsdb_table, select, where ? where : &none,
+        num_where, mon_cb, NULL, NULL, receipt_cb, monitor_id);
+}
 
-    str_json = ovsdb_insert_to_json(config, rID);
-    if (!str_json){
-        OvsDbApiError("Failed to convert GW config to JSON string.\n");
+/**
+ * Same as ovsdb_ctx_monitor_cond() but 'row_cb' is told of every kind of
+ * row change, with the whole row and the columns that changed, and a NULL
+ * 'where' monitors every row.
+**/
+OVS_STATUS ovsdb_ctx_monitor_rows(ovsdb_ctx * ctx, OVS_TABLE ovsdb_table,
+    const OvsDb_Monitor_Select * select, const OvsDb_Condition * where, size_t num_where,
+    ovsdb_row_cb row_cb, ovsdb_receipt_cb receipt_cb, char * monitor_id)
+{
+    if (!ctx || !row_cb){
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
         return OVS_FAILED_STATUS;
     }
-    OvsDbApiDebug("Successfully converted GC to JSON str: %s\n", str_json);
 
-    // Add to the receipt list before writing to socket to avoid any race condition issues
-    status = receipt_list_add(rID, OVSDB_INSERT_RECEIPT_ID,
-            (receipt_cb != NULL) ? receipt_cb : dummy_receipt_cb);
-    if(status != OVS_SUCCESS_STATUS){
-        OvsDbApiError("%s failed to add to the receipt list.\n", __func__);
-        free(str_json);
-        return status;
-    }
+    return ovsdb_ctx_add_monitor_cond(ctx, ovsdb_table, select, where, num_where, NULL,
+        row_cb, NULL, receipt_cb, monitor_id);
+}
 
-    len = strlen(str_json);
-    size = ovsdb_socket_write(ovsdb_sock_fd, str_json, len);
-    if(size < 0){
-        OvsDbApiError("Failed to write rId %s to socket.\n", rID);
-        free(str_json);
+/**
+ * Same as ovsdb_ctx_monitor_rows() but 'batch_cb' gets all the row changes
+ * of an update in one call, once the whole update has been decoded. The
+ * rows the monitor starts with come as one batch of OVSDB_SELECT_INITIAL
+ * changes.
+**/
+OVS_STATUS ovsdb_ctx_monitor_batch(ovsdb_ctx * ctx, OVS_TABLE ovsdb_table,
+    const OvsDb_Monitor_Select * select, const OvsDb_Condition * where, size_t num_where,
+    ovsdb_batch_cb batch_cb, ovsdb_receipt_cb receipt_cb, char * monitor_id)
+{
+    if (!ctx || !batch_cb){
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
         return OVS_FAILED_STATUS;
     }
 
-    free(str_json);
-    OvsDbApiInfo("%s successfully wrote %zd/%zu bytes for rId %s to socket.\n",
-        __func__, size, len, rID);
-    return status;
+    return ovsdb_ctx_add_monitor_cond(ctx, ovsdb_table, select, where, num_where, NULL,
+        NULL, batch_cb, receipt_cb, monitor_id);
 }
 
 /**
- * Send the monitor message to OVSDB and calls the callback whenever we get a response
+ * Replaces the condition of a monitor set up by ovsdb_ctx_monitor_cond().
+ * The new condition is kept for re-issuing the monitor after a reconnect,
+ * even if sending it now fails.
 **/
-OVS_STATUS ovsdb_monitor(OVS_TABLE ovsdb_table, ovsdb_mon_cb mon_cb, ovsdb_receipt_cb receipt_cb)
+OVS_STATUS ovsdb_ctx_monitor_cond_change(ovsdb_ctx * ctx, const char * monitor_id,
+    const OvsDb_Condition * where, size_t num_where, ovsdb_receipt_cb receipt_cb)
 {
-    //TODO: Implement proper unique ID, use ID generator
-    size_t len = 0;
-    ssize_t size = 0;
     OVS_STATUS status = OVS_SUCCESS_STATUS;
-    char * str_json = NULL;
-    char unique_id[MAX_UUID_LEN+1] = { 0 };
+    char cond_buf[JSON_WRITER_STACK_SIZE];
+    char buf[JSON_WRITER_STACK_SIZE];
+    json_writer cond;
+    json_writer writer;
     char rID[MAX_UUID_LEN+1] = { 0 };
+    OVS_TABLE ovsdb_table = OVS_GW_CONFIG_TABLE;
+    ovsdb_session * s = NULL;
 
-    if (!mon_cb){
-        OvsDbApiError("Provided monitor callback is NULL.\n");
+    if (!ctx || !monitor_id){
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
         return OVS_FAILED_STATUS;
     }
+    s = ovsdb_monitor_session(ctx);
 
-    snprintf(unique_id, sizeof(unique_id), "%u", id_generate());
-    snprintf(rID, sizeof(rID), "%u", id_generate());
-    OvsDbApiDebug("%s table: %d, rId: %s, Unique Id: %s\n",
-        __func__, ovsdb_table, rID, unique_id);
+    json_writer_init(&cond, cond_buf, sizeof(cond_buf));
+    json_writer_init(&writer, buf, sizeof(buf));
+    snprintf(rID, sizeof(rID), "%u", ovsdb_ctx_id_generate(ctx));
 
-    //Create the JSON string
-    str_json = ovsdb_monitor_to_json(ovsdb_table, rID, unique_id);
-    if (!str_json){
-        OvsDbApiError("%s unable to convert to JSON string.\n", __func__);
+    if (mon_list_get_table(ctx->monitors, monitor_id, &ovsdb_table) != OVS_SUCCESS_STATUS ||
+        ovsdb_where_to_json(&cond, ovsdb_table, where, num_where) != OVS_SUCCESS_STATUS ||
+        mon_list_set_where(ctx->monitors, monitor_id, cond.buf) != OVS_SUCCESS_STATUS ||
+        ovsdb_monitor_cond_change_to_json(&writer, ovsdb_table, cond.buf, monitor_id,
+            rID) != OVS_SUCCESS_STATUS){
+        OvsDbApiError("%s unable to change the condition of monitor %s.\n",
+            __func__, monitor_id);
+        json_writer_release(&cond);
+        json_writer_release(&writer);
         return OVS_FAILED_STATUS;
     }
-    OvsDbApiDebug("%s generated monitor json string: %s\n",
-        __func__, str_json);
+    json_writer_release(&cond);
 
-    status = receipt_list_add(rID, OVSDB_MONITOR_RECEIPT_ID,
-            (receipt_cb != NULL) ? receipt_cb : dummy_receipt_cb);
+    status = ovsdb_add_receipt(ctx, rID, OVSDB_MONITOR_COND_CHANGE_RECEIPT_ID,
+        (receipt_cb != NULL) ? receipt_cb : dummy_receipt_cb, s->index);
     if(status != OVS_SUCCESS_STATUS){
         OvsDbApiError("%s failed to register receipt callback.\n", __func__);
-        free(str_json);
+        json_writer_release(&writer);
         return status;
     }
 
-    status = mon_list_add(unique_id, mon_cb);
+    status = ovsdb_send(s, writer.buf, writer.len);
+    json_writer_release(&writer);
     if(status != OVS_SUCCESS_STATUS){
-        OvsDbApiError("%s failed to register monitor callback.\n", __func__);
-        free(str_json);
+        OvsDbApiError("%s failed to write to OVSDB socket, status %d.\n",
+            __func__, status);
+        (void)receipt_list_remove(ctx->receipts, rID);
         return status;
     }
 
-    //Write it to the OVSDB socket
-    len = strlen(str_json);
-    size = ovsdb_socket_write(ovsdb_sock_fd, str_json, len);
-    if(size < 0){
-        OvsDbApiError("%s failed to write to OVSDB socket.\n", __func__);
-        mon_list_remove(unique_id);
-        free(str_json);
-        return OVS_FAILED_STATUS;
-    }
-
-    free(str_json);
-    OvsDbApiInfo("%s successfully wrote %zd/%zu bytes for rId %s to socket.\n",
-        __func__, size, len, rID);
+    OvsDbApiInfo("%s successfully sent %zu bytes for rId %s.\n",
+        __func__, writer.len, rID);
     return status;
 }
 
-//TODO: Call this from the associated OvsAgentApi.c (in deinit)
-OVS_STATUS ovsdb_monitor_cancel(const char * rID, ovsdb_receipt_cb receipt_cb)
+OVS_STATUS ovsdb_ctx_monitor_cancel(ovsdb_ctx * ctx, const char * rID,
+    ovsdb_receipt_cb receipt_cb)
 {
-    size_t len = 0;
-    ssize_t size = 0;
     OVS_STATUS status = OVS_SUCCESS_STATUS;
-    char * str_json = NULL;
+    char buf[JSON_WRITER_STACK_SIZE];
+    json_writer writer;
     char new_id[MAX_UUID_LEN+1] = { 0 };
+    char group[MAX_UUID_LEN+1] = { 0 };
+    ovsdb_session * s = NULL;
 
-    if (!rID){
-        OvsDbApiError("%s cannot have NULL as rId.\n", __func__);
+    if (!ctx || !rID){
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
         return OVS_FAILED_STATUS;
     }
+    s = ovsdb_monitor_session(ctx);
+
+    if (mon_list_get_group(ctx->monitors, rID, group) == OVS_SUCCESS_STATUS){
+        return ovsdb_ctx_leave_session_monitor(ctx, rID, receipt_cb);
+    }
 
-    snprintf(new_id, sizeof(new_id), "%u", id_generate());
+    snprintf(new_id, sizeof(new_id), "%u", ovsdb_ctx_id_generate(ctx));
     OvsDbApiDebug("%s rId: %s, New Id: %s\n", __func__, rID, new_id);
 
-    str_json = ovsdb_monitor_cancel_to_json(rID, new_id);
-    if (!str_json){
+    json_writer_init(&writer, buf, sizeof(buf));
+    if (ovsdb_monitor_cancel_to_json(&writer, rID, new_id) != OVS_SUCCESS_STATUS){
         OvsDbApiError("Failed to build monitor cancel JSON string\n");
+        json_writer_release(&writer);
         return OVS_FAILED_STATUS;
     }
 
-    status = receipt_list_add(new_id, OVSDB_MONITOR_CANCEL_RECEIPT_ID, receipt_cb);
+    status = ovsdb_add_receipt(ctx, new_id, OVSDB_MONITOR_CANCEL_RECEIPT_ID,
+        receipt_cb, s->index);
     if(status != OVS_SUCCESS_STATUS){
         OvsDbApiError("Failed to add receipt_cb to receipt list.\n");
-        free(str_json);
+        json_writer_release(&writer);
         return status;
     }
 
-    len = strlen(str_json);
-    size = ovsdb_socket_write(ovsdb_sock_fd, str_json, len);
-    if(size < 0){
-        OvsDbApiError("%s failed to write JSON to socket\n", __func__);
-        free(str_json);
-        return OVS_FAILED_STATUS;
+    status = ovsdb_send(s, writer.buf, writer.len);
+    json_writer_release(&writer);
+    if(status != OVS_SUCCESS_STATUS){
+        OvsDbApiError("%s failed to write JSON to socket, status %d\n",
+            __func__, status);
+        (void)receipt_list_remove(ctx->receipts, new_id);
+        return status;
     }
 
-    status = mon_list_remove(rID);
+    status = mon_list_remove(ctx->monitors, rID);
     if(status != OVS_SUCCESS_STATUS){
         OvsDbApiError("Failed to remove node from monitor list.\n");
-        free(str_json);
         return status;
     }
 
-    free(str_json);
-    OvsDbApiInfo("%s successfully wrote %zd/%zu bytes to socket.\n", __func__,
-        size, len);
+    OvsDbApiInfo("%s successfully sent %zu bytes.\n", __func__, writer.len);
     return status;
 }
 
-OVS_STATUS ovsdb_delete(OVS_TABLE ovsdb_table, const char * key, const char * value)
+OVS_STATUS ovsdb_ctx_delete(ovsdb_ctx * ctx, OVS_TABLE ovsdb_table, const char * key,
+    const char * value)
 {
-    size_t len = 0;
-    ssize_t size = 0;
     OVS_STATUS status = OVS_SUCCESS_STATUS;
-    char * str_json = NULL;
+    char buf[JSON_WRITER_STACK_SIZE];
+    json_writer writer;
     char new_id[MAX_UUID_LEN+1] = { 0 };
+    ovsdb_session * s = NULL;
 
-    if (!key || !value)
+    if (!ctx || !key || !value)
     {
         OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
         return OVS_FAILED_STATUS;
     }
+    s = ovsdb_transact_session(ctx);
 
-    snprintf(new_id, sizeof(new_id), "%u", id_generate());
+    snprintf(new_id, sizeof(new_id), "%u", ovsdb_ctx_id_generate(ctx));
 
     OvsDbApiDebug("%s Table: %d, New Id: %s, Key: %s, Value: %s\n", __func__,
         ovsdb_table, new_id, key, value);
 
-    str_json = ovsdb_delete_to_json(ovsdb_table, new_id, key, value);
-    if (!str_json)
+    json_writer_init(&writer, buf, sizeof(buf));
+    if (ovsdb_delete_to_json(&writer, ovsdb_table, new_id, key, value) != OVS_SUCCESS_STATUS)
     {
         OvsDbApiError("%s Failed to convert GW config to JSON string.\n",
             __func__);
+        json_writer_release(&writer);
         return OVS_FAILED_STATUS;
     }
-    OvsDbApiDebug("%s Converted to JSON str: %s\n", __func__, str_json);
+    OvsDbApiDebug("%s Converted to JSON str: %s\n", __func__, writer.buf);
 
-    status = receipt_list_add(new_id, OVSDB_DELETE_RECEIPT_ID,
-        dummy_receipt_cb);
+    status = ovsdb_add_receipt(ctx, new_id, OVSDB_DELETE_RECEIPT_ID,
+        dummy_receipt_cb, s->index);
     if(status != OVS_SUCCESS_STATUS){
         OvsDbApiError("%s failed to add to the receipt list.\n", __func__);
-        free(str_json);
+        json_writer_release(&writer);
         return status;
     }
 
-    len = strlen(str_json);
-    size = ovsdb_socket_write(ovsdb_sock_fd, str_json, len);
-    if (size < 0)
+    status = ovsdb_send(s, writer.buf, writer.len);
+    json_writer_release(&writer);
+    if (status != OVS_SUCCESS_STATUS)
     {
-        OvsDbApiError("%s failed to write JSON to socket\n", __func__);
-        free(str_json);
+        OvsDbApiError("%s failed to write JSON to socket, status %d\n",
+            __func__, status);
+        (void)receipt_list_remove(ctx->receipts, new_id);
+        return status;
+    }
+
+    OvsDbApiInfo("%s successfully sent %zu bytes.\n", __func__, writer.len);
+    return status;
+}
+
+/**
+ * Limits the number of bytes that may wait in the send queue while the
+ * socket is not writable. Beyond it requests fail with OVS_BUSY_STATUS.
+**/
+OVS_STATUS ovsdb_ctx_set_send_queue_limit(ovsdb_ctx * ctx, size_t bytes)
+{
+    int i = 0;
+
+    if (!ctx || bytes == 0){
+        OvsDbApiError("%s invalid parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    for (i = 0; i < OVSDB_SESSION_COUNT; i++){
+        ovsdb_txq_set_high_water(&ctx->sessions[i].txq, bytes);
+    }
+    return OVS_SUCCESS_STATUS;
+}
+
+/**
+ * Sets how often the connections are probed with an echo request, 0
+ * disables the keepalive.
+**/
+OVS_STATUS ovsdb_ctx_set_echo_interval(ovsdb_ctx * ctx, unsigned int msecs)
+{
+    OVS_STATUS status = OVS_SUCCESS_STATUS;
+    int i = 0;
+
+    if (!ctx){
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    ctx->echo_interval = msecs;
+    for (i = 0; i < OVSDB_SESSION_COUNT; i++){
+        if (ovsdb_reactor_timer_arm(ctx->sessions[i].echo_timer, msecs, msecs) != OVS_SUCCESS_STATUS){
+            status = OVS_FAILED_STATUS;
+        }
+    }
+    return status;
+}
+
+/**
+ * Sets how long requests sent from now on wait for their response before
+ * their receipt callback gets OVS_TIMED_OUT_STATUS, 0 waits forever.
+**/
+OVS_STATUS ovsdb_ctx_set_request_timeout(ovsdb_ctx * ctx, unsigned int msecs)
+{
+    if (!ctx){
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    return receipt_list_set_timeout(ctx->receipts, msecs);
+}
+
+/**
+ * Makes the monitors of 'ctx' resume where they left off: the last
+ * transaction id seen is kept in 'path' and monitors are requested with
+ * monitor_cond_since, so after a reconnect or a restart only the rows
+ * changed in between are delivered. It applies to every monitor of 'ctx'
+ * sent from then on, the tables of the session monitor included, and
+ * their updates are update3 ones whose modifies only carry the changed
+ * columns. A monitor that caches rows resumes only once it was sent its
+ * contents in this process, its first request asks for every row. NULL
+ * turns it off. It is turned off as well when the server refuses a
+ * monitor_cond_since.
+**/
+OVS_STATUS ovsdb_ctx_set_state_file(ovsdb_ctx * ctx, const char * path)
+{
+    char * state_file = NULL;
+
+    if (!ctx){
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    if (path && (state_file = strdup(path)) == NULL){
+        OvsDbApiError("%s failed to allocate state file path.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    pthread_mutex_lock(&ctx->state_mutex);
+    free(ctx->state_file);
+    ctx->state_file = state_file;
+    ctx->state_dirty = false;
+    if (state_file){
+        ovsdb_state_load(state_file, ctx->last_txn_id, sizeof(ctx->last_txn_id));
+    }
+    pthread_mutex_unlock(&ctx->state_mutex);
+    return OVS_SUCCESS_STATUS;
+}
+
+OVS_STATUS ovsdb_ctx_get_echo_stats(ovsdb_ctx * ctx, OvsDb_Echo_Stats * stats)
+{
+    if (!ctx || !stats){
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    pthread_mutex_lock(&ctx->echo_mutex);
+    *stats = ctx->echo_stats;
+    ovsdb_rtt_window_stats(&ctx->rtt_window, stats);
+    pthread_mutex_unlock(&ctx->echo_mutex);
+    return OVS_SUCCESS_STATUS;
+}
+
+unsigned int ovsdb_ctx_id_generate(ovsdb_ctx * ctx)
+{
+    // called from API callers and the reactor thread
+    return __atomic_add_fetch(&ctx->id, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * Initialize the OVSDB Abstraction layer
+ * Must use this function before any other OVSDB APIs
+**/
+OVS_STATUS ovsdb_init(unsigned int startingId)
+{
+    if (default_ctx){
+        OvsDbApiDebug("%s already initialized\n", __func__);
+        __atomic_store_n(&default_ctx->id, startingId, __ATOMIC_RELAXED);
+        return OVS_SUCCESS_STATUS;
+    }
+
+    default_ctx = ovsdb_ctx_open(startingId, default_send_queue_limit,
+        default_echo_interval);
+    if (!default_ctx){
         return OVS_FAILED_STATUS;
     }
+    (void)ovsdb_ctx_set_request_timeout(default_ctx, default_request_timeout);
+    return default_state_file ? ovsdb_ctx_set_state_file(default_ctx, default_state_file) :
+        OVS_SUCCESS_STATUS;
+}
+
+OVS_STATUS ovsdb_deinit()
+{
+    OVS_STATUS status = OVS_SUCCESS_STATUS;
+
+    if (!default_ctx){
+        OvsDbApiDebug("%s not initialized\n", __func__);
+        return OVS_SUCCESS_STATUS;
+    }
 
-    free(str_json);
-    OvsDbApiInfo("%s successfully wrote %zd/%zu bytes to socket.\n", __func__,
-        size, len);
+    status = ovsdb_ctx_destroy(default_ctx);
+    default_ctx = NULL;
     return status;
 }
 
+OVS_STATUS ovsdb_write(const char* rID, Rdkb_Table_Config* config, ovsdb_receipt_cb receipt_cb)
+{
+    return ovsdb_ctx_write(default_ctx, rID, config, receipt_cb);
+}
+
+OVS_STATUS ovsdb_write_batch(const char* rID, Rdkb_Table_Config* configs, size_t count,
+    ovsdb_receipt_cb receipt_cb)
+{
+    return ovsdb_ctx_write_batch(default_ctx, rID, configs, count, receipt_cb);
+}
+
+OVS_STATUS ovsdb_monitor(OVS_TABLE ovsdb_table, ovsdb_mon_cb mon_cb, ovsdb_receipt_cb receipt_cb)
+{
+    return ovsdb_ctx_monitor(default_ctx, ovsdb_table, mon_cb, receipt_cb);
+}
+
+OVS_STATUS ovsdb_monitor_select(OVS_TABLE ovsdb_table, const OvsDb_Monitor_Select * select,
+    ovsdb_mon_cb mon_cb, ovsdb_receipt_cb receipt_cb)
+{
+    return ovsdb_ctx_monitor_select(default_ctx, ovsdb_table, select, mon_cb, receipt_cb);
+}
+
+OVS_STATUS ovsdb_monitor_cond(OVS_TABLE ovsdb_table, const OvsDb_Monitor_Select * select,
+    const OvsDb_Condition * where, size_t num_where, ovsdb_mon_cb mon_cb,
+    ovsdb_receipt_cb receipt_cb, char * monitor_id)
+{
+    return ovsdb_ctx_monitor_cond(default_ctx, ovsdb_table, select, where, num_where,
+        mon_cb, receipt_cb, monitor_id);
+}
+
+/**
+ * The bit of 'column' in the 'changed' mask of a row update, 0 for a
+ * column we have no field for.
+**/
+uint32_t ovsdb_column_mask(OVS_TABLE ovsdb_table, const char * column)
+{
+    const table_desc * desc = table_desc_get(ovsdb_table);
+    const table_column * found = NULL;
+
+    if (!desc || !column ||
+        (found = table_column_find(desc, column, strlen(column))) == NULL){
+        return 0;
+    }
+    return 1u << (found - desc->columns);
+}
+
+OVS_STATUS ovsdb_monitor_rows(OVS_TABLE ovsdb_table, const OvsDb_Monitor_Select * select,
+    const OvsDb_Condition * where, size_t num_where, ovsdb_row_cb row_cb,
+    ovsdb_receipt_cb receipt_cb, char * monitor_id)
+{
+    return ovsdb_ctx_monitor_rows(default_ctx, ovsdb_table, select, where, num_where,
+        row_cb, receipt_cb, monitor_id);
+}
+
+OVS_STATUS ovsdb_monitor_batch(OVS_TABLE ovsdb_table, const OvsDb_Monitor_Select * select,
+    const OvsDb_Condition * where, size_t num_where, ovsdb_batch_cb batch_cb,
+    ovsdb_receipt_cb receipt_cb, char * monitor_id)
+{
+    return ovsdb_ctx_monitor_batch(default_ctx, ovsdb_table, select, where, num_where,
+        batch_cb, receipt_cb, monitor_id);
+}
+
+OVS_STATUS ovsdb_monitor_cond_change(const char * monitor_id, const OvsDb_Condition * where,
+    size_t num_where, ovsdb_receipt_cb receipt_cb)
+{
+    return ovsdb_ctx_monitor_cond_change(default_ctx, monitor_id, where, num_where,
+        receipt_cb);
+}
+
+//TODO: Call this from the associated OvsAgentApi.c (in deinit)
+OVS_STATUS ovsdb_monitor_cancel(const char * rID, ovsdb_receipt_cb receipt_cb)
+{
+    return ovsdb_ctx_monitor_cancel(default_ctx, rID, receipt_cb);
+}
+
+OVS_STATUS ovsdb_delete(OVS_TABLE ovsdb_table, const char * key, const char * value)
+{
+    return ovsdb_ctx_delete(default_ctx, ovsdb_table, key, value);
+}
+
+/** Also applies to a later ovsdb_init() **/
+OVS_STATUS ovsdb_set_send_queue_limit(size_t bytes)
+{
+    if (bytes == 0){
+        OvsDbApiError("%s limit cannot be 0.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    default_send_queue_limit = bytes;
+    return default_ctx ? ovsdb_ctx_set_send_queue_limit(default_ctx, bytes) :
+        OVS_SUCCESS_STATUS;
+}
+
+/** Also applies to a later ovsdb_init() **/
+OVS_STATUS ovsdb_set_echo_interval(unsigned int msecs)
+{
+    default_echo_interval = msecs;
+    return default_ctx ? ovsdb_ctx_set_echo_interval(default_ctx, msecs) :
+        OVS_SUCCESS_STATUS;
+}
+
+/** Also applies to a later ovsdb_init() **/
+OVS_STATUS ovsdb_set_request_timeout(unsigned int msecs)
+{
+    default_request_timeout = msecs;
+    return default_ctx ? ovsdb_ctx_set_request_timeout(default_ctx, msecs) :
+        OVS_SUCCESS_STATUS;
+}
+
+/** Also applies to a later ovsdb_init() **/
+OVS_STATUS ovsdb_set_state_file(const char * path)
+{
+    char * state_file = NULL;
+
+    if (path && (state_file = strdup(path)) == NULL){
+        OvsDbApiError("%s failed to allocate state file path.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    free(default_state_file);
+    default_state_file = state_file;
+    return default_ctx ? ovsdb_ctx_set_state_file(default_ctx, path) :
+        OVS_SUCCESS_STATUS;
+}
+
+OVS_STATUS ovsdb_get_echo_stats(OvsDb_Echo_Stats * stats)
+{
+    return ovsdb_ctx_get_echo_stats(default_ctx, stats);
+}
+
 unsigned int id_generate()
 {
-    return ++id;
+    if (!default_ctx){
+        OvsDbApiError("%s not initialized\n", __func__);
+        return 0;
+    }
+    return ovsdb_ctx_id_generate(default_ctx);
 }
 
 /** Dummy callback used to print data when not provided by API consumer **/
@@ -19,17 +19,79 @@
 #ifndef OVSDBAPI_H
 #define OVSDBAPI_H
 
+#include <stddef.h>
 #include "OvsDbApi/OvsDbDefs.h"
 
 OVS_STATUS ovsdb_init(unsigned int startingId);
 OVS_STATUS ovsdb_deinit();
 OVS_STATUS ovsdb_write(const char* rID, Rdkb_Table_Config * table_config,
     ovsdb_receipt_cb receipt_cb);
+OVS_STATUS ovsdb_write_batch(const char* rID, Rdkb_Table_Config * table_configs,
+    size_t count, ovsdb_receipt_cb receipt_cb);
 OVS_STATUS ovsdb_monitor(OVS_TABLE ovsdb_table, ovsdb_mon_cb mon_cb,
     ovsdb_receipt_cb receipt_cb);
+OVS_STATUS ovsdb_monitor_select(OVS_TABLE ovsdb_table, const OvsDb_Monitor_Select * select,
+    ovsdb_mon_cb mon_cb, ovsdb_receipt_cb receipt_cb);
+OVS_STATUS ovsdb_monitor_cond(OVS_TABLE ovsdb_table, const OvsDb_Monitor_Select * select,
+    const OvsDb_Condition * where, size_t num_where, ovsdb_mon_cb mon_cb,
+    ovsdb_receipt_cb receipt_cb, char * monitor_id);
+OVS_STATUS ovsdb_monitor_rows(OVS_TABLE ovsdb_table, const OvsDb_Monitor_Select * select,
+    const OvsDb_Condition * where, size_t num_where, ovsdb_row_cb row_cb,
+    ovsdb_receipt_cb receipt_cb, char * monitor_id);
+OVS_STATUS ovsdb_monitor_batch(OVS_TABLE ovsdb_table, const OvsDb_Monitor_Select * select,
+    const OvsDb_Condition * where, size_t num_where, ovsdb_batch_cb batch_cb,
+    ovsdb_receipt_cb receipt_cb, char * monitor_id);
+OVS_STATUS ovsdb_monitor_cond_change(const char * monitor_id, const OvsDb_Condition * where,
+    size_t num_where, ovsdb_receipt_cb receipt_cb);
 OVS_STATUS ovsdb_monitor_cancel(const char * rID, ovsdb_receipt_cb receipt_cb);
 OVS_STATUS ovsdb_delete(OVS_TABLE ovsdb_table, const char * key,
     const char * value);
+OVS_STATUS ovsdb_set_send_queue_limit(size_t bytes);
+OVS_STATUS ovsdb_set_echo_interval(unsigned int msecs);
+OVS_STATUS ovsdb_set_request_timeout(unsigned int msecs);
+OVS_STATUS ovsdb_set_state_file(const char * path);
+OVS_STATUS ovsdb_get_echo_stats(OvsDb_Echo_Stats * stats);
 unsigned int id_generate();
+uint32_t ovsdb_column_mask(OVS_TABLE ovsdb_table, const char * column);
+
+/**
+ * An independent set of connections to OVSDB with its own request ids,
+ * pending receipts and monitors. The functions above operate on a default
+ * context created by ovsdb_init(); any number of contexts may be used side
+ * by side from different threads.
+**/
+typedef struct ovsdb_ctx ovsdb_ctx;
+
+ovsdb_ctx * ovsdb_ctx_create(unsigned int startingId);
+OVS_STATUS ovsdb_ctx_destroy(ovsdb_ctx * ctx);
+OVS_STATUS ovsdb_ctx_write(ovsdb_ctx * ctx, const char* rID,
+    Rdkb_Table_Config * table_config, ovsdb_receipt_cb receipt_cb);
+OVS_STATUS ovsdb_ctx_write_batch(ovsdb_ctx * ctx, const char* rID,
+    Rdkb_Table_Config * table_configs, size_t count, ovsdb_receipt_cb receipt_cb);
+OVS_STATUS ovsdb_ctx_monitor(ovsdb_ctx * ctx, OVS_TABLE ovsdb_table,
+    ovsdb_mon_cb mon_cb, ovsdb_receipt_cb receipt_cb);
+OVS_STATUS ovsdb_ctx_monitor_select(ovsdb_ctx * ctx, OVS_TABLE ovsdb_table,
+    const OvsDb_Monitor_Select * select, ovsdb_mon_cb mon_cb, ovsdb_receipt_cb receipt_cb);
+OVS_STATUS ovsdb_ctx_monitor_cond(ovsdb_ctx * ctx, OVS_TABLE ovsdb_table,
+    const OvsDb_Monitor_Select * select, const OvsDb_Condition * where, size_t num_where,
+    ovsdb_mon_cb mon_cb, ovsdb_receipt_cb receipt_cb, char * monitor_id);
+OVS_STATUS ovsdb_ctx_monitor_rows(ovsdb_ctx * ctx, OVS_TABLE ovsdb_table,
+    const OvsDb_Monitor_Select * select, const OvsDb_Condition * where, size_t num_where,
+    ovsdb_row_cb row_cb, ovsdb_receipt_cb receipt_cb, char * monitor_id);
+OVS_STATUS ovsdb_ctx_monitor_batch(ovsdb_ctx * ctx, OVS_TABLE ovsdb_table,
+    const OvsDb_Monitor_Select * select, const OvsDb_Condition * where, size_t num_where,
+    ovsdb_batch_cb batch_cb, ovsdb_receipt_cb receipt_cb, char * monitor_id);
+OVS_STATUS ovsdb_ctx_monitor_cond_change(ovsdb_ctx * ctx, const char * monitor_id,
+    const OvsDb_Condition * where, size_t num_where, ovsdb_receipt_cb receipt_cb);
+OVS_STATUS ovsdb_ctx_monitor_cancel(ovsdb_ctx * ctx, const char * rID,
+    ovsdb_receipt_cb receipt_cb);
+OVS_STATUS ovsdb_ctx_delete(ovsdb_ctx * ctx, OVS_TABLE ovsdb_table,
+    const char * key, const char * value);
+OVS_STATUS ovsdb_ctx_set_send_queue_limit(ovsdb_ctx * ctx, size_t bytes);
+OVS_STATUS ovsdb_ctx_set_echo_interval(ovsdb_ctx * ctx, unsigned int msecs);
+OVS_STATUS ovsdb_ctx_set_request_timeout(ovsdb_ctx * ctx, unsigned int msecs);
+OVS_STATUS ovsdb_ctx_set_state_file(ovsdb_ctx * ctx, const char * path);
+OVS_STATUS ovsdb_ctx_get_echo_stats(ovsdb_ctx * ctx, OvsDb_Echo_Stats * stats);
+unsigned int ovsdb_ctx_id_generate(ovsdb_ctx * ctx);
 
 #endif
@@ -21,6 +21,8 @@
 #define OVS_DB_DEFS_H_
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include "OvsConfig.h"
 
 #define OVSDB_DEF_DB "Open_vSwitch"
@@ -37,11 +39,16 @@ typedef enum {
     OVSDB_INSERT_RECEIPT_ID,
     OVSDB_MONITOR_RECEIPT_ID,
     OVSDB_MONITOR_CANCEL_RECEIPT_ID,
-    OVSDB_DELETE_RECEIPT_ID
+    OVSDB_DELETE_RECEIPT_ID,
+    OVSDB_ECHO_RECEIPT_ID,
+    OVSDB_MONITOR_COND_CHANGE_RECEIPT_ID,
+    OVSDB_MONITOR_COND_SINCE_RECEIPT_ID,
+    OVSDB_INSERT_BATCH_RECEIPT_ID
 } OVSDB_RECEIPT_ID;
 
 #define OVSDB_BASE_RECEIPT \
     OVSDB_RECEIPT_ID receipt_id; \
+    OVS_STATUS status; \
     char error[OVSDB_ERROR_RECEIPT_SIZE]
 
 typedef struct {
@@ -53,10 +60,30 @@ typedef struct {
     char uuid[MAX_UUID_LEN + 1];
 } OvsDb_Insert_Receipt;
 
-/** Turn this into a count, and a list of Rdkb_Table_Config? **/
+/**
+ * Response to ovsdb_write_batch(), 'uuids' has the uuids of the 'count' rows
+ * in the order they were given and is only valid during the call. OVSDB
+ * inserts all of them or none, a failed receipt has no uuids and the index
+ * of the refused operation in 'failed_row'. That is the number of rows when
+ * OVSDB refused the transaction as a whole, and -1 when it did not answer.
+**/
+typedef struct {
+    OVSDB_BASE_RECEIPT;
+    size_t count;
+    int failed_row;
+    char (*uuids)[MAX_UUID_LEN + 1];
+} OvsDb_Insert_Batch_Receipt;
+
+/**
+ * 'update_count' is the number of rows in the response to a monitor
+ * request. 'resumed' is set when a monitor_cond_since found the last
+ * transaction, the rows are then the ones changed since and have been
+ * delivered to the monitor, otherwise they are its initial contents.
+**/
 typedef struct {
     OVSDB_BASE_RECEIPT;
     int update_count;
+    bool resumed;
 } OvsDb_Monitor_Receipt;
 
 /** what should be in this struct **/
@@ -70,7 +97,83 @@ typedef struct {
     int count;
 } OvsDb_Delete_Receipt;
 
+/** Echo keepalive counters and round-trip times over the last samples **/
+typedef struct {
+    unsigned int sent;
+    unsigned int received;
+    unsigned int missed;        // echoes not answered within the interval
+    unsigned int samples;       // number of round-trip times below are based on
+    unsigned int min_usecs;
+    unsigned int p50_usecs;
+    unsigned int p90_usecs;
+    unsigned int p99_usecs;
+    unsigned int max_usecs;
+} OvsDb_Echo_Stats;
+
+/** Functions of a monitor condition clause, see RFC 7047 section 5.1 **/
+typedef enum {
+    OVSDB_COND_EQ = 0,  // ==
+    OVSDB_COND_NE,      // !=
+    OVSDB_COND_LT,      // <, integer columns only
+    OVSDB_COND_LE,      // <=
+    OVSDB_COND_GT,      // >
+    OVSDB_COND_GE,      // >=
+    OVSDB_COND_INCLUDES,
+    OVSDB_COND_EXCLUDES
+} OVSDB_COND_FUNCTION;
+
+/**
+ * One clause of a monitor condition, e.g. req_uuid == "<uuid>". A string
+ * column is compared against 'string', any other against 'integer'. A
+ * monitor delivers the rows that satisfy at least one of its clauses.
+**/
+typedef struct {
+    const char * column;
+    OVSDB_COND_FUNCTION function;
+    const char * string;
+    int integer;
+} OvsDb_Condition;
+
+/** Kinds of row updates a monitor receives, see RFC 7047 section 4.1.5 **/
+typedef enum {
+    OVSDB_SELECT_INITIAL = 1 << 0,  // rows present when the monitor is set up
+    OVSDB_SELECT_INSERT = 1 << 1,
+    OVSDB_SELECT_DELETE = 1 << 2,
+    OVSDB_SELECT_MODIFY = 1 << 3,
+    OVSDB_SELECT_ALL = 0xf
+} OVSDB_MONITOR_SELECT;
+
+/**
+ * What a monitor asks the server for, the columns it needs and an
+ * OVSDB_MONITOR_SELECT mask of the updates it wants. No columns means
+ * every column and a 0 mask every kind of update.
+**/
+typedef struct {
+    const char * const * columns;
+    size_t num_columns;
+    unsigned int updates;
+} OvsDb_Monitor_Select;
+
+/**
+ * A row change delivered to a row monitor, 'type' is one OVSDB_SELECT_*
+ * bit. 'table_config' has the whole row, the one with the changes applied
+ * for a modify and the last contents for a delete. 'changed' has the
+ * ovsdb_column_mask() bits of the columns a modify changed.
+**/
+typedef struct {
+    OVSDB_MONITOR_SELECT type;
+    uint32_t changed;
+    const char * uuid;
+    Rdkb_Table_Config * table_config;
+} OvsDb_Row_Update;
+
 typedef void (*ovsdb_receipt_cb) (const char* rID, const OvsDb_Base_Receipt* receipt_result);
 typedef ovs_interact_cb ovsdb_mon_cb;
+typedef void (*ovsdb_row_cb) (const OvsDb_Row_Update * update);
+/**
+ * The 'count' row changes of one monitor update, in the order the server
+ * sent them. 'updates' and what it points to are only valid during the call.
+**/
+typedef void (*ovsdb_batch_cb) (const OvsDb_Row_Update * updates, size_t count);
 
 #endif /* OVS_DB_DEFS_H_ */
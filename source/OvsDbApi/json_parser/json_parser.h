@@ -19,11 +19,12 @@
 #ifndef JSON_PARSER_H
 #define JSON_PARSER_H
 
-#include <jansson.h>
-#include "gateway_config.h"
-#include "feedback.h"
+#include "json_writer.h"
+#include "ovsdb_schema.h"
 
-char* gc_insert_to_json(Gateway_Config * config, const char * unique_id);
-char* fb_insert_to_json(Feedback * config, const char * unique_id);
+OVS_STATUS table_insert_op_to_json(json_writer * writer, const table_desc * desc,
+    const void * row);
+OVS_STATUS table_insert_to_json(json_writer * writer, const table_desc * desc,
+    const void * row, const char * unique_id);
 
 #endif
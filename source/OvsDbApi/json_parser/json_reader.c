@@ -0,0 +1,566 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include "common/OvsAgentLog.h"
+#include "json_reader.h"
+
+/** What may come next, checked before every token **/
+enum {
+    EXPECT_VALUE = 0,
+    EXPECT_VALUE_OR_END,        // just after '['
+    EXPECT_KEY,                 // after ',' inside an object
+    EXPECT_KEY_OR_END,          // just after '{'
+    EXPECT_COLON,
+    EXPECT_COMMA_OR_END,
+    EXPECT_DONE,
+    EXPECT_NOTHING              // a previous error, the reader is unusable
+};
+
+void json_reader_init(json_reader * reader, const char * buf, size_t len)
+{
+    memset(reader, 0, sizeof(json_reader));
+    reader->buf = buf;
+    reader->len = len;
+    reader->expect = EXPECT_VALUE;
+}
+
+static json_token_type json_reader_fail(json_reader * reader, const char * what)
+{
+    OvsDbApiError("%s %s at offset %zu.\n", __func__, what, reader->pos);
+    reader->expect = EXPECT_NOTHING;
+    return JSON_TOKEN_ERROR;
+}
+
+static void json_reader_value_done(json_reader * reader)
+{
+    reader->expect = (reader->depth == 0) ? EXPECT_DONE : EXPECT_COMMA_OR_END;
+}
+
+static json_token_type json_reader_open(json_reader * reader, json_token * token, char c)
+{
+    if (reader->depth == JSON_READER_MAX_DEPTH)
+    {
+        return json_reader_fail(reader, "nesting too deep");
+    }
+
+    reader->stack[reader->depth++] = c;
+    token->start = reader->buf + reader->pos;
+    token->len = 1;
+    reader->pos++;
+    if (c == '{')
+    {
+        reader->expect = EXPECT_KEY_OR_END;
+        return JSON_TOKEN_OBJECT_START;
+    }
+    reader->expect = EXPECT_VALUE_OR_END;
+    return JSON_TOKEN_ARRAY_START;
+}
+
+static json_token_type json_reader_close(json_reader * reader, json_token * token, char c)
+{
+    char open = (c == '}') ? '{' : '[';
+
+    if (reader->depth == 0 || reader->stack[reader->depth - 1] != open)
+    {
+        return json_reader_fail(reader, "unbalanced container");
+    }
+
+    reader->depth--;
+    token->start = reader->buf + reader->pos;
+    token->len = 1;
+    reader->pos++;
+    json_reader_value_done(reader);
+    return (c == '}') ? JSON_TOKEN_OBJECT_END : JSON_TOKEN_ARRAY_END;
+}
+
+static json_token_type json_reader_string(json_reader * reader, json_token * token)
+{
+    const char * buf = reader->buf;
+    size_t i = reader->pos + 1;
+
+    token->start = buf + i;
+    token->escaped = false;
+    while (i < reader->len && buf[i] != '"')
+    {
+        if (buf[i] == '\\')
+        {
+            token->escaped = true;
+            i++;
+        }
+        else if ((unsigned char) buf[i] < 0x20)
+        {
+            return json_reader_fail(reader, "control character in string");
+        }
+        i++;
+    }
+
+    if (i >= reader->len)
+    {
+        return json_reader_fail(reader, "unterminated string");
+    }
+
+    token->len = (size_t)(buf + i - token->start);
+    reader->pos = i + 1;
+    return JSON_TOKEN_STRING;
+}
+
+static size_t json_reader_digits(const json_reader * reader, size_t i)
+{
+    while (i < reader->len && reader->buf[i] >= '0' && reader->buf[i] <= '9')
+    {
+        i++;
+    }
+    return i;
+}
+
+static json_token_type json_reader_number(json_reader * reader, json_token * token)
+{
+    size_t i = reader->pos;
+    size_t end = 0;
+
+    if (reader->buf[i] == '-')
+    {
+        i++;
+    }
+    end = json_reader_digits(reader, i);
+    if (end == i || (reader->buf[i] == '0' && end > i + 1))
+    {
+        return json_reader_fail(reader, "invalid number");
+    }
+    i = end;
+
+    if (i < reader->len && reader->buf[i] == '.')
+    {
+        end = json_reader_digits(reader, i + 1);
+        if (end == i + 1)
+        {
+            return json_reader_fail(reader, "invalid fraction");
+        }
+        i = end;
+    }
+
+    if (i < reader->len && (reader->buf[i] == 'e' || reader->buf[i] == 'E'))
+    {
+        i++;
+        if (i < reader->len && (reader->buf[i] == '+' || reader->buf[i] == '-'))
+        {
+            i++;
+        }
+        end = json_reader_digits(reader, i);
+        if (end == i)
+        {
+            return json_reader_fail(reader, "invalid exponent");
+        }
+        i = end;
+    }
+
+    token->start = reader->buf + reader->pos;
+    token->len = i - reader->pos;
+    token->escaped = false;
+    reader->pos = i;
+    return JSON_TOKEN_NUMBER;
+}
+
+static json_token_type json_reader_literal(json_reader * reader, json_token * token,
+    const char * literal, json_token_type type)
+{
+    size_t len = strlen(literal);
+
+    if (reader->len - reader->pos < len ||
+        memcmp(reader->buf + reader->pos, literal, len) != 0)
+    {
+        return json_reader_fail(reader, "invalid literal");
+    }
+
+    token->start = reader->buf + reader->pos;
+    token->len = len;
+    token->escaped = false;
+    reader->pos += len;
+    return type;
+}
+
+static json_token_type json_reader_value(json_reader * reader, json_token * token)
+{
+    json_token_type type = JSON_TOKEN_ERROR;
+    char c = reader->buf[reader->pos];
+
+    switch (c)
+    {
+        case '{':
+        case '[':
+            return json_reader_open(reader, token, c);
+        case '"':
+            type = json_reader_string(reader, token);
+            break;
+        case 't':
+            type = json_reader_literal(reader, token, "true", JSON_TOKEN_TRUE);
+            break;
+        case 'f':
+            type = json_reader_literal(reader, token, "false", JSON_TOKEN_FALSE);
+            break;
+        case 'n':
+            type = json_reader_literal(reader, token, "null", JSON_TOKEN_NULL);
+            break;
+        default:
+            if (c == '-' || (c >= '0' && c <= '9'))
+            {
+                type = json_reader_number(reader, token);
+            }
+            else
+            {
+                return json_reader_fail(reader, "unexpected character");
+            }
+            break;
+    }
+
+    if (type != JSON_TOKEN_ERROR)
+    {
+        json_reader_value_done(reader);
+    }
+    return type;
+}
+
+json_token_type json_reader_next(json_reader * reader, json_token * token)
+{
+    char c = 0;
+
+    memset(token, 0, sizeof(json_token));
+    for (;;)
+    {
+        while (reader->pos < reader->len &&
+            (reader->buf[reader->pos] == ' ' || reader->buf[reader->pos] == '\t' ||
+             reader->buf[reader->pos] == '\r' || reader->buf[reader->pos] == '\n'))
+        {
+            reader->pos++;
+        }
+
+        if (reader->expect == EXPECT_DONE)
+        {
+            return (token->type = JSON_TOKEN_EOF);
+        }
+        if (reader->expect == EXPECT_NOTHING)
+        {
+            return (token->type = JSON_TOKEN_ERROR);
+        }
+        if (reader->pos == reader->len)
+        {
+            return (token->type = json_reader_fail(reader, "truncated input"));
+        }
+
+        c = reader->buf[reader->pos];
+        switch (reader->expect)
+        {
+            case EXPECT_COLON:
+                if (c != ':')
+                {
+                    return (token->type = json_reader_fail(reader, "expected ':'"));
+                }
+                reader->pos++;
+                reader->expect = EXPECT_VALUE;
+                continue;
+
+            case EXPECT_COMMA_OR_END:
+                if (c == ',')
+                {
+                    reader->pos++;
+                    reader->expect = (reader->stack[reader->depth - 1] == '{') ?
+                        EXPECT_KEY : EXPECT_VALUE;
+                    continue;
+                }
+                if (c == '}' || c == ']')
+                {
+                    return (token->type = json_reader_close(reader, token, c));
+                }
+                return (token->type = json_reader_fail(reader, "expected ',' or end"));
+
+            case EXPECT_KEY_OR_END:
+                if (c == '}')
+                {
+                    return (token->type = json_reader_close(reader, token, c));
+                }
+                /* fall through */
+            case EXPECT_KEY:
+                if (c != '"')
+                {
+                    return (token->type = json_reader_fail(reader, "expected a key"));
+                }
+                if (json_reader_string(reader, token) != JSON_TOKEN_STRING)
+                {
+                    return (token->type = JSON_TOKEN_ERROR);
+                }
+                reader->expect = EXPECT_COLON;
+                return (token->type = JSON_TOKEN_KEY);
+
+            case EXPECT_VALUE_OR_END:
+                if (c == ']')
+                {
+                    return (token->type = json_reader_close(reader, token, c));
+                }
+                /* fall through */
+            default:
+                return (token->type = json_reader_value(reader, token));
+        }
+    }
+}
+
+OVS_STATUS json_reader_skip(json_reader * reader, const json_token * token)
+{
+    json_token next;
+    unsigned depth = 0;
+
+    switch (token->type)
+    {
+        case JSON_TOKEN_STRING:
+        case JSON_TOKEN_NUMBER:
+        case JSON_TOKEN_TRUE:
+        case JSON_TOKEN_FALSE:
+        case JSON_TOKEN_NULL:
+            return OVS_SUCCESS_STATUS;
+        case JSON_TOKEN_OBJECT_START:
+        case JSON_TOKEN_ARRAY_START:
+            break;
+        default:
+            return OVS_FAILED_STATUS;
+    }
+
+    // the container was opened by 'token', it is done once we are back above it
+    depth = reader->depth - 1;
+    do
+    {
+        if (json_reader_next(reader, &next) == JSON_TOKEN_ERROR ||
+            next.type == JSON_TOKEN_EOF)
+        {
+            return OVS_FAILED_STATUS;
+        }
+    } while (reader->depth > depth);
+
+    return OVS_SUCCESS_STATUS;
+}
+
+/**
+ * Names are compared as they appear on the wire, OVSDB never escapes the
+ * plain ASCII used for table and column names.
+**/
+bool json_token_equals(const json_token * token, const char * str)
+{
+    size_t len = strlen(str);
+
+    return !token->escaped && token->len == len && memcmp(token->start, str, len) == 0;
+}
+
+static int json_hex_value(char c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f')
+    {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F')
+    {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+static long json_read_hex4(const char * s, const char * end)
+{
+    long value = 0;
+    int i, digit;
+
+    if (end - s < 4)
+    {
+        return -1;
+    }
+    for (i = 0; i < 4; i++)
+    {
+        if ((digit = json_hex_value(s[i])) < 0)
+        {
+            return -1;
+        }
+        value = (value << 4) | digit;
+    }
+    return value;
+}
+
+/**
+ * Decodes the \u escape at 's', including a following low surrogate.
+ * Returns the number of input characters used or 0 if invalid.
+**/
+static size_t json_read_unicode(const char * s, const char * end, long * code)
+{
+    long high = json_read_hex4(s, end);
+    long low = 0;
+
+    if (high < 0 || (high >= 0xDC00 && high <= 0xDFFF))
+    {
+        return 0;
+    }
+    if (high < 0xD800 || high > 0xDBFF)
+    {
+        *code = high;
+        return 4;
+    }
+
+    if (end - s < 10 || s[4] != '\\' || s[5] != 'u' ||
+        (low = json_read_hex4(s + 6, end)) < 0xDC00 || low > 0xDFFF)
+    {
+        return 0;
+    }
+    *code = 0x10000 + ((high - 0xD800) << 10) + (low - 0xDC00);
+    return 10;
+}
+
+static size_t json_utf8_encode(long code, char * out)
+{
+    if (code < 0x80)
+    {
+        out[0] = (char) code;
+        return 1;
+    }
+    if (code < 0x800)
+    {
+        out[0] = (char)(0xC0 | (code >> 6));
+        out[1] = (char)(0x80 | (code & 0x3F));
+        return 2;
+    }
+    if (code < 0x10000)
+    {
+        out[0] = (char)(0xE0 | (code >> 12));
+        out[1] = (char)(0x80 | ((code >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (code & 0x3F));
+        return 3;
+    }
+    out[0] = (char)(0xF0 | (code >> 18));
+    out[1] = (char)(0x80 | ((code >> 12) & 0x3F));
+    out[2] = (char)(0x80 | ((code >> 6) & 0x3F));
+    out[3] = (char)(0x80 | (code & 0x3F));
+    return 4;
+}
+
+OVS_STATUS json_token_copy(const json_token * token, char * dst, size_t size)
+{
+    const char * s = NULL;
+    const char * end = NULL;
+    char utf8[4];
+    size_t used = 0;
+    size_t n = 0;
+    long code = 0;
+
+    if (!token || !dst || size == 0 ||
+        (token->type != JSON_TOKEN_STRING && token->type != JSON_TOKEN_KEY))
+    {
+        return OVS_FAILED_STATUS;
+    }
+
+    dst[0] = '\0';
+    if (!token->escaped)
+    {
+        n = (token->len < size) ? token->len : size - 1;
+        memcpy(dst, token->start, n);
+        dst[n] = '\0';
+        return (n == token->len) ? OVS_SUCCESS_STATUS : OVS_FAILED_STATUS;
+    }
+
+    s = token->start;
+    end = token->start + token->len;
+    while (s < end)
+    {
+        if (*s != '\\')
+        {
+            utf8[0] = *s++;
+            n = 1;
+        }
+        else if (s + 1 < end && s[1] == 'u')
+        {
+            if ((n = json_read_unicode(s + 2, end, &code)) == 0 || code == 0)
+            {
+                break;
+            }
+            s += 2 + n;
+            n = json_utf8_encode(code, utf8);
+        }
+        else
+        {
+            n = 1;
+            switch ((s + 1 < end) ? s[1] : '\0')
+            {
+                case '"':  utf8[0] = '"'; break;
+                case '\\': utf8[0] = '\\'; break;
+                case '/':  utf8[0] = '/'; break;
+                case 'b':  utf8[0] = '\b'; break;
+                case 'f':  utf8[0] = '\f'; break;
+                case 'n':  utf8[0] = '\n'; break;
+                case 'r':  utf8[0] = '\r'; break;
+                case 't':  utf8[0] = '\t'; break;
+                default:
+                    n = 0;
+                    break;
+            }
+            if (n == 0)
+            {
+                break;
+            }
+            s += 2;
+        }
+
+        if (used + n >= size)
+        {   // truncated
+            dst[used] = '\0';
+            return OVS_FAILED_STATUS;
+        }
+        memcpy(dst + used, utf8, n);
+        used += n;
+    }
+
+    dst[used] = '\0';
+    return (s == end) ? OVS_SUCCESS_STATUS : OVS_FAILED_STATUS;
+}
+
+OVS_STATUS json_token_to_int(const json_token * token, int * value)
+{
+    char number[24];
+    char * end = NULL;
+    long long parsed = 0;
+
+    if (!token || !value || token->type != JSON_TOKEN_NUMBER ||
+        token->len >= sizeof(number))
+    {
+        return OVS_FAILED_STATUS;
+    }
+
+    memcpy(number, token->start, token->len);
+    number[token->len] = '\0';
+
+    errno = 0;
+    parsed = strtoll(number, &end, 10);
+    if (errno != 0 || *end != '\0' || parsed < INT_MIN || parsed > INT_MAX)
+    {
+        return OVS_FAILED_STATUS;
+    }
+
+    *value = (int) parsed;
+    return OVS_SUCCESS_STATUS;
+}
@@ -0,0 +1,90 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+
+#ifndef JSON_READER_H
+#define JSON_READER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "OvsDataTypes.h"
+
+/** Containers nested deeper than this are rejected **/
+#define JSON_READER_MAX_DEPTH 32
+
+typedef enum {
+    JSON_TOKEN_ERROR = 0,
+    JSON_TOKEN_EOF,             // the top level value is complete
+    JSON_TOKEN_OBJECT_START,
+    JSON_TOKEN_OBJECT_END,
+    JSON_TOKEN_ARRAY_START,
+    JSON_TOKEN_ARRAY_END,
+    JSON_TOKEN_KEY,             // a member name, its value is the next token
+    JSON_TOKEN_STRING,
+    JSON_TOKEN_NUMBER,
+    JSON_TOKEN_TRUE,
+    JSON_TOKEN_FALSE,
+    JSON_TOKEN_NULL
+} json_token_type;
+
+/**
+ * Points into the reader's buffer, strings are given without their quotes
+ * and with escapes left in place. Container tokens point at their bracket.
+**/
+typedef struct json_token
+{
+    json_token_type type;
+    const char * start;
+    size_t len;
+    bool escaped;               // the string contains backslash escapes
+} json_token;
+
+/**
+ * Pull tokenizer over one JSON value held in memory. It does not allocate
+ * and checks the grammar as it goes, commas and colons are consumed
+ * without being reported.
+**/
+typedef struct json_reader
+{
+    const char * buf;
+    size_t len;
+    size_t pos;
+    unsigned depth;
+    char stack[JSON_READER_MAX_DEPTH];  // '{' or '[' per open container
+    int expect;
+} json_reader;
+
+void json_reader_init(json_reader * reader, const char * buf, size_t len);
+json_token_type json_reader_next(json_reader * reader, json_token * token);
+
+/**
+ * Skips the rest of the value that 'token' starts, i.e. the whole container
+ * for an object or array start and nothing for a scalar.
+**/
+OVS_STATUS json_reader_skip(json_reader * reader, const json_token * token);
+
+bool json_token_equals(const json_token * token, const char * str);
+
+/**
+ * Copies the unescaped string into 'dst', always null terminated. Fails if
+ * the string had to be truncated or contains an invalid escape.
+**/
+OVS_STATUS json_token_copy(const json_token * token, char * dst, size_t size);
+OVS_STATUS json_token_to_int(const json_token * token, int * value);
+
+#endif
@@ -0,0 +1,224 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "common/OvsAgentLog.h"
+#include "json_writer.h"
+
+void json_writer_init(json_writer * writer, char * buf, size_t size)
+{
+    memset(writer, 0, sizeof(json_writer));
+    writer->buf = buf;
+    writer->size = size;
+    writer->failed = (buf == NULL || size == 0);
+}
+
+void json_writer_release(json_writer * writer)
+{
+    if (writer && writer->allocated)
+    {
+        free(writer->buf);
+        writer->buf = NULL;
+        writer->size = 0;
+        writer->allocated = false;
+    }
+}
+
+/**
+ * Makes room for 'need' more bytes plus the terminating null character.
+**/
+static bool json_writer_reserve(json_writer * writer, size_t need)
+{
+    size_t size = writer->size;
+    char * buf = NULL;
+
+    if (writer->failed)
+    {
+        return false;
+    }
+    if (writer->size - writer->len > need)
+    {
+        return true;
+    }
+
+    while (size - writer->len <= need)
+    {
+        size *= 2;
+    }
+
+    buf = writer->allocated ? realloc(writer->buf, size) : malloc(size);
+    if (!buf)
+    {
+        OvsDbApiError("%s failed to grow buffer to %zu bytes.\n", __func__, size);
+        writer->failed = true;
+        return false;
+    }
+
+    if (!writer->allocated)
+    {
+        memcpy(buf, writer->buf, writer->len);
+        writer->allocated = true;
+    }
+    writer->buf = buf;
+    writer->size = size;
+    return true;
+}
+
+void json_writer_raw(json_writer * writer, const char * data, size_t len)
+{
+    if (json_writer_reserve(writer, len))
+    {
+        memcpy(writer->buf + writer->len, data, len);
+        writer->len += len;
+    }
+}
+
+/**
+ * Returns the length of the UTF-8 sequence at 's', or 0 if it is invalid.
+**/
+static size_t json_utf8_length(const unsigned char * s)
+{
+    size_t len = 0;
+    size_t i;
+    unsigned long code = 0;
+
+    if (s[0] < 0x80)
+    {
+        return 1;
+    }
+    else if ((s[0] & 0xE0) == 0xC0)
+    {
+        len = 2;
+        code = s[0] & 0x1F;
+    }
+    else if ((s[0] & 0xF0) == 0xE0)
+    {
+        len = 3;
+        code = s[0] & 0x0F;
+    }
+    else if ((s[0] & 0xF8) == 0xF0)
+    {
+        len = 4;
+        code = s[0] & 0x07;
+    }
+    else
+    {
+        return 0;
+    }
+
+    for (i = 1; i < len; i++)
+    {
+        if ((s[i] & 0xC0) != 0x80)
+        {
+            return 0;
+        }
+        code = (code << 6) | (s[i] & 0x3F);
+    }
+
+    // overlong forms, surrogates and values past U+10FFFF
+    if ((len == 2 && code < 0x80) || (len == 3 && code < 0x800) ||
+        (len == 4 && code < 0x10000) || (code >= 0xD800 && code <= 0xDFFF) ||
+        code > 0x10FFFF)
+    {
+        return 0;
+    }
+    return len;
+}
+
+void json_writer_string(json_writer * writer, const char * str)
+{
+    const unsigned char * s = (const unsigned char *) str;
+    const unsigned char * run = s;
+    char escape[8];
+    size_t n = 0;
+
+    if (!str)
+    {
+        writer->failed = true;
+        return;
+    }
+
+    json_writer_literal(writer, "\"");
+    while (*s)
+    {
+        if (*s >= 0x20 && *s != '"' && *s != '\\')
+        {
+            if ((n = json_utf8_length(s)) == 0)
+            {
+                OvsDbApiError("%s invalid UTF-8 in string.\n", __func__);
+                writer->failed = true;
+                return;
+            }
+            s += n;
+            continue;
+        }
+
+        // copy the plain characters before the one that needs escaping
+        json_writer_raw(writer, (const char *) run, (size_t)(s - run));
+        switch (*s)
+        {
+            case '"':  json_writer_literal(writer, "\\\""); break;
+            case '\\': json_writer_literal(writer, "\\\\"); break;
+            case '\b': json_writer_literal(writer, "\\b"); break;
+            case '\f': json_writer_literal(writer, "\\f"); break;
+            case '\n': json_writer_literal(writer, "\\n"); break;
+            case '\r': json_writer_literal(writer, "\\r"); break;
+            case '\t': json_writer_literal(writer, "\\t"); break;
+            default:
+                n = (size_t) snprintf(escape, sizeof(escape), "\\u%04X", *s);
+                json_writer_raw(writer, escape, n);
+                break;
+        }
+        run = ++s;
+    }
+    json_writer_raw(writer, (const char *) run, (size_t)(s - run));
+    json_writer_literal(writer, "\"");
+}
+
+void json_writer_int(json_writer * writer, long long value)
+{
+    char number[24];
+    int n = snprintf(number, sizeof(number), "%lld", value);
+
+    json_writer_raw(writer, number, (size_t) n);
+}
+
+void json_writer_bool(json_writer * writer, bool value)
+{
+    if (value)
+    {
+        json_writer_literal(writer, "true");
+    }
+    else
+    {
+        json_writer_literal(writer, "false");
+    }
+}
+
+OVS_STATUS json_writer_finish(json_writer * writer)
+{
+    if (!json_writer_reserve(writer, 0))
+    {
+        return OVS_FAILED_STATUS;
+    }
+
+    writer->buf[writer->len] = '\0';
+    return OVS_SUCCESS_STATUS;
+}
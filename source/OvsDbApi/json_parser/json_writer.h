@@ -0,0 +1,67 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "OvsDataTypes.h"
+
+/** Fits any request we send, except deletes with unusually long keys **/
+#define JSON_WRITER_STACK_SIZE 1024
+
+/**
+ * Writes compact JSON text into a buffer provided by the caller, usually on
+ * its stack. Only if the text outgrows it is a larger one allocated, which
+ * json_writer_release() frees. Errors are sticky and reported by
+ * json_writer_finish().
+**/
+typedef struct json_writer
+{
+    char * buf;
+    size_t size;
+    size_t len;
+    bool allocated;     // buf is no longer the caller's buffer
+    bool failed;
+} json_writer;
+
+void json_writer_init(json_writer * writer, char * buf, size_t size);
+void json_writer_release(json_writer * writer);
+
+/** Appends text that is already JSON, e.g. a fixed part of a request **/
+void json_writer_raw(json_writer * writer, const char * data, size_t len);
+// "" text "" only compiles for a string literal, sizeof would be wrong for a pointer
+#define json_writer_literal(writer, text) \
+    json_writer_raw((writer), "" text "", sizeof(text) - 1)
+
+/**
+ * Appends 'str' as a quoted JSON string, escaped the same way as
+ * json_dumps() does. Fails for invalid UTF-8.
+**/
+void json_writer_string(json_writer * writer, const char * str);
+void json_writer_int(json_writer * writer, long long value);
+void json_writer_bool(json_writer * writer, bool value);
+
+/**
+ * Null terminates the text, which is then at writer->buf and
+ * writer->len long.
+**/
+OVS_STATUS json_writer_finish(json_writer * writer);
+
+#endif
@@ -0,0 +1,81 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+/** Generated by scripts/ovsdb_codegen.py from source/emulator/ovs.ovschema, do not edit. **/
+
+#include <stddef.h>
+#include "ovsdb_schema.h"
+
+static const table_column gateway_config_columns[] = {
+    { "if_name", 0xc4cc4380u, TABLE_COLUMN_STRING,
+      offsetof(Gateway_Config, if_name), sizeof(((Gateway_Config*)0)->if_name) },
+    { "if_type", 0x538f1103u, TABLE_COLUMN_INTEGER,
+      offsetof(Gateway_Config, if_type), sizeof(((Gateway_Config*)0)->if_type) },
+    { "if_cmd", 0x7a0ccde1u, TABLE_COLUMN_INTEGER,
+      offsetof(Gateway_Config, if_cmd), sizeof(((Gateway_Config*)0)->if_cmd) },
+    { "inet_addr", 0xcc4cbcf3u, TABLE_COLUMN_STRING,
+      offsetof(Gateway_Config, inet_addr), sizeof(((Gateway_Config*)0)->inet_addr) },
+    { "netmask", 0x09b32b30u, TABLE_COLUMN_STRING,
+      offsetof(Gateway_Config, netmask), sizeof(((Gateway_Config*)0)->netmask) },
+    { "gre_remote_inet_addr", 0xaccda93du, TABLE_COLUMN_STRING,
+      offsetof(Gateway_Config, gre_remote_inet_addr), sizeof(((Gateway_Config*)0)->gre_remote_inet_addr) },
+    { "gre_local_inet_addr", 0x867f7df4u, TABLE_COLUMN_STRING,
+      offsetof(Gateway_Config, gre_local_inet_addr), sizeof(((Gateway_Config*)0)->gre_local_inet_addr) },
+    { "parent_ifname", 0xf8db633au, TABLE_COLUMN_STRING,
+      offsetof(Gateway_Config, parent_ifname), sizeof(((Gateway_Config*)0)->parent_ifname) },
+    { "mtu", 0xce828143u, TABLE_COLUMN_INTEGER,
+      offsetof(Gateway_Config, mtu), sizeof(((Gateway_Config*)0)->mtu) },
+    { "parent_bridge", 0x3124df0fu, TABLE_COLUMN_STRING,
+      offsetof(Gateway_Config, parent_bridge), sizeof(((Gateway_Config*)0)->parent_bridge) },
+    { "vlan_id", 0xa956bbdcu, TABLE_COLUMN_INTEGER,
+      offsetof(Gateway_Config, vlan_id), sizeof(((Gateway_Config*)0)->vlan_id) }
+};
+
+static const uint8_t gateway_config_slots[16] = {
+    11, 1, 2, 0, 10, 5, 8, 0, 0, 0, 9, 6, 4, 3, 0, 7
+};
+
+static const table_column feedback_columns[] = {
+    { "req_uuid", 0xbc8e20efu, TABLE_COLUMN_STRING,
+      offsetof(Feedback, req_uuid), sizeof(((Feedback*)0)->req_uuid) },
+    { "status", 0xba4b77efu, TABLE_COLUMN_INTEGER,
+      offsetof(Feedback, status), sizeof(((Feedback*)0)->status) }
+};
+
+static const uint8_t feedback_slots[2] = {
+    1, 2
+};
+
+const table_desc ovsdb_schema_tables[OVSDB_SCHEMA_TABLE_COUNT] = {
+    { "Gateway_Config", 0x5d1bbb3cu, OVS_GW_CONFIG_TABLE, sizeof(Gateway_Config),
+      gateway_config_columns, 11, { gateway_config_slots, 0x9e377a51u, 28 },
+      "\"gre_ifname\":\"null\"," },
+    { "Feedback", 0x3055fe22u, OVS_FEEDBACK_TABLE, sizeof(Feedback),
+      feedback_columns, 2, { feedback_slots, 0x9e3779b1u, 31 },
+      NULL }
+};
+
+static const uint8_t table_slots[2] = {
+    2, 1
+};
+
+const table_name_index ovsdb_schema_table_index = { table_slots, 0x9e3779b9u, 31 };
+
+const uint8_t ovsdb_schema_table_ids[OVSDB_SCHEMA_ID_SLOTS] = {
+    1, 2
+};
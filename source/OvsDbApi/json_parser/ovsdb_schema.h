@@ -0,0 +1,44 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+/** Generated by scripts/ovsdb_codegen.py from source/emulator/ovs.ovschema, do not edit. **/
+
+#ifndef OVSDB_SCHEMA_H
+#define OVSDB_SCHEMA_H
+
+#include "OvsConfig.h"
+#include "table_desc.h"
+
+#define OVSDB_SCHEMA_VERSION     "7.12.1"
+#define OVSDB_SCHEMA_TABLE_COUNT 2
+#define OVSDB_SCHEMA_ID_SLOTS    2
+
+/** Storage for one row of any table we decode, e.g. on the stack **/
+typedef union ovsdb_table_row
+{
+    Gateway_Config gateway_config;
+    Feedback feedback;
+} ovsdb_table_row;
+
+extern const table_desc ovsdb_schema_tables[OVSDB_SCHEMA_TABLE_COUNT];
+/** Perfect hash of the table names into ovsdb_schema_tables **/
+extern const table_name_index ovsdb_schema_table_index;
+/** 1 + position in ovsdb_schema_tables by OVS_TABLE id, 0 if there is no codec **/
+extern const uint8_t ovsdb_schema_table_ids[OVSDB_SCHEMA_ID_SLOTS];
+
+#endif
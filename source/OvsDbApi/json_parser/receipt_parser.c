@@ -17,44 +17,130 @@
 */
 
 #include <jansson.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "common/OvsAgentLog.h"
 #include "OvsDbApi/OvsDbDefs.h"
 
-typedef OvsDb_Base_Receipt*(*receipt_parser)(json_t* receipt);
+typedef OvsDb_Base_Receipt*(*receipt_parser)(json_t* receipt, json_t* error);
 
-static OvsDb_Base_Receipt* insert_receipt_parser(json_t* receipt);
-static OvsDb_Base_Receipt* monitor_receipt_parser(json_t* receipt);
-static OvsDb_Base_Receipt* monitor_cancel_receipt_parser(json_t* receipt);
-static OvsDb_Base_Receipt* delete_receipt_parser(json_t* receipt);
+static OvsDb_Base_Receipt* insert_receipt_parser(json_t* receipt, json_t* error);
+static OvsDb_Base_Receipt* monitor_receipt_parser(json_t* receipt, json_t* error);
+static OvsDb_Base_Receipt* monitor_cancel_receipt_parser(json_t* receipt, json_t* error);
+static OvsDb_Base_Receipt* delete_receipt_parser(json_t* receipt, json_t* error);
+static OvsDb_Base_Receipt* echo_receipt_parser(json_t* receipt, json_t* error);
+static OvsDb_Base_Receipt* monitor_cond_change_receipt_parser(json_t* receipt, json_t* error);
+static OvsDb_Base_Receipt* monitor_cond_since_receipt_parser(json_t* receipt, json_t* error);
+static OvsDb_Base_Receipt* insert_batch_receipt_parser(json_t* receipt, json_t* error);
 
 const static receipt_parser parser_lkup_tbl[] = {
     [OVSDB_INSERT_RECEIPT_ID] = insert_receipt_parser,
     [OVSDB_MONITOR_RECEIPT_ID] = monitor_receipt_parser,
     [OVSDB_MONITOR_CANCEL_RECEIPT_ID] = monitor_cancel_receipt_parser,
-    [OVSDB_DELETE_RECEIPT_ID] = delete_receipt_parser
+    [OVSDB_DELETE_RECEIPT_ID] = delete_receipt_parser,
+    [OVSDB_ECHO_RECEIPT_ID] = echo_receipt_parser,
+    [OVSDB_MONITOR_COND_CHANGE_RECEIPT_ID] = monitor_cond_change_receipt_parser,
+    [OVSDB_MONITOR_COND_SINCE_RECEIPT_ID] = monitor_cond_since_receipt_parser,
+    [OVSDB_INSERT_BATCH_RECEIPT_ID] = insert_batch_receipt_parser
 };
 
-OvsDb_Base_Receipt* ovsdb_parse_result(OVSDB_RECEIPT_ID type, json_t* receipt)
+/**
+ * Decodes the 'receipt' of a request of type 'type'. 'error' is the error
+ * member of the response, NULL or null if there is none.
+**/
+OvsDb_Base_Receipt* ovsdb_parse_result(OVSDB_RECEIPT_ID type, json_t* receipt, json_t* error)
 {
     //TODO: Add a check to make sure type is within range
 
-    if (!receipt)
+    if (!receipt && !error)
     {
         OvsDbApiError("%s called with NULL receipt.\n", __func__);
         return NULL;
     }
 
-    return parser_lkup_tbl[type](receipt);
+    return parser_lkup_tbl[type](receipt, error);
 }
 
-static OvsDb_Base_Receipt* insert_receipt_parser(json_t* receipt)
+/**
+ * Fails 'receipt' when 'error' is set, either a string or an object such as
+ * {"error":"unknown method","details":"..."}. Returns false if it is not.
+**/
+static bool receipt_parse_error(json_t* error, OvsDb_Base_Receipt* receipt)
 {
-    if (!receipt){
+    json_t* json_error = error;
+    json_t* json_details = NULL;
+
+    if (!error || json_is_null(error))
+    {
+        return false;
+    }
+
+    if (json_is_object(error))
+    {
+        json_error = json_object_get(error, "error");
+        json_details = json_object_get(error, "details");
+    }
+    OvsDbApiError("%s request %d failed: %s %s\n", __func__, receipt->receipt_id,
+        json_is_string(json_error) ? json_string_value(json_error) : "error",
+        json_is_string(json_details) ? json_string_value(json_details) : "");
+
+    receipt->status = OVS_FAILED_STATUS;
+    snprintf(receipt->error, sizeof(receipt->error), "%s",
+        json_is_string(json_error) ? json_string_value(json_error) : "error");
+    return true;
+}
+
+/**
+ * The error a transact failed with, the JSON-RPC 'error' or else the first
+ * operation result with an "error" member, e.g. {"error":"constraint
+ * violation"}, which may also follow the results of the operations when
+ * the transaction as a whole failed. NULL if it succeeded.
+**/
+static json_t* receipt_transact_error(json_t* receipt, json_t* error)
+{
+    size_t index;
+    json_t* value;
+
+    if (error && !json_is_null(error))
+    {
+        return error;
+    }
+
+    json_array_foreach(receipt, index, value)
+    {
+        if (json_object_get(value, "error"))
+        {
+            return value;
+        }
+    }
+    return NULL;
+}
+
+static OvsDb_Base_Receipt* insert_receipt_parser(json_t* receipt, json_t* error)
+{
+    json_t* json_error = NULL;
+
+    if (!receipt && !error){
         OvsDbApiError("%s called with NULL receipt.\n", __func__);
         return NULL;
     }
 
+    if ((json_error = receipt_transact_error(receipt, error)) != NULL)
+    {
+        OvsDb_Insert_Receipt* failed_receipt = (OvsDb_Insert_Receipt*) calloc(1, sizeof(OvsDb_Insert_Receipt));
+        if (!failed_receipt)
+        {
+            OvsDbApiError("%s memory allocation failed!\n", __func__);
+            return NULL;
+        }
+
+        failed_receipt->receipt_id = OVSDB_INSERT_RECEIPT_ID;
+        (void)receipt_parse_error(json_error, (OvsDb_Base_Receipt*)failed_receipt);
+        return (OvsDb_Base_Receipt*)failed_receipt;
+    }
+
     if (json_is_array(receipt) == 0)
     {
         OvsDbApiError("%s receipt object is not an array\n", __func__);
@@ -97,9 +183,9 @@ static OvsDb_Base_Receipt* insert_receipt_parser(json_t* receipt)
     return (OvsDb_Base_Receipt*)insert_receipt;
 }
 
-static OvsDb_Base_Receipt* monitor_receipt_parser(json_t* receipt)
+static OvsDb_Base_Receipt* monitor_receipt_parser(json_t* receipt, json_t* error)
 {
-    if (!receipt)
+    if (!receipt && !error)
     {
         OvsDbApiError("%s called with NULL receipt.\n", __func__);
         return NULL;
@@ -116,10 +202,11 @@ static OvsDb_Base_Receipt* monitor_receipt_parser(json_t* receipt)
     memset(update_receipt, 0, sizeof(OvsDb_Monitor_Receipt));
     update_receipt->receipt_id = OVSDB_MONITOR_RECEIPT_ID;
     update_receipt->update_count = 0; // TODO Figure out why this is not used.
+    (void)receipt_parse_error(error, (OvsDb_Base_Receipt*)update_receipt);
     return (OvsDb_Base_Receipt*)update_receipt;
 }
 
-static OvsDb_Base_Receipt* monitor_cancel_receipt_parser(json_t* receipt)
+static OvsDb_Base_Receipt* monitor_cancel_receipt_parser(json_t* receipt, json_t* error)
 {
     if (!receipt)
     {
@@ -140,13 +227,29 @@ static OvsDb_Base_Receipt* monitor_cancel_receipt_parser(json_t* receipt)
     return (OvsDb_Base_Receipt*)mon_cancel_receipt;
 }
 
-static OvsDb_Base_Receipt* delete_receipt_parser(json_t* receipt)
+static OvsDb_Base_Receipt* delete_receipt_parser(json_t* receipt, json_t* error)
 {
-    if (!receipt){
+    json_t* json_error = NULL;
+
+    if (!receipt && !error){
         OvsDbApiError("%s called with NULL receipt.\n", __func__);
         return NULL;
     }
 
+    if ((json_error = receipt_transact_error(receipt, error)) != NULL)
+    {
+        OvsDb_Delete_Receipt* failed_receipt = (OvsDb_Delete_Receipt*) calloc(1, sizeof(OvsDb_Delete_Receipt));
+        if (!failed_receipt)
+        {
+            OvsDbApiError("%s memory allocation failed!\n", __func__);
+            return NULL;
+        }
+
+        failed_receipt->receipt_id = OVSDB_DELETE_RECEIPT_ID;
+        (void)receipt_parse_error(json_error, (OvsDb_Base_Receipt*)failed_receipt);
+        return (OvsDb_Base_Receipt*)failed_receipt;
+    }
+
     if (json_is_array(receipt) == 0)
     {
         OvsDbApiError("%s receipt object is not an array\n", __func__);
@@ -174,3 +277,143 @@ static OvsDb_Base_Receipt* delete_receipt_parser(json_t* receipt)
 
     return (OvsDb_Base_Receipt*)delete_receipt;
 }
+
+static OvsDb_Base_Receipt* echo_receipt_parser(json_t* receipt, json_t* error)
+{
+    if (!receipt){
+        OvsDbApiError("%s called with NULL receipt.\n", __func__);
+        return NULL;
+    }
+
+    // the server echoes the request's params back, nothing to look at
+    OvsDb_Base_Receipt* echo_receipt = (OvsDb_Base_Receipt*) malloc(sizeof(OvsDb_Base_Receipt));
+    if (!echo_receipt)
+    {
+        OvsDbApiError("%s memory allocation failed!\n", __func__);
+        return NULL;
+    }
+
+    memset(echo_receipt, 0, sizeof(OvsDb_Base_Receipt));
+    echo_receipt->receipt_id = OVSDB_ECHO_RECEIPT_ID;
+    return echo_receipt;
+}
+
+static OvsDb_Base_Receipt* monitor_cond_change_receipt_parser(json_t* receipt, json_t* error)
+{
+    if (!receipt){
+        OvsDbApiError("%s called with NULL receipt.\n", __func__);
+        return NULL;
+    }
+
+    // the result carries nothing, rows the new condition adds arrive as updates
+    OvsDb_Base_Receipt* change_receipt = (OvsDb_Base_Receipt*) malloc(sizeof(OvsDb_Base_Receipt));
+    if (!change_receipt)
+    {
+        OvsDbApiError("%s memory allocation failed!\n", __func__);
+        return NULL;
+    }
+
+    memset(change_receipt, 0, sizeof(OvsDb_Base_Receipt));
+    change_receipt->receipt_id = OVSDB_MONITOR_COND_CHANGE_RECEIPT_ID;
+    return change_receipt;
+}
+
+static OvsDb_Base_Receipt* monitor_cond_since_receipt_parser(json_t* receipt, json_t* error)
+{
+    if (!receipt && !error){
+        OvsDbApiError("%s called with NULL receipt.\n", __func__);
+        return NULL;
+    }
+
+    // [<found>, <last-txn-id>, <table-updates2>], the rows are only delivered
+    // by the streaming decoder
+    OvsDb_Monitor_Receipt* since_receipt = (OvsDb_Monitor_Receipt*) malloc(sizeof(OvsDb_Monitor_Receipt));
+    if (!since_receipt)
+    {
+        OvsDbApiError("%s memory allocation failed!\n", __func__);
+        return NULL;
+    }
+
+    memset(since_receipt, 0, sizeof(OvsDb_Monitor_Receipt));
+    since_receipt->receipt_id = OVSDB_MONITOR_COND_SINCE_RECEIPT_ID;
+    // e.g. "unknown method" from a server without monitor_cond_since
+    if (!receipt_parse_error(error, (OvsDb_Base_Receipt*)since_receipt))
+    {
+        since_receipt->resumed = json_is_true(json_array_get(receipt, 0));
+    }
+    return (OvsDb_Base_Receipt*)since_receipt;
+}
+
+/**
+ * One result per insert, [{"uuid":["uuid","<uuid>"]}, ...]. A refused row
+ * has {"error":...} instead and the results after it are null, an error
+ * past the last insert is about the transaction as a whole.
+**/
+static OvsDb_Base_Receipt* insert_batch_receipt_parser(json_t* receipt, json_t* error)
+{
+    OvsDb_Insert_Batch_Receipt* batch_receipt = NULL;
+    size_t count = 0;
+    size_t index;
+    json_t* value;
+
+    if (!receipt){
+        OvsDbApiError("%s called with NULL receipt.\n", __func__);
+        return NULL;
+    }
+
+    if (json_is_array(receipt) == 0)
+    {
+        OvsDbApiError("%s receipt object is not an array\n", __func__);
+        return NULL;
+    }
+
+    // the uuids are kept right behind the receipt, freed along with it
+    count = json_array_size(receipt);
+    batch_receipt = (OvsDb_Insert_Batch_Receipt*) calloc(1,
+        sizeof(OvsDb_Insert_Batch_Receipt) + count * (MAX_UUID_LEN + 1));
+    if (!batch_receipt)
+    {
+        OvsDbApiError("%s memory allocation failed!\n", __func__);
+        return NULL;
+    }
+    batch_receipt->receipt_id = OVSDB_INSERT_BATCH_RECEIPT_ID;
+    batch_receipt->status = OVS_SUCCESS_STATUS;
+    batch_receipt->failed_row = -1;
+    batch_receipt->uuids = (char (*)[MAX_UUID_LEN + 1])(batch_receipt + 1);
+
+    json_array_foreach(receipt, index, value)
+    {
+        json_t* json_error = json_object_get(value, "error");
+        json_t* json_uuid = json_object_get(value, OVSDB_TABLE_UUID);
+
+        if (json_error)
+        {
+            json_t* json_details = json_object_get(value, "details");
+
+            OvsDbApiError("%s row %zu of the batch failed: %s\n", __func__, index,
+                json_is_string(json_details) ? json_string_value(json_details) : "");
+            batch_receipt->status = OVS_FAILED_STATUS;
+            batch_receipt->failed_row = (int) index;
+            snprintf(batch_receipt->error, sizeof(batch_receipt->error), "%s",
+                json_is_string(json_error) ? json_string_value(json_error) : "error");
+            break;
+        }
+
+        if (json_is_array(json_uuid) == 0 ||
+            json_is_string(json_array_get(json_uuid, 1)) == 0)
+        {
+            OvsDbApiError("%s result %zu is not a uuid\n", __func__, index);
+            free(batch_receipt);
+            return NULL;
+        }
+        snprintf(batch_receipt->uuids[index], MAX_UUID_LEN + 1, "%s",
+            json_string_value(json_array_get(json_uuid, 1)));
+        batch_receipt->count++;
+    }
+
+    if (batch_receipt->status != OVS_SUCCESS_STATUS)
+    {   // none of the rows were inserted
+        batch_receipt->count = 0;
+    }
+    return (OvsDb_Base_Receipt*)batch_receipt;
+}
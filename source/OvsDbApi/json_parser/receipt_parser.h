@@ -22,6 +22,6 @@
 #include <jansson.h>
 #include "OvsDbApi/OvsDbDefs.h"
 
-OvsDb_Base_Receipt* ovsdb_parse_result(OVSDB_RECEIPT_ID type, json_t* result);
+OvsDb_Base_Receipt* ovsdb_parse_result(OVSDB_RECEIPT_ID type, json_t* result, json_t* error);
 
 #endif
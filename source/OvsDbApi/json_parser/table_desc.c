@@ -0,0 +1,115 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+#include <stdbool.h>
+#include <string.h>
+#include "common/OvsAgentLog.h"
+#include "ovsdb_schema.h"
+
+uint32_t table_name_hash(const char * name, size_t len)
+{
+    uint32_t hash = 0x811c9dc5u;
+    size_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        hash ^= (unsigned char) name[i];
+        hash *= 0x01000193u;
+    }
+    return hash;
+}
+
+/** Position + 1 of the only name that may hash to 'hash', 0 if there is none **/
+static uint8_t table_name_lookup(const table_name_index * index, uint32_t hash)
+{
+    return index->slots[(uint32_t)(hash * index->mult) >> index->shift];
+}
+
+static bool table_name_equals(const char * name, const char * other, size_t len)
+{
+    return strncmp(name, other, len) == 0 && name[len] == '\0';
+}
+
+const table_desc * table_desc_find(const char * table_name, size_t len)
+{
+    const table_desc * desc = NULL;
+    uint32_t hash = 0;
+    uint8_t entry = 0;
+
+    if (!table_name)
+    {
+        return NULL;
+    }
+
+    hash = table_name_hash(table_name, len);
+    if ((entry = table_name_lookup(&ovsdb_schema_table_index, hash)) != 0)
+    {
+        desc = &ovsdb_schema_tables[entry - 1];
+        if (desc->hash == hash && table_name_equals(desc->name, table_name, len))
+        {
+            return desc;
+        }
+    }
+
+    OvsDbApiError("%s unknown table %.*s\n", __func__, (int) len, table_name);
+    return NULL;
+}
+
+const table_desc * table_desc_get(OVS_TABLE table_id)
+{
+    if ((unsigned int) table_id < OVSDB_SCHEMA_ID_SLOTS &&
+        ovsdb_schema_table_ids[table_id] != 0)
+    {
+        return &ovsdb_schema_tables[ovsdb_schema_table_ids[table_id] - 1];
+    }
+
+    OvsDbApiError("%s Failed to identify config with table id %d\n",
+        __func__, table_id);
+    return NULL;
+}
+
+/**
+ * Looks up a column by the raw bytes of its name, e.g. straight from the
+ * receive buffer. The column's perfect hash slot rules out all but one
+ * candidate, the name is compared only to confirm it.
+**/
+const table_column * table_column_find(const table_desc * desc, const char * name,
+    size_t len)
+{
+    const table_column * column = NULL;
+    uint32_t hash = 0;
+    uint8_t entry = 0;
+
+    if (!desc || !name)
+    {
+        return NULL;
+    }
+
+    hash = table_name_hash(name, len);
+    if ((entry = table_name_lookup(&desc->column_index, hash)) == 0)
+    {
+        return NULL;
+    }
+
+    column = &desc->columns[entry - 1];
+    if (column->hash != hash || !table_name_equals(column->name, name, len))
+    {
+        return NULL;
+    }
+    return column;
+}
@@ -0,0 +1,77 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+#ifndef TABLE_DESC_H
+#define TABLE_DESC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "OvsDataTypes.h"
+
+typedef enum {
+    TABLE_COLUMN_STRING,
+    TABLE_COLUMN_INTEGER,
+    TABLE_COLUMN_BOOLEAN
+} table_column_type;
+
+/** Where a column's value is stored within the table's struct **/
+typedef struct table_column
+{
+    const char * name;
+    uint32_t hash;              // table_name_hash() of name
+    table_column_type type;
+    size_t offset;
+    size_t size;
+} table_column;
+
+/**
+ * Perfect hash of a set of names: the name hashing to 'hash' can only be
+ * the one in slots[(hash * mult) >> shift], stored as 1 + its position,
+ * slots that no name maps to hold 0.
+**/
+typedef struct table_name_index
+{
+    const uint8_t * slots;
+    uint32_t mult;
+    uint32_t shift;
+} table_name_index;
+
+/**
+ * A table of the OVSDB schema that has a struct in the public API. The
+ * descriptors are generated from the schema, see ovsdb_schema.c.
+**/
+typedef struct table_desc
+{
+    const char * name;
+    uint32_t hash;              // table_name_hash() of name
+    OVS_TABLE id;
+    size_t row_size;
+    const table_column * columns;
+    size_t num_columns;
+    table_name_index column_index;
+    const char * insert_prefix;  // fixed members written ahead of the columns on insert
+} table_desc;
+
+/** 32 bit FNV-1a, the generator precomputes it for every column name **/
+uint32_t table_name_hash(const char * name, size_t len);
+
+const table_desc * table_desc_find(const char * table_name, size_t len);
+const table_desc * table_desc_get(OVS_TABLE table_id);
+const table_column * table_column_find(const table_desc * desc, const char * name,
+    size_t len);
+
+#endif
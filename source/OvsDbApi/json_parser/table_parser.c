@@ -16,19 +16,68 @@
 * SPDX-License-Identifier: Apache-2.0
 */
 
+#include <stdbool.h>
 #include <string.h>
 #include <jansson.h>
 #include "common/OvsAgentLog.h"
 #include "OvsDbApi/OvsDbDefs.h"
 #include "table_parser.h"
 
-static const char * json_fetch_string (json_t * root, const char *key);
-static OVS_STATUS gateway_config_parser(json_t * json, Rdkb_Table_Config* table_config);
-static OVS_STATUS feedback_config_parser(json_t * json, Rdkb_Table_Config* table_config);
+/**
+ * Stores a value into a column, one setter per table_column_type. Values
+ * of another type, e.g. the empty set ["set",[]] of an optional column,
+ * leave the column zeroed.
+**/
+typedef void (*json_column_setter)(const table_column * column, json_t * value,
+    void * row);
+typedef OVS_STATUS (*token_column_setter)(const table_column * column,
+    json_reader * reader, const json_token * token, void * row);
+
+static void table_column_set_integer(const table_column * column, void * row, int value)
+{
+    // the integer columns are ints or enums, which are int sized
+    memcpy((char*) row + column->offset, &value, sizeof(int));
+}
+
+static void table_column_set_boolean(const table_column * column, void * row, bool value)
+{
+    memcpy((char*) row + column->offset, &value, sizeof(bool));
+}
+
+static void json_set_string(const table_column * column, json_t * value, void * row)
+{
+    char * dst = (char*) row + column->offset;
+
+    if (json_is_string(value))
+    {
+        strncpy(dst, json_string_value(value), column->size - 1);
+        dst[column->size - 1] = '\0';
+    }
+}
+
+static void json_set_integer(const table_column * column, json_t * value, void * row)
+{
+    table_column_set_integer(column, row, (int) json_integer_value(value));
+}
+
+static void json_set_boolean(const table_column * column, json_t * value, void * row)
+{
+    table_column_set_boolean(column, row, json_is_true(value));
+}
+
+static const json_column_setter json_column_setters[] = {
+    [TABLE_COLUMN_STRING] = json_set_string,
+    [TABLE_COLUMN_INTEGER] = json_set_integer,
+    [TABLE_COLUMN_BOOLEAN] = json_set_boolean
+};
 
 OVS_STATUS parse_table(const char * table_name, json_t* update, Rdkb_Table_Config* table_config)
 {
-    OVS_STATUS status = OVS_FAILED_STATUS;
+    const table_desc * desc = NULL;
+    const table_column * column = NULL;
+    const char * key = NULL;
+    json_t * value = NULL;
+    void * row = NULL;
     char* str_json = NULL;
 
     if (!table_name || !update || !table_config)
@@ -41,145 +90,293 @@ OVS_STATUS parse_table(const char * table_name, json_t* update, Rdkb_Table_Confi
     OvsDbApiDebug("%s: table_name: %s, update: %s\n", __func__, table_name, str_json);
     free(str_json);
 
-    /** TODO: Replace this later with some kind of table, try hsearch **/
-    if (strcmp(table_name, GATEWAY_CONFIG_TABLE_NAME) == 0)
+    if ((desc = table_desc_find(table_name, strlen(table_name))) == NULL)
     {
-        status = gateway_config_parser(update, table_config);
+        return OVS_FAILED_STATUS;
     }
-    else if (strcmp(table_name, FEEDBACK_TABLE_NAME) == 0)
+
+    row = calloc(1, desc->row_size);
+    if (!row)
     {
-        status = feedback_config_parser(update, table_config);
+        OvsDbApiError("%s memory allocation failed!\n", __func__);
+        return OVS_FAILED_STATUS;
     }
 
-    return status;
+    // columns we have no field for, e.g. _version, are skipped
+    json_object_foreach(update, key, value)
+    {
+        if ((column = table_column_find(desc, key, strlen(key))) != NULL)
+        {
+            json_column_setters[column->type](column, value, row);
+        }
+    }
+
+    table_config->table.id = desc->id;
+    table_config->config = row;
+
+    return OVS_SUCCESS_STATUS;
 }
 
-static OVS_STATUS gateway_config_parser(json_t * json, Rdkb_Table_Config* table_config)
+static OVS_STATUS token_set_string(const table_column * column, json_reader * reader,
+    const json_token * token, void * row)
 {
-    //TODO: Add checks on returns
-    if (!json)
+    if (token->type != JSON_TOKEN_STRING)
     {
-        OvsDbApiError("%s error!\n", __func__);
-        return OVS_FAILED_STATUS;
+        return json_reader_skip(reader, token);
     }
 
-    Gateway_Config* config = malloc(sizeof(Gateway_Config));
-    if (!config)
+    if (json_token_copy(token, (char*) row + column->offset, column->size) != OVS_SUCCESS_STATUS)
     {
-        OvsDbApiError("%s memory allocation failed!\n", __func__);
-        return OVS_FAILED_STATUS;
+        OvsDbApiWarning("%s value of column %s was truncated.\n", __func__, column->name);
+    }
+    return OVS_SUCCESS_STATUS;
+}
+
+static OVS_STATUS token_set_integer(const table_column * column, json_reader * reader,
+    const json_token * token, void * row)
+{
+    int value = 0;
+
+    if (token->type != JSON_TOKEN_NUMBER)
+    {
+        return json_reader_skip(reader, token);
+    }
+
+    if (json_token_to_int(token, &value) == OVS_SUCCESS_STATUS)
+    {
+        table_column_set_integer(column, row, value);
     }
-    memset(config, 0, sizeof(Gateway_Config));
+    return OVS_SUCCESS_STATUS;
+}
 
-    const char * if_name = json_fetch_string (json, "if_name");
-    if (if_name)
+static OVS_STATUS token_set_boolean(const table_column * column, json_reader * reader,
+    const json_token * token, void * row)
+{
+    if (token->type != JSON_TOKEN_TRUE && token->type != JSON_TOKEN_FALSE)
     {
-        strncpy(config->if_name, if_name, sizeof(config->if_name)-1);
-        config->if_name[ sizeof(config->if_name)-1 ] = '\0';
+        return json_reader_skip(reader, token);
     }
 
-    config->if_type = (int) json_integer_value (json_object_get (json, "if_type"));
-    config->if_cmd = (int) json_integer_value (json_object_get (json, "if_cmd"));
+    table_column_set_boolean(column, row, token->type == JSON_TOKEN_TRUE);
+    return OVS_SUCCESS_STATUS;
+}
+
+static const token_column_setter token_column_setters[] = {
+    [TABLE_COLUMN_STRING] = token_set_string,
+    [TABLE_COLUMN_INTEGER] = token_set_integer,
+    [TABLE_COLUMN_BOOLEAN] = token_set_boolean
+};
 
-    const char * inet_addr = json_fetch_string (json, "inet_addr");
-    if (inet_addr)
+OVS_STATUS parse_table_row(const char * table_name, json_reader* reader,
+    const json_token* token, ovsdb_table_row* row, Rdkb_Table_Config* table_config)
+{
+    const table_desc * desc = NULL;
+    const table_column * column = NULL;
+    json_token key;
+    json_token value;
+
+    if (!table_name || !reader || !token || !row || !table_config)
     {
-        strncpy(config->inet_addr, inet_addr, sizeof(config->inet_addr)-1);
-        config->inet_addr[ sizeof(config->inet_addr) -1 ] = '\0';
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
     }
 
-    const char * netmask = json_fetch_string (json, "netmask");
-    if (netmask)
+    if ((desc = table_desc_find(table_name, strlen(table_name))) == NULL)
     {
-        strncpy(config->netmask, netmask, sizeof(config->netmask)-1);
-        config->netmask[ sizeof(config->netmask)-1 ] = '\0';
+        return OVS_FAILED_STATUS;
     }
 
-    const char * gre_remote_inet_addr = json_fetch_string (json, "gre_remote_inet_addr");
-    if (gre_remote_inet_addr)
+    if (token->type != JSON_TOKEN_OBJECT_START)
     {
-        strncpy(config->gre_remote_inet_addr, gre_remote_inet_addr, sizeof(config->gre_remote_inet_addr)-1);
-        config->gre_remote_inet_addr[ sizeof(config->gre_remote_inet_addr)-1 ] = '\0';
+        OvsDbApiError("%s row of table %s is not an object.\n", __func__, table_name);
+        return OVS_FAILED_STATUS;
     }
 
-    const char * gre_local_inet_addr = json_fetch_string (json, "gre_local_inet_addr");
-    if (gre_local_inet_addr)
+    memset(row, 0, sizeof(ovsdb_table_row));
+    while (json_reader_next(reader, &key) == JSON_TOKEN_KEY)
     {
-        strncpy(config->gre_local_inet_addr, gre_local_inet_addr, sizeof(config->gre_local_inet_addr)-1);
-        config->gre_local_inet_addr[ sizeof(config->gre_local_inet_addr)-1 ] = '\0';
+        if (json_reader_next(reader, &value) == JSON_TOKEN_ERROR)
+        {
+            return OVS_FAILED_STATUS;
+        }
+
+        // columns we have no field for, e.g. _version, are skipped
+        column = key.escaped ? NULL : table_column_find(desc, key.start, key.len);
+        if ((column ? token_column_setters[column->type](column, reader, &value, row) :
+            json_reader_skip(reader, &value)) != OVS_SUCCESS_STATUS)
+        {
+            return OVS_FAILED_STATUS;
+        }
     }
 
-    const char * parent_ifname = json_fetch_string (json, "parent_ifname");
-    if (parent_ifname)
+    if (key.type != JSON_TOKEN_OBJECT_END)
     {
-        strncpy(config->parent_ifname, parent_ifname, sizeof(config->parent_ifname)-1);
-        config->parent_ifname[ sizeof(config->parent_ifname) -1 ] = '\0';
+        return OVS_FAILED_STATUS;
     }
 
-    config->mtu = (int) json_integer_value (json_object_get (json, "mtu"));
+    table_config->table.id = desc->id;
+    table_config->config = row;
+    return OVS_SUCCESS_STATUS;
+}
 
-    const char * parent_bridge = json_fetch_string (json, "parent_bridge");
-    if (parent_bridge)
+static bool table_column_equals(const table_column * column, const char * a, const char * b)
+{
+    if (column->type == TABLE_COLUMN_STRING)
     {
-        strncpy(config->parent_bridge, parent_bridge, sizeof(config->parent_bridge)-1);
-        config->parent_bridge[ sizeof(config->parent_bridge)-1 ] = '\0';
+        return strncmp(a, b, column->size) == 0;
     }
+    return memcmp(a, b, column->size) == 0;
+}
 
-    config->vlan_id = (int) json_integer_value (json_object_get (json, "vlan_id"));
+/**
+ * Reads the value of a column of a "modify" into 'delta'. A set,
+ * ["set",[<a>,<b>]], is what was added to and removed from an optional
+ * column, sets of other columns are not decoded.
+**/
+static OVS_STATUS parse_delta_column(const table_column * column, uint32_t bit,
+    json_reader * reader, const json_token * token, ovsdb_row_delta * delta)
+{
+    ovsdb_table_row * values[] = { &delta->first, &delta->second };
+    json_token value;
+    size_t count = 0;
 
-    table_config->table.id = OVS_GW_CONFIG_TABLE;
-    table_config->config = (void*) config;
+    delta->present |= bit;
+    if (token->type != JSON_TOKEN_ARRAY_START)
+    {
+        return token_column_setters[column->type](column, reader, token, &delta->first);
+    }
 
-    return OVS_SUCCESS_STATUS;
+    if (json_reader_next(reader, &value) != JSON_TOKEN_STRING ||
+        !json_token_equals(&value, "set") ||
+        json_reader_next(reader, &value) != JSON_TOKEN_ARRAY_START)
+    {
+        OvsDbApiError("%s value of column %s is not a set.\n", __func__, column->name);
+        return OVS_FAILED_STATUS;
+    }
+
+    while (json_reader_next(reader, &value) != JSON_TOKEN_ARRAY_END)
+    {
+        if (value.type == JSON_TOKEN_ERROR || count == 2)
+        {
+            OvsDbApiError("%s invalid set in column %s.\n", __func__, column->name);
+            return OVS_FAILED_STATUS;
+        }
+        if (token_column_setters[column->type](column, reader, &value,
+            values[count++]) != OVS_SUCCESS_STATUS)
+        {
+            return OVS_FAILED_STATUS;
+        }
+    }
+
+    if (count == 2)
+    {
+        delta->pairs |= bit;
+    }
+    return (json_reader_next(reader, &value) == JSON_TOKEN_ARRAY_END) ?
+        OVS_SUCCESS_STATUS : OVS_FAILED_STATUS;
 }
 
-static OVS_STATUS feedback_config_parser(json_t * json, Rdkb_Table_Config* table_config){
+OVS_STATUS parse_table_delta(const table_desc * desc, json_reader* reader,
+    const json_token* token, ovsdb_row_delta* delta)
+{
+    const table_column * column = NULL;
+    json_token key;
+    json_token value;
 
-    if (!json)
+    if (!desc || !reader || !token || !delta)
     {
-        OvsDbApiError("%s error!\n", __func__);
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
         return OVS_FAILED_STATUS;
     }
 
-    Feedback* feedback = malloc(sizeof(Feedback));
-    if (!feedback)
+    if (token->type != JSON_TOKEN_OBJECT_START)
     {
-        OvsDbApiError("%s memory allocation failed!\n", __func__);
+        OvsDbApiError("%s delta of table %s is not an object.\n", __func__, desc->name);
         return OVS_FAILED_STATUS;
     }
-    memset(feedback->req_uuid, 0, sizeof(feedback->req_uuid));
 
-    const char * req_uuid = json_fetch_string(json, "req_uuid");
-    if (req_uuid)
+    memset(delta, 0, sizeof(ovsdb_row_delta));
+    while (json_reader_next(reader, &key) == JSON_TOKEN_KEY)
     {
-        strncpy(feedback->req_uuid, req_uuid, sizeof(feedback->req_uuid)-1);
-        feedback->req_uuid[ sizeof(feedback->req_uuid)-1 ] = '\0';
+        if (json_reader_next(reader, &value) == JSON_TOKEN_ERROR)
+        {
+            return OVS_FAILED_STATUS;
+        }
+
+        column = key.escaped ? NULL : table_column_find(desc, key.start, key.len);
+        if ((column ? parse_delta_column(column, 1u << (column - desc->columns), reader,
+            &value, delta) : json_reader_skip(reader, &value)) != OVS_SUCCESS_STATUS)
+        {
+            return OVS_FAILED_STATUS;
+        }
     }
 
-    feedback->status = (int) json_integer_value(json_object_get(json, "status"));
+    return (key.type == JSON_TOKEN_OBJECT_END) ? OVS_SUCCESS_STATUS : OVS_FAILED_STATUS;
+}
 
-    table_config->table.id = OVS_FEEDBACK_TABLE;
-    table_config->config = feedback;
+uint32_t apply_table_delta(const table_desc * desc, ovsdb_table_row* row,
+    const ovsdb_row_delta* delta)
+{
+    const table_column * column = NULL;
+    const char * value = NULL;
+    char * current = NULL;
+    uint32_t bit = 0;
+    size_t i;
 
-    return OVS_SUCCESS_STATUS;
+    if (!desc || !row || !delta)
+    {
+        return 0;
+    }
+
+    for (i = 0; i < desc->num_columns; i++)
+    {
+        bit = 1u << i;
+        if (!(delta->present & bit))
+        {
+            continue;
+        }
+
+        column = &desc->columns[i];
+        current = (char*) row + column->offset;
+        value = (const char*) &delta->first + column->offset;
+        if (table_column_equals(column, value, current))
+        {   // the old value of a pair, or the value removed from an optional column
+            value = (delta->pairs & bit) ?
+                (const char*) &delta->second + column->offset : NULL;
+        }
+
+        if (value)
+        {
+            memcpy(current, value, column->size);
+        }
+        else
+        {
+            memset(current, 0, column->size);
+        }
+    }
+    return delta->present;
 }
 
-static const char * json_fetch_string(json_t * root, const char *key)
+uint32_t table_row_changes(const table_desc * desc, const ovsdb_table_row* old,
+    const ovsdb_table_row* row)
 {
-    json_t *obj = NULL;
+    const table_column * column = NULL;
+    uint32_t changed = 0;
+    size_t i;
 
-    if (!root || !key)
+    if (!desc || !old || !row)
     {
-        OvsDbApiError("%s error for key %s!\n", __func__, key);
-        return NULL;
+        return 0;
     }
 
-    obj = json_object_get (root, key);
-    if (!obj)
+    for (i = 0; i < desc->num_columns; i++)
     {
-        OvsDbApiError("%s Error fetching %s\n", __func__, key);
-        return NULL;
+        column = &desc->columns[i];
+        if (!table_column_equals(column, (const char*) old + column->offset,
+            (const char*) row + column->offset))
+        {
+            changed |= 1u << i;
+        }
     }
-
-    return json_string_value (obj);
+    return changed;
 }
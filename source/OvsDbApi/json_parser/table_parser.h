@@ -21,7 +21,51 @@
 
 #include <jansson.h>
 #include "OvsDbApi/OvsDbDefs.h"
+#include "json_reader.h"
+#include "ovsdb_schema.h"
+
+/**
+ * The columns of an update2 "modify", bit i of 'present' and 'pairs' is
+ * column i of the table's descriptor. A column holds its new value in
+ * 'first', except for an optional column which holds the values added to
+ * and removed from it: one in 'first', or when its bit in 'pairs' is set
+ * the old and the new one in 'first' and 'second'.
+**/
+typedef struct ovsdb_row_delta
+{
+    ovsdb_table_row first;
+    ovsdb_table_row second;
+    uint32_t present;
+    uint32_t pairs;
+} ovsdb_row_delta;
 
 OVS_STATUS parse_table(const char * table_name, json_t* update, Rdkb_Table_Config* table_config);
 
+/**
+ * Decodes the row object whose start 'token' was just read from 'reader'
+ * into 'row', without allocating. On success 'table_config' is set to the
+ * table's id and points to 'row'.
+**/
+OVS_STATUS parse_table_row(const char * table_name, json_reader* reader,
+    const json_token* token, ovsdb_table_row* row, Rdkb_Table_Config* table_config);
+
+/**
+ * Decodes the "modify" object whose start 'token' was just read from
+ * 'reader' into 'delta'. The "old" object of an update is read the same
+ * way, its columns are then the ones that changed.
+**/
+OVS_STATUS parse_table_delta(const table_desc * desc, json_reader* reader,
+    const json_token* token, ovsdb_row_delta* delta);
+
+/**
+ * Applies 'delta' to 'row', a complete row of table 'desc', and returns
+ * the bits of the columns that changed.
+**/
+uint32_t apply_table_delta(const table_desc * desc, ovsdb_table_row* row,
+    const ovsdb_row_delta* delta);
+
+/** The bits of the columns of table 'desc' that differ between 'old' and 'row' **/
+uint32_t table_row_changes(const table_desc * desc, const ovsdb_table_row* old,
+    const ovsdb_table_row* row);
+
 #endif
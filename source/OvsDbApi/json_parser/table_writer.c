@@ -0,0 +1,109 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+#include <stdbool.h>
+#include <string.h>
+#include "OvsDbApi/OvsDbDefs.h"
+#include "common/OvsAgentLog.h"
+#include "json_parser.h"
+
+static void table_column_to_json(json_writer * writer, const table_column * column,
+    const void * row)
+{
+    const char * value = (const char*) row + column->offset;
+    int integer = 0;
+    bool boolean = false;
+
+    switch (column->type)
+    {
+        case TABLE_COLUMN_STRING:
+            json_writer_string(writer, value);
+            break;
+
+        case TABLE_COLUMN_INTEGER:
+            memcpy(&integer, value, sizeof(int));
+            json_writer_int(writer, integer);
+            break;
+
+        case TABLE_COLUMN_BOOLEAN:
+            memcpy(&boolean, value, sizeof(bool));
+            json_writer_bool(writer, boolean);
+            break;
+    }
+}
+
+/**
+ * Writes the insert operation of 'row', a struct of the table described by
+ * 'desc', with every column of the descriptor in schema order.
+**/
+OVS_STATUS table_insert_op_to_json(json_writer * writer, const table_desc * desc,
+    const void * row)
+{
+    size_t i;
+
+    if (!writer || !desc || !row)
+    {
+        OvsDbApiError("%s Unable to create JSON string due to incomplete parameters.\n",
+            __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    json_writer_literal(writer, "{\"op\":\"insert\",\"table\":");
+    json_writer_string(writer, desc->name);
+    json_writer_literal(writer, ",\"row\":{");
+    if (desc->insert_prefix)
+    {
+        json_writer_raw(writer, desc->insert_prefix, strlen(desc->insert_prefix));
+    }
+
+    for (i = 0; i < desc->num_columns; i++)
+    {
+        if (i > 0)
+        {
+            json_writer_literal(writer, ",");
+        }
+        json_writer_string(writer, desc->columns[i].name);
+        json_writer_literal(writer, ":");
+        table_column_to_json(writer, &desc->columns[i], row);
+    }
+    json_writer_literal(writer, "}}");
+    return OVS_SUCCESS_STATUS;
+}
+
+/** Writes the transact request inserting 'row', see table_insert_op_to_json() **/
+OVS_STATUS table_insert_to_json(json_writer * writer, const table_desc * desc,
+    const void * row, const char * unique_id)
+{
+    if (!writer || !unique_id)
+    {
+        OvsDbApiError("%s Unable to create JSON string due to incomplete parameters.\n",
+            __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    json_writer_literal(writer, "{\"method\":\"transact\",\"id\":");
+    json_writer_string(writer, unique_id);
+    json_writer_literal(writer, ",\"params\":[\"" OVSDB_DEF_DB "\",");
+    if (table_insert_op_to_json(writer, desc, row) != OVS_SUCCESS_STATUS)
+    {
+        return OVS_FAILED_STATUS;
+    }
+    json_writer_literal(writer, "]}");
+
+    return json_writer_finish(writer);
+}
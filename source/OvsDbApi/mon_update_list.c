@@ -19,24 +19,243 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <pthread.h>
 #include "OvsDbApi/mon_update_list.h"
 #include "OvsDbApi/OvsDbDefs.h"
+#include "OvsDbApi/row_cache.h"
 #include "common/OvsAgentLog.h"
 
+/** A row held for a batch callback, its update points into it once handed over **/
+typedef struct mon_batch_row
+{
+    OvsAgent_Table_Config table_config;
+    ovsdb_table_row row;
+} mon_batch_row;
+
+/** Rows of one update, 'updates' and 'rows' are parallel arrays **/
+typedef struct mon_batch
+{
+    OvsDb_Row_Update* updates;
+    mon_batch_row* rows;
+    size_t count;
+    size_t capacity;
+} mon_batch;
+
+/** Where a monitor is in re-syncing a cache that missed a row **/
+typedef enum
+{
+    MON_RESYNC_NONE,
+    MON_RESYNC_WANTED,               //to be re-issued once the update is decoded
+    MON_RESYNC_REQUESTED             //re-issued, waiting for its contents
+} mon_resync;
+
 //TODO: Update later to hash table?
-//TODO: Add cleanup to all of this in deinit
 typedef struct mon_node_t
 {
     char uuid[MAX_UUID_LEN+1];       //Unique ID to identify messages
+    char rid[MAX_UUID_LEN+1];        //Request that set the monitor up, answered with its rows
+    char group[MAX_UUID_LEN+1];      //Session monitor the table is part of, empty for its own
+    OVS_TABLE table;                 //Monitored table, used to re-issue the monitor
+    char* select;                    //Encoded columns and updates asked for, or NULL for all
+    char* where;                     //Encoded condition of a conditional monitor, or NULL
+    unsigned int updates;            //OVSDB_MONITOR_SELECT mask of the changes told to the callbacks
     ovsdb_mon_cb callback;           //Callback to invoke when message is found
+    ovsdb_row_cb row_callback;       //Callback for every kind of row change, or NULL
+    ovsdb_batch_cb batch_callback;   //Callback for the rows of each update, or NULL
+    row_cache* rows;                 //Rows seen, if the monitor sees them deleted
+    bool synced;                     //Whether 'rows' holds the contents sent in this process
+    mon_resync resync;               //Whether the monitor is re-issued to fill 'rows' again
+    row_cache* stale_rows;           //Rows before a re-sync, to tell what changed meanwhile
+    mon_batch batch;                 //Rows of the update being decoded, for batch_callback
     struct mon_node_t* next;         //Next in the list
 } mon_node_t;
 
-static mon_node_t* msg_list = NULL;
+struct mon_list
+{
+    pthread_mutex_t mutex;
+    mon_node_t* head;
+};
+
+mon_list* mon_list_create()
+{
+    mon_list* list = calloc(1, sizeof(mon_list));
+
+    if (!list)
+    {
+        OvsDbApiError("%s failed to allocate monitor list.\n", __func__);
+        return NULL;
+    }
+
+    pthread_mutex_init(&list->mutex, NULL);
+    return list;
+}
+
+void mon_list_destroy(mon_list* list)
+{
+    if (!list)
+    {
+        return;
+    }
+
+    (void)mon_list_clear(list);
+    pthread_mutex_destroy(&list->mutex);
+    free(list);
+}
+
+static void mon_batch_free(mon_batch* batch)
+{
+    free(batch->updates);
+    free(batch->rows);
+    memset(batch, 0, sizeof(mon_batch));
+}
+
+/** Appends a row to 'batch', 'row' NULL for one whose contents are unknown **/
+static OVS_STATUS mon_batch_add(mon_batch* batch, const table_desc* desc,
+    const OvsDb_Row_Update* update, const ovsdb_table_row* row)
+{
+    OvsDb_Row_Update* updates = NULL;
+    mon_batch_row* rows = NULL;
+    size_t capacity = 0;
+
+    if (batch->count == batch->capacity)
+    {
+        capacity = batch->capacity ? batch->capacity * 2 : 16;
+        if ((updates = realloc(batch->updates, capacity * sizeof(*updates))) == NULL)
+        {
+            return OVS_FAILED_STATUS;
+        }
+        batch->updates = updates;
+        if ((rows = realloc(batch->rows, capacity * sizeof(*rows))) == NULL)
+        {
+            return OVS_FAILED_STATUS;
+        }
+        batch->rows = rows;
+        batch->capacity = capacity;
+    }
+
+    // the pointers are set when the batch is handed over, the arrays may still move
+    memcpy(&batch->updates[batch->count], update, sizeof(OvsDb_Row_Update));
+    memset(&batch->rows[batch->count], 0, sizeof(mon_batch_row));
+    batch->rows[batch->count].table_config.table.id = desc->id;
+    snprintf(batch->rows[batch->count].table_config.uuid,
+        sizeof(batch->rows[batch->count].table_config.uuid), "%s", update->uuid);
+    if (row)
+    {
+        memcpy(&batch->rows[batch->count].row, row, sizeof(ovsdb_table_row));
+    }
+    batch->count++;
+    return OVS_SUCCESS_STATUS;
+}
+
+static void mon_node_free(mon_node_t* node)
+{
+    mon_batch_free(&node->batch);
+    row_cache_destroy(node->rows);
+    row_cache_destroy(node->stale_rows);
+    free(node->select);
+    free(node->where);
+    free(node);
+}
+
+static OVS_STATUS mon_list_insert(mon_list* list, const char* uuid, const char* group,
+    OVS_TABLE table, const char* select, const char* where, unsigned int updates,
+    ovsdb_mon_cb cb, ovsdb_row_cb row_cb, ovsdb_batch_cb batch_cb);
+
+/**
+ * Whether a monitor of the 'updates' it selects caches rows, to apply
+ * modify deltas or, with a 'row_cb', to report what a deleted row held.
+ * The server must then send it every kind of update to keep them complete.
+**/
+bool mon_list_caches_rows(unsigned int updates, bool row_cb)
+{
+    return (updates & OVSDB_SELECT_MODIFY) || ((updates & OVSDB_SELECT_DELETE) && row_cb);
+}
 
-OVS_STATUS mon_list_add(const char* uuid, ovsdb_mon_cb cb)
+OVS_STATUS mon_list_add(mon_list* list, const char* uuid, OVS_TABLE table, ovsdb_mon_cb cb)
 {
+    return mon_list_add_select(list, uuid, table, NULL, NULL, cb);
+}
+
+OVS_STATUS mon_list_add_cond(mon_list* list, const char* uuid, OVS_TABLE table,
+    const char* where, ovsdb_mon_cb cb)
+{
+    return mon_list_add_select(list, uuid, table, NULL, where, cb);
+}
+
+/**
+ * Registers a monitor, 'select' and 'where' are kept to re-issue it asking
+ * for the same columns and with its current condition.
+**/
+OVS_STATUS mon_list_add_select(mon_list* list, const char* uuid, OVS_TABLE table,
+    const char* select, const char* where, ovsdb_mon_cb cb)
+{
+    return mon_list_add_rows(list, uuid, table, select, where, OVSDB_SELECT_ALL, cb, NULL);
+}
+
+/**
+ * Same as mon_list_add_select(), 'updates' is the OVSDB_MONITOR_SELECT mask
+ * of the changes the callbacks are told of and 'row_cb' is called for every
+ * one of them. When the monitor caches rows, see mon_list_caches_rows(),
+ * 'select' asks for every kind of update and the others are left out here.
+**/
+OVS_STATUS mon_list_add_rows(mon_list* list, const char* uuid, OVS_TABLE table,
+    const char* select, const char* where, unsigned int updates, ovsdb_mon_cb cb,
+    ovsdb_row_cb row_cb)
+{
+    return mon_list_insert(list, uuid, NULL, table, select, where, updates, cb, row_cb,
+        NULL);
+}
+
+/**
+ * Same as mon_list_add_rows() but the row changes are held until
+ * mon_list_flush() hands all the rows of an update to 'batch_cb' at once.
+**/
+OVS_STATUS mon_list_add_batch(mon_list* list, const char* uuid, OVS_TABLE table,
+    const char* select, const char* where, unsigned int updates, ovsdb_batch_cb batch_cb)
+{
+    if (!batch_cb)
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+    return mon_list_insert(list, uuid, NULL, table, select, where, updates, NULL, NULL,
+        batch_cb);
+}
+
+/**
+ * Registers 'table' as part of the session monitor 'group', which watches
+ * every row of several tables. Updates of the session monitor go to the
+ * member of their table, 'uuid' only identifies the member locally.
+**/
+OVS_STATUS mon_list_add_member(mon_list* list, const char* uuid, const char* group,
+    OVS_TABLE table, ovsdb_mon_cb cb)
+{
+    if (!group)
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+    return mon_list_insert(list, uuid, group, table, NULL, NULL, OVSDB_SELECT_ALL, cb, NULL,
+        NULL);
+}
+
+static OVS_STATUS mon_list_insert(mon_list* list, const char* uuid, const char* group,
+    OVS_TABLE table, const char* select, const char* where, unsigned int updates,
+    ovsdb_mon_cb cb, ovsdb_row_cb row_cb, ovsdb_batch_cb batch_cb)
+{
+    mon_node_t** link = NULL;
+
+    if (!list || !uuid)
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
     OvsDbApiDebug("%s adding UUID to list: %s\n", __func__, uuid);
+    if (updates == 0)
+    {
+        updates = OVSDB_SELECT_ALL;
+    }
 
     mon_node_t* new_node = (mon_node_t*) malloc( sizeof( mon_node_t) );
     if (!new_node)
@@ -48,99 +267,725 @@ OVS_STATUS mon_list_add(const char* uuid, ovsdb_mon_cb cb)
 
     memset(new_node->uuid, 0, sizeof(new_node->uuid));
     strncpy(new_node->uuid, uuid, MAX_UUID_LEN);
+    new_node->rid[0] = '\0';
+    snprintf(new_node->group, sizeof(new_node->group), "%s", group ? group : "");
+    new_node->table = table;
+    new_node->select = NULL;
+    new_node->where = NULL;
+    new_node->updates = updates;
     new_node->callback = cb;
+    new_node->row_callback = row_cb;
+    new_node->batch_callback = batch_cb;
+    new_node->rows = NULL;
+    new_node->synced = false;
+    new_node->resync = MON_RESYNC_NONE;
+    new_node->stale_rows = NULL;
+    memset(&new_node->batch, 0, sizeof(new_node->batch));
     new_node->next = NULL;
 
-    if (!msg_list)
+    if ((select && (new_node->select = strdup(select)) == NULL) ||
+        (where && (new_node->where = strdup(where)) == NULL) ||
+        (mon_list_caches_rows(updates, row_cb || batch_cb) &&
+         (new_node->rows = row_cache_create()) == NULL))
     {
-        msg_list = new_node;
-        return OVS_SUCCESS_STATUS;
+        OvsDbApiError("%s failed to copy the monitor request.\n", __func__);
+        mon_node_free(new_node);
+        return OVS_FAILED_STATUS;
     }
 
-    mon_node_t* temp = msg_list;
-    while (temp->next != NULL)
+    pthread_mutex_lock(&list->mutex);
+    link = &list->head;
+    while (*link != NULL)
     {
-        temp = temp->next;
+        link = &(*link)->next;
     }
-    temp->next = new_node;
+    *link = new_node;
+    pthread_mutex_unlock(&list->mutex);
     return OVS_SUCCESS_STATUS;
 }
 
-OVS_STATUS mon_list_process(const char* uuid, Rdkb_Table_Config* table_config)
+/** Finds the monitor 'uuid', the list must be locked **/
+static mon_node_t* mon_list_find(mon_list* list, const char* uuid)
 {
     mon_node_t* temp = NULL;
 
+    for (temp = list->head; temp != NULL; temp = temp->next)
+    {
+        if (strncmp(uuid, temp->uuid, sizeof(temp->uuid)) == 0)
+        {
+            break;
+        }
+    }
+    return temp;
+}
+
+/** Whether 'node' is monitor 'uuid' or part of session monitor 'uuid' **/
+static bool mon_node_is(const mon_node_t* node, const char* uuid)
+{
+    return strncmp(uuid, node->uuid, sizeof(node->uuid)) == 0 ||
+        (node->group[0] && strncmp(uuid, node->group, sizeof(node->group)) == 0);
+}
+
+/**
+ * Finds who gets the rows of 'table' sent to monitor 'uuid', the monitor
+ * itself or the member for 'table' of a session monitor. The list must be
+ * locked.
+**/
+static mon_node_t* mon_list_find_table(mon_list* list, const char* uuid, OVS_TABLE table)
+{
+    mon_node_t* temp = NULL;
+
+    for (temp = list->head; temp != NULL; temp = temp->next)
+    {
+        if (strncmp(uuid, temp->uuid, sizeof(temp->uuid)) == 0 ||
+            (temp->group[0] && temp->table == table &&
+             strncmp(uuid, temp->group, sizeof(temp->group)) == 0))
+        {
+            break;
+        }
+    }
+    return temp;
+}
+
+/**
+ * Records 'rid' as the request that sets up monitor 'uuid', its response
+ * has the rows the monitor starts with. For a session monitor it is
+ * recorded for every member.
+**/
+OVS_STATUS mon_list_set_request(mon_list* list, const char* uuid, const char* rid)
+{
+    mon_node_t* temp = NULL;
+    bool found = false;
+
+    if (!list || !uuid || !rid)
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    pthread_mutex_lock(&list->mutex);
+    for (temp = list->head; temp != NULL; temp = temp->next)
+    {
+        if (mon_node_is(temp, uuid))
+        {
+            snprintf(temp->rid, sizeof(temp->rid), "%s", rid);
+            found = true;
+        }
+    }
+    pthread_mutex_unlock(&list->mutex);
+    return found ? OVS_SUCCESS_STATUS : OVS_FAILED_STATUS;
+}
+
+/**
+ * Finds the monitor set up by request 'rid', its id, the session monitor's
+ * for a member of one, is copied to 'uuid' which must hold MAX_UUID_LEN + 1
+ * characters.
+**/
+OVS_STATUS mon_list_find_request(mon_list* list, const char* rid, char* uuid)
+{
+    mon_node_t* temp = NULL;
+
+    if (!list || !rid || !uuid)
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    pthread_mutex_lock(&list->mutex);
+    for (temp = list->head; temp != NULL; temp = temp->next)
+    {
+        if (strncmp(rid, temp->rid, sizeof(temp->rid)) == 0)
+        {
+            memcpy(uuid, temp->group[0] ? temp->group : temp->uuid, sizeof(temp->uuid));
+            break;
+        }
+    }
+    pthread_mutex_unlock(&list->mutex);
+    return temp ? OVS_SUCCESS_STATUS : OVS_FAILED_STATUS;
+}
+
+/**
+ * Forgets the rows of monitor 'uuid', or of every member of session
+ * monitor 'uuid', before it is sent its contents again. The rows of one
+ * being re-synced are kept aside to tell the rows that changed meanwhile.
+**/
+OVS_STATUS mon_list_reset_rows(mon_list* list, const char* uuid)
+{
+    mon_node_t* temp = NULL;
+    bool found = false;
+
+    if (!list || !uuid)
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    pthread_mutex_lock(&list->mutex);
+    for (temp = list->head; temp != NULL; temp = temp->next)
+    {
+        if (mon_node_is(temp, uuid))
+        {
+            if (temp->resync == MON_RESYNC_REQUESTED && temp->rows && !temp->stale_rows &&
+                (temp->stale_rows = row_cache_create()) != NULL)
+            {   // swapped, the contents go to the empty cache
+                row_cache* rows = temp->rows;
+                temp->rows = temp->stale_rows;
+                temp->stale_rows = rows;
+            }
+            row_cache_clear(temp->rows);
+            temp->synced = false;
+            found = true;
+        }
+    }
+    pthread_mutex_unlock(&list->mutex);
+    return found ? OVS_SUCCESS_STATUS : OVS_FAILED_STATUS;
+}
+
+/**
+ * Records that monitor 'uuid', or every member of session monitor 'uuid',
+ * was sent its contents and its cached rows are complete, unless a row
+ * was missed in them.
+**/
+OVS_STATUS mon_list_set_synced(mon_list* list, const char* uuid)
+{
+    mon_node_t* temp = NULL;
+    bool found = false;
+
+    if (!list || !uuid)
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    pthread_mutex_lock(&list->mutex);
+    for (temp = list->head; temp != NULL; temp = temp->next)
+    {
+        if (mon_node_is(temp, uuid))
+        {
+            if (temp->resync != MON_RESYNC_WANTED)
+            {
+                temp->synced = true;
+                temp->resync = MON_RESYNC_NONE;
+                row_cache_destroy(temp->stale_rows);
+                temp->stale_rows = NULL;
+            }
+            found = true;
+        }
+    }
+    pthread_mutex_unlock(&list->mutex);
+    return found ? OVS_SUCCESS_STATUS : OVS_FAILED_STATUS;
+}
+
+/** See mon_list_can_resume(), the list must be locked **/
+static bool mon_node_can_resume(const mon_node_t* node)
+{
+    return !node->rows || node->synced;
+}
+
+/**
+ * Whether monitor 'uuid', or session monitor 'uuid', can be sent only what
+ * changed since a transaction. A monitor that caches rows needs them to
+ * apply modify deltas, so it resumes only once it was sent its contents,
+ * e.g. not after a restart whose cache starts empty.
+**/
+bool mon_list_can_resume(mon_list* list, const char* uuid)
+{
+    mon_node_t* temp = NULL;
+    bool resume = true;
+
+    if (!list || !uuid)
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&list->mutex);
+    for (temp = list->head; temp != NULL; temp = temp->next)
+    {
+        if (mon_node_is(temp, uuid) && !mon_node_can_resume(temp))
+        {
+            resume = false;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&list->mutex);
+    return resume;
+}
+
+/**
+ * Whether monitor 'uuid', or session monitor 'uuid', missed a modified row
+ * in its cache and is to be re-issued for its contents. True once, the
+ * monitor then waits for them and the rows that changed are delivered as
+ * inserts and modifies as they arrive.
+**/
+bool mon_list_take_resync(mon_list* list, const char* uuid)
+{
+    mon_node_t* temp = NULL;
+    bool resync = false;
+
+    if (!list || !uuid)
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&list->mutex);
+    for (temp = list->head; temp != NULL; temp = temp->next)
+    {
+        resync = resync || (mon_node_is(temp, uuid) && temp->resync == MON_RESYNC_WANTED);
+    }
+    for (temp = list->head; resync && temp != NULL; temp = temp->next)
+    {   // a session monitor is re-issued with all its tables
+        if (mon_node_is(temp, uuid))
+        {
+            temp->resync = MON_RESYNC_REQUESTED;
+        }
+    }
+    pthread_mutex_unlock(&list->mutex);
+    return resync;
+}
+
+/** The 1 << OVS_TABLE bits of the tables that are part of session monitor 'group' **/
+uint32_t mon_list_group_tables(mon_list* list, const char* group)
+{
+    mon_node_t* temp = NULL;
+    uint32_t tables = 0;
+
+    if (!list || !group || !group[0])
+    {
+        return 0;
+    }
+
+    pthread_mutex_lock(&list->mutex);
+    for (temp = list->head; temp != NULL; temp = temp->next)
+    {
+        if (strncmp(group, temp->group, sizeof(temp->group)) == 0)
+        {
+            tables |= 1u << temp->table;
+        }
+    }
+    pthread_mutex_unlock(&list->mutex);
+    return tables;
+}
+
+/**
+ * Copies the session monitor monitor 'uuid' is part of to 'group', which
+ * must hold MAX_UUID_LEN + 1 characters. Fails for a monitor of its own.
+**/
+OVS_STATUS mon_list_get_group(mon_list* list, const char* uuid, char* group)
+{
+    mon_node_t* temp = NULL;
+    OVS_STATUS status = OVS_FAILED_STATUS;
+
+    if (!list || !uuid || !group)
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    pthread_mutex_lock(&list->mutex);
+    if ((temp = mon_list_find(list, uuid)) != NULL && temp->group[0])
+    {
+        memcpy(group, temp->group, sizeof(temp->group));
+        status = OVS_SUCCESS_STATUS;
+    }
+    pthread_mutex_unlock(&list->mutex);
+    return status;
+}
+
+OVS_STATUS mon_list_get_table(mon_list* list, const char* uuid, OVS_TABLE* table)
+{
+    mon_node_t* temp = NULL;
+    OVS_STATUS status = OVS_FAILED_STATUS;
+
+    if (!list || !uuid || !table)
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    pthread_mutex_lock(&list->mutex);
+    for (temp = list->head; temp != NULL; temp = temp->next)
+    {
+        if (strncmp(uuid, temp->uuid, sizeof(temp->uuid)) == 0)
+        {
+            *table = temp->table;
+            status = OVS_SUCCESS_STATUS;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&list->mutex);
+
+    if (status != OVS_SUCCESS_STATUS)
+    {
+        OvsDbApiError("%s Cannot find UUID: %s in the mon_update list.\n",
+            __func__, uuid);
+    }
+    return status;
+}
+
+/**
+ * Replaces the condition of the conditional monitor 'uuid'. Fails for a
+ * plain monitor.
+**/
+OVS_STATUS mon_list_set_where(mon_list* list, const char* uuid, const char* where)
+{
+    mon_node_t* temp = NULL;
+    char* copy = NULL;
+    OVS_STATUS status = OVS_FAILED_STATUS;
+
+    if (!list || !uuid || !where)
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    if ((copy = strdup(where)) == NULL)
+    {
+        OvsDbApiError("%s failed to copy the monitor condition.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    pthread_mutex_lock(&list->mutex);
+    for (temp = list->head; temp != NULL; temp = temp->next)
+    {
+        if (strncmp(uuid, temp->uuid, sizeof(temp->uuid)) == 0)
+        {
+            if (temp->where)
+            {
+                free(temp->where);
+                temp->where = copy;
+                copy = NULL;
+                status = OVS_SUCCESS_STATUS;
+            }
+            break;
+        }
+    }
+    pthread_mutex_unlock(&list->mutex);
+
+    if (status != OVS_SUCCESS_STATUS)
+    {
+        OvsDbApiError("%s UUID: %s is not a conditional monitor.\n", __func__, uuid);
+    }
+    free(copy);
+    return status;
+}
+
+OVS_STATUS mon_list_process(mon_list* list, const char* uuid, Rdkb_Table_Config* table_config)
+{
+    mon_node_t* temp = NULL;
+    ovsdb_mon_cb callback = NULL;
+
+    if (!list || !uuid)
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
     OvsDbApiDebug("%s parsing UUID: %s\n", __func__, uuid);
 
-    for (temp = msg_list; temp != NULL; temp = temp->next)
+    pthread_mutex_lock(&list->mutex);
+    for (temp = list->head; temp != NULL; temp = temp->next)
     {
         if (strncmp(uuid, temp->uuid, sizeof(temp->uuid)) == 0)
         {
-            temp->callback( OVS_SUCCESS_STATUS, table_config );
-            return OVS_SUCCESS_STATUS;
+            callback = temp->callback;
+            break;
         }
     }
+    pthread_mutex_unlock(&list->mutex);
 
-    OvsDbApiWarning("%s UUID: %s is not present inside monitor update list.\n",
-        __func__, uuid);
-    return OVS_FAILED_STATUS;
+    if (!callback)
+    {
+        OvsDbApiWarning("%s UUID: %s is not present inside monitor update list.\n",
+            __func__, uuid);
+        return OVS_FAILED_STATUS;
+    }
+
+    // called without the lock held, the callback may cancel the monitor
+    callback( OVS_SUCCESS_STATUS, table_config );
+    return OVS_SUCCESS_STATUS;
 }
 
-OVS_STATUS mon_list_remove(const char * uuid)
+/**
+ * Brings the cached row of 'change' up to date and hands the complete row
+ * to the callbacks of monitor 'uuid'. The callback gets inserts and
+ * modifies, the row callback every change, of the kinds the monitor
+ * selected. A modify delta of a row that is not cached only reaches the
+ * row callback, with just its columns set, and the monitor is re-synced
+ * to get the row. A batch monitor holds every change until
+ * mon_list_flush() instead.
+**/
+OVS_STATUS mon_list_update(mon_list* list, const char* uuid, const mon_row_change* change)
 {
-    mon_node_t* curr = NULL;
-    mon_node_t* next = NULL;
+    mon_node_t* temp = NULL;
+    ovsdb_mon_cb callback = NULL;
+    ovsdb_row_cb row_callback = NULL;
+    ovsdb_table_row* cached = NULL;
+    ovsdb_table_row* stale = NULL;
+    ovsdb_table_row row;
+    OvsAgent_Table_Config table_config;
+    OvsDb_Row_Update update;
+    OVS_STATUS status = OVS_SUCCESS_STATUS;
+    bool complete = true;
 
-    if (!uuid || !msg_list)
+    if (!list || !uuid || !change || !change->uuid || !change->desc)
     {
-        OvsDbApiError("%s removing monitor node with either list empty or uuid NULL.\n",
-            __func__);
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
         return OVS_FAILED_STATUS;
     }
 
-    OvsDbApiDebug("%s UUID: %s from list.\n", __func__, uuid);
+    memset(&row, 0, sizeof(row));
+    memset(&update, 0, sizeof(update));
+    update.type = change->type;
+    update.changed = change->changed;
+
+    pthread_mutex_lock(&list->mutex);
+    if ((temp = mon_list_find_table(list, uuid, change->desc->id)) != NULL)
+    {
+        callback = temp->callback;
+        row_callback = temp->row_callback;
+        cached = row_cache_get(temp->rows, change->uuid);
+
+        if (change->row)
+        {
+            memcpy(&row, change->row, sizeof(row));
+        }
+        else if (change->delta)
+        {   // applied to an empty row when the row is not cached
+            complete = (cached != NULL);
+            update.changed = apply_table_delta(change->desc, cached ? cached : &row,
+                change->delta);
+            if (cached)
+            {
+                memcpy(&row, cached, sizeof(row));
+            }
+        }
+        else if (cached)
+        {   // an update2 delete, the row is only known from the cache
+            memcpy(&row, cached, sizeof(row));
+        }
+
+        if (!complete && temp->rows && temp->resync == MON_RESYNC_NONE)
+        {   // its contents are asked for again, see mon_list_take_resync()
+            temp->synced = false;
+            temp->resync = MON_RESYNC_WANTED;
+        }
+        else if (change->type == OVSDB_SELECT_INITIAL && temp->stale_rows)
+        {   // contents of a re-sync, told as what happened to the row meanwhile
+            if ((stale = row_cache_get(temp->stale_rows, change->uuid)) == NULL)
+            {
+                update.type = OVSDB_SELECT_INSERT;
+            }
+            else if ((update.changed = table_row_changes(change->desc, stale, &row)) != 0)
+            {
+                update.type = OVSDB_SELECT_MODIFY;
+            }
+        }
+
+        if (change->type == OVSDB_SELECT_DELETE)
+        {
+            (void)row_cache_remove(temp->rows, change->uuid, NULL);
+        }
+        else if (temp->rows && change->row)
+        {
+            (void)row_cache_put(temp->rows, change->uuid, &row);
+        }
+
+        if (!(temp->updates & update.type))
+        {   // only sent to keep the cache complete
+            callback = NULL;
+            row_callback = NULL;
+        }
+        else if (temp->batch_callback)
+        {
+            update.uuid = change->uuid;
+            status = mon_batch_add(&temp->batch, change->desc, &update, &row);
+        }
+    }
+    pthread_mutex_unlock(&list->mutex);
 
-    /** Check head of list **/
-    if (strncmp(uuid, msg_list->uuid, sizeof(msg_list->uuid)) == 0)
+    if (!temp)
     {
-        curr = msg_list;
-        msg_list = msg_list->next;
-        free(curr);
-        return OVS_SUCCESS_STATUS;
+        OvsDbApiWarning("%s UUID: %s is not present inside monitor update list.\n",
+            __func__, uuid);
+        return OVS_FAILED_STATUS;
     }
 
-    for (curr = msg_list; next != NULL; curr = curr->next)
+    if (!callback && !row_callback)
+    {   // a batch monitor, the row waits for the rest of the update, or a row not asked for
+        if (status != OVS_SUCCESS_STATUS)
+        {
+            OvsDbApiError("%s UUID: %s - failed to hold row %s for the batch.\n",
+                __func__, uuid, change->uuid);
+        }
+        return status;
+    }
+
+    memset(&table_config, 0, sizeof(table_config));
+    table_config.table.id = change->desc->id;
+    table_config.config = &row;
+    snprintf(table_config.uuid, sizeof(table_config.uuid), "%s", change->uuid);
+    if (!complete)
     {
-        next = curr->next;
+        OvsDbApiWarning("%s UUID: %s - modify of row %s which is not cached, re-syncing.\n",
+            __func__, uuid, change->uuid);
+    }
+
+    // called without the lock held, the callbacks may cancel the monitor
+    if (callback && complete &&
+        (update.type == OVSDB_SELECT_INSERT || update.type == OVSDB_SELECT_MODIFY))
+    {
+        callback(OVS_SUCCESS_STATUS, (Rdkb_Table_Config*) &table_config);
+    }
+    if (row_callback)
+    {
+        update.uuid = table_config.uuid;
+        update.table_config = (Rdkb_Table_Config*) &table_config;
+        row_callback(&update);
+    }
+    return OVS_SUCCESS_STATUS;
+}
+
+/**
+ * Hands the rows of monitor 'uuid' held since the last flush to its batch
+ * callback, once the whole update they came in has been decoded. Does
+ * nothing for other monitors or when no row is held.
+**/
+OVS_STATUS mon_list_flush(mon_list* list, const char* uuid)
+{
+    mon_node_t* temp = NULL;
+    ovsdb_batch_cb batch_callback = NULL;
+    mon_batch batch;
+    size_t i;
+
+    if (!list || !uuid)
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    memset(&batch, 0, sizeof(batch));
+    pthread_mutex_lock(&list->mutex);
+    for (temp = list->head; temp != NULL && !mon_node_is(temp, uuid); temp = temp->next)
+    {
+    }
+    if (temp && temp->batch.count > 0)
+    {   // taken over, rows of the next update start a new batch
+        batch_callback = temp->batch_callback;
+        memcpy(&batch, &temp->batch, sizeof(batch));
+        memset(&temp->batch, 0, sizeof(temp->batch));
+    }
+    pthread_mutex_unlock(&list->mutex);
+
+    if (!temp)
+    {
+        OvsDbApiWarning("%s UUID: %s is not present inside monitor update list.\n",
+            __func__, uuid);
+        return OVS_FAILED_STATUS;
+    }
 
-        if (strncmp(uuid, next->uuid, sizeof(next->uuid)) == 0)
+    if (batch.count > 0)
+    {
+        for (i = 0; i < batch.count; i++)
+        {
+            batch.rows[i].table_config.config = &batch.rows[i].row;
+            batch.updates[i].uuid = batch.rows[i].table_config.uuid;
+            batch.updates[i].table_config = (Rdkb_Table_Config*) &batch.rows[i].table_config;
+        }
+
+        OvsDbApiDebug("%s UUID: %s, %zu rows.\n", __func__, uuid, batch.count);
+        // called without the lock held, the callback may cancel the monitor
+        batch_callback(batch.updates, batch.count);
+        mon_batch_free(&batch);
+    }
+    return OVS_SUCCESS_STATUS;
+}
+
+OVS_STATUS mon_list_remove(mon_list* list, const char * uuid)
+{
+    mon_node_t** link = NULL;
+    mon_node_t* node = NULL;
+
+    if (!list || !uuid)
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    OvsDbApiDebug("%s UUID: %s from list.\n", __func__, uuid);
+
+    pthread_mutex_lock(&list->mutex);
+    for (link = &list->head; *link != NULL; link = &(*link)->next)
+    {
+        if (strncmp(uuid, (*link)->uuid, sizeof((*link)->uuid)) == 0)
         {
-            curr->next = next->next;
-            free(next);
-            return OVS_SUCCESS_STATUS;
+            node = *link;
+            *link = node->next;
+            break;
         }
     }
+    pthread_mutex_unlock(&list->mutex);
 
-    OvsDbApiError("%s Cannot find UUID: %s in the mon_update list.\n",
-        __func__, uuid);
-    return OVS_FAILED_STATUS;
+    if (!node)
+    {
+        OvsDbApiError("%s Cannot find UUID: %s in the mon_update list.\n",
+            __func__, uuid);
+        return OVS_FAILED_STATUS;
+    }
+
+    mon_node_free(node);
+    return OVS_SUCCESS_STATUS;
 }
 
-OVS_STATUS mon_list_clear()
+/**
+ * Calls 'cb' for every registered monitor with a request of its own, e.g.
+ * to re-issue them on a new connection, the members of session monitors
+ * are left out. 'cb' must not add or remove monitors.
+**/
+OVS_STATUS mon_list_foreach(mon_list* list, mon_list_foreach_cb cb, void* data)
 {
-    mon_node_t* curr = msg_list;
+    mon_node_t* temp = NULL;
+
+    if (!list || !cb)
+    {
+        return OVS_FAILED_STATUS;
+    }
+
+    pthread_mutex_lock(&list->mutex);
+    for (temp = list->head; temp != NULL; temp = temp->next)
+    {
+        if (!temp->group[0])
+        {
+            cb(temp->uuid, temp->table, temp->select, temp->where,
+                mon_node_can_resume(temp), temp->rid, data);
+        }
+    }
+    pthread_mutex_unlock(&list->mutex);
+    return OVS_SUCCESS_STATUS;
+}
+
+OVS_STATUS mon_list_clear(mon_list* list)
+{
+    mon_node_t* curr = NULL;
     mon_node_t* next = NULL;
 
+    if (!list)
+    {
+        return OVS_FAILED_STATUS;
+    }
+
     OvsDbApiDebug("%s clearing the monitor list.\n", __func__);
 
+    pthread_mutex_lock(&list->mutex);
+    curr = list->head;
+    list->head = NULL;
+    pthread_mutex_unlock(&list->mutex);
+
     while (curr != NULL)
     {
         OvsDbApiDebug("%s UUID: %s from list.\n", __func__, curr->uuid);
         next = curr->next;
-        free(curr);
+        mon_node_free(curr);
         curr = next;
     }
-
-    msg_list = NULL;
     return OVS_SUCCESS_STATUS;
 }
@@ -21,10 +21,69 @@
 
 #include "OvsDbApi/OvsDbDefs.h"
 #include "OvsDataTypes.h"
+#include "OvsDbApi/json_parser/table_parser.h"
 
-OVS_STATUS mon_list_add(const char* uuid, ovsdb_mon_cb cb);
-OVS_STATUS mon_list_process(const char* uuid, Rdkb_Table_Config* table_config);
-OVS_STATUS mon_list_remove(const char* uuid);
-OVS_STATUS mon_list_clear();
+/** Registered monitors, one list per OVSDB context **/
+typedef struct mon_list mon_list;
+
+/**
+ * 'select' is the encoded columns and updates the monitor asks for, NULL
+ * for all, 'where' the condition of a conditional monitor, NULL for a
+ * plain one, and 'resume' as for mon_list_can_resume(). A callback
+ * re-issuing the monitor records the id of its request in 'rid', which
+ * holds MAX_UUID_LEN + 1 characters.
+**/
+typedef void (*mon_list_foreach_cb)(const char* uuid, OVS_TABLE table, const char* select,
+    const char* where, bool resume, char* rid, void* data);
+
+/**
+ * A row of a monitor update as decoded. 'row' has the complete contents,
+ * except for an update2 modify which has its columns in 'delta' and an
+ * update2 delete which has neither. 'changed' is set for an update modify,
+ * whose "old" has the columns that changed.
+**/
+typedef struct mon_row_change
+{
+    OVSDB_MONITOR_SELECT type;
+    const char* uuid;
+    const table_desc* desc;
+    const ovsdb_table_row* row;
+    const ovsdb_row_delta* delta;
+    uint32_t changed;
+} mon_row_change;
+
+bool mon_list_caches_rows(unsigned int updates, bool row_cb);
+
+mon_list* mon_list_create();
+void mon_list_destroy(mon_list* list);
+
+OVS_STATUS mon_list_add(mon_list* list, const char* uuid, OVS_TABLE table, ovsdb_mon_cb cb);
+OVS_STATUS mon_list_add_cond(mon_list* list, const char* uuid, OVS_TABLE table,
+    const char* where, ovsdb_mon_cb cb);
+OVS_STATUS mon_list_add_select(mon_list* list, const char* uuid, OVS_TABLE table,
+    const char* select, const char* where, ovsdb_mon_cb cb);
+OVS_STATUS mon_list_add_rows(mon_list* list, const char* uuid, OVS_TABLE table,
+    const char* select, const char* where, unsigned int updates, ovsdb_mon_cb cb,
+    ovsdb_row_cb row_cb);
+OVS_STATUS mon_list_add_batch(mon_list* list, const char* uuid, OVS_TABLE table,
+    const char* select, const char* where, unsigned int updates, ovsdb_batch_cb batch_cb);
+OVS_STATUS mon_list_add_member(mon_list* list, const char* uuid, const char* group,
+    OVS_TABLE table, ovsdb_mon_cb cb);
+uint32_t mon_list_group_tables(mon_list* list, const char* group);
+OVS_STATUS mon_list_get_group(mon_list* list, const char* uuid, char* group);
+OVS_STATUS mon_list_set_request(mon_list* list, const char* uuid, const char* rid);
+OVS_STATUS mon_list_find_request(mon_list* list, const char* rid, char* uuid);
+OVS_STATUS mon_list_reset_rows(mon_list* list, const char* uuid);
+OVS_STATUS mon_list_set_synced(mon_list* list, const char* uuid);
+bool mon_list_can_resume(mon_list* list, const char* uuid);
+bool mon_list_take_resync(mon_list* list, const char* uuid);
+OVS_STATUS mon_list_get_table(mon_list* list, const char* uuid, OVS_TABLE* table);
+OVS_STATUS mon_list_set_where(mon_list* list, const char* uuid, const char* where);
+OVS_STATUS mon_list_process(mon_list* list, const char* uuid, Rdkb_Table_Config* table_config);
+OVS_STATUS mon_list_update(mon_list* list, const char* uuid, const mon_row_change* change);
+OVS_STATUS mon_list_flush(mon_list* list, const char* uuid);
+OVS_STATUS mon_list_remove(mon_list* list, const char* uuid);
+OVS_STATUS mon_list_foreach(mon_list* list, mon_list_foreach_cb cb, void* data);
+OVS_STATUS mon_list_clear(mon_list* list);
 
 #endif
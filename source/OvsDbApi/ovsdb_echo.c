@@ -0,0 +1,88 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "OvsDbApi/ovsdb_echo.h"
+
+void ovsdb_rtt_window_reset(ovsdb_rtt_window * window)
+{
+    if (window)
+    {
+        memset(window, 0, sizeof(ovsdb_rtt_window));
+    }
+}
+
+void ovsdb_rtt_window_add(ovsdb_rtt_window * window, unsigned int usecs)
+{
+    if (!window)
+    {
+        return;
+    }
+
+    window->samples[window->next] = usecs;
+    window->next = (window->next + 1) % OVSDB_ECHO_WINDOW_SIZE;
+    if (window->count < OVSDB_ECHO_WINDOW_SIZE)
+    {
+        window->count++;
+    }
+}
+
+static int compare_usecs(const void * a, const void * b)
+{
+    unsigned int lhs = *(const unsigned int *)a;
+    unsigned int rhs = *(const unsigned int *)b;
+
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+/** nearest-rank percentile of the sorted samples **/
+static unsigned int percentile(const unsigned int * sorted, size_t count, unsigned int pct)
+{
+    size_t rank = (count * pct + 99) / 100;
+
+    return sorted[(rank > 0) ? rank - 1 : 0];
+}
+
+void ovsdb_rtt_window_stats(const ovsdb_rtt_window * window, OvsDb_Echo_Stats * stats)
+{
+    unsigned int sorted[OVSDB_ECHO_WINDOW_SIZE];
+
+    if (!window || !stats)
+    {
+        return;
+    }
+
+    stats->samples = window->count;
+    if (window->count == 0)
+    {
+        stats->min_usecs = stats->p50_usecs = stats->p90_usecs = 0;
+        stats->p99_usecs = stats->max_usecs = 0;
+        return;
+    }
+
+    memcpy(sorted, window->samples, window->count * sizeof(unsigned int));
+    qsort(sorted, window->count, sizeof(unsigned int), compare_usecs);
+
+    stats->min_usecs = sorted[0];
+    stats->p50_usecs = percentile(sorted, window->count, 50);
+    stats->p90_usecs = percentile(sorted, window->count, 90);
+    stats->p99_usecs = percentile(sorted, window->count, 99);
+    stats->max_usecs = sorted[window->count - 1];
+}
@@ -0,0 +1,49 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+
+#ifndef OVSDB_ECHO_H
+#define OVSDB_ECHO_H
+
+#include <stddef.h>
+#include "OvsDbApi/OvsDbDefs.h"
+
+#define OVSDB_ECHO_INTERVAL_MSECS 5000
+#define OVSDB_ECHO_MAX_MISSED     3
+#define OVSDB_ECHO_WINDOW_SIZE    128
+
+/**
+ * Round-trip times of the most recent echo requests, oldest samples are
+ * overwritten once the window is full.
+**/
+typedef struct ovsdb_rtt_window
+{
+    unsigned int samples[OVSDB_ECHO_WINDOW_SIZE];   // usecs
+    size_t count;
+    size_t next;
+} ovsdb_rtt_window;
+
+void ovsdb_rtt_window_reset(ovsdb_rtt_window * window);
+void ovsdb_rtt_window_add(ovsdb_rtt_window * window, unsigned int usecs);
+
+/**
+ * Fills the min/percentile/max fields of 'stats' from the window.
+**/
+void ovsdb_rtt_window_stats(const ovsdb_rtt_window * window, OvsDb_Echo_Stats * stats);
+
+#endif
@@ -0,0 +1,338 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "OvsDbApi/ovsdb_framer.h"
+#include "common/OvsAgentLog.h"
+
+OVS_STATUS ovsdb_framer_init(ovsdb_framer * framer)
+{
+    if (!framer)
+    {
+        OvsDbApiError("%s framer is NULL.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    memset(framer, 0, sizeof(ovsdb_framer));
+    return OVS_SUCCESS_STATUS;
+}
+
+void ovsdb_framer_deinit(ovsdb_framer * framer)
+{
+    if (!framer)
+    {
+        return;
+    }
+
+    free(framer->buffer);
+    memset(framer, 0, sizeof(ovsdb_framer));
+}
+
+/**
+ * Drops any partially received message, keeping the allocated buffer.
+**/
+void ovsdb_framer_reset(ovsdb_framer * framer)
+{
+    if (!framer)
+    {
+        return;
+    }
+
+    framer->len = 0;
+    framer->start = 0;
+    framer->scan = 0;
+    framer->depth = 0;
+    framer->in_string = false;
+    framer->escaped = false;
+}
+
+/**
+ * Makes room for 'need' more bytes at the end of the buffer, first by moving
+ * the pending partial message to the front and then by growing the buffer.
+**/
+static OVS_STATUS ovsdb_framer_reserve(ovsdb_framer * framer, size_t need)
+{
+    size_t size = 0;
+    char * buffer = NULL;
+
+    if (framer->size - framer->len >= need)
+    {
+        return OVS_SUCCESS_STATUS;
+    }
+
+    if (framer->start > 0)
+    {
+        memmove(framer->buffer, framer->buffer + framer->start,
+            framer->len - framer->start);
+        framer->len -= framer->start;
+        framer->scan -= framer->start;
+        framer->start = 0;
+
+        if (framer->size - framer->len >= need)
+        {
+            return OVS_SUCCESS_STATUS;
+        }
+    }
+
+    size = (framer->size != 0) ? framer->size : OVSDB_FRAMER_INITIAL_SIZE;
+    while (size - framer->len < need)
+    {
+        size *= 2;
+    }
+
+    if (size > OVSDB_FRAMER_MAX_SIZE)
+    {
+        OvsDbApiError("%s message exceeds the maximum size of %d bytes.\n",
+            __func__, OVSDB_FRAMER_MAX_SIZE);
+        return OVS_FAILED_STATUS;
+    }
+
+    buffer = realloc(framer->buffer, size);
+    if (!buffer)
+    {
+        OvsDbApiError("%s failed to grow buffer to %zu bytes.\n", __func__, size);
+        return OVS_FAILED_STATUS;
+    }
+
+    OvsDbApiDebug("%s grew buffer from %zu to %zu bytes.\n", __func__,
+        framer->size, size);
+    framer->buffer = buffer;
+    framer->size = size;
+    return OVS_SUCCESS_STATUS;
+}
+
+/**
+ * Scans the bytes received since the previous call for message boundaries.
+ * Each byte is looked at exactly once, the scan state carries over between
+ * calls.
+**/
+static OVS_STATUS ovsdb_framer_scan(ovsdb_framer * framer,
+    ovsdb_framer_msg_cb cb, void * cb_data)
+{
+    const char * buf = framer->buffer;
+    size_t end = framer->len;
+    size_t i = framer->scan;
+
+    while (i < end)
+    {
+        if (framer->in_string)
+        {
+            if (framer->escaped)
+            {
+                framer->escaped = false;
+                i++;
+                continue;
+            }
+
+            while (i < end && buf[i] != '"' && buf[i] != '\\')
+            {
+                i++;
+            }
+            if (i == end)
+            {
+                break;
+            }
+
+            if (buf[i] == '\\')
+            {
+                framer->escaped = true;
+            }
+            else
+            {
+                framer->in_string = false;
+            }
+            i++;
+            continue;
+        }
+
+        switch (buf[i])
+        {
+            case '{':
+            case '[':
+                if (framer->depth == 0)
+                {
+                    framer->start = i;
+                }
+                framer->depth++;
+                break;
+
+            case '}':
+            case ']':
+                if (framer->depth == 0)
+                {
+                    OvsDbApiError("%s unbalanced '%c' at offset %zu.\n",
+                        __func__, buf[i], i);
+                    return OVS_FAILED_STATUS;
+                }
+                framer->depth--;
+                if (framer->depth == 0)
+                {
+                    cb(buf + framer->start, i + 1 - framer->start, cb_data);
+                    framer->start = i + 1;
+                }
+                break;
+
+            case '"':
+                if (framer->depth == 0)
+                {
+                    OvsDbApiError("%s unexpected string outside of a message.\n",
+                        __func__);
+                    return OVS_FAILED_STATUS;
+                }
+                framer->in_string = true;
+                break;
+
+            case ' ':
+            case '\t':
+            case '\r':
+            case '\n':
+                break;
+
+            default:
+                if (framer->depth == 0)
+                {
+                    OvsDbApiError("%s unexpected '%c' outside of a message.\n",
+                        __func__, buf[i]);
+                    return OVS_FAILED_STATUS;
+                }
+                break;
+        }
+        i++;
+    }
+
+    framer->scan = i;
+    if (framer->depth == 0)
+    {   // only whitespace left after the last complete message
+        framer->start = i;
+    }
+    return OVS_SUCCESS_STATUS;
+}
+
+/**
+ * Returns the free tail of the buffer to receive at least 'min' more bytes
+ * into, 'space' is set to its actual size. Returns NULL if the buffer
+ * cannot grow any further.
+**/
+char * ovsdb_framer_get_space(ovsdb_framer * framer, size_t min, size_t * space)
+{
+    if (!framer || !space)
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return NULL;
+    }
+
+    if (ovsdb_framer_reserve(framer, (min > 0) ? min : 1) != OVS_SUCCESS_STATUS)
+    {
+        ovsdb_framer_reset(framer);
+        return NULL;
+    }
+
+    *space = framer->size - framer->len;
+    return framer->buffer + framer->len;
+}
+
+/**
+ * Releases a buffer that grew for a large message, meant to be called when
+ * the socket has been drained. Does nothing while a message is pending.
+**/
+void ovsdb_framer_shrink(ovsdb_framer * framer)
+{
+    char * buffer = NULL;
+
+    if (!framer || framer->size <= OVSDB_FRAMER_INITIAL_SIZE || framer->len != 0)
+    {
+        return;
+    }
+
+    buffer = realloc(framer->buffer, OVSDB_FRAMER_INITIAL_SIZE);
+    if (!buffer)
+    {   // keep using the larger buffer
+        return;
+    }
+
+    OvsDbApiDebug("%s shrank buffer from %zu to %d bytes.\n", __func__,
+        framer->size, OVSDB_FRAMER_INITIAL_SIZE);
+    framer->buffer = buffer;
+    framer->size = OVSDB_FRAMER_INITIAL_SIZE;
+}
+
+/**
+ * Accounts for 'len' bytes received into the space returned by
+ * ovsdb_framer_get_space() and calls 'cb' for every message that they
+ * complete. On a framing error the buffered data is dropped.
+**/
+OVS_STATUS ovsdb_framer_commit(ovsdb_framer * framer, size_t len,
+    ovsdb_framer_msg_cb cb, void * cb_data)
+{
+    if (!framer || !cb || len > framer->size - framer->len)
+    {
+        OvsDbApiError("%s Invalid parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    if (len == 0)
+    {
+        return OVS_SUCCESS_STATUS;
+    }
+
+    framer->len += len;
+    if (ovsdb_framer_scan(framer, cb, cb_data) != OVS_SUCCESS_STATUS)
+    {
+        ovsdb_framer_reset(framer);
+        return OVS_FAILED_STATUS;
+    }
+
+    if (framer->start == framer->len)
+    {   // nothing pending, rewind without copying
+        framer->len = 0;
+        framer->start = 0;
+        framer->scan = 0;
+    }
+    return OVS_SUCCESS_STATUS;
+}
+
+/**
+ * Appends a copy of 'len' bytes of 'data' to the stream, for callers that
+ * did not receive straight into the framer.
+**/
+OVS_STATUS ovsdb_framer_feed(ovsdb_framer * framer, const char * data,
+    size_t len, ovsdb_framer_msg_cb cb, void * cb_data)
+{
+    char * space = NULL;
+    size_t avail = 0;
+
+    if (!framer || !cb || (!data && len > 0))
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    if (len == 0)
+    {
+        return OVS_SUCCESS_STATUS;
+    }
+
+    if ((space = ovsdb_framer_get_space(framer, len, &avail)) == NULL)
+    {
+        return OVS_FAILED_STATUS;
+    }
+
+    memcpy(space, data, len);
+    return ovsdb_framer_commit(framer, len, cb, cb_data);
+}
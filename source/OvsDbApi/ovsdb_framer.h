@@ -0,0 +1,67 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+#ifndef OVSDB_FRAMER_H
+#define OVSDB_FRAMER_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "OvsDataTypes.h"
+
+#define OVSDB_FRAMER_INITIAL_SIZE (64 * 1024)
+#define OVSDB_FRAMER_MAX_SIZE     (16 * 1024 * 1024)
+#define OVSDB_FRAMER_MIN_READ     (16 * 1024)
+
+/**
+ * Called once for every complete JSON-RPC message found in the stream.
+ * 'msg' points into the framer's buffer and is NOT null terminated.
+**/
+typedef void (*ovsdb_framer_msg_cb)(const char * msg, size_t len, void * data);
+
+/**
+ * Incremental JSON-RPC framer. The socket is read straight into the free
+ * tail of a persistent heap buffer, which is scanned once for message
+ * boundaries, keeping track of the brace depth and string state between
+ * reads so a message split across several reads is only handed over once
+ * it is complete. Messages are parsed in place, the buffer is never
+ * cleared. It rewinds when all messages were consumed, grows for large
+ * monitor dumps and can be shrunk back once the socket is idle.
+**/
+typedef struct ovsdb_framer
+{
+    char * buffer;      // reassembly buffer
+    size_t size;        // allocated size of buffer
+    size_t len;         // number of valid bytes in buffer
+    size_t start;       // offset of the first byte of the pending message
+    size_t scan;        // offset at which the boundary scan resumes
+    int depth;          // current {} / [] nesting depth
+    bool in_string;     // scan is inside a JSON string
+    bool escaped;       // previous string character was a backslash
+} ovsdb_framer;
+
+OVS_STATUS ovsdb_framer_init(ovsdb_framer * framer);
+void ovsdb_framer_deinit(ovsdb_framer * framer);
+void ovsdb_framer_reset(ovsdb_framer * framer);
+char * ovsdb_framer_get_space(ovsdb_framer * framer, size_t min, size_t * space);
+OVS_STATUS ovsdb_framer_commit(ovsdb_framer * framer, size_t len,
+    ovsdb_framer_msg_cb cb, void * cb_data);
+void ovsdb_framer_shrink(ovsdb_framer * framer);
+OVS_STATUS ovsdb_framer_feed(ovsdb_framer * framer, const char * data,
+    size_t len, ovsdb_framer_msg_cb cb, void * cb_data);
+
+#endif
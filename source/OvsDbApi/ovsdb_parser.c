@@ -16,6 +16,7 @@
 * SPDX-License-Identifier: Apache-2.0
 */
 
+#include <stdlib.h>
 #include <string.h>
 #include <jansson.h>
 #include "OvsDataTypes.h"
@@ -24,389 +25,1251 @@
 #include "OvsDbApi/ovsdb_parser.h"
 #include "OvsDbApi/json_parser/table_parser.h"
 #include "OvsDbApi/json_parser/json_parser.h"
+#include "OvsDbApi/json_parser/json_reader.h"
+#include "OvsDbApi/json_parser/ovsdb_schema.h"
 #include "OvsDbApi/mon_update_list.h"
 #include "OvsDbApi/receipt_list.h"
 
-static OVS_STATUS ovsdb_parse_monitor_update(const char * uuid, json_t* update);
-static OVS_STATUS ovsdb_parse_params(json_t* params);
+/** Longest table name accepted in a monitor update **/
+#define OVSDB_MAX_TABLE_NAME_LEN 64
 
-char * ovsdb_insert_to_json(Rdkb_Table_Config * table_config, const char * unique_id)
+/**
+ * Where the members of a JSON-RPC message we look at are, a missing token
+ * is left zeroed i.e. of type JSON_TOKEN_ERROR.
+**/
+typedef struct ovsdb_msg_members
 {
-    char * str_json = NULL;
+    json_token id;
+    json_token method;
+    json_token error;
+    const char * params;        // NULL if the member is missing
+    size_t params_len;
+    const char * result;
+    size_t result_len;
+} ovsdb_msg_members;
 
-    switch(table_config->table.id)
-    {
-        case OVS_GW_CONFIG_TABLE:
-            str_json = gc_insert_to_json((Gateway_Config*) table_config->config, unique_id);
-            break;
+/** Room for the decoded response to any request we send **/
+typedef union ovsdb_receipt_buf
+{
+    OvsDb_Base_Receipt base;
+    OvsDb_Insert_Receipt insert;
+    OvsDb_Monitor_Receipt monitor;
+    OvsDb_Monitor_Cancel_Receipt monitor_cancel;
+    OvsDb_Delete_Receipt delete_count;
+    OvsDb_Insert_Batch_Receipt insert_batch;    // its uuids are allocated
+} ovsdb_receipt_buf;
 
-        case OVS_FEEDBACK_TABLE:
-            str_json = fb_insert_to_json((Feedback*) table_config->config, unique_id);
-            break;
+OVS_STATUS ovsdb_insert_to_json(json_writer * writer, Rdkb_Table_Config * table_config,
+    const char * unique_id)
+{
+    const table_desc * desc = table_desc_get(table_config->table.id);
 
-         default:
-            OvsDbApiError("%s Failed to identify config with table id %d\n",
-                __func__, table_config->table.id);
-            break;
+    if (!desc)
+    {
+        return OVS_FAILED_STATUS;
     }
 
-    return str_json;
+    return table_insert_to_json(writer, desc, table_config->config, unique_id);
 }
 
-char * ovsdb_monitor_to_json(OVS_TABLE ovsdb_table, const char * rID, const char * unique_id)
-{
-  char * table = NULL;
-  json_t *js = NULL;
-  json_t *jparams;
-  json_t *jtbl;
-  json_t *jo_col;
-  char * str_json = NULL;
-
-  if(ovsdb_table == OVS_GW_CONFIG_TABLE)
-  {
-      table = GATEWAY_CONFIG_TABLE_NAME;
-  }
-  else if(ovsdb_table == OVS_FEEDBACK_TABLE)
-  {
-      table = FEEDBACK_TABLE_NAME;
-  }
-  else
-  {
-     OvsDbApiError("%s Failed to identify config with table id %d\n",
-        __func__, ovsdb_table);
-      return NULL;
-  }
-
-  jparams = json_array();
-  json_array_append_new(jparams, json_string (OVSDB_DEF_DB));
-  json_array_append_new(jparams, json_string (unique_id));
-
-  jtbl = json_object();
-  jo_col = json_object();
-
-  json_object_set_new(jtbl, table, jo_col);
-
-  json_array_append_new(jparams, jtbl);
-
-  js = json_object();
-
-  if (json_object_set_new(js, "method", json_string("monitor")) < 0)
-  {
-      OvsDbApiError("%s Error adding method key.\n", __func__);
-      return NULL;
-  }
-
-  if (json_object_set_new(js, "params", jparams) < 0)
-  {
-      OvsDbApiError("%s Error adding params array.\n", __func__);
-      return NULL;
-  }
-
-  if (json_object_set_new(js, "id", json_string(rID)) < 0)
-  {
-      OvsDbApiError("%s Error adding ID key.\n", __func__);
-      return NULL;
-  }
-
-  str_json = json_dumps(js, JSON_COMPACT);
-  json_decref(js);
-  return str_json;
-
-  //TODO: Check to make sure we are releasing all JSON objects and this isn't memory leak.
+/**
+ * Writes one transact request inserting the 'count' rows of 'configs', in
+ * their order. OVSDB inserts all of them or none.
+**/
+OVS_STATUS ovsdb_insert_batch_to_json(json_writer * writer, Rdkb_Table_Config * configs,
+    size_t count, const char * unique_id)
+{
+    size_t i;
+
+    if (!writer || !configs || count == 0 || !unique_id)
+    {
+        return OVS_FAILED_STATUS;
+    }
+
+    json_writer_literal(writer, "{\"method\":\"transact\",\"id\":");
+    json_writer_string(writer, unique_id);
+    json_writer_literal(writer, ",\"params\":[\"" OVSDB_DEF_DB "\"");
+    for (i = 0; i < count; i++)
+    {
+        json_writer_literal(writer, ",");
+        if (table_insert_op_to_json(writer, table_desc_get(configs[i].table.id),
+            configs[i].config) != OVS_SUCCESS_STATUS)
+        {
+            return OVS_FAILED_STATUS;
+        }
+    }
+    json_writer_literal(writer, "]}");
+
+    return json_writer_finish(writer);
 }
 
-char * ovsdb_monitor_cancel_to_json(const char * old_id, const char * rID)
-{
-  json_t *js = NULL;
-  json_t *jparams = NULL;
-  char * str_json = NULL;
-
-  jparams = json_array();
-  json_array_append_new(jparams, json_string (old_id));
-  js = json_object();
-
-  if (json_object_set_new(js, "method", json_string("monitor_cancel")) < 0)
-  {
-      OvsDbApiError("%s Error adding method key.\n", __func__);
-      return NULL;
-  }
-
-  if (json_object_set_new(js, "params", jparams) < 0)
-  {
-      OvsDbApiError("%s Error adding params array.\n", __func__);
-      return NULL;
-  }
-
-  if (json_object_set_new(js, "id", json_string(rID)) < 0)
-  {
-      OvsDbApiError("%s Error adding ID key.\n", __func__);
-      return NULL;
-  }
-
-  str_json = json_dumps(js, JSON_COMPACT);
-  json_decref(js);
-  return str_json;
+static const char * ovsdb_table_name(OVS_TABLE ovsdb_table)
+{
+    const table_desc * desc = table_desc_get(ovsdb_table);
+
+    return desc ? desc->name : NULL;
 }
 
-char * ovsdb_delete_to_json(OVS_TABLE ovsdb_table, const char * rID,
-    const char * key, const char * value)
+/**
+ * Writes the members of a <monitor-request> that 'select' asks for, e.g.
+ * "columns":["status"],"select":{"initial":false,...}. Nothing is written
+ * for a NULL 'select' or one asking for everything. Each column is
+ * checked against the table's columns.
+**/
+OVS_STATUS ovsdb_select_to_json(json_writer * writer, OVS_TABLE ovsdb_table,
+    const OvsDb_Monitor_Select * select)
 {
-    char * table = NULL;
-    json_t *js = NULL;
-    json_t *jparams;
-    //json_t *jtbl;
-    //json_t *jo_col;
-    json_t * where_json;
-    char * str_json = NULL;
+    const table_desc * desc = table_desc_get(ovsdb_table);
+    const char * column = NULL;
+    size_t i;
 
-    if(ovsdb_table == OVS_GW_CONFIG_TABLE)
+    if (!writer || !desc || (select && select->num_columns > 0 && !select->columns) ||
+        (select && (select->updates & ~OVSDB_SELECT_ALL)))
     {
-        table = GATEWAY_CONFIG_TABLE_NAME;
+        return OVS_FAILED_STATUS;
     }
-    else if(ovsdb_table == OVS_FEEDBACK_TABLE)
+
+    if (select && select->num_columns > 0)
     {
-        table = FEEDBACK_TABLE_NAME;
+        json_writer_literal(writer, "\"columns\":[");
+        for (i = 0; i < select->num_columns; i++)
+        {
+            column = select->columns[i];
+            if (!column || !table_column_find(desc, column, strlen(column)))
+            {
+                OvsDbApiError("%s invalid column %zu for table %s.\n", __func__, i, desc->name);
+                return OVS_FAILED_STATUS;
+            }
+            if (i > 0)
+            {
+                json_writer_literal(writer, ",");
+            }
+            json_writer_string(writer, column);
+        }
+        json_writer_literal(writer, "]");
+    }
+
+    if (select && select->updates != 0 && select->updates != OVSDB_SELECT_ALL)
+    {
+        if (select->num_columns > 0)
+        {
+            json_writer_literal(writer, ",");
+        }
+        json_writer_literal(writer, "\"select\":{\"initial\":");
+        json_writer_bool(writer, select->updates & OVSDB_SELECT_INITIAL);
+        json_writer_literal(writer, ",\"insert\":");
+        json_writer_bool(writer, select->updates & OVSDB_SELECT_INSERT);
+        json_writer_literal(writer, ",\"delete\":");
+        json_writer_bool(writer, select->updates & OVSDB_SELECT_DELETE);
+        json_writer_literal(writer, ",\"modify\":");
+        json_writer_bool(writer, select->updates & OVSDB_SELECT_MODIFY);
+        json_writer_literal(writer, "}");
+    }
+
+    return json_writer_finish(writer);
+}
+
+/**
+ * Writes the [{<select>,"where":<where>}] array of a <monitor-cond-request>,
+ * NULL 'where' matches every row.
+**/
+static void ovsdb_monitor_cond_request(json_writer * writer, const char * select,
+    const char * where)
+{
+    json_writer_literal(writer, "[{");
+    if (select)
+    {
+        json_writer_raw(writer, select, strlen(select));
+        json_writer_literal(writer, ",");
+    }
+    json_writer_literal(writer, "\"where\":");
+    if (where)
+    {
+        json_writer_raw(writer, where, strlen(where));
     }
     else
     {
-        OvsDbApiError("%s Failed to identify config with table id %d\n",
-            __func__, ovsdb_table);
-        return NULL;
+        json_writer_literal(writer, "[true]");
     }
+    json_writer_literal(writer, "}]");
+}
 
-    jparams = json_array();
-    json_array_append_new(jparams, json_string (OVSDB_DEF_DB));
-    js = json_object();
+/**
+ * 'select' is what ovsdb_select_to_json() wrote, NULL to monitor every
+ * column and kind of update.
+**/
+OVS_STATUS ovsdb_monitor_to_json(json_writer * writer, OVS_TABLE ovsdb_table,
+    const char * select, const char * rID, const char * unique_id)
+{
+    const char * table = ovsdb_table_name(ovsdb_table);
 
-    if (json_object_set_new(js, "method", json_string("transact")) < 0)
+    if (!writer || !table || !rID || !unique_id)
     {
-        OvsDbApiError("%s Error adding method key.\n", __func__);
-        return NULL;
+        return OVS_FAILED_STATUS;
     }
-    if (json_object_set_new(js, "params", jparams) < 0)
+
+    json_writer_literal(writer, "{\"method\":\"monitor\",\"params\":[\"" OVSDB_DEF_DB "\",");
+    json_writer_string(writer, unique_id);
+    json_writer_literal(writer, ",{");
+    json_writer_string(writer, table);
+    json_writer_literal(writer, ":{");
+    if (select)
     {
-        OvsDbApiError("%s Error adding params array.\n", __func__);
-        return NULL;
+        json_writer_raw(writer, select, strlen(select));
     }
+    json_writer_literal(writer, "}}],\"id\":");
+    json_writer_string(writer, rID);
+    json_writer_literal(writer, "}");
 
-    json_t * json = json_object();
-    if (json_object_set_new(json, "op", json_string("delete")) < 0)
+    return json_writer_finish(writer);
+}
+
+static const char * const ovsdb_cond_functions[] = {
+    [OVSDB_COND_EQ] = "==",
+    [OVSDB_COND_NE] = "!=",
+    [OVSDB_COND_LT] = "<",
+    [OVSDB_COND_LE] = "<=",
+    [OVSDB_COND_GT] = ">",
+    [OVSDB_COND_GE] = ">=",
+    [OVSDB_COND_INCLUDES] = "includes",
+    [OVSDB_COND_EXCLUDES] = "excludes"
+};
+
+/**
+ * Writes the clauses of a monitor condition as the "where" array of a
+ * <monitor-cond-request>, e.g. [["req_uuid","==","<uuid>"]]. An empty list
+ * matches no row. Each clause is checked against the table's columns.
+**/
+OVS_STATUS ovsdb_where_to_json(json_writer * writer, OVS_TABLE ovsdb_table,
+    const OvsDb_Condition * where, size_t num_where)
+{
+    const table_desc * desc = table_desc_get(ovsdb_table);
+    const table_column * column = NULL;
+    const OvsDb_Condition * clause = NULL;
+    size_t i;
+
+    if (!writer || !desc || (!where && num_where > 0))
+    {
+        return OVS_FAILED_STATUS;
+    }
+
+    if (num_where == 0)
+    {
+        json_writer_literal(writer, "[false]");
+        return json_writer_finish(writer);
+    }
+
+    json_writer_literal(writer, "[");
+    for (i = 0; i < num_where; i++)
+    {
+        clause = &where[i];
+        column = clause->column ?
+            table_column_find(desc, clause->column, strlen(clause->column)) : NULL;
+        if (!column || (unsigned int) clause->function > OVSDB_COND_EXCLUDES ||
+            ((column->type == TABLE_COLUMN_STRING) != (clause->string != NULL)) ||
+            (clause->function >= OVSDB_COND_LT && clause->function <= OVSDB_COND_GE &&
+             column->type != TABLE_COLUMN_INTEGER))
+        {
+            OvsDbApiError("%s invalid clause %zu for table %s.\n", __func__, i, desc->name);
+            return OVS_FAILED_STATUS;
+        }
+
+        if (i > 0)
+        {
+            json_writer_literal(writer, ",");
+        }
+        json_writer_literal(writer, "[");
+        json_writer_string(writer, column->name);
+        json_writer_literal(writer, ",");
+        json_writer_string(writer, ovsdb_cond_functions[clause->function]);
+        json_writer_literal(writer, ",");
+        switch (column->type)
+        {
+            case TABLE_COLUMN_STRING:
+                json_writer_string(writer, clause->string);
+                break;
+
+            case TABLE_COLUMN_INTEGER:
+                json_writer_int(writer, clause->integer);
+                break;
+
+            case TABLE_COLUMN_BOOLEAN:
+                json_writer_bool(writer, clause->integer != 0);
+                break;
+        }
+        json_writer_literal(writer, "]");
+    }
+    json_writer_literal(writer, "]");
+
+    return json_writer_finish(writer);
+}
+
+/**
+ * A monitor of the rows matching 'where', as written by ovsdb_where_to_json().
+ * Its updates arrive as update2 notifications.
+**/
+OVS_STATUS ovsdb_monitor_cond_to_json(json_writer * writer, OVS_TABLE ovsdb_table,
+    const char * select, const char * where, const char * rID, const char * unique_id)
+{
+    const char * table = ovsdb_table_name(ovsdb_table);
+
+    if (!writer || !table || !where || !rID || !unique_id)
+    {
+        return OVS_FAILED_STATUS;
+    }
+
+    json_writer_literal(writer, "{\"method\":\"monitor_cond\",\"params\":[\"" OVSDB_DEF_DB "\",");
+    json_writer_string(writer, unique_id);
+    json_writer_literal(writer, ",{");
+    json_writer_string(writer, table);
+    json_writer_literal(writer, ":");
+    ovsdb_monitor_cond_request(writer, select, where);
+    json_writer_literal(writer, "}],\"id\":");
+    json_writer_string(writer, rID);
+    json_writer_literal(writer, "}");
+
+    return json_writer_finish(writer);
+}
+
+/**
+ * Same as ovsdb_monitor_cond_to_json() but only asks for the changes made
+ * after transaction 'last_txn_id'. A NULL 'where' monitors every row.
+ * Its updates arrive as update3 notifications.
+**/
+OVS_STATUS ovsdb_monitor_cond_since_to_json(json_writer * writer, OVS_TABLE ovsdb_table,
+    const char * select, const char * where, const char * last_txn_id, const char * rID,
+    const char * unique_id)
+{
+    const char * table = ovsdb_table_name(ovsdb_table);
+
+    if (!writer || !table || !last_txn_id || !rID || !unique_id)
     {
-        OvsDbApiError("%s Error adding op key.\n", __func__);
-        return NULL;
+        return OVS_FAILED_STATUS;
     }
 
-    if (json_object_set_new(json, "table", json_string(table)) < 0)
+    json_writer_literal(writer, "{\"method\":\"monitor_cond_since\",\"params\":[\"" OVSDB_DEF_DB "\",");
+    json_writer_string(writer, unique_id);
+    json_writer_literal(writer, ",{");
+    json_writer_string(writer, table);
+    json_writer_literal(writer, ":");
+    ovsdb_monitor_cond_request(writer, select, where);
+    json_writer_literal(writer, "},");
+    json_writer_string(writer, last_txn_id);
+    json_writer_literal(writer, "],\"id\":");
+    json_writer_string(writer, rID);
+    json_writer_literal(writer, "}");
+
+    return json_writer_finish(writer);
+}
+
+/**
+ * A session monitor of every table we have a codec for, all columns and
+ * kinds of updates. 'tables' has the 1 << OVS_TABLE bits of the tables
+ * whose rows it asks for, the others match no row until a
+ * monitor_cond_change adds them. With 'last_txn_id' set it is a
+ * monitor_cond_since.
+**/
+OVS_STATUS ovsdb_monitor_tables_to_json(json_writer * writer, uint32_t tables,
+    const char * last_txn_id, const char * rID, const char * unique_id)
+{
+    const table_desc * desc = NULL;
+    size_t i;
+
+    if (!writer || !rID || !unique_id)
     {
-        OvsDbApiError("%s Error adding table key.\n", __func__);
-        return NULL;
+        return OVS_FAILED_STATUS;
     }
 
+    if (last_txn_id)
+    {
+        json_writer_literal(writer, "{\"method\":\"monitor_cond_since\",\"params\":[\"" OVSDB_DEF_DB "\",");
+    }
+    else
+    {
+        json_writer_literal(writer, "{\"method\":\"monitor_cond\",\"params\":[\"" OVSDB_DEF_DB "\",");
+    }
+    json_writer_string(writer, unique_id);
+    json_writer_literal(writer, ",{");
+    for (i = 0; i < OVSDB_SCHEMA_TABLE_COUNT; i++)
+    {
+        desc = &ovsdb_schema_tables[i];
+        if (i > 0)
+        {
+            json_writer_literal(writer, ",");
+        }
+        json_writer_string(writer, desc->name);
+        json_writer_literal(writer, ":");
+        ovsdb_monitor_cond_request(writer, NULL,
+            (tables & (1u << desc->id)) ? "[true]" : "[false]");
+    }
+    json_writer_literal(writer, "}");
+    if (last_txn_id)
+    {
+        json_writer_literal(writer, ",");
+        json_writer_string(writer, last_txn_id);
+    }
+    json_writer_literal(writer, "],\"id\":");
+    json_writer_string(writer, rID);
+    json_writer_literal(writer, "}");
+
+    return json_writer_finish(writer);
+}
+
+/**
+ * Replaces the condition of the conditional monitor 'monitor_id', which
+ * keeps its id.
+**/
+OVS_STATUS ovsdb_monitor_cond_change_to_json(json_writer * writer, OVS_TABLE ovsdb_table,
+    const char * where, const char * monitor_id, const char * rID)
+{
+    const char * table = ovsdb_table_name(ovsdb_table);
+
+    if (!writer || !table || !where || !monitor_id || !rID)
+    {
+        return OVS_FAILED_STATUS;
+    }
+
+    json_writer_literal(writer, "{\"method\":\"monitor_cond_change\",\"params\":[");
+    json_writer_string(writer, monitor_id);
+    json_writer_literal(writer, ",");
+    json_writer_string(writer, monitor_id);
+    json_writer_literal(writer, ",{");
+    json_writer_string(writer, table);
+    json_writer_literal(writer, ":[{\"where\":");
+    json_writer_raw(writer, where, strlen(where));
+    json_writer_literal(writer, "}]}],\"id\":");
+    json_writer_string(writer, rID);
+    json_writer_literal(writer, "}");
+
+    return json_writer_finish(writer);
+}
+
+OVS_STATUS ovsdb_monitor_cancel_to_json(json_writer * writer, const char * old_id,
+    const char * rID)
+{
+    if (!writer || !old_id || !rID)
+    {
+        return OVS_FAILED_STATUS;
+    }
+
+    json_writer_literal(writer, "{\"method\":\"monitor_cancel\",\"params\":[");
+    json_writer_string(writer, old_id);
+    json_writer_literal(writer, "],\"id\":");
+    json_writer_string(writer, rID);
+    json_writer_literal(writer, "}");
+
+    return json_writer_finish(writer);
+}
+
+OVS_STATUS ovsdb_delete_to_json(json_writer * writer, OVS_TABLE ovsdb_table,
+    const char * rID, const char * key, const char * value)
+{
+    const char * table = ovsdb_table_name(ovsdb_table);
+
+    if (!writer || !table || !rID || !key || !value)
+    {
+        return OVS_FAILED_STATUS;
+    }
+
+    json_writer_literal(writer, "{\"method\":\"transact\",\"params\":[\"" OVSDB_DEF_DB "\","
+        "{\"op\":\"delete\",\"table\":");
+    json_writer_string(writer, table);
+    json_writer_literal(writer, ",\"where\":[[");
+
     if ((strcmp(OVSDB_TABLE_UUID, key) == 0) ||
         (strcmp(OVSDB_TABLE_UUID_ALT, key)== 0))
     {
-        json_t * uuid_json = json_pack("[s,s]", OVSDB_TABLE_UUID, value);
-        where_json = json_pack("[[s,s,o]]", OVSDB_TABLE_UUID_ALT, "==", uuid_json);
+        json_writer_literal(writer, "\"" OVSDB_TABLE_UUID_ALT "\",\"==\",[\"" OVSDB_TABLE_UUID "\",");
+        json_writer_string(writer, value);
+        json_writer_literal(writer, "]");
     }
     else
     {
-        where_json = json_pack("[[s,s,s]]", key, "==", value);
+        json_writer_string(writer, key);
+        json_writer_literal(writer, ",\"==\",");
+        json_writer_string(writer, value);
     }
-    if (json_object_set_new(json, "where", where_json) < 0)
+
+    json_writer_literal(writer, "]]}],\"id\":");
+    json_writer_string(writer, rID);
+    json_writer_literal(writer, "}");
+
+    return json_writer_finish(writer);
+}
+
+OVS_STATUS ovsdb_echo_to_json(json_writer * writer, const char * rID)
+{
+    if (!writer || !rID)
     {
-        OvsDbApiError("%s Error adding where key.\n", __func__);
-        return NULL;
+        return OVS_FAILED_STATUS;
     }
-    json_array_append_new(jparams, json);
 
-    if (json_object_set_new(js, "id", json_string(rID)) < 0)
+    json_writer_literal(writer, "{\"method\":\"echo\",\"params\":[],\"id\":");
+    json_writer_string(writer, rID);
+    json_writer_literal(writer, "}");
+
+    return json_writer_finish(writer);
+}
+
+/**
+ * Answers an echo request from ovsdb-server with its own params.
+**/
+static OVS_STATUS ovsdb_reply_echo(const ovsdb_msg_target * target, json_t* id,
+    json_t* params)
+{
+    OVS_STATUS status = OVS_FAILED_STATUS;
+    json_t *js = NULL;
+    char * str_json = NULL;
+
+    if (!target->reply_fn)
     {
-        OvsDbApiError("%s Error adding ID key.\n", __func__);
-        return NULL;
+        OvsDbApiWarning("%s no reply function set, ignoring echo request.\n",
+            __func__);
+        return OVS_SUCCESS_STATUS;
     }
 
+    js = json_object();
+    json_object_set(js, "id", id);
+    json_object_set_new(js, "result", params ? json_incref(params) : json_array());
+    json_object_set_new(js, "error", json_null());
+
     str_json = json_dumps(js, JSON_COMPACT);
     json_decref(js);
-    return str_json;
+    if (str_json)
+    {
+        status = target->reply_fn(target->reply_data, str_json, strlen(str_json));
+        free(str_json);
+    }
+    return status;
 }
 
-OVS_STATUS ovsdb_parse_msg(const char* json_str, size_t size)
+/**
+ * Reads the top level members of the message at 'msg' without decoding
+ * their values, 'used' is set to the length of the message.
+**/
+static OVS_STATUS ovsdb_stream_scan(const char * msg, size_t size,
+    ovsdb_msg_members * members, size_t * used)
 {
-    OVS_STATUS status = OVS_FAILED_STATUS;
-    json_error_t error;
-    json_t* msg = NULL;
-    size_t bytes_read = 0;
+    json_reader reader;
+    json_token key;
+    json_token value;
+    size_t start = 0;
 
-    if (!json_str)
+    memset(members, 0, sizeof(ovsdb_msg_members));
+    json_reader_init(&reader, msg, size);
+    if (json_reader_next(&reader, &value) != JSON_TOKEN_OBJECT_START)
     {
-        OvsDbApiError("%s JSON message is NULL.\n", __func__);
         return OVS_FAILED_STATUS;
     }
 
-    do
+    while (json_reader_next(&reader, &key) == JSON_TOKEN_KEY)
     {
-        msg = json_loads(json_str, JSON_DISABLE_EOF_CHECK, &error);
-        if (!msg)
+        json_reader_next(&reader, &value);
+        if (value.type == JSON_TOKEN_ERROR)
         {
-            OvsDbApiError("%s failed to parse JRPC: %s\n",
-                __func__, error.text);
             return OVS_FAILED_STATUS;
         }
+        // a string token starts after its opening quote
+        start = (size_t)(value.start - msg) - (value.type == JSON_TOKEN_STRING ? 1 : 0);
 
-        bytes_read += error.position;
-        json_str += error.position;
-        OvsDbApiDebug("%s position=%d, bytes read=%zu, size=%zu\n",
-            __func__, error.position, bytes_read, size);
+        if (json_reader_skip(&reader, &value) != OVS_SUCCESS_STATUS)
+        {
+            return OVS_FAILED_STATUS;
+        }
 
-        json_t* id = json_object_get(msg, "id");
-        if (!id)
+        if (json_token_equals(&key, "id"))
+        {
+            members->id = value;
+        }
+        else if (json_token_equals(&key, "method"))
+        {
+            members->method = value;
+        }
+        else if (json_token_equals(&key, "error"))
         {
-            OvsDbApiError("%s cannot fetch ID from the JRPC, must be malformed message.\n",
-                __func__);
-            return OVS_FAILED_STATUS; // TODO: Use more meaningful OVS_STATUS code
+            members->error = value;
         }
+        else if (json_token_equals(&key, "params"))
+        {
+            members->params = msg + start;
+            members->params_len = reader.pos - start;
+        }
+        else if (json_token_equals(&key, "result"))
+        {
+            members->result = msg + start;
+            members->result_len = reader.pos - start;
+        }
+    }
+
+    if (key.type != JSON_TOKEN_OBJECT_END)
+    {
+        return OVS_FAILED_STATUS;
+    }
+
+    *used = reader.pos;
+    return OVS_SUCCESS_STATUS;
+}
+
+/**
+ * Decodes a row's {"new":{...},"old":{...}} of an update, or the
+ * {"initial"|"insert":{...}}, {"modify":{...}} or {"delete":null} of an
+ * update2, and hands the change to the monitor. 'initial' is set for the
+ * rows a monitor starts with, see mon_list_update() for who gets what.
+ * 'count' is incremented for every row.
+**/
+static OVS_STATUS ovsdb_stream_row(mon_list * monitors, const char * uuid,
+    const table_desc * desc, json_reader * reader, const char * row_uuid, bool initial,
+    OVS_STATUS * delivered, int * count)
+{
+    Rdkb_Table_Config table_config;
+    ovsdb_table_row row;
+    ovsdb_row_delta delta;
+    mon_row_change change;
+    json_token key;
+    json_token value;
+    OVS_STATUS status = OVS_SUCCESS_STATUS;
+    bool has_old = false;
+
+    memset(&change, 0, sizeof(change));
+    change.uuid = row_uuid;
+    change.desc = desc;
+    if (json_reader_next(reader, &value) != JSON_TOKEN_OBJECT_START)
+    {
+        OvsDbApiError("%s invalid row in %s monitor update.\n", __func__, desc->name);
+        return OVS_FAILED_STATUS;
+    }
 
-        if (json_is_null(id))
+    while (json_reader_next(reader, &key) == JSON_TOKEN_KEY)
+    {
+        json_reader_next(reader, &value);
+        if (json_token_equals(&key, "new") || json_token_equals(&key, "initial") ||
+            json_token_equals(&key, "insert"))
+        {
+            // a row is initial for being in the response to the monitor request
+            status = parse_table_row(desc->name, reader, &value, &row, &table_config);
+            change.type = OVSDB_SELECT_INSERT;
+            change.row = &row;
+        }
+        else if (json_token_equals(&key, "old") || json_token_equals(&key, "modify"))
         {
-            //TODO: Check 'method' to make sure it's monitor update
-            json_t* method = json_object_get(msg, "method");
-            if (!method || json_is_string(method) == 0)
+            status = parse_table_delta(desc, reader, &value, &delta);
+            has_old = json_token_equals(&key, "old");
+            if (!has_old)
             {
-                OvsDbApiError("The value of 'method' within JSON string is invalid.\n");
-                return OVS_FAILED_STATUS;
+                change.type = OVSDB_SELECT_MODIFY;
+                change.delta = &delta;
             }
-            OvsDbApiDebug("%s JSON monitor update (id=null).\n", __func__);
-            json_t* params = json_object_get(msg, "params");
-            if (!params || json_is_array(params) == 0)
+        }
+        else
+        {
+            status = json_reader_skip(reader, &value);
+            if (json_token_equals(&key, "delete"))
             {
-                OvsDbApiError("The value of 'params' with monitor update is invalid.\n");
-                return OVS_FAILED_STATUS;
+                change.type = OVSDB_SELECT_DELETE;
             }
+        }
 
-            status = ovsdb_parse_params(params);
+        if (status != OVS_SUCCESS_STATUS)
+        {
+            OvsDbApiError("%s failed to parse row %s of UUID: %s.\n", __func__,
+                row_uuid, uuid);
+            return OVS_FAILED_STATUS;
         }
-        else
+    }
+
+    if (key.type != JSON_TOKEN_OBJECT_END)
+    {
+        return OVS_FAILED_STATUS;
+    }
+
+    if (has_old && change.row)
+    {   // "old" has the columns a modify changed
+        change.type = OVSDB_SELECT_MODIFY;
+        change.changed = delta.present;
+    }
+    else if (has_old)
+    {   // and all of them for a delete
+        change.type = OVSDB_SELECT_DELETE;
+        change.row = &delta.first;
+    }
+    else if (!change.type)
+    {
+        OvsDbApiWarning("%s UUID: %s - Ignoring %s monitor update. Inner UUID: %s\n",
+            __func__, uuid, desc->name, row_uuid);
+        return OVS_SUCCESS_STATUS;
+    }
+
+    if (initial && change.type == OVSDB_SELECT_INSERT)
+    {
+        change.type = OVSDB_SELECT_INITIAL;
+    }
+
+    OvsDbApiDebug("%s Table %s uuid=%s type=%d\n", __func__, desc->name, row_uuid,
+        change.type);
+    (*count)++;
+    if (mon_list_update(monitors, uuid, &change) != OVS_SUCCESS_STATUS)
+    {
+        OvsDbApiError("%s failed to process monitor update for UUID: %s.\n",
+            __func__, uuid);
+        *delivered = OVS_FAILED_STATUS;
+    }
+    return OVS_SUCCESS_STATUS;
+}
+
+/**
+ * Decodes a <table-updates> object whose opening brace has been read,
+ * {"<table>":{"<row uuid>":{"new":{...}}, ...}}, delivering each row as
+ * soon as it is read. 'initial' and 'count' are as for ovsdb_stream_row().
+**/
+static OVS_STATUS ovsdb_stream_tables(mon_list * monitors, const char * uuid,
+    json_reader * reader, bool initial, OVS_STATUS * delivered, int * count)
+{
+    const table_desc * desc = NULL;
+    char row_uuid[MAX_UUID_LEN + 1];
+    json_token token;
+
+    while (json_reader_next(reader, &token) == JSON_TOKEN_KEY)
+    {
+        if (token.escaped || (desc = table_desc_find(token.start, token.len)) == NULL ||
+            json_reader_next(reader, &token) != JSON_TOKEN_OBJECT_START)
         {
-            status = receipt_list_process(json_string_value(id), json_object_get(msg, "result"));
+            OvsDbApiError("%s invalid table in monitor update for UUID: %s\n",
+                __func__, uuid);
+            return OVS_FAILED_STATUS;
         }
-    } while (bytes_read != size);
 
+        while (json_reader_next(reader, &token) == JSON_TOKEN_KEY)
+        {
+            if (json_token_copy(&token, row_uuid, sizeof(row_uuid)) != OVS_SUCCESS_STATUS ||
+                ovsdb_stream_row(monitors, uuid, desc, reader, row_uuid, initial,
+                    delivered, count) != OVS_SUCCESS_STATUS)
+            {
+                return OVS_FAILED_STATUS;
+            }
+        }
+    }
+
+    return (token.type == JSON_TOKEN_OBJECT_END) ? OVS_SUCCESS_STATUS : OVS_FAILED_STATUS;
+}
+
+/** Re-issues monitor 'uuid' if its cache missed a row of what was just decoded **/
+static void ovsdb_stream_resync(const ovsdb_msg_target * target, const char * uuid)
+{
+    if (target->resync_fn && mon_list_take_resync(target->monitors, uuid))
+    {
+        target->resync_fn(target->txn_data, uuid);
+    }
+}
+
+/**
+ * Decodes the params of an update or update2 notification,
+ * ["<monitor id>",{"<table>":{"<row uuid>":{"new":{...}}, ...}}], or of an
+ * update3 which has the last transaction id after the monitor id.
+**/
+static OVS_STATUS ovsdb_stream_update(const ovsdb_msg_target * target, const char * params,
+    size_t len, bool has_txn)
+{
+    char uuid[MAX_UUID_LEN + 1];
+    char txn_id[MAX_UUID_LEN + 1];
+    json_reader reader;
+    json_token token;
+    OVS_STATUS status = OVS_SUCCESS_STATUS;
+    int count = 0;
+
+    json_reader_init(&reader, params, len);
+    if (json_reader_next(&reader, &token) != JSON_TOKEN_ARRAY_START ||
+        json_reader_next(&reader, &token) != JSON_TOKEN_STRING ||
+        json_token_copy(&token, uuid, sizeof(uuid)) != OVS_SUCCESS_STATUS)
+    {
+        OvsDbApiError("Unable to get the UUID from the monitor update.\n");
+        return OVS_FAILED_STATUS;
+    }
+
+    if (has_txn && (json_reader_next(&reader, &token) != JSON_TOKEN_STRING ||
+        json_token_copy(&token, txn_id, sizeof(txn_id)) != OVS_SUCCESS_STATUS))
+    {
+        OvsDbApiError("Unable to get the transaction id from the monitor update.\n");
+        return OVS_FAILED_STATUS;
+    }
+
+    while (json_reader_next(&reader, &token) == JSON_TOKEN_OBJECT_START)
+    {
+        if (ovsdb_stream_tables(target->monitors, uuid, &reader, false, &status,
+            &count) != OVS_SUCCESS_STATUS)
+        {
+            (void)mon_list_flush(target->monitors, uuid);
+            ovsdb_stream_resync(target, uuid);
+            return OVS_FAILED_STATUS;
+        }
+    }
+
+    // the rows read so far are in the monitor's rows, a batch must see them too
+    (void)mon_list_flush(target->monitors, uuid);
+    ovsdb_stream_resync(target, uuid);
+    if (token.type != JSON_TOKEN_ARRAY_END)
+    {
+        OvsDbApiError("Unable to get the object from the monitor update.\n");
+        return OVS_FAILED_STATUS;
+    }
+
+    // only once the rows are delivered, a restart then repeats rather than loses them
+    if (has_txn && target->txn_fn)
+    {
+        target->txn_fn(target->txn_data, txn_id);
+    }
     return status;
 }
 
-static OVS_STATUS ovsdb_parse_params(json_t* params)
+/**
+ * Decodes the result of a monitor_cond_since, [<found>,"<last txn id>",
+ * {<table-updates2>}]. The request id is the monitor's id. When the
+ * server found our last transaction the updates are what changed since
+ * and are delivered, otherwise they are the initial contents which, as for
+ * any other monitor, replace the rows the monitor had.
+**/
+static OVS_STATUS ovsdb_stream_since(const ovsdb_msg_target * target, const char * rid,
+    const char * result, size_t len, ovsdb_receipt_buf * receipt)
+{
+    char txn_id[MAX_UUID_LEN + 1];
+    json_reader reader;
+    json_token token;
+    json_token found;
+    OVS_STATUS status = OVS_SUCCESS_STATUS;
+    OVS_STATUS delivered = OVS_SUCCESS_STATUS;  // failures are logged per row
+
+    memset(receipt, 0, sizeof(ovsdb_receipt_buf));
+    receipt->base.receipt_id = OVSDB_MONITOR_COND_SINCE_RECEIPT_ID;
+    json_reader_init(&reader, result, len);
+
+    if (json_reader_next(&reader, &token) != JSON_TOKEN_ARRAY_START ||
+        (json_reader_next(&reader, &found) != JSON_TOKEN_TRUE &&
+         found.type != JSON_TOKEN_FALSE) ||
+        json_reader_next(&reader, &token) != JSON_TOKEN_STRING ||
+        json_token_copy(&token, txn_id, sizeof(txn_id)) != OVS_SUCCESS_STATUS ||
+        json_reader_next(&reader, &token) != JSON_TOKEN_OBJECT_START)
+    {
+        return OVS_FAILED_STATUS;
+    }
+
+    receipt->monitor.resumed = (found.type == JSON_TOKEN_TRUE);
+    if (!receipt->monitor.resumed)
+    {
+        (void)mon_list_reset_rows(target->monitors, rid);
+    }
+    status = ovsdb_stream_tables(target->monitors, rid, &reader, !receipt->monitor.resumed,
+        &delivered, &receipt->monitor.update_count);
+    (void)mon_list_flush(target->monitors, rid);
+    if (status != OVS_SUCCESS_STATUS ||
+        json_reader_next(&reader, &token) != JSON_TOKEN_ARRAY_END)
+    {
+        return OVS_FAILED_STATUS;
+    }
+
+    (void)mon_list_set_synced(target->monitors, rid);
+    // the changes since are deltas as well
+    ovsdb_stream_resync(target, rid);
+    OvsDbApiInfo("%s monitor %s %s at transaction %s, %d rows.\n", __func__,
+        rid, receipt->monitor.resumed ? "resumed" : "started", txn_id,
+        receipt->monitor.update_count);
+    if (target->txn_fn)
+    {
+        target->txn_fn(target->txn_data, txn_id);
+    }
+    return OVS_SUCCESS_STATUS;
+}
+
+/**
+ * Decodes the result of a monitor or monitor_cond, the <table-updates>
+ * with the rows the monitor starts with. They replace the rows the monitor
+ * had and are not delivered to its callback, unless the monitor is being
+ * re-synced and they changed, see mon_list_take_resync().
+**/
+static OVS_STATUS ovsdb_stream_initial(const ovsdb_msg_target * target, const char * rid,
+    const char * result, size_t len, ovsdb_receipt_buf * receipt)
 {
-    size_t index;
-    json_t* value;
-    const char * uuid = NULL;
+    char uuid[MAX_UUID_LEN + 1];
+    json_reader reader;
+    json_token token;
     OVS_STATUS status = OVS_SUCCESS_STATUS;
+    OVS_STATUS delivered = OVS_SUCCESS_STATUS;  // failures are logged per row
+
+    memset(receipt, 0, sizeof(ovsdb_receipt_buf));
+    receipt->base.receipt_id = OVSDB_MONITOR_RECEIPT_ID;
+    if (!target->monitors ||
+        mon_list_find_request(target->monitors, rid, uuid) != OVS_SUCCESS_STATUS)
+    {   // e.g. cancelled in the meantime, the rows are of no use
+        return OVS_SUCCESS_STATUS;
+    }
+
+    (void)mon_list_reset_rows(target->monitors, uuid);
+    json_reader_init(&reader, result, len);
+    if (json_reader_next(&reader, &token) != JSON_TOKEN_OBJECT_START)
+    {
+        return OVS_FAILED_STATUS;
+    }
+
+    status = ovsdb_stream_tables(target->monitors, uuid, &reader, true, &delivered,
+        &receipt->monitor.update_count);
+    (void)mon_list_flush(target->monitors, uuid);
+    if (status != OVS_SUCCESS_STATUS)
+    {
+        return OVS_FAILED_STATUS;
+    }
+
+    (void)mon_list_set_synced(target->monitors, uuid);
+    OvsDbApiDebug("%s monitor %s started with %d rows.\n", __func__, uuid,
+        receipt->monitor.update_count);
+    return OVS_SUCCESS_STATUS;
+}
+
+/**
+ * Reads the first operation result of a transact response, i.e. the
+ * reader is left inside the object at result[0].
+**/
+static OVS_STATUS ovsdb_stream_first_op(json_reader * reader)
+{
+    json_token token;
 
-    if (!params)
+    if (json_reader_next(reader, &token) != JSON_TOKEN_ARRAY_START ||
+        json_reader_next(reader, &token) != JSON_TOKEN_OBJECT_START)
     {
-        OvsDbApiError("%s params is NULL.\n", __func__);
         return OVS_FAILED_STATUS;
     }
+    return OVS_SUCCESS_STATUS;
+}
 
-    //TODO: Add check to make sure params is an array
+/**
+ * Reads the rest of an operation result whose opening brace has been read,
+ * {"uuid":["uuid","<uuid>"], ...}. Fails if it has no uuid, e.g. when it
+ * is {"error":...}.
+**/
+static OVS_STATUS ovsdb_stream_op_uuid(json_reader * reader, char * uuid, size_t size)
+{
+    json_token key;
+    json_token value;
+    bool found = false;
 
-    json_array_foreach(params, index, value)
+    while (json_reader_next(reader, &key) == JSON_TOKEN_KEY)
     {
-        if (index == 0)
+        json_reader_next(reader, &value);
+        if (!json_token_equals(&key, OVSDB_TABLE_UUID))
         {
-            if (!value || json_is_string(value) == 0)
+            if (json_reader_skip(reader, &value) != OVS_SUCCESS_STATUS)
             {
-                OvsDbApiError("Unable to get the UUID from the monitor update.\n");
                 return OVS_FAILED_STATUS;
             }
+            continue;
+        }
 
-            uuid = json_string_value(value);
+        if (value.type != JSON_TOKEN_ARRAY_START ||
+            json_reader_next(reader, &value) != JSON_TOKEN_STRING ||
+            !json_token_equals(&value, OVSDB_TABLE_UUID) ||
+            json_reader_next(reader, &value) != JSON_TOKEN_STRING ||
+            json_token_copy(&value, uuid, size) != OVS_SUCCESS_STATUS ||
+            json_reader_next(reader, &value) != JSON_TOKEN_ARRAY_END)
+        {
+            return OVS_FAILED_STATUS;
         }
-        else
+        found = true;
+    }
+    return (found && key.type == JSON_TOKEN_OBJECT_END) ? OVS_SUCCESS_STATUS :
+        OVS_FAILED_STATUS;
+}
+
+/**
+ * Decodes the result of ovsdb_write_batch(), [{"uuid":["uuid","<uuid>"]}, ...]
+ * with one operation per row. The rows are counted first so that their
+ * uuids are allocated at once, the caller frees them.
+**/
+static OVS_STATUS ovsdb_stream_batch(json_reader * reader, OvsDb_Insert_Batch_Receipt * batch)
+{
+    json_reader rows;
+    json_token token;
+    size_t count = 0;
+
+    if (json_reader_next(reader, &token) != JSON_TOKEN_ARRAY_START)
+    {
+        return OVS_FAILED_STATUS;
+    }
+
+    rows = *reader;
+    while (json_reader_next(&rows, &token) == JSON_TOKEN_OBJECT_START)
+    {
+        if (json_reader_skip(&rows, &token) != OVS_SUCCESS_STATUS)
         {
-            if (!value || json_is_object(value) == 0)
+            return OVS_FAILED_STATUS;
+        }
+        count++;
+    }
+    if (token.type != JSON_TOKEN_ARRAY_END || count == 0)
+    {
+        return OVS_FAILED_STATUS;
+    }
+
+    batch->uuids = (char (*)[MAX_UUID_LEN + 1])malloc(count * sizeof(*batch->uuids));
+    if (!batch->uuids)
+    {
+        OvsDbApiError("%s failed to allocate %zu uuids\n", __func__, count);
+        return OVS_FAILED_STATUS;
+    }
+    batch->failed_row = -1;
+    while (batch->count < count &&
+        json_reader_next(reader, &token) == JSON_TOKEN_OBJECT_START &&
+        ovsdb_stream_op_uuid(reader, batch->uuids[batch->count],
+            sizeof(*batch->uuids)) == OVS_SUCCESS_STATUS)
+    {
+        batch->count++;
+    }
+
+    if (batch->count < count)
+    {   // e.g. a refused row
+        free(batch->uuids);
+        batch->uuids = NULL;
+        batch->count = 0;
+        return OVS_FAILED_STATUS;
+    }
+    return OVS_SUCCESS_STATUS;
+}
+
+/**
+ * Decodes the result of a request of type 'receipt_id' into 'receipt'.
+ * Fails for shapes it does not know, e.g. a failed operation, which are
+ * then left to the jansson based receipt parsers.
+**/
+static OVS_STATUS ovsdb_stream_result(OVSDB_RECEIPT_ID receipt_id, const char * result,
+    size_t len, ovsdb_receipt_buf * receipt)
+{
+    json_reader reader;
+    json_token key;
+    json_token value;
+
+    memset(receipt, 0, sizeof(ovsdb_receipt_buf));
+    receipt->base.receipt_id = receipt_id;
+    json_reader_init(&reader, result, len);
+
+    switch (receipt_id)
+    {
+        case OVSDB_INSERT_RECEIPT_ID:
+            // [{"uuid":["uuid","<uuid>"]}, ...]
+            if (ovsdb_stream_first_op(&reader) != OVS_SUCCESS_STATUS)
             {
-                OvsDbApiError("Unable to get the object from the monitor update.\n");
                 return OVS_FAILED_STATUS;
             }
+            return ovsdb_stream_op_uuid(&reader, receipt->insert.uuid,
+                sizeof(receipt->insert.uuid));
+
+        case OVSDB_INSERT_BATCH_RECEIPT_ID:
+            return ovsdb_stream_batch(&reader, &receipt->insert_batch);
 
-            status = ovsdb_parse_monitor_update(uuid, value);
-            if (status != OVS_SUCCESS_STATUS)
+        case OVSDB_DELETE_RECEIPT_ID:
+            // [{"count":<n>}, ...]
+            if (ovsdb_stream_first_op(&reader) != OVS_SUCCESS_STATUS)
+            {
+                return OVS_FAILED_STATUS;
+            }
+            while (json_reader_next(&reader, &key) == JSON_TOKEN_KEY)
             {
-                OvsDbApiError("%s failed to parse monitor update for UUID: %s\n",
-                    __func__, uuid);
+                json_reader_next(&reader, &value);
+                if (json_token_equals(&key, "count"))
+                {
+                    return json_token_to_int(&value, &receipt->delete_count.count);
+                }
+                if (json_reader_skip(&reader, &value) != OVS_SUCCESS_STATUS)
+                {
+                    return OVS_FAILED_STATUS;
+                }
             }
-        }
+            return OVS_FAILED_STATUS;
+
+        case OVSDB_MONITOR_CANCEL_RECEIPT_ID:
+            receipt->monitor_cancel.is_successful = true;
+            return OVS_SUCCESS_STATUS;
+
+        case OVSDB_ECHO_RECEIPT_ID:
+        case OVSDB_MONITOR_COND_CHANGE_RECEIPT_ID:
+            return OVS_SUCCESS_STATUS;
+
+        default:
+            return OVS_FAILED_STATUS;
     }
+}
 
-    return status;
+/** Decodes the result of request 'rid' into 'receipt' **/
+static OVS_STATUS ovsdb_stream_receipt(const ovsdb_msg_target * target, const char * rid,
+    OVSDB_RECEIPT_ID receipt_id, const char * result, size_t len, ovsdb_receipt_buf * receipt)
+{
+    switch (receipt_id)
+    {
+        case OVSDB_MONITOR_RECEIPT_ID:
+            return ovsdb_stream_initial(target, rid, result, len, receipt);
+
+        case OVSDB_MONITOR_COND_SINCE_RECEIPT_ID:
+            return ovsdb_stream_since(target, rid, result, len, receipt);
+
+        default:
+            return ovsdb_stream_result(receipt_id, result, len, receipt);
+    }
 }
 
-static OVS_STATUS ovsdb_parse_monitor_update(const char * uuid, json_t* update)
+/**
+ * Handles the message at 'msg' straight from its text when it is one of
+ * the shapes we receive in bulk, monitor updates and successful responses.
+ * 'fallback' is set when the message must go through jansson instead,
+ * nothing has been delivered in that case.
+**/
+static OVS_STATUS ovsdb_stream_msg(const char * msg, size_t size,
+    const ovsdb_msg_target * target, size_t * used, bool * fallback)
 {
+    ovsdb_msg_members members;
+    ovsdb_receipt_buf receipt;
+    OVSDB_RECEIPT_ID receipt_id = OVSDB_UNKNOWN_RECEIPT_ID;
     OVS_STATUS status = OVS_FAILED_STATUS;
-    char* str_json = NULL;
+    char rid[MAX_UUID_LEN + 1];
 
-    str_json = json_dumps(update, JSON_COMPACT);
-    OvsDbApiDebug("%s UUID: %s, %s\n", __func__, uuid, str_json);
-    free(str_json);
+    *fallback = true;
+    *used = 0;
+    if (ovsdb_stream_scan(msg, size, &members, used) != OVS_SUCCESS_STATUS)
+    {
+        return OVS_FAILED_STATUS;
+    }
 
-    if (json_object_size(update) != 1)
+    if (members.id.type == JSON_TOKEN_NULL && members.params &&
+        (json_token_equals(&members.method, "update") ||
+         json_token_equals(&members.method, "update2") ||
+         json_token_equals(&members.method, "update3")))
+    {
+        OvsDbApiDebug("%s JSON monitor update (id=null).\n", __func__);
+        *fallback = false;
+        return ovsdb_stream_update(target, members.params, members.params_len,
+            json_token_equals(&members.method, "update3"));
+    }
+
+    if (members.id.type != JSON_TOKEN_STRING || members.method.type != JSON_TOKEN_ERROR ||
+        !members.result || (members.error.type != JSON_TOKEN_ERROR &&
+        members.error.type != JSON_TOKEN_NULL) || !target->receipts ||
+        json_token_copy(&members.id, rid, sizeof(rid)) != OVS_SUCCESS_STATUS ||
+        receipt_list_get_type(target->receipts, rid, &receipt_id) != OVS_SUCCESS_STATUS ||
+        ovsdb_stream_receipt(target, rid, receipt_id, members.result, members.result_len,
+            &receipt) != OVS_SUCCESS_STATUS)
     {
-        OvsDbApiError("%s as the size of the update object isn't 1\n",
-            __func__);
         return OVS_FAILED_STATUS;
     }
 
-    void* iter = json_object_iter(update);
-    const char* table_name = json_object_iter_key(iter);
-    json_t* table_value = json_object_iter_value(iter);
+    *fallback = false;
+    status = receipt_list_complete(target->receipts, rid, &receipt.base);
+    if (receipt_id == OVSDB_INSERT_BATCH_RECEIPT_ID)
+    {   // only valid during the callback
+        free(receipt.insert_batch.uuids);
+    }
+    return status;
+}
+
+/**
+ * Parses the message at 'msg' with jansson, for anything the streaming
+ * decoder does not handle. 'used' is left at 0 if the stream cannot be
+ * parsed any further.
+**/
+static OVS_STATUS ovsdb_parse_json_msg(const char * msg, size_t size,
+    const ovsdb_msg_target * target, size_t * used)
+{
+    OVS_STATUS status = OVS_FAILED_STATUS;
+    json_error_t error;
+    json_t* json = NULL;
+
+    *used = 0;
 
-    void* update_iter = json_object_iter(table_value);
-    while (update_iter)
+    // msg isn't required to be null terminated, it may point into the framer's buffer
+    json = json_loadb(msg, size, JSON_DISABLE_EOF_CHECK, &error);
+    if (!json)
     {
-        const char* update_uuid = json_object_iter_key(update_iter);
-        json_t* value = json_object_iter_value(update_iter);
+        OvsDbApiError("%s failed to parse JRPC: %s\n",
+            __func__, error.text);
+        return OVS_FAILED_STATUS;
+    }
 
-        void* value_iter = json_object_iter(value);
-        const char* update_type = json_object_iter_key(value_iter);
-        OvsDbApiDebug("%s Table %s uuid=%s, type=%s\n", __func__,
-            table_name, update_uuid, update_type);
+    json_t* id = json_object_get(json, "id");
+    if (!id)
+    {
+        OvsDbApiError("%s cannot fetch ID from the JRPC, must be malformed message.\n",
+            __func__);
+        json_decref(json);
+        return OVS_FAILED_STATUS; // TODO: Use more meaningful OVS_STATUS code
+    }
 
-        json_t* new_update = json_object_get(value, "new");
-        if (!new_update)
-        {   // handles and discards an update of type 'old' i.e. delete requests
-            OvsDbApiWarning(
-                "%s UUID: %s - Ignoring %s monitor update. Inner UUID: %s, Type %s!\n",
-                __func__, uuid, table_name, update_uuid, update_type);
-            status = OVS_SUCCESS_STATUS;
+    if (json_is_null(id))
+    {   // updates are only decoded from the text, one it rejected is malformed
+        OvsDbApiError("%s dropping malformed notification.\n", __func__);
+        status = OVS_FAILED_STATUS;
+    }
+    else if (json_object_get(json, "method"))
+    {   // a request from the server, the only one expected is echo
+        json_t* method = json_object_get(json, "method");
+        if (json_is_string(method) && strcmp(json_string_value(method), "echo") == 0)
+        {
+            status = ovsdb_reply_echo(target, id, json_object_get(json, "params"));
         }
         else
         {
-            OvsAgent_Table_Config table_config = { 0 };
-
-            strncpy(table_config.uuid, update_uuid, sizeof(table_config.uuid));
-            table_config.uuid[ sizeof(table_config.uuid)-1 ] = '\0';
+            OvsDbApiWarning("%s ignoring unsupported request.\n", __func__);
+            status = OVS_FAILED_STATUS;
+        }
+    }
+    else
+    {   // e.g. a response with an error, which the streaming decoder leaves to us
+        const char * rid = json_string_value(id);
+        json_t* rpc_error = json_object_get(json, "error");
+        OVSDB_RECEIPT_ID receipt_id = OVSDB_UNKNOWN_RECEIPT_ID;
 
-            status = parse_table(table_name, new_update, (Rdkb_Table_Config*) &table_config);
-            if(status != OVS_SUCCESS_STATUS)
-            {
-                OvsDbApiError("%s failed to parse local structure for UUID: %s.\n",
-                    __func__, uuid);
-                return status;
-            }
+        (void)receipt_list_get_type(target->receipts, rid, &receipt_id);
+        status = receipt_list_process(target->receipts, rid,
+            json_object_get(json, "result"), rpc_error);
+        if (status == OVS_SUCCESS_STATUS && rpc_error && !json_is_null(rpc_error) &&
+            receipt_id == OVSDB_MONITOR_COND_SINCE_RECEIPT_ID && target->since_fn)
+        {   // the request id of a monitor_cond_since is the monitor's id
+            target->since_fn(target->txn_data, rid);
+        }
+    }
 
-            status = mon_list_process(uuid, (Rdkb_Table_Config*)&table_config);
-            if (status != OVS_SUCCESS_STATUS)
-            {
-                OvsDbApiError("%s failed to process monitor update for UUID: %s.\n",
-                    __func__, uuid);
-            }
+    *used = error.position;
+    json_decref(json);
+    return status;
+}
 
-            free(table_config.config);
-       }
+/**
+ * Parses one or more JSON-RPC messages and hands responses, monitor updates
+ * and server requests to 'target'. Monitor updates and responses are
+ * decoded straight from the text, anything else is parsed with jansson.
+**/
+OVS_STATUS ovsdb_parse_msg(const char* json_str, size_t size,
+    const ovsdb_msg_target * target)
+{
+    OVS_STATUS status = OVS_FAILED_STATUS;
+    size_t bytes_read = 0;
+    size_t used = 0;
+    bool fallback = false;
 
-       update_iter = json_object_iter_next(table_value, update_iter);
+    if (!json_str || !target)
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
     }
 
+    do
+    {
+        status = ovsdb_stream_msg(json_str, size - bytes_read, target, &used, &fallback);
+        if (fallback)
+        {
+            status = ovsdb_parse_json_msg(json_str, size - bytes_read, target, &used);
+        }
+        if (used == 0)
+        {
+            return OVS_FAILED_STATUS;
+        }
+
+        bytes_read += used;
+        json_str += used;
+        OvsDbApiDebug("%s bytes read=%zu, size=%zu\n", __func__, bytes_read, size);
+    } while (bytes_read < size);
+
     return status;
 }
@@ -19,13 +19,65 @@
 #ifndef OVSDB_PARSER_H
 #define OVSDB_PARSER_H
 
+#include <stddef.h>
 #include "OvsDbApi/OvsDbDefs.h"
+#include "OvsDbApi/receipt_list.h"
+#include "OvsDbApi/mon_update_list.h"
+#include "OvsDbApi/json_parser/json_writer.h"
 
-char * ovsdb_insert_to_json(Rdkb_Table_Config * config, const char * unique_id);
-char * ovsdb_monitor_to_json(OVS_TABLE ovsdb_table, const char * rID,
+/**
+ * The requests are written into 'writer', see json_writer.h. The text is at
+ * writer->buf once they return OVS_SUCCESS_STATUS.
+**/
+OVS_STATUS ovsdb_insert_to_json(json_writer * writer, Rdkb_Table_Config * config,
     const char * unique_id);
-char * ovsdb_monitor_cancel_to_json(const char * old_id, const char * rID);
-char * ovsdb_delete_to_json(OVS_TABLE ovsdb_table, const char * rID,
-    const char * key, const char * value);
-OVS_STATUS ovsdb_parse_msg(const char* str_json, size_t size);
+OVS_STATUS ovsdb_insert_batch_to_json(json_writer * writer, Rdkb_Table_Config * configs,
+    size_t count, const char * unique_id);
+OVS_STATUS ovsdb_select_to_json(json_writer * writer, OVS_TABLE ovsdb_table,
+    const OvsDb_Monitor_Select * select);
+OVS_STATUS ovsdb_monitor_to_json(json_writer * writer, OVS_TABLE ovsdb_table,
+    const char * select, const char * rID, const char * unique_id);
+OVS_STATUS ovsdb_where_to_json(json_writer * writer, OVS_TABLE ovsdb_table,
+    const OvsDb_Condition * where, size_t num_where);
+OVS_STATUS ovsdb_monitor_cond_to_json(json_writer * writer, OVS_TABLE ovsdb_table,
+    const char * select, const char * where, const char * rID, const char * unique_id);
+OVS_STATUS ovsdb_monitor_cond_since_to_json(json_writer * writer, OVS_TABLE ovsdb_table,
+    const char * select, const char * where, const char * last_txn_id, const char * rID,
+    const char * unique_id);
+OVS_STATUS ovsdb_monitor_tables_to_json(json_writer * writer, uint32_t tables,
+    const char * last_txn_id, const char * rID, const char * unique_id);
+OVS_STATUS ovsdb_monitor_cond_change_to_json(json_writer * writer, OVS_TABLE ovsdb_table,
+    const char * where, const char * monitor_id, const char * rID);
+OVS_STATUS ovsdb_monitor_cancel_to_json(json_writer * writer, const char * old_id,
+    const char * rID);
+OVS_STATUS ovsdb_delete_to_json(json_writer * writer, OVS_TABLE ovsdb_table,
+    const char * rID, const char * key, const char * value);
+OVS_STATUS ovsdb_echo_to_json(json_writer * writer, const char * rID);
+
+typedef OVS_STATUS (*ovsdb_reply_fn)(void * data, const char * msg, size_t len);
+
+/** Called with the last transaction id of an update3 or monitor_cond_since reply **/
+typedef void (*ovsdb_txn_fn)(void * data, const char * txn_id);
+
+/** Called with the id of a monitor whose monitor_cond_since the server refused **/
+typedef void (*ovsdb_since_fn)(void * data, const char * monitor_id);
+
+/** Called with the id of a monitor to re-issue, see mon_list_take_resync() **/
+typedef void (*ovsdb_resync_fn)(void * data, const char * monitor_id);
+
+/** Where the messages received on one connection are delivered **/
+typedef struct ovsdb_msg_target
+{
+    receipt_list * receipts;
+    mon_list * monitors;
+    ovsdb_reply_fn reply_fn;    // answers requests initiated by the server
+    void * reply_data;
+    ovsdb_txn_fn txn_fn;        // optional, tracks the database's last transaction
+    ovsdb_since_fn since_fn;    // optional, called with txn_data
+    ovsdb_resync_fn resync_fn;  // optional, called with txn_data
+    void * txn_data;
+} ovsdb_msg_target;
+
+OVS_STATUS ovsdb_parse_msg(const char* str_json, size_t size,
+    const ovsdb_msg_target * target);
 #endif
@@ -0,0 +1,473 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include "OvsDbApi/ovsdb_reactor.h"
+#include "common/OvsAgentLog.h"
+
+#define OVSDB_REACTOR_MAX_EVENTS 16
+
+typedef struct ovsdb_reactor_handler
+{
+    int fd;
+    bool is_timer;                          // fd is a timerfd owned by the reactor
+    bool removed;                           // freed once the current dispatch completes
+    ovsdb_reactor_cb callback;
+    void * data;
+    struct ovsdb_reactor_handler * next;
+} ovsdb_reactor_handler;
+
+struct ovsdb_reactor
+{
+    int epoll_fd;
+    int event_fd;                           // used for stop and wakeup requests
+    volatile bool terminate;
+    ovsdb_reactor_cb wakeup_cb;
+    void * wakeup_data;
+    pthread_mutex_t mutex;                  // guards the handler lists
+    ovsdb_reactor_handler * handlers;
+    ovsdb_reactor_handler * removed;
+};
+
+ovsdb_reactor * ovsdb_reactor_create(void)
+{
+    struct epoll_event event;
+    ovsdb_reactor * reactor = NULL;
+
+    if ((reactor = (ovsdb_reactor *)malloc(sizeof(ovsdb_reactor))) == NULL)
+    {
+        OvsDbApiError("%s failed to allocate reactor.\n", __func__);
+        return NULL;
+    }
+    memset(reactor, 0, sizeof(ovsdb_reactor));
+
+    reactor->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (reactor->epoll_fd < 0)
+    {
+        OvsDbApiError("%s epoll_create1 error. %s\n", __func__, strerror(errno));
+        free(reactor);
+        return NULL;
+    }
+
+    reactor->event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (reactor->event_fd < 0)
+    {
+        OvsDbApiError("%s eventfd error. %s\n", __func__, strerror(errno));
+        close(reactor->epoll_fd);
+        free(reactor);
+        return NULL;
+    }
+
+    // a NULL handler identifies the reactor's own eventfd
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.ptr = NULL;
+    if (epoll_ctl(reactor->epoll_fd, EPOLL_CTL_ADD, reactor->event_fd, &event) < 0)
+    {
+        OvsDbApiError("%s failed to watch eventfd. %s\n", __func__, strerror(errno));
+        close(reactor->event_fd);
+        close(reactor->epoll_fd);
+        free(reactor);
+        return NULL;
+    }
+
+    pthread_mutex_init(&reactor->mutex, NULL);
+    OvsDbApiDebug("%s epoll fd=%d, event fd=%d\n", __func__,
+        reactor->epoll_fd, reactor->event_fd);
+    return reactor;
+}
+
+static void free_handler_list(ovsdb_reactor_handler * handler)
+{
+    ovsdb_reactor_handler * next = NULL;
+
+    while (handler)
+    {
+        next = handler->next;
+        if (handler->is_timer)
+        {
+            close(handler->fd);
+        }
+        free(handler);
+        handler = next;
+    }
+}
+
+void ovsdb_reactor_destroy(ovsdb_reactor * reactor)
+{
+    if (!reactor)
+    {
+        return;
+    }
+
+    free_handler_list(reactor->handlers);
+    free_handler_list(reactor->removed);
+    close(reactor->event_fd);
+    close(reactor->epoll_fd);
+    pthread_mutex_destroy(&reactor->mutex);
+    free(reactor);
+}
+
+static OVS_STATUS signal_event_fd(ovsdb_reactor * reactor)
+{
+    uint64_t value = 1;
+
+    if (write(reactor->event_fd, &value, sizeof(value)) != sizeof(value) &&
+        errno != EAGAIN)
+    {
+        OvsDbApiError("%s eventfd write error. %s\n", __func__, strerror(errno));
+        return OVS_FAILED_STATUS;
+    }
+    return OVS_SUCCESS_STATUS;
+}
+
+OVS_STATUS ovsdb_reactor_stop(ovsdb_reactor * reactor)
+{
+    if (!reactor)
+    {
+        return OVS_FAILED_STATUS;
+    }
+
+    reactor->terminate = true;
+    return signal_event_fd(reactor);
+}
+
+OVS_STATUS ovsdb_reactor_wakeup(ovsdb_reactor * reactor)
+{
+    if (!reactor)
+    {
+        return OVS_FAILED_STATUS;
+    }
+    return signal_event_fd(reactor);
+}
+
+void ovsdb_reactor_set_wakeup_cb(ovsdb_reactor * reactor, ovsdb_reactor_cb cb,
+    void * data)
+{
+    if (!reactor)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&reactor->mutex);
+    reactor->wakeup_cb = cb;
+    reactor->wakeup_data = data;
+    pthread_mutex_unlock(&reactor->mutex);
+}
+
+static ovsdb_reactor_handler * find_handler(ovsdb_reactor * reactor, int fd)
+{
+    ovsdb_reactor_handler * handler = NULL;
+
+    for (handler = reactor->handlers; handler != NULL; handler = handler->next)
+    {
+        if (handler->fd == fd)
+        {
+            return handler;
+        }
+    }
+    return NULL;
+}
+
+static OVS_STATUS add_handler(ovsdb_reactor * reactor, int fd, uint32_t events,
+    bool is_timer, ovsdb_reactor_cb cb, void * data)
+{
+    struct epoll_event event;
+    ovsdb_reactor_handler * handler = NULL;
+
+    if ((handler = (ovsdb_reactor_handler *)malloc(sizeof(ovsdb_reactor_handler))) == NULL)
+    {
+        OvsDbApiError("%s failed to allocate handler for fd=%d.\n", __func__, fd);
+        return OVS_FAILED_STATUS;
+    }
+    handler->fd = fd;
+    handler->is_timer = is_timer;
+    handler->removed = false;
+    handler->callback = cb;
+    handler->data = data;
+
+    memset(&event, 0, sizeof(event));
+    event.events = events;
+    event.data.ptr = handler;
+
+    pthread_mutex_lock(&reactor->mutex);
+    if (find_handler(reactor, fd) != NULL)
+    {
+        pthread_mutex_unlock(&reactor->mutex);
+        OvsDbApiError("%s fd=%d is already watched.\n", __func__, fd);
+        free(handler);
+        return OVS_FAILED_STATUS;
+    }
+
+    if (epoll_ctl(reactor->epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0)
+    {
+        pthread_mutex_unlock(&reactor->mutex);
+        OvsDbApiError("%s failed to watch fd=%d. %s\n", __func__, fd, strerror(errno));
+        free(handler);
+        return OVS_FAILED_STATUS;
+    }
+
+    handler->next = reactor->handlers;
+    reactor->handlers = handler;
+    pthread_mutex_unlock(&reactor->mutex);
+
+    OvsDbApiDebug("%s fd=%d, events=0x%x\n", __func__, fd, events);
+    return OVS_SUCCESS_STATUS;
+}
+
+OVS_STATUS ovsdb_reactor_add(ovsdb_reactor * reactor, int fd, uint32_t events,
+    ovsdb_reactor_cb cb, void * data)
+{
+    if (!reactor || fd < 0 || !cb)
+    {
+        OvsDbApiError("%s Invalid parameter, fd=%d.\n", __func__, fd);
+        return OVS_FAILED_STATUS;
+    }
+    return add_handler(reactor, fd, events, false, cb, data);
+}
+
+/**
+ * Thread safe. Replaces the set of events watched for fd, e.g. to start or
+ * stop waiting for EPOLLOUT.
+**/
+OVS_STATUS ovsdb_reactor_modify(ovsdb_reactor * reactor, int fd, uint32_t events)
+{
+    struct epoll_event event;
+    ovsdb_reactor_handler * handler = NULL;
+    OVS_STATUS status = OVS_SUCCESS_STATUS;
+
+    if (!reactor)
+    {
+        return OVS_FAILED_STATUS;
+    }
+
+    pthread_mutex_lock(&reactor->mutex);
+    handler = find_handler(reactor, fd);
+    if (!handler)
+    {
+        pthread_mutex_unlock(&reactor->mutex);
+        OvsDbApiError("%s fd=%d is not watched.\n", __func__, fd);
+        return OVS_FAILED_STATUS;
+    }
+
+    memset(&event, 0, sizeof(event));
+    event.events = events;
+    event.data.ptr = handler;
+    if (epoll_ctl(reactor->epoll_fd, EPOLL_CTL_MOD, fd, &event) < 0)
+    {
+        OvsDbApiError("%s failed to modify fd=%d. %s\n", __func__, fd, strerror(errno));
+        status = OVS_FAILED_STATUS;
+    }
+    pthread_mutex_unlock(&reactor->mutex);
+    return status;
+}
+
+static OVS_STATUS remove_handler(ovsdb_reactor * reactor, int fd)
+{
+    ovsdb_reactor_handler ** link = NULL;
+    ovsdb_reactor_handler * handler = NULL;
+
+    pthread_mutex_lock(&reactor->mutex);
+    for (link = &reactor->handlers; *link != NULL; link = &(*link)->next)
+    {
+        if ((*link)->fd == fd)
+        {
+            handler = *link;
+            *link = handler->next;
+            break;
+        }
+    }
+
+    if (!handler)
+    {
+        pthread_mutex_unlock(&reactor->mutex);
+        OvsDbApiWarning("%s fd=%d is not watched.\n", __func__, fd);
+        return OVS_FAILED_STATUS;
+    }
+
+    (void)epoll_ctl(reactor->epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+
+    // events for this handler may still be pending in the current dispatch
+    handler->removed = true;
+    handler->next = reactor->removed;
+    reactor->removed = handler;
+    pthread_mutex_unlock(&reactor->mutex);
+
+    OvsDbApiDebug("%s fd=%d\n", __func__, fd);
+    return OVS_SUCCESS_STATUS;
+}
+
+OVS_STATUS ovsdb_reactor_remove(ovsdb_reactor * reactor, int fd)
+{
+    if (!reactor || fd < 0)
+    {
+        return OVS_FAILED_STATUS;
+    }
+    return remove_handler(reactor, fd);
+}
+
+int ovsdb_reactor_timer_create(ovsdb_reactor * reactor, ovsdb_reactor_cb cb,
+    void * data)
+{
+    int fd = -1;
+
+    if (!reactor || !cb)
+    {
+        return -1;
+    }
+
+    fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (fd < 0)
+    {
+        OvsDbApiError("%s timerfd_create error. %s\n", __func__, strerror(errno));
+        return -1;
+    }
+
+    if (add_handler(reactor, fd, EPOLLIN, true, cb, data) != OVS_SUCCESS_STATUS)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * Arms the timer to first fire after initial_msecs and then every
+ * interval_msecs. An initial_msecs of 0 disarms the timer.
+**/
+OVS_STATUS ovsdb_reactor_timer_arm(int timer_fd, unsigned int initial_msecs,
+    unsigned int interval_msecs)
+{
+    struct itimerspec spec;
+
+    memset(&spec, 0, sizeof(spec));
+    spec.it_value.tv_sec = initial_msecs / 1000;
+    spec.it_value.tv_nsec = (initial_msecs % 1000) * 1000000L;
+    spec.it_interval.tv_sec = interval_msecs / 1000;
+    spec.it_interval.tv_nsec = (interval_msecs % 1000) * 1000000L;
+
+    if (timerfd_settime(timer_fd, 0, &spec, NULL) < 0)
+    {
+        OvsDbApiError("%s timerfd_settime error for fd=%d. %s\n", __func__,
+            timer_fd, strerror(errno));
+        return OVS_FAILED_STATUS;
+    }
+    return OVS_SUCCESS_STATUS;
+}
+
+OVS_STATUS ovsdb_reactor_timer_destroy(ovsdb_reactor * reactor, int timer_fd)
+{
+    if (!reactor || timer_fd < 0)
+    {
+        return OVS_FAILED_STATUS;
+    }
+    // the timerfd is closed together with its handler
+    return remove_handler(reactor, timer_fd);
+}
+
+static void handle_event_fd(ovsdb_reactor * reactor)
+{
+    uint64_t value = 0;
+    ovsdb_reactor_cb cb = NULL;
+    void * data = NULL;
+
+    (void)read(reactor->event_fd, &value, sizeof(value));
+    if (reactor->terminate)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&reactor->mutex);
+    cb = reactor->wakeup_cb;
+    data = reactor->wakeup_data;
+    pthread_mutex_unlock(&reactor->mutex);
+
+    if (cb)
+    {
+        cb(reactor->event_fd, EPOLLIN, data);
+    }
+}
+
+OVS_STATUS ovsdb_reactor_run(ovsdb_reactor * reactor)
+{
+    struct epoll_event events[OVSDB_REACTOR_MAX_EVENTS];
+    ovsdb_reactor_handler * handler = NULL;
+    ovsdb_reactor_handler * removed = NULL;
+    uint64_t expirations = 0;
+    int count = 0;
+    int i;
+
+    if (!reactor)
+    {
+        return OVS_FAILED_STATUS;
+    }
+
+    OvsDbApiDebug("%s started, epoll fd=%d\n", __func__, reactor->epoll_fd);
+    while (!reactor->terminate)
+    {
+        count = epoll_wait(reactor->epoll_fd, events, OVSDB_REACTOR_MAX_EVENTS, -1);
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            OvsDbApiError("%s epoll_wait error. %s\n", __func__, strerror(errno));
+            return OVS_FAILED_STATUS;
+        }
+
+        for (i = 0; i < count && !reactor->terminate; i++)
+        {
+            handler = (ovsdb_reactor_handler *)events[i].data.ptr;
+            if (!handler)
+            {
+                handle_event_fd(reactor);
+                continue;
+            }
+
+            if (handler->removed)
+            {
+                continue;
+            }
+
+            if (handler->is_timer &&
+                read(handler->fd, &expirations, sizeof(expirations)) != sizeof(expirations))
+            {   // timer was re-armed or disarmed since it fired
+                continue;
+            }
+
+            handler->callback(handler->fd, events[i].events, handler->data);
+        }
+
+        pthread_mutex_lock(&reactor->mutex);
+        removed = reactor->removed;
+        reactor->removed = NULL;
+        pthread_mutex_unlock(&reactor->mutex);
+        free_handler_list(removed);
+    }
+
+    OvsDbApiDebug("%s stopped, epoll fd=%d\n", __func__, reactor->epoll_fd);
+    return OVS_SUCCESS_STATUS;
+}
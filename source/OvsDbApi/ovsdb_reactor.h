@@ -0,0 +1,72 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+#ifndef OVSDB_REACTOR_H
+#define OVSDB_REACTOR_H
+
+#include <stdint.h>
+#include <sys/epoll.h>
+#include "OvsDataTypes.h"
+
+/**
+ * Called from the reactor thread when a watched fd is ready. 'events' is the
+ * EPOLLIN/EPOLLOUT/EPOLLHUP/EPOLLERR mask reported by epoll. For timers the
+ * expiration count has already been read from the timerfd.
+**/
+typedef void (*ovsdb_reactor_cb)(int fd, uint32_t events, void * data);
+
+typedef struct ovsdb_reactor ovsdb_reactor;
+
+ovsdb_reactor * ovsdb_reactor_create(void);
+void ovsdb_reactor_destroy(ovsdb_reactor * reactor);
+
+/**
+ * Blocks the calling thread, dispatching fd events until ovsdb_reactor_stop()
+ * is called. There is no polling timeout, an idle reactor never wakes up.
+**/
+OVS_STATUS ovsdb_reactor_run(ovsdb_reactor * reactor);
+
+/**
+ * Thread safe. Makes ovsdb_reactor_run() return after the current dispatch.
+**/
+OVS_STATUS ovsdb_reactor_stop(ovsdb_reactor * reactor);
+
+/**
+ * Thread safe. Runs the wakeup callback on the reactor thread.
+**/
+OVS_STATUS ovsdb_reactor_wakeup(ovsdb_reactor * reactor);
+void ovsdb_reactor_set_wakeup_cb(ovsdb_reactor * reactor, ovsdb_reactor_cb cb,
+    void * data);
+
+OVS_STATUS ovsdb_reactor_add(ovsdb_reactor * reactor, int fd, uint32_t events,
+    ovsdb_reactor_cb cb, void * data);
+OVS_STATUS ovsdb_reactor_modify(ovsdb_reactor * reactor, int fd, uint32_t events);
+OVS_STATUS ovsdb_reactor_remove(ovsdb_reactor * reactor, int fd);
+
+/**
+ * Creates a timerfd watched by the reactor, initially disarmed.
+ * Returns the timer's fd, or -1 on failure. Release it with
+ * ovsdb_reactor_timer_destroy().
+**/
+int ovsdb_reactor_timer_create(ovsdb_reactor * reactor, ovsdb_reactor_cb cb,
+    void * data);
+OVS_STATUS ovsdb_reactor_timer_arm(int timer_fd, unsigned int initial_msecs,
+    unsigned int interval_msecs);
+OVS_STATUS ovsdb_reactor_timer_destroy(ovsdb_reactor * reactor, int timer_fd);
+
+#endif
@@ -29,16 +29,6 @@
 
 #define OVSDB_SOCK_PATH "/var/run/openvswitch/db.sock"
 
-static bool msecs_to_timeval(int msecs, struct timeval* tv)
-{
-    if (!tv){
-        return false;
-    }
-    tv->tv_sec = msecs / 1000;
-    tv->tv_usec = (msecs % 1000) * 1000;
-    return true;
-}
-
 /**
  * Disconnect from the OVSDB socket
 **/
@@ -127,13 +117,18 @@ int ovsdb_socket_connect()
 }
 
 /**
- * Write sz bytes in buf to OVSDB socket
+ * Write up to len bytes in buf to OVSDB socket. Returns the number of bytes
+ * written, which may be short or 0 when the socket buffer is full.
 **/
 ssize_t ovsdb_socket_write(int fd, const char *buffer, size_t len)
 {
-    ssize_t nwr = send(fd, buffer, len, 0);
+    ssize_t nwr = send(fd, buffer, len, MSG_NOSIGNAL);
     if (nwr < 0)
     {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+        {
+            return 0;
+        }
         OvsDbApiError("OVSDB-API: JSON RPC: Error writing to socket.::error=%s|errno=%d\n",
             strerror(errno), errno);
         return -1;
@@ -142,57 +137,57 @@ ssize_t ovsdb_socket_write(int fd, const char *buffer, size_t len)
 }
 
 /**
- * Check for data on the OVSDB socket for the specified timeout in msecs.
+ * Gathered write of iovcnt buffers to OVSDB socket, same return values as
+ * ovsdb_socket_write().
 **/
-ssize_t ovsdb_socket_listen(int fd, char * buffer, size_t size, int timeout)
+ssize_t ovsdb_socket_writev(int fd, const struct iovec *iov, int iovcnt)
 {
-    int ret = 0;
-    ssize_t len = 0;
-    OVS_STATUS status = OVS_SUCCESS_STATUS;
-    const char * UUID = NULL;
-    fd_set read_flags;
-    struct timeval tv = {0};
+    struct msghdr msg;
+    ssize_t nwr = 0;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = (struct iovec *)iov;
+    msg.msg_iovlen = iovcnt;
 
-    if (!msecs_to_timeval(timeout, &tv))
+    nwr = sendmsg(fd, &msg, MSG_NOSIGNAL);
+    if (nwr < 0)
     {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+        {
+            return 0;
+        }
+        OvsDbApiError("OVSDB-API: JSON RPC: Error writing to socket.::error=%s|errno=%d\n",
+            strerror(errno), errno);
         return -1;
     }
+    return nwr;
+}
 
-    FD_ZERO(&read_flags);
-    FD_SET(fd, &read_flags);
+/**
+ * Non-blocking read of the data pending on the OVSDB socket. The data is
+ * NOT null terminated. Returns 0 when there is nothing left to read.
+**/
+ssize_t ovsdb_socket_read(int fd, char * buffer, size_t size)
+{
+    ssize_t len = 0;
 
-    ret = select(fd + 1, &read_flags, NULL, NULL, &tv);
-    if(ret == 0){
-        //OvsDbApiDebug("OVSDB-API: Socket select timeout %d msecs.\n", timeout);
-        return 0; // TODO: Use more meaningful OVS_STATUS code
-    }
-    else if(ret < 0){
-        OvsDbApiError("OVSDB-API: Select socket::error=%s|errno=%d\n", strerror(errno), errno);
-        return -2; // TODO: Use more meaningful OVS_STATUS code
-    }
+    len = recv(fd, (void*)buffer, size, 0);
+    if(len <= 0){
+        if(len < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)){
+            return 0;
+        }
 
-    if (FD_ISSET(fd, &read_flags))
-    {
-        FD_CLR(fd, &read_flags);
-
-        memset(buffer, 0, size);
-        len = recv(fd, (void*)buffer, size - 1, 0);
-        if(len <= 0){
-            if(len < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)){
-                OvsDbApiDebug("OVSDB-API: No data received from socket::error=%s|errno=%d\n",
-                    strerror(errno), errno);
-                return 0; // TODO: Use more meaningful OVS_STATUS code
-            }
-
-            OvsDbApiError("OVSDB-API: Socket fd=%d connection was closed. Len: %zd\n", fd, len);
-            return -3; // TODO: Use more meaningful OVS_STATUS code
+        if (len < 0){
+            OvsDbApiError("OVSDB-API: Socket fd=%d read::error=%s|errno=%d\n",
+                fd, strerror(errno), errno);
+            return -2;
         }
 
-        buffer[len] = 0;
-        OvsDbApiDebug("%s received %zd bytes, bufSize: %zd, msg: %s\n",
-            __func__, len, size, buffer);
+        OvsDbApiError("OVSDB-API: Socket fd=%d connection was closed.\n", fd);
+        return -3;
     }
 
+    OvsDbApiDebug("%s received %zd bytes, bufSize: %zu, msg: %.*s\n",
+        __func__, len, size, (int)len, buffer);
     return len;
 }
-
@@ -20,10 +20,12 @@
 #define OVSDB_SOCKET_H
 
 #include <stddef.h>
+#include <sys/uio.h>
 
 int ovsdb_socket_connect();
 ssize_t ovsdb_socket_write(int fd, const char *buffer, size_t len);
-ssize_t ovsdb_socket_listen(int fd, char *buffer, size_t size, int timeout);
+ssize_t ovsdb_socket_writev(int fd, const struct iovec *iov, int iovcnt);
+ssize_t ovsdb_socket_read(int fd, char *buffer, size_t size);
 int ovsdb_socket_disconnect(int fd);
 
 #endif
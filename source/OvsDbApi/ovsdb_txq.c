@@ -0,0 +1,256 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+#include "OvsDbApi/ovsdb_txq.h"
+#include "OvsDbApi/ovsdb_socket.h"
+#include "common/OvsAgentLog.h"
+
+OVS_STATUS ovsdb_txq_init(ovsdb_txq * txq, size_t high_water)
+{
+    if (!txq)
+    {
+        OvsDbApiError("%s txq is NULL.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    memset(txq, 0, sizeof(ovsdb_txq));
+    pthread_mutex_init(&txq->mutex, NULL);
+    txq->high_water = high_water;
+    return OVS_SUCCESS_STATUS;
+}
+
+static void ovsdb_txq_free(ovsdb_txq * txq)
+{
+    ovsdb_txq_buf * buf = txq->head;
+    ovsdb_txq_buf * next = NULL;
+
+    while (buf)
+    {
+        next = buf->next;
+        free(buf);
+        buf = next;
+    }
+    txq->head = NULL;
+    txq->tail = NULL;
+    txq->queued = 0;
+}
+
+void ovsdb_txq_deinit(ovsdb_txq * txq)
+{
+    if (!txq)
+    {
+        return;
+    }
+
+    ovsdb_txq_free(txq);
+    pthread_mutex_destroy(&txq->mutex);
+}
+
+/**
+ * Drops everything still queued, e.g. after the connection was lost.
+**/
+void ovsdb_txq_reset(ovsdb_txq * txq)
+{
+    if (!txq)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&txq->mutex);
+    if (txq->queued > 0)
+    {
+        OvsDbApiWarning("%s dropping %zu queued bytes.\n", __func__, txq->queued);
+    }
+    ovsdb_txq_free(txq);
+    pthread_mutex_unlock(&txq->mutex);
+}
+
+void ovsdb_txq_set_high_water(ovsdb_txq * txq, size_t high_water)
+{
+    if (!txq)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&txq->mutex);
+    txq->high_water = high_water;
+    pthread_mutex_unlock(&txq->mutex);
+}
+
+size_t ovsdb_txq_pending(ovsdb_txq * txq)
+{
+    size_t queued = 0;
+
+    if (!txq)
+    {
+        return 0;
+    }
+
+    pthread_mutex_lock(&txq->mutex);
+    queued = txq->queued;
+    pthread_mutex_unlock(&txq->mutex);
+    return queued;
+}
+
+static OVS_STATUS ovsdb_txq_append(ovsdb_txq * txq, const char * data, size_t len)
+{
+    ovsdb_txq_buf * buf = NULL;
+
+    if ((buf = (ovsdb_txq_buf *)malloc(sizeof(ovsdb_txq_buf) + len)) == NULL)
+    {
+        OvsDbApiError("%s failed to allocate %zu bytes.\n", __func__, len);
+        return OVS_FAILED_STATUS;
+    }
+    memcpy(buf->data, data, len);
+    buf->len = len;
+    buf->offset = 0;
+    buf->next = NULL;
+
+    if (txq->tail)
+    {
+        txq->tail->next = buf;
+    }
+    else
+    {
+        txq->head = buf;
+    }
+    txq->tail = buf;
+    txq->queued += len;
+    return OVS_SUCCESS_STATUS;
+}
+
+OVS_STATUS ovsdb_txq_send(ovsdb_txq * txq, int fd, const char * msg,
+    size_t len, bool * queued)
+{
+    ssize_t sent = 0;
+    OVS_STATUS status = OVS_SUCCESS_STATUS;
+
+    if (!txq || !msg || !queued)
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+    *queued = false;
+
+    pthread_mutex_lock(&txq->mutex);
+    if (txq->queued + len > txq->high_water)
+    {
+        OvsDbApiWarning("%s %zu bytes already queued, refusing %zu more.\n",
+            __func__, txq->queued, len);
+        pthread_mutex_unlock(&txq->mutex);
+        return OVS_BUSY_STATUS;
+    }
+
+    // anything already queued must go out first to keep the stream in order
+    if (txq->head == NULL)
+    {
+        sent = ovsdb_socket_write(fd, msg, len);
+        if (sent < 0)
+        {
+            pthread_mutex_unlock(&txq->mutex);
+            return OVS_FAILED_STATUS;
+        }
+    }
+
+    if ((size_t)sent < len)
+    {
+        OvsDbApiDebug("%s queueing %zu of %zu bytes for fd=%d\n", __func__,
+            len - sent, len, fd);
+        status = ovsdb_txq_append(txq, msg + sent, len - sent);
+        *queued = (status == OVS_SUCCESS_STATUS);
+    }
+    pthread_mutex_unlock(&txq->mutex);
+    return status;
+}
+
+OVS_STATUS ovsdb_txq_flush(ovsdb_txq * txq, int fd, bool * empty)
+{
+    struct iovec iov[OVSDB_TXQ_MAX_IOV];
+    ovsdb_txq_buf * buf = NULL;
+    ssize_t written = 0;
+    ssize_t sent = 0;
+    size_t chunk = 0;
+    size_t total = 0;
+    int count = 0;
+
+    if (!txq || !empty)
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    pthread_mutex_lock(&txq->mutex);
+    while (txq->head)
+    {
+        count = 0;
+        total = 0;
+        for (buf = txq->head; buf && count < OVSDB_TXQ_MAX_IOV; buf = buf->next)
+        {
+            iov[count].iov_base = buf->data + buf->offset;
+            iov[count].iov_len = buf->len - buf->offset;
+            total += iov[count].iov_len;
+            count++;
+        }
+
+        written = ovsdb_socket_writev(fd, iov, count);
+        if (written < 0)
+        {
+            pthread_mutex_unlock(&txq->mutex);
+            *empty = false;
+            return OVS_FAILED_STATUS;
+        }
+        if (written == 0)
+        {   // socket is full again
+            break;
+        }
+
+        txq->queued -= written;
+        sent = written;
+        while (sent > 0)
+        {
+            buf = txq->head;
+            chunk = buf->len - buf->offset;
+            if ((size_t)sent < chunk)
+            {
+                buf->offset += sent;
+                break;
+            }
+
+            sent -= chunk;
+            txq->head = buf->next;
+            free(buf);
+        }
+        if (!txq->head)
+        {
+            txq->tail = NULL;
+        }
+
+        if ((size_t)written < total)
+        {   // short write, wait for the next EPOLLOUT
+            break;
+        }
+    }
+
+    *empty = (txq->head == NULL);
+    pthread_mutex_unlock(&txq->mutex);
+    return OVS_SUCCESS_STATUS;
+}
@@ -0,0 +1,73 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+
+#ifndef OVSDB_TXQ_H
+#define OVSDB_TXQ_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "OvsDataTypes.h"
+
+#define OVSDB_TXQ_DEFAULT_HIGH_WATER (1024 * 1024)
+#define OVSDB_TXQ_MAX_IOV            64
+
+typedef struct ovsdb_txq_buf
+{
+    struct ovsdb_txq_buf * next;
+    size_t len;         // size of data
+    size_t offset;      // bytes of data already sent
+    char data[];
+} ovsdb_txq_buf;
+
+/**
+ * Outbound queue of a non-blocking OVSDB connection. Messages are sent
+ * directly while the socket keeps up; whatever the kernel does not accept
+ * is queued, in order, until the socket becomes writable again.
+**/
+typedef struct ovsdb_txq
+{
+    pthread_mutex_t mutex;
+    ovsdb_txq_buf * head;
+    ovsdb_txq_buf * tail;
+    size_t queued;      // bytes waiting to be sent
+    size_t high_water;  // messages are refused once queued would exceed this
+} ovsdb_txq;
+
+OVS_STATUS ovsdb_txq_init(ovsdb_txq * txq, size_t high_water);
+void ovsdb_txq_deinit(ovsdb_txq * txq);
+void ovsdb_txq_reset(ovsdb_txq * txq);
+void ovsdb_txq_set_high_water(ovsdb_txq * txq, size_t high_water);
+size_t ovsdb_txq_pending(ovsdb_txq * txq);
+
+/**
+ * Sends or queues one complete message. Returns OVS_BUSY_STATUS, without
+ * sending anything, when queueing it would exceed the high-water mark.
+ * 'queued' is set when part of the message is left for ovsdb_txq_flush().
+**/
+OVS_STATUS ovsdb_txq_send(ovsdb_txq * txq, int fd, const char * msg,
+    size_t len, bool * queued);
+
+/**
+ * Writes as much of the queue as the socket accepts. 'empty' is set once
+ * the queue has been fully sent.
+**/
+OVS_STATUS ovsdb_txq_flush(ovsdb_txq * txq, int fd, bool * empty);
+
+#endif
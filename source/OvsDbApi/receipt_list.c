@@ -17,36 +17,246 @@
 */
 
 #include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <pthread.h>
 #include "OvsDbApi/receipt_list.h"
 #include "OvsDbApi/OvsDbDefs.h"
 #include "common/OvsAgentLog.h"
 #include "OvsDbApi/json_parser/receipt_parser.h"
+#include "OvsDbApi/json_parser/table_desc.h"
+#include "OvsDbApi/timer_wheel.h"
+
+#define RECEIPT_LIST_STRIPES        16      // a power of 2
+#define RECEIPT_LIST_MIN_BUCKETS    8
 
-//TODO: Update later to hash table?
-//TODO: Add clean up to this list in deinit
 typedef struct receipt_node_t
 {
     char rid[MAX_UUID_LEN+1];           //Unique ID to identify messages
+    uint32_t key;                       //receipt_key() of rid
     ovsdb_receipt_cb callback;          //Callback to invoke when message is found
+    receipt_list_data_cb data_callback; //Used instead of 'callback' when set
+    void* data;
     OVSDB_RECEIPT_ID receipt_type;
-    struct receipt_node_t* next;        //Next in the list
+    int session;                        //Connection the request was sent on
+    timer_wheel_entry timer;            //Deadline, not scheduled without a timeout
+    struct receipt_node_t* next;        //Next in the bucket
 } receipt_node_t;
 
-static receipt_node_t* msg_list = NULL;
+#define receipt_node_of(entry) \
+    ((receipt_node_t*)((char*)(entry) - offsetof(receipt_node_t, timer)))
+
+/**
+ * Requests are added from API callers and completed by the reactor, so the
+ * table is split in stripes that each have their own lock, buckets and
+ * deadlines.
+**/
+typedef struct receipt_stripe
+{
+    pthread_mutex_t mutex;
+    receipt_node_t** buckets;
+    size_t num_buckets;                 //A power of 2, allocated on first add
+    size_t count;
+    timer_wheel wheel;                  //In RECEIPT_LIST_TICK_MSECS ticks
+} receipt_stripe;
+
+struct receipt_list
+{
+    receipt_stripe stripes[RECEIPT_LIST_STRIPES];
+    unsigned int timeout_msecs;         //For receipts added from now on, 0 for none
+};
+
+static uint64_t receipt_list_ticks()
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000) / RECEIPT_LIST_TICK_MSECS;
+}
+
+receipt_list* receipt_list_create()
+{
+    receipt_list* list = calloc(1, sizeof(receipt_list));
+    uint64_t now = receipt_list_ticks();
+    size_t i;
+
+    if (!list)
+    {
+        OvsDbApiError("%s failed to allocate receipt list.\n", __func__);
+        return NULL;
+    }
+
+    for (i = 0; i < RECEIPT_LIST_STRIPES; i++)
+    {
+        pthread_mutex_init(&list->stripes[i].mutex, NULL);
+        timer_wheel_init(&list->stripes[i].wheel, now);
+    }
+    list->timeout_msecs = RECEIPT_LIST_TIMEOUT_MSECS;
+    return list;
+}
+
+void receipt_list_destroy(receipt_list* list)
+{
+    size_t i;
+
+    if (!list)
+    {
+        return;
+    }
+
+    (void)receipt_list_clear(list);
+    for (i = 0; i < RECEIPT_LIST_STRIPES; i++)
+    {
+        pthread_mutex_destroy(&list->stripes[i].mutex);
+        free(list->stripes[i].buckets);
+    }
+    free(list);
+}
+
+/**
+ * Request ids are decimal counters which spread evenly over the stripes as
+ * they are, anything else is hashed.
+**/
+static uint32_t receipt_key(const char* rid)
+{
+    uint32_t key = 0;
+    const char* c = rid;
+
+    for (; *c >= '0' && *c <= '9'; c++)
+    {
+        key = key * 10 + (uint32_t)(*c - '0');
+    }
+    if (c == rid || *c != '\0')
+    {
+        return table_name_hash(rid, strlen(rid));
+    }
+    return key;
+}
+
+static receipt_stripe* receipt_list_stripe(receipt_list* list, uint32_t key)
+{
+    return &list->stripes[key & (RECEIPT_LIST_STRIPES - 1)];
+}
+
+static receipt_node_t** receipt_stripe_bucket(receipt_node_t** buckets,
+    size_t num_buckets, uint32_t key)
+{
+    return &buckets[(key / RECEIPT_LIST_STRIPES) & (num_buckets - 1)];
+}
+
+/** Returns the link to the node matching 'rid', or to the end of its bucket **/
+static receipt_node_t** receipt_stripe_find(receipt_stripe* stripe, uint32_t key,
+    const char* rid)
+{
+    receipt_node_t** link = receipt_stripe_bucket(stripe->buckets,
+        stripe->num_buckets, key);
+
+    while (*link && ((*link)->key != key ||
+        strncmp(rid, (*link)->rid, sizeof((*link)->rid)) != 0))
+    {
+        link = &(*link)->next;
+    }
+    return link;
+}
+
+/** Doubles the buckets once there are more receipts than buckets **/
+static OVS_STATUS receipt_stripe_grow(receipt_stripe* stripe)
+{
+    size_t num_buckets = stripe->num_buckets ?
+        stripe->num_buckets * 2 : RECEIPT_LIST_MIN_BUCKETS;
+    receipt_node_t** buckets = calloc(num_buckets, sizeof(receipt_node_t*));
+    receipt_node_t** link = NULL;
+    receipt_node_t* node = NULL;
+    size_t i;
+
+    if (!buckets)
+    {   // longer chains, but still correct unless there are no buckets yet
+        return stripe->num_buckets ? OVS_SUCCESS_STATUS : OVS_FAILED_STATUS;
+    }
+
+    for (i = 0; i < stripe->num_buckets; i++)
+    {
+        while ((node = stripe->buckets[i]) != NULL)
+        {
+            stripe->buckets[i] = node->next;
+            link = receipt_stripe_bucket(buckets, num_buckets, node->key);
+            node->next = *link;
+            *link = node;
+        }
+    }
+
+    free(stripe->buckets);
+    stripe->buckets = buckets;
+    stripe->num_buckets = num_buckets;
+    return OVS_SUCCESS_STATUS;
+}
+
+static void receipt_node_complete(receipt_node_t* node, const OvsDb_Base_Receipt* receipt)
+{
+    if (node->data_callback)
+    {
+        node->data_callback(node->rid, receipt, node->data);
+    }
+    else if (node->callback)
+    {
+        node->callback(node->rid, receipt);
+    }
+}
+
+/** Completes the receipt with a failure, e.g. for a request that never got a response **/
+static void receipt_node_fail(receipt_node_t* node, OVS_STATUS status, const char* error)
+{
+    union {
+        OvsDb_Base_Receipt base;
+        OvsDb_Insert_Receipt insert;
+        OvsDb_Monitor_Receipt monitor;
+        OvsDb_Monitor_Cancel_Receipt monitor_cancel;
+        OvsDb_Delete_Receipt del;
+        OvsDb_Insert_Batch_Receipt insert_batch;
+    } receipt;
+
+    memset(&receipt, 0, sizeof(receipt));
+    receipt.insert_batch.failed_row = -1;   // only read for a batch
+    receipt.base.receipt_id = node->receipt_type;
+    receipt.base.status = status;
+    snprintf(receipt.base.error, sizeof(receipt.base.error), "%s",
+        error ? error : "request failed");
+
+    receipt_node_complete(node, &receipt.base);
+}
+
+/** Unlinks 'node', found at 'link', from its bucket and its deadline **/
+static void receipt_stripe_unlink(receipt_stripe* stripe, receipt_node_t** link)
+{
+    receipt_node_t* node = *link;
+
+    *link = node->next;
+    node->next = NULL;
+    timer_wheel_remove(&stripe->wheel, &node->timer);
+    stripe->count--;
+}
 
-OVS_STATUS receipt_list_add(const char* rid, OVSDB_RECEIPT_ID receipt_type, ovsdb_receipt_cb cb)
+static OVS_STATUS receipt_list_append(receipt_list* list, const char* rid,
+    OVSDB_RECEIPT_ID receipt_type, ovsdb_receipt_cb cb,
+    receipt_list_data_cb data_cb, void* data, int session)
 {
+    receipt_node_t** link = NULL;
+    receipt_stripe* stripe = NULL;
+    unsigned int timeout_msecs = 0;
+    uint64_t now = 0;
+
     OvsDbApiDebug("%s adding rid %s with receipt type %d to list...\n",
         __func__, rid, receipt_type);
 
-    if (!rid)
+    if (!list || !rid)
     {
-        OvsDbApiError("%s 'rid' is NULL", __func__);
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
         return OVS_FAILED_STATUS;
     }
 
-    receipt_node_t* new_node = malloc(sizeof(receipt_node_t));
+    receipt_node_t* new_node = calloc(1, sizeof(receipt_node_t));
     if (!new_node)
     {
         OvsDbApiError("%s failed to allocate new receipt node for rid: %s\n",
@@ -54,113 +264,406 @@ OVS_STATUS receipt_list_add(const char* rid, OVSDB_RECEIPT_ID receipt_type, ovsd
         return OVS_FAILED_STATUS;
     }
 
-    memset(new_node->rid, 0, sizeof(new_node->rid));
     strncpy(new_node->rid, rid, MAX_UUID_LEN);
     new_node->callback = cb;
+    new_node->data_callback = data_cb;
+    new_node->data = data;
     new_node->receipt_type = receipt_type;
-    new_node->next = NULL;
+    new_node->session = session;
+    new_node->key = receipt_key(new_node->rid);
 
-    if (!msg_list)
+    timeout_msecs = __atomic_load_n(&list->timeout_msecs, __ATOMIC_RELAXED);
+    if (timeout_msecs)
     {
-        msg_list = new_node;
-        return OVS_SUCCESS_STATUS;
+        now = receipt_list_ticks();
     }
 
-    receipt_node_t* temp = msg_list;
-    while (temp->next != NULL)
+    stripe = receipt_list_stripe(list, new_node->key);
+    pthread_mutex_lock(&stripe->mutex);
+    if (stripe->count >= stripe->num_buckets &&
+        receipt_stripe_grow(stripe) != OVS_SUCCESS_STATUS)
     {
-        temp = temp->next;
+        pthread_mutex_unlock(&stripe->mutex);
+        OvsDbApiError("%s failed to allocate receipt buckets for rid: %s\n",
+            __func__, rid);
+        free(new_node);
+        return OVS_FAILED_STATUS;
     }
-    temp->next = new_node;
+    // appended, so that a reused rid is still answered oldest first
+    link = receipt_stripe_bucket(stripe->buckets, stripe->num_buckets, new_node->key);
+    while (*link != NULL)
+    {
+        link = &(*link)->next;
+    }
+    *link = new_node;
+    stripe->count++;
+    if (timeout_msecs)
+    {
+        if (stripe->wheel.count == 0)
+        {   // nobody advanced the idle wheel, catch up first
+            (void)timer_wheel_advance(&stripe->wheel, now);
+        }
+        timer_wheel_add(&stripe->wheel, &new_node->timer, now +
+            (timeout_msecs + RECEIPT_LIST_TICK_MSECS - 1) / RECEIPT_LIST_TICK_MSECS);
+    }
+    pthread_mutex_unlock(&stripe->mutex);
     return OVS_SUCCESS_STATUS;
 }
 
-OVS_STATUS receipt_list_process(const char* rid, json_t* result)
+OVS_STATUS receipt_list_add(receipt_list* list, const char* rid,
+    OVSDB_RECEIPT_ID receipt_type, ovsdb_receipt_cb cb, int session)
 {
-    receipt_node_t* curr = NULL;
-    receipt_node_t* next = NULL;
+    return receipt_list_append(list, rid, receipt_type, cb, NULL, NULL, session);
+}
+
+/**
+ * Same as receipt_list_add() for callers that need their own context back
+ * in the callback.
+**/
+OVS_STATUS receipt_list_add_data(receipt_list* list, const char* rid,
+    OVSDB_RECEIPT_ID receipt_type, receipt_list_data_cb cb, void* data, int session)
+{
+    return receipt_list_append(list, rid, receipt_type, NULL, cb, data, session);
+}
+
+/**
+ * Unlinks the node matching 'rid', the caller owns it afterwards.
+**/
+static receipt_node_t* receipt_list_take(receipt_list* list, const char* rid)
+{
+    uint32_t key = receipt_key(rid);
+    receipt_stripe* stripe = receipt_list_stripe(list, key);
+    receipt_node_t** link = NULL;
+    receipt_node_t* node = NULL;
+
+    pthread_mutex_lock(&stripe->mutex);
+    if (stripe->buckets && *(link = receipt_stripe_find(stripe, key, rid)) != NULL)
+    {
+        node = *link;
+        receipt_stripe_unlink(stripe, link);
+    }
+    pthread_mutex_unlock(&stripe->mutex);
+    return node;
+}
+
+/**
+ * Completes the receipt of 'rid' with its decoded 'result', 'error' is the
+ * error member of the response, NULL or null if there is none.
+**/
+OVS_STATUS receipt_list_process(receipt_list* list, const char* rid, json_t* result,
+    json_t* error)
+{
+    receipt_node_t* node = NULL;
+
+    if (!list || !rid)
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
 
     OvsDbApiDebug("%s parsing rid: %s\n", __func__, rid);
 
-    if (!rid)
+    node = receipt_list_take(list, rid);
+    if (!node)
+    {
+        OvsDbApiWarning("%s rid: %s is not present inside receipt list.\n",
+            __func__, rid);
+        return OVS_FAILED_STATUS;
+    }
+
+    OvsDb_Base_Receipt* parsed_result = ovsdb_parse_result(node->receipt_type, result, error); //Table lookup
+    if (!parsed_result)
+    {   // the node is off its deadline already, this is its only completion
+        OvsDbApiError("%s failed to parse result of receipt with rid: %s\n",
+            __func__, rid);
+        receipt_node_fail(node, OVS_FAILED_STATUS, "unexpected response");
+        free(node);
+        return OVS_FAILED_STATUS;
+    }
+
+    // called without the lock held, the callback may send new requests
+    receipt_node_complete(node, parsed_result);
+    free(parsed_result);
+    free(node);
+    return OVS_SUCCESS_STATUS;
+}
+
+/**
+ * Looks up what kind of response 'rid' is waiting for, so that it can be
+ * decoded before the receipt is completed.
+**/
+OVS_STATUS receipt_list_get_type(receipt_list* list, const char* rid,
+    OVSDB_RECEIPT_ID* receipt_id)
+{
+    receipt_stripe* stripe = NULL;
+    receipt_node_t* node = NULL;
+    OVS_STATUS status = OVS_FAILED_STATUS;
+    uint32_t key = 0;
+
+    if (!list || !rid || !receipt_id)
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    key = receipt_key(rid);
+    stripe = receipt_list_stripe(list, key);
+    pthread_mutex_lock(&stripe->mutex);
+    if (stripe->buckets && (node = *receipt_stripe_find(stripe, key, rid)) != NULL)
+    {
+        *receipt_id = node->receipt_type;
+        status = OVS_SUCCESS_STATUS;
+    }
+    pthread_mutex_unlock(&stripe->mutex);
+    return status;
+}
+
+/**
+ * Same as receipt_list_process() for a response the caller already decoded.
+**/
+OVS_STATUS receipt_list_complete(receipt_list* list, const char* rid,
+    const OvsDb_Base_Receipt* receipt)
+{
+    receipt_node_t* node = NULL;
+
+    if (!list || !rid || !receipt)
     {
-        OvsDbApiError("%s 'rid' is NULL", __func__);
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
         return OVS_FAILED_STATUS;
     }
 
-    if (!msg_list)
+    node = receipt_list_take(list, rid);
+    if (!node)
     {
-        OvsDbApiError("%s Cannot process receipt with rid: %s as receipt list is empty.\n",
+        OvsDbApiWarning("%s rid: %s is not present inside receipt list.\n",
             __func__, rid);
         return OVS_FAILED_STATUS;
     }
 
-    if (strncmp(rid, msg_list->rid, sizeof(msg_list->rid)) == 0)
+    receipt_node_complete(node, receipt);
+    free(node);
+    return OVS_SUCCESS_STATUS;
+}
+
+/**
+ * Drops the receipt without calling its callback, e.g. when the request
+ * could not be sent.
+**/
+OVS_STATUS receipt_list_remove(receipt_list* list, const char* rid)
+{
+    receipt_node_t* node = NULL;
+
+    if (!list || !rid)
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    node = receipt_list_take(list, rid);
+    if (!node)
+    {
+        OvsDbApiWarning("%s rid: %s is not present inside receipt list.\n",
+            __func__, rid);
+        return OVS_FAILED_STATUS;
+    }
+
+    free(node);
+    return OVS_SUCCESS_STATUS;
+}
+
+/**
+ * Completes the pending receipts of 'session', or all of them when
+ * 'session' is negative, with a failure. The nodes are unlinked one stripe
+ * at a time before any callback runs.
+**/
+static OVS_STATUS receipt_list_fail(receipt_list* list, int session,
+    OVS_STATUS status, const char* error)
+{
+    receipt_stripe* stripe = NULL;
+    receipt_node_t** link = NULL;
+    receipt_node_t* failed = NULL;
+    receipt_node_t* curr = NULL;
+    receipt_node_t* next = NULL;
+    size_t i, j;
+
+    if (!list)
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    for (i = 0; i < RECEIPT_LIST_STRIPES; i++)
     {
-        OvsDb_Base_Receipt* parsed_result = ovsdb_parse_result(msg_list->receipt_type, result);
-        if (!parsed_result)  //TODO: Call callback with error rather than exit
+        stripe = &list->stripes[i];
+        pthread_mutex_lock(&stripe->mutex);
+        for (j = 0; j < stripe->num_buckets; j++)
         {
-            OvsDbApiError("%s failed to parse result of receipt with rid: %s\n",
-                __func__, rid);
-            return OVS_FAILED_STATUS;
+            link = &stripe->buckets[j];
+            while (*link != NULL)
+            {
+                curr = *link;
+                if (session >= 0 && curr->session != session)
+                {
+                    link = &curr->next;
+                    continue;
+                }
+                receipt_stripe_unlink(stripe, link);
+                curr->next = failed;
+                failed = curr;
+            }
         }
+        pthread_mutex_unlock(&stripe->mutex);
+    }
 
-        msg_list->callback(rid, parsed_result);
-        free(parsed_result);
+    for (curr = failed; curr != NULL; curr = next)
+    {
+        OvsDbApiWarning("%s failing rid: %s, Receipt Id: %d\n", __func__,
+            curr->rid, curr->receipt_type);
 
-        curr = msg_list;
-        msg_list = msg_list->next;
+        next = curr->next;
+        receipt_node_fail(curr, status, error);
         free(curr);
-        return OVS_SUCCESS_STATUS;
     }
+    return OVS_SUCCESS_STATUS;
+}
+
+/**
+ * Completes every pending receipt with a failure, e.g. when OVSDB is going
+ * away and no response will ever arrive.
+**/
+OVS_STATUS receipt_list_fail_all(receipt_list* list, OVS_STATUS status, const char* error)
+{
+    return receipt_list_fail(list, -1, status, error);
+}
+
+/**
+ * Fails only the requests sent on 'session', e.g. when that connection was
+ * lost.
+**/
+OVS_STATUS receipt_list_fail_session(receipt_list* list, int session,
+    OVS_STATUS status, const char* error)
+{
+    if (session < 0)
+    {
+        OvsDbApiError("%s invalid session %d\n", __func__, session);
+        return OVS_FAILED_STATUS;
+    }
+    return receipt_list_fail(list, session, status, error);
+}
+
+OVS_STATUS receipt_list_clear(receipt_list* list)
+{
+    receipt_stripe* stripe = NULL;
+    receipt_node_t* curr = NULL;
+    receipt_node_t* next = NULL;
+    size_t i, j;
+
+    if (!list)
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    OvsDbApiDebug("%s clearing the receipt list.\n", __func__);
 
-    curr = msg_list;
-    next = curr->next;
-    while (next != NULL)
+    for (i = 0; i < RECEIPT_LIST_STRIPES; i++)
     {
-        if (strncmp(rid, next->rid, sizeof(next->rid)) == 0)
+        stripe = &list->stripes[i];
+        pthread_mutex_lock(&stripe->mutex);
+        for (j = 0; j < stripe->num_buckets; j++)
         {
-            OvsDb_Base_Receipt* parsed_result = ovsdb_parse_result(next->receipt_type, result); //Table lookup
-            if (!parsed_result)
+            for (curr = stripe->buckets[j]; curr != NULL; curr = next)
             {
-                OvsDbApiError("%s failed to parse result of receipt with rid: %s\n",
-                    __func__, rid);
-                return OVS_FAILED_STATUS;
+                OvsDbApiDebug("%s clearing rid: %s, Receipt Id: %d, from list.\n",
+                    __func__, curr->rid, curr->receipt_type);
+                next = curr->next;
+                timer_wheel_remove(&stripe->wheel, &curr->timer);
+                free(curr);
             }
-
-            next->callback(rid, parsed_result);
-            free(parsed_result);
-            curr->next = next->next;
-            free(next);
-            return OVS_SUCCESS_STATUS;
+            stripe->buckets[j] = NULL;
         }
+        stripe->count = 0;
+        pthread_mutex_unlock(&stripe->mutex);
+    }
+    return OVS_SUCCESS_STATUS;
+}
 
-        curr = curr->next;
-        next = curr->next;
+/**
+ * Applies to the receipts added afterwards, 0 lets them wait for their
+ * response forever.
+**/
+OVS_STATUS receipt_list_set_timeout(receipt_list* list, unsigned int msecs)
+{
+    if (!list)
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
     }
 
-    OvsDbApiWarning("%s rid: %s is not present inside receipt list.\n",
-        __func__, rid);
-    return OVS_FAILED_STATUS;
+    __atomic_store_n(&list->timeout_msecs, msecs, __ATOMIC_RELAXED);
+    return OVS_SUCCESS_STATUS;
 }
 
-OVS_STATUS receipt_list_clear()
+/**
+ * Completes the receipts whose deadline passed with OVS_TIMED_OUT_STATUS,
+ * to be called every RECEIPT_LIST_TICK_MSECS. 'pending' is set to the
+ * number of receipts that still have a deadline, once there are none the
+ * caller may stop calling until the next one is added.
+**/
+OVS_STATUS receipt_list_expire(receipt_list* list, size_t* pending)
 {
-    receipt_node_t* curr = msg_list;
+    receipt_stripe* stripe = NULL;
+    timer_wheel_entry* entry = NULL;
+    receipt_node_t** link = NULL;
+    receipt_node_t* expired = NULL;
+    receipt_node_t* curr = NULL;
     receipt_node_t* next = NULL;
+    uint64_t now = 0;
+    size_t count = 0;
+    size_t i;
 
-    OvsDbApiDebug("%s clearing the receipt list.\n", __func__);
+    if (!list)
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    now = receipt_list_ticks();
+    for (i = 0; i < RECEIPT_LIST_STRIPES; i++)
+    {
+        stripe = &list->stripes[i];
+        pthread_mutex_lock(&stripe->mutex);
+        for (entry = timer_wheel_advance(&stripe->wheel, now); entry != NULL;
+            entry = entry->next)
+        {
+            curr = receipt_node_of(entry);
+            // the node itself rather than its rid, which may have been reused
+            link = receipt_stripe_bucket(stripe->buckets, stripe->num_buckets, curr->key);
+            while (*link != curr)
+            {
+                link = &(*link)->next;
+            }
+            *link = curr->next;
+            curr->next = expired;
+            expired = curr;
+            stripe->count--;
+        }
+        count += stripe->wheel.count;
+        pthread_mutex_unlock(&stripe->mutex);
+    }
 
-    while (curr != NULL)
+    for (curr = expired; curr != NULL; curr = next)
     {
-        OvsDbApiDebug("%s clearing rid: %s, Receipt Id: %d, from list.\n",
-            __func__, curr->rid, curr->receipt_type);
+        OvsDbApiWarning("%s rid: %s, Receipt Id: %d timed out\n", __func__,
+            curr->rid, curr->receipt_type);
         next = curr->next;
+        receipt_node_fail(curr, OVS_TIMED_OUT_STATUS, "request timed out");
         free(curr);
-        curr = next;
     }
 
-    msg_list = NULL;
+    if (pending)
+    {
+        *pending = count;
+    }
     return OVS_SUCCESS_STATUS;
 }
-
@@ -22,8 +22,35 @@
 #include <jansson.h>
 #include "OvsDbApi/OvsDbDefs.h"
 
-OVS_STATUS receipt_list_add(const char* rid, OVSDB_RECEIPT_ID receipt_id, ovsdb_receipt_cb cb);
-OVS_STATUS receipt_list_process(const char* rid, json_t* result);
-OVS_STATUS receipt_list_clear();
+// a request without a response by then is completed with OVS_TIMED_OUT_STATUS
+#define RECEIPT_LIST_TIMEOUT_MSECS  30000
+#define RECEIPT_LIST_TICK_MSECS     100
+
+/** Requests waiting for their response, one list per OVSDB context **/
+typedef struct receipt_list receipt_list;
+
+typedef void (*receipt_list_data_cb)(const char* rid, const OvsDb_Base_Receipt* receipt,
+    void* data);
+
+receipt_list* receipt_list_create();
+void receipt_list_destroy(receipt_list* list);
+
+OVS_STATUS receipt_list_add(receipt_list* list, const char* rid,
+    OVSDB_RECEIPT_ID receipt_id, ovsdb_receipt_cb cb, int session);
+OVS_STATUS receipt_list_add_data(receipt_list* list, const char* rid,
+    OVSDB_RECEIPT_ID receipt_id, receipt_list_data_cb cb, void* data, int session);
+OVS_STATUS receipt_list_process(receipt_list* list, const char* rid, json_t* result,
+    json_t* error);
+OVS_STATUS receipt_list_get_type(receipt_list* list, const char* rid,
+    OVSDB_RECEIPT_ID* receipt_id);
+OVS_STATUS receipt_list_complete(receipt_list* list, const char* rid,
+    const OvsDb_Base_Receipt* receipt);
+OVS_STATUS receipt_list_remove(receipt_list* list, const char* rid);
+OVS_STATUS receipt_list_fail_all(receipt_list* list, OVS_STATUS status, const char* error);
+OVS_STATUS receipt_list_fail_session(receipt_list* list, int session,
+    OVS_STATUS status, const char* error);
+OVS_STATUS receipt_list_clear(receipt_list* list);
+OVS_STATUS receipt_list_set_timeout(receipt_list* list, unsigned int msecs);
+OVS_STATUS receipt_list_expire(receipt_list* list, size_t* pending);
 
 #endif
@@ -0,0 +1,217 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "OvsDbApi/row_cache.h"
+#include "OvsDbApi/json_parser/table_desc.h"
+#include "common/OvsAgentLog.h"
+
+#define ROW_CACHE_MIN_BUCKETS 16
+
+typedef struct row_node_t
+{
+    char uuid[MAX_UUID_LEN+1];
+    ovsdb_table_row row;
+    struct row_node_t* next;
+} row_node_t;
+
+struct row_cache
+{
+    row_node_t** buckets;
+    size_t num_buckets;         // a power of 2
+    size_t count;
+};
+
+row_cache* row_cache_create()
+{
+    row_cache* cache = calloc(1, sizeof(row_cache));
+
+    if (!cache || (cache->buckets = calloc(ROW_CACHE_MIN_BUCKETS, sizeof(row_node_t*))) == NULL)
+    {
+        OvsDbApiError("%s failed to allocate row cache.\n", __func__);
+        free(cache);
+        return NULL;
+    }
+
+    cache->num_buckets = ROW_CACHE_MIN_BUCKETS;
+    return cache;
+}
+
+void row_cache_destroy(row_cache* cache)
+{
+    if (!cache)
+    {
+        return;
+    }
+
+    row_cache_clear(cache);
+    free(cache->buckets);
+    free(cache);
+}
+
+static row_node_t** row_cache_bucket(row_node_t** buckets, size_t num_buckets,
+    const char* uuid)
+{
+    return &buckets[table_name_hash(uuid, strlen(uuid)) & (num_buckets - 1)];
+}
+
+static row_node_t** row_cache_find(row_cache* cache, const char* uuid)
+{
+    row_node_t** link = row_cache_bucket(cache->buckets, cache->num_buckets, uuid);
+
+    while (*link && strncmp((*link)->uuid, uuid, sizeof((*link)->uuid)) != 0)
+    {
+        link = &(*link)->next;
+    }
+    return link;
+}
+
+/** Doubles the buckets once there are more rows than buckets **/
+static void row_cache_grow(row_cache* cache)
+{
+    size_t num_buckets = cache->num_buckets * 2;
+    row_node_t** buckets = calloc(num_buckets, sizeof(row_node_t*));
+    row_node_t** link = NULL;
+    row_node_t* node = NULL;
+    size_t i;
+
+    if (!buckets)
+    {   // longer chains, but still correct
+        return;
+    }
+
+    for (i = 0; i < cache->num_buckets; i++)
+    {
+        while ((node = cache->buckets[i]) != NULL)
+        {
+            cache->buckets[i] = node->next;
+            link = row_cache_bucket(buckets, num_buckets, node->uuid);
+            node->next = *link;
+            *link = node;
+        }
+    }
+
+    free(cache->buckets);
+    cache->buckets = buckets;
+    cache->num_buckets = num_buckets;
+}
+
+ovsdb_table_row* row_cache_get(row_cache* cache, const char* uuid)
+{
+    row_node_t** link = NULL;
+
+    if (!cache || !uuid)
+    {
+        return NULL;
+    }
+
+    link = row_cache_find(cache, uuid);
+    return *link ? &(*link)->row : NULL;
+}
+
+/** Adds the row 'uuid', or replaces its contents if it is already cached **/
+OVS_STATUS row_cache_put(row_cache* cache, const char* uuid, const ovsdb_table_row* row)
+{
+    row_node_t** link = NULL;
+    row_node_t* node = NULL;
+
+    if (!cache || !uuid || !row)
+    {
+        OvsDbApiError("%s Invalid NULL parameter.\n", __func__);
+        return OVS_FAILED_STATUS;
+    }
+
+    link = row_cache_find(cache, uuid);
+    if (*link)
+    {
+        memcpy(&(*link)->row, row, sizeof(ovsdb_table_row));
+        return OVS_SUCCESS_STATUS;
+    }
+
+    if ((node = malloc(sizeof(row_node_t))) == NULL)
+    {
+        OvsDbApiError("%s failed to allocate row %s.\n", __func__, uuid);
+        return OVS_FAILED_STATUS;
+    }
+
+    memset(node->uuid, 0, sizeof(node->uuid));
+    strncpy(node->uuid, uuid, MAX_UUID_LEN);
+    memcpy(&node->row, row, sizeof(ovsdb_table_row));
+    node->next = NULL;
+    *link = node;
+
+    if (++cache->count > cache->num_buckets)
+    {
+        row_cache_grow(cache);
+    }
+    return OVS_SUCCESS_STATUS;
+}
+
+/** Removes the row 'uuid', its contents are copied to 'last' if not NULL **/
+OVS_STATUS row_cache_remove(row_cache* cache, const char* uuid, ovsdb_table_row* last)
+{
+    row_node_t** link = NULL;
+    row_node_t* node = NULL;
+
+    if (!cache || !uuid)
+    {
+        return OVS_FAILED_STATUS;
+    }
+
+    link = row_cache_find(cache, uuid);
+    if ((node = *link) == NULL)
+    {
+        return OVS_FAILED_STATUS;
+    }
+
+    *link = node->next;
+    if (last)
+    {
+        memcpy(last, &node->row, sizeof(ovsdb_table_row));
+    }
+    free(node);
+    cache->count--;
+    return OVS_SUCCESS_STATUS;
+}
+
+void row_cache_clear(row_cache* cache)
+{
+    row_node_t* node = NULL;
+    size_t i;
+
+    if (!cache)
+    {
+        return;
+    }
+
+    for (i = 0; i < cache->num_buckets; i++)
+    {
+        while ((node = cache->buckets[i]) != NULL)
+        {
+            cache->buckets[i] = node->next;
+            free(node);
+        }
+    }
+    cache->count = 0;
+}
+
+size_t row_cache_count(const row_cache* cache)
+{
+    return cache ? cache->count : 0;
+}
@@ -0,0 +1,42 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+#ifndef ROW_CACHE_H
+#define ROW_CACHE_H
+
+#include <stddef.h>
+#include "OvsDbApi/OvsDbDefs.h"
+#include "OvsDbApi/json_parser/ovsdb_schema.h"
+
+/**
+ * The rows a monitor has seen, by row uuid, to apply the modify deltas
+ * of update2 notifications to. Not locked, the monitor list that owns a
+ * cache serializes the access to it.
+**/
+typedef struct row_cache row_cache;
+
+row_cache* row_cache_create();
+void row_cache_destroy(row_cache* cache);
+
+ovsdb_table_row* row_cache_get(row_cache* cache, const char* uuid);
+OVS_STATUS row_cache_put(row_cache* cache, const char* uuid, const ovsdb_table_row* row);
+OVS_STATUS row_cache_remove(row_cache* cache, const char* uuid, ovsdb_table_row* last);
+void row_cache_clear(row_cache* cache);
+size_t row_cache_count(const row_cache* cache);
+
+#endif
@@ -0,0 +1,150 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+#include <string.h>
+#include "OvsDbApi/timer_wheel.h"
+
+#define TIMER_WHEEL_SLOT_MASK   (TIMER_WHEEL_SLOTS - 1)
+
+void timer_wheel_init(timer_wheel* wheel, uint64_t now)
+{
+    memset(wheel, 0, sizeof(timer_wheel));
+    wheel->now = now;
+}
+
+/** Picks the lowest level whose slots still reach the entry's tick **/
+static void timer_wheel_place(timer_wheel* wheel, timer_wheel_entry* entry)
+{
+    uint64_t delta = entry->expires - wheel->now;
+    timer_wheel_entry** slot = NULL;
+    int level = 0;
+
+    while (level < TIMER_WHEEL_LEVELS - 1 &&
+        delta >= ((uint64_t)1 << ((level + 1) * TIMER_WHEEL_SLOT_BITS)))
+    {
+        level++;
+    }
+
+    slot = &wheel->slots[level][(entry->expires >> (level * TIMER_WHEEL_SLOT_BITS)) &
+        TIMER_WHEEL_SLOT_MASK];
+    entry->next = *slot;
+    entry->pprev = slot;
+    if (*slot)
+    {
+        (*slot)->pprev = &entry->next;
+    }
+    *slot = entry;
+}
+
+/**
+ * Schedules 'entry' to expire at tick 'expires'. Ticks that already passed
+ * expire with the next one, ticks beyond TIMER_WHEEL_MAX_TICKS are cut
+ * short to the farthest the wheel reaches.
+**/
+void timer_wheel_add(timer_wheel* wheel, timer_wheel_entry* entry, uint64_t expires)
+{
+    timer_wheel_remove(wheel, entry);
+
+    if (expires <= wheel->now)
+    {
+        expires = wheel->now + 1;
+    }
+    else if (expires - wheel->now >= TIMER_WHEEL_MAX_TICKS)
+    {
+        expires = wheel->now + TIMER_WHEEL_MAX_TICKS - 1;
+    }
+
+    entry->expires = expires;
+    timer_wheel_place(wheel, entry);
+    wheel->count++;
+}
+
+/** Does nothing for an entry that is not scheduled **/
+void timer_wheel_remove(timer_wheel* wheel, timer_wheel_entry* entry)
+{
+    if (!entry->pprev)
+    {
+        return;
+    }
+
+    *entry->pprev = entry->next;
+    if (entry->next)
+    {
+        entry->next->pprev = entry->pprev;
+    }
+    entry->next = NULL;
+    entry->pprev = NULL;
+    wheel->count--;
+}
+
+/** Moves the entries of the current slot of 'level' down to the levels below **/
+static void timer_wheel_cascade(timer_wheel* wheel, int level)
+{
+    timer_wheel_entry** slot = &wheel->slots[level][(wheel->now >>
+        (level * TIMER_WHEEL_SLOT_BITS)) & TIMER_WHEEL_SLOT_MASK];
+    timer_wheel_entry* entry = *slot;
+    timer_wheel_entry* next = NULL;
+
+    *slot = NULL;
+    for (; entry != NULL; entry = next)
+    {
+        next = entry->next;
+        timer_wheel_place(wheel, entry);
+    }
+}
+
+/**
+ * Moves the wheel to tick 'now' and returns the entries that expired on
+ * the way, linked through 'next' and no longer scheduled. An empty wheel
+ * jumps there right away.
+**/
+timer_wheel_entry* timer_wheel_advance(timer_wheel* wheel, uint64_t now)
+{
+    timer_wheel_entry* expired = NULL;
+    timer_wheel_entry* entry = NULL;
+    timer_wheel_entry** slot = NULL;
+    int level = 0;
+
+    while (wheel->now < now)
+    {
+        if (wheel->count == 0)
+        {
+            wheel->now = now;
+            break;
+        }
+
+        wheel->now++;
+        for (level = 1; level < TIMER_WHEEL_LEVELS &&
+            (wheel->now & (((uint64_t)1 << (level * TIMER_WHEEL_SLOT_BITS)) - 1)) == 0;
+            level++)
+        {
+            timer_wheel_cascade(wheel, level);
+        }
+
+        slot = &wheel->slots[0][wheel->now & TIMER_WHEEL_SLOT_MASK];
+        while ((entry = *slot) != NULL)
+        {
+            *slot = entry->next;
+            entry->pprev = NULL;
+            entry->next = expired;
+            expired = entry;
+            wheel->count--;
+        }
+    }
+    return expired;
+}
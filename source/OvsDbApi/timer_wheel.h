@@ -0,0 +1,56 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define TIMER_WHEEL_LEVELS      4
+#define TIMER_WHEEL_SLOT_BITS   6
+#define TIMER_WHEEL_SLOTS       (1 << TIMER_WHEEL_SLOT_BITS)
+#define TIMER_WHEEL_MAX_TICKS   ((uint64_t)1 << (TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOT_BITS))
+
+/** Embedded in whatever has a deadline, the wheel never allocates **/
+typedef struct timer_wheel_entry
+{
+    struct timer_wheel_entry* next;
+    struct timer_wheel_entry** pprev;   // NULL while not scheduled
+    uint64_t expires;                   // in ticks
+} timer_wheel_entry;
+
+/**
+ * Hierarchical timer wheel, each level has TIMER_WHEEL_SLOTS slots that
+ * span TIMER_WHEEL_SLOTS times the ticks of the level below. Adding and
+ * removing an entry is O(1), an entry is moved down at most once per
+ * level before it expires. Not locked, the owner serializes the access.
+**/
+typedef struct timer_wheel
+{
+    uint64_t now;                       // in ticks
+    size_t count;
+    timer_wheel_entry* slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+} timer_wheel;
+
+void timer_wheel_init(timer_wheel* wheel, uint64_t now);
+void timer_wheel_add(timer_wheel* wheel, timer_wheel_entry* entry, uint64_t expires);
+void timer_wheel_remove(timer_wheel* wheel, timer_wheel_entry* entry);
+timer_wheel_entry* timer_wheel_advance(timer_wheel* wheel, uint64_t now);
+
+#endif
@@ -21,6 +21,7 @@
 #define OVS_AGENT_API_H_
 
 #include <stdbool.h>
+#include <stddef.h>
 #include "OvsConfig.h"
 
 /**
@@ -61,8 +62,71 @@ bool ovs_agent_api_get_config(OVS_TABLE table, void ** ppConfig);
  * @param[in] callback Callback function that is called when the response is
  *                     ready to be provided back to the caller.
  *
+ * In OVS_DISABLE_BLOCK_MODE a transact request that returns true calls its
+ * callback exactly once, with the Feedback status, the failed status of the
+ * write, or OVS_TIMED_OUT_STATUS when no Feedback came in time. One that
+ * returns false does not call it.
+ *
  * @return boolean true indicating success, false indicating failure.
  */
 bool ovs_agent_api_interact(ovs_interact_request * request, ovs_interact_cb callback);
 
+/**
+ * @brief Submit several transact requests as one OVS DB transaction.
+ *
+ * All requests must be insert transactions with the same block mode. Their
+ * rows are inserted all or none, in one round trip, and each gets its own
+ * Feedback. The callback is called once, when every row has its Feedback,
+ * with the status of each, or with all of them failed or timed out. In
+ * OVS_ENABLE_BLOCK_MODE it returns once that is known.
+ *
+ * @param[in] requests Array of requests, the table configs are taken over.
+ * @param[in] count Number of requests.
+ * @param[in] callback Callback function that is called with the result of
+ *                     every row, can be NULL.
+ *
+ * @return boolean true indicating success, false indicating failure. In
+ *         OVS_ENABLE_BLOCK_MODE true only when every row succeeded.
+ */
+bool ovs_agent_api_interact_batch(ovs_interact_request * requests, size_t count,
+    ovs_interact_batch_cb callback);
+
+/**
+ * @brief Submit a transact request whose completion is queued instead of
+ *        calling back.
+ *
+ * Only non-blocking insert transactions can be queued. A request that returns
+ * true is completed exactly once, like with ovs_agent_api_interact(), and
+ * the completion carries its table config and user_data.
+ *
+ * @param[in] request Pointer to a request structure.
+ * @param[in] user_data Returned in the completion to identify the request.
+ *
+ * @return boolean true indicating success, false indicating failure.
+ */
+bool ovs_agent_api_interact_queued(ovs_interact_request * request, uint64_t user_data);
+
+/**
+ * @brief Returns a non-blocking eventfd that is readable while completions
+ *        are queued, to watch with poll or epoll.
+ *
+ * The fd belongs to the OVS Agent API, it must neither be read nor closed.
+ *
+ * @return The fd, or -1 when not initialized.
+ */
+int ovs_agent_api_get_completion_fd(void);
+
+/**
+ * @brief Takes queued completions, oldest first.
+ *
+ * Reap until fewer than max are returned, the fd stays readable until the
+ * queue is empty.
+ *
+ * @param[out] completions Array to fill with completions.
+ * @param[in] max Number of completions the array can hold.
+ *
+ * @return The number of completions taken.
+ */
+size_t ovs_agent_api_reap_completions(ovs_agent_api_completion * completions, size_t max);
+
 #endif /* OVS_AGENT_API_H_ */
@@ -30,4 +30,10 @@
 #define OVSAGENT_INIT_FILE       "/tmp/ovsagent_initialized"
 #endif
 
+/* Last OVSDB transaction the agent's monitors saw, kept in /tmp so that a
+   reboot, which loses the applied configuration, starts from scratch. */
+#ifndef OVSAGENT_STATE_FILE
+#define OVSAGENT_STATE_FILE      "/tmp/ovsagent_monitor_txn"
+#endif
+
 #endif
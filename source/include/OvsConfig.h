@@ -20,6 +20,8 @@
 #ifndef OVS_CONFIG_H_
 #define OVS_CONFIG_H_
 
+#include <stddef.h>
+#include <stdint.h>
 #include "gateway_config.h"
 #include "feedback.h"
 
@@ -132,4 +134,33 @@ typedef struct ovs_interact_request
  */
 typedef void (*ovs_interact_cb) (OVS_STATUS status, Rdkb_Table_Config * table_config);
 
+/**
+ * @brief Callback for a batch of DB Interactions.
+ *
+ * @param[out] status OVS_SUCCESS_STATUS once every row succeeded, otherwise
+ *                    the status of the first row that did not.
+ * @param[out] row_status The status code of each row, in the order of the
+ *                        requests.
+ * @param[out] table_configs The RDKB Component's table configuration of each row.
+ * @param[out] count Number of rows.
+ * NOTE: If needed, the RDKB Component must make a copy of the tables' config
+ *       data, as it will be deleted after the callback completes.
+ */
+typedef void (*ovs_interact_batch_cb) (OVS_STATUS status, const OVS_STATUS * row_status,
+    Rdkb_Table_Config * table_configs, size_t count);
+
+/**
+ * @brief Completion of a queued DB interaction.
+ *
+ * Reaped from the completion queue, see ovs_agent_api_reap_completions().
+ * NOTE: The table's config data is handed over, the RDKB Component must free
+ *       it.
+ */
+typedef struct ovs_agent_api_completion
+{
+  uint64_t user_data; /**< As passed to ovs_agent_api_interact_queued(). */
+  OVS_STATUS status; /**< Status code of the DB interact operation. */
+  Rdkb_Table_Config table_config; /**< The table configuration of the request. */
+} ovs_agent_api_completion;
+
 #endif /* OVS_CONFIG_H_ */
@@ -32,7 +32,8 @@ typedef enum ovs_status
   OVS_UNKNOWN_STATUS, /**< Unknown or pending status. */
   OVS_FAILED_STATUS, /**< Failed or error status. */
   OVS_TIMED_OUT_STATUS, /**< Operation timed out. */
-  OVS_TIMED_WAIT_ERROR_STATUS /**< Error while waiting on a timed operation to complete. */
+  OVS_TIMED_WAIT_ERROR_STATUS, /**< Error while waiting on a timed operation to complete. */
+  OVS_BUSY_STATUS /**< Send queue is full, retry once pending requests complete. */
 } OVS_STATUS;
 
 /**
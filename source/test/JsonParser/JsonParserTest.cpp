@@ -19,6 +19,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string>
+#include <vector>
 #include "test/mocks/MockJsonParser.h"
 
 extern "C" {
@@ -38,10 +39,17 @@ class JsonParserTestFixture : public ::testing::Test
 {
     protected:
         JsonParserMock mockedJsonParser;
+        ovsdb_msg_target m_target;  // the lists are mocked, only passed through
+        std::string m_lastTxnId;
 
         JsonParserTestFixture()
         {
             g_jsonParserMock = &mockedJsonParser;
+            memset(&m_target, 0, sizeof(m_target));
+            m_target.txn_fn = RecordTxn;
+            m_target.txn_data = &m_lastTxnId;
+            EXPECT_CALL(mockedJsonParser, mon_list_update(_, _, _))
+                .Times(::testing::AnyNumber());
         }
         virtual ~JsonParserTestFixture()
         {
@@ -74,6 +82,11 @@ class JsonParserTestFixture : public ::testing::Test
             OvsDbApiInfo("%s %s\n", __func__,
                 ::testing::UnitTest::GetInstance()->current_test_case()->name());
         }
+
+        static void RecordTxn(void * data, const char * txn_id)
+        {
+            *(std::string *)data = txn_id;
+        }
 };
 
 MATCHER_P(JsonMatch, n, "")
@@ -136,10 +149,10 @@ TEST_F(JsonParserTestFixture, insert_receipt_test)
     json_t* expected_result = json_loads("[{\"uuid\":[\"uuid\",\"f8ecdbd4-0c07-42a9-91ff-819bbf2f4196\"]}]", 0, NULL);
     const char* expected_id = "2003";
 
-    EXPECT_CALL(*g_jsonParserMock, receipt_list_process(StrEq(expected_id), JsonMatch(expected_result)))
+    EXPECT_CALL(*g_jsonParserMock, receipt_list_process(_, StrEq(expected_id), JsonMatch(expected_result), _))
         .WillOnce(Return(OVS_SUCCESS_STATUS));
 
-    EXPECT_EQ(OVS_SUCCESS_STATUS, ovsdb_parse_msg(example_receipt.c_str(), example_receipt.length()));
+    EXPECT_EQ(OVS_SUCCESS_STATUS, ovsdb_parse_msg(example_receipt.c_str(), example_receipt.length(), &m_target));
 }
 
 TEST_F(JsonParserTestFixture, monitor_update_new_feedback_req_test)
@@ -153,28 +166,37 @@ TEST_F(JsonParserTestFixture, monitor_update_new_feedback_req_test)
     expected_table_config.table.id = OVS_FEEDBACK_TABLE;
     expected_table_config.config = &fb;
 
-    EXPECT_CALL(*g_jsonParserMock, mon_list_process(StrEq(expected_uuid), RdkbTableMatch(&expected_table_config)))
+    EXPECT_CALL(*g_jsonParserMock, mon_list_process(_, StrEq(expected_uuid), RdkbTableMatch(&expected_table_config)))
         .WillOnce(Return(OVS_SUCCESS_STATUS));
 
-    EXPECT_EQ(OVS_SUCCESS_STATUS, ovsdb_parse_msg(example_update.c_str(), example_update.length()));
+    EXPECT_EQ(OVS_SUCCESS_STATUS, ovsdb_parse_msg(example_update.c_str(), example_update.length(), &m_target));
 }
 
 TEST(JsonParserTest, delete_gateway_config_uuid_test)
 {
     const std::string expected_json_str = "{\"method\":\"transact\",\"params\":[\"Open_vSwitch\",{\"op\":\"delete\",\"table\":\"Gateway_Config\",\"where\":[[\"_uuid\",\"==\",[\"uuid\",\"59702df5-c44a-4d44-a34c-4ade23ed7e2d\"]]]}],\"id\":\"null\"}";
 
-    EXPECT_EQ(expected_json_str,
-        ovsdb_delete_to_json(OVS_GW_CONFIG_TABLE, "null", "uuid",
-            "59702df5-c44a-4d44-a34c-4ade23ed7e2d"));
+    char buf[JSON_WRITER_STACK_SIZE];
+    json_writer writer;
+
+    json_writer_init(&writer, buf, sizeof(buf));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_delete_to_json(&writer, OVS_GW_CONFIG_TABLE, "null", "uuid",
+        "59702df5-c44a-4d44-a34c-4ade23ed7e2d"));
+    EXPECT_EQ(expected_json_str, writer.buf);
+    EXPECT_EQ(expected_json_str.size(), writer.len);
 }
 
 TEST(JsonParserTest, delete_feedback_req_uuid_test)
 {
     const std::string expected_json_str = "{\"method\":\"transact\",\"params\":[\"Open_vSwitch\",{\"op\":\"delete\",\"table\":\"Feedback\",\"where\":[[\"req_uuid\",\"==\",\"59702df5-c44a-4d44-a34c-4ade23ed7e2d\"]]}],\"id\":\"null\"}";
 
-    EXPECT_EQ(expected_json_str,
-        ovsdb_delete_to_json(OVS_FEEDBACK_TABLE, "null", "req_uuid",
-            "59702df5-c44a-4d44-a34c-4ade23ed7e2d"));
+    char buf[JSON_WRITER_STACK_SIZE];
+    json_writer writer;
+
+    json_writer_init(&writer, buf, sizeof(buf));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_delete_to_json(&writer, OVS_FEEDBACK_TABLE, "null", "req_uuid",
+        "59702df5-c44a-4d44-a34c-4ade23ed7e2d"));
+    EXPECT_EQ(expected_json_str, writer.buf);
 }
 
 TEST_F(JsonParserTestFixture, monitor_update_old_and_new_gw_config_reqs_test)
@@ -187,8 +209,181 @@ TEST_F(JsonParserTestFixture, monitor_update_old_and_new_gw_config_reqs_test)
     expected_table_config.table.id = OVS_GW_CONFIG_TABLE;
     expected_table_config.config = &gc;
 
-    EXPECT_CALL(*g_jsonParserMock, mon_list_process(StrEq(expected_uuid), RdkbTableMatch(&expected_table_config)))
+    EXPECT_CALL(*g_jsonParserMock, mon_list_process(_, StrEq(expected_uuid), RdkbTableMatch(&expected_table_config)))
         .WillOnce(Return(OVS_SUCCESS_STATUS));
 
-    EXPECT_EQ(OVS_SUCCESS_STATUS, ovsdb_parse_msg(example_update.c_str(), example_update.length()));
+    EXPECT_EQ(OVS_SUCCESS_STATUS, ovsdb_parse_msg(example_update.c_str(), example_update.length(), &m_target));
+}
+
+namespace {
+    OvsDb_Insert_Receipt g_insertReceipt;
+    int g_receiptCount = 0;
+
+    void insert_receipt_cb(const char * rid, const OvsDb_Base_Receipt * receipt)
+    {
+        memcpy(&g_insertReceipt, receipt, sizeof(g_insertReceipt));
+        g_receiptCount++;
+    }
+}
+
+TEST_F(JsonParserTestFixture, insert_receipt_decoded_from_stream_test)
+{
+    const std::string example_receipt = "{\"id\":\"2004\",\"result\":[{\"uuid\":[\"uuid\",\"f8ecdbd4-0c07-42a9-91ff-819bbf2f4196\"]}],\"error\":null}";
+
+    m_target.receipts = receipt_list_create();
+    ASSERT_TRUE(m_target.receipts != NULL);
+    ASSERT_EQ(OVS_SUCCESS_STATUS, receipt_list_add(m_target.receipts, "2004",
+        OVSDB_INSERT_RECEIPT_ID, insert_receipt_cb, 0));
+    g_receiptCount = 0;
+
+    EXPECT_CALL(*g_jsonParserMock, receipt_list_process(_, _, _, _)).Times(0);
+
+    EXPECT_EQ(OVS_SUCCESS_STATUS, ovsdb_parse_msg(example_receipt.c_str(), example_receipt.length(), &m_target));
+    EXPECT_EQ(1, g_receiptCount);
+    EXPECT_EQ(OVSDB_INSERT_RECEIPT_ID, g_insertReceipt.receipt_id);
+    EXPECT_STREQ("f8ecdbd4-0c07-42a9-91ff-819bbf2f4196", g_insertReceipt.uuid);
+
+    receipt_list_destroy(m_target.receipts);
+}
+
+TEST_F(JsonParserTestFixture, failed_insert_falls_back_to_receipt_parser_test)
+{
+    const std::string example_receipt = "{\"id\":\"2005\",\"result\":[{\"error\":\"constraint violation\",\"details\":\"duplicate \\\"if_name\\\"\"}],\"error\":null}";
+    json_t* expected_result = json_loads("[{\"error\":\"constraint violation\",\"details\":\"duplicate \\\"if_name\\\"\"}]", 0, NULL);
+
+    m_target.receipts = receipt_list_create();
+    ASSERT_TRUE(m_target.receipts != NULL);
+    ASSERT_EQ(OVS_SUCCESS_STATUS, receipt_list_add(m_target.receipts, "2005",
+        OVSDB_INSERT_RECEIPT_ID, insert_receipt_cb, 0));
+
+    EXPECT_CALL(*g_jsonParserMock, receipt_list_process(m_target.receipts, StrEq("2005"), JsonMatch(expected_result), _))
+        .WillOnce(Return(OVS_FAILED_STATUS));
+
+    EXPECT_EQ(OVS_FAILED_STATUS, ovsdb_parse_msg(example_receipt.c_str(), example_receipt.length(), &m_target));
+
+    json_decref(expected_result);
+    receipt_list_destroy(m_target.receipts);
+}
+
+namespace {
+    OvsDb_Insert_Batch_Receipt g_batchReceipt;
+    std::vector<std::string> g_batchUuids;
+
+    void insert_batch_receipt_cb(const char * rid, const OvsDb_Base_Receipt * receipt)
+    {
+        size_t i;
+
+        memcpy(&g_batchReceipt, receipt, sizeof(g_batchReceipt));
+        g_batchUuids.clear();
+        for (i = 0; i < g_batchReceipt.count; i++)
+        {
+            g_batchUuids.push_back(g_batchReceipt.uuids[i]);
+        }
+        g_receiptCount++;
+    }
+}
+
+TEST_F(JsonParserTestFixture, insert_batch_receipt_decoded_from_stream_test)
+{
+    const std::string example_receipt = "{\"id\":\"2006\",\"result\":[{\"uuid\":[\"uuid\",\"f8ecdbd4-0c07-42a9-91ff-819bbf2f4196\"]},{\"uuid\":[\"uuid\",\"0f4bd4c4-9a67-4a4c-8a3c-8f5c2a0e1d11\"]}],\"error\":null}";
+    const std::string refused_receipt = "{\"id\":\"2007\",\"result\":[{\"uuid\":[\"uuid\",\"f8ecdbd4-0c07-42a9-91ff-819bbf2f4196\"]},{\"error\":\"constraint violation\"}],\"error\":null}";
+
+    m_target.receipts = receipt_list_create();
+    ASSERT_TRUE(m_target.receipts != NULL);
+    ASSERT_EQ(OVS_SUCCESS_STATUS, receipt_list_add(m_target.receipts, "2006",
+        OVSDB_INSERT_BATCH_RECEIPT_ID, insert_batch_receipt_cb, 0));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, receipt_list_add(m_target.receipts, "2007",
+        OVSDB_INSERT_BATCH_RECEIPT_ID, insert_batch_receipt_cb, 0));
+    g_receiptCount = 0;
+
+    // a refused row is left to the receipt parser
+    EXPECT_CALL(*g_jsonParserMock, receipt_list_process(m_target.receipts, StrEq("2007"), _, _))
+        .WillOnce(Return(OVS_SUCCESS_STATUS));
+
+    EXPECT_EQ(OVS_SUCCESS_STATUS, ovsdb_parse_msg(example_receipt.c_str(), example_receipt.length(), &m_target));
+    EXPECT_EQ(1, g_receiptCount);
+    EXPECT_EQ(OVSDB_INSERT_BATCH_RECEIPT_ID, g_batchReceipt.receipt_id);
+    EXPECT_EQ(OVS_SUCCESS_STATUS, g_batchReceipt.status);
+    EXPECT_EQ(-1, g_batchReceipt.failed_row);
+    ASSERT_EQ(2u, g_batchUuids.size());
+    EXPECT_EQ("f8ecdbd4-0c07-42a9-91ff-819bbf2f4196", g_batchUuids[0]);
+    EXPECT_EQ("0f4bd4c4-9a67-4a4c-8a3c-8f5c2a0e1d11", g_batchUuids[1]);
+
+    EXPECT_EQ(OVS_SUCCESS_STATUS, ovsdb_parse_msg(refused_receipt.c_str(), refused_receipt.length(), &m_target));
+    EXPECT_EQ(1, g_receiptCount);
+
+    receipt_list_destroy(m_target.receipts);
+}
+
+TEST_F(JsonParserTestFixture, monitor_update_rows_decoded_from_stream_test)
+{
+    // members in any order, escapes, empty sets and a deleted row in between
+    const std::string example_update = "{\"method\":\"update\",\"params\":[\"2002\",{\"Gateway_Config\":{"
+        "\"8a5caead-d266-422c-a184-1848a7fbff7d\":{\"new\":{\"vlan_id\":[\"set\",[]],\"if_name\":\"br\\u0030\",\"if_type\":1,\"mtu\":1400,\"inet_addr\":\"10.0.0.1\"}},"
+        "\"3c55d061-0942-4470-a99e-d37b0f243e4c\":{\"old\":{\"if_name\":\"pgd0\"}},"
+        "\"e4bb63ed-988a-4951-848f-d8374f4972fd\":{\"old\":{\"mtu\":1500},\"new\":{\"if_name\":\"pgd1\",\"mtu\":[\"set\",[]],\"if_cmd\":2}}}}],\"id\":null}";
+    const char * expected_uuid = "2002";
+    Gateway_Config gc1 = {"br0", "10.0.0.1", "", "", "", "", "", 1400, 0, OVS_BRIDGE_IF_TYPE, OVS_IF_UP_CMD};
+    Gateway_Config gc2 = {"pgd1", "", "", "", "", "", "", 0, 0, OVS_OTHER_IF_TYPE, OVS_IF_DELETE_CMD};
+    Rdkb_Table_Config expected1 = {{OVS_GW_CONFIG_TABLE}, &gc1};
+    Rdkb_Table_Config expected2 = {{OVS_GW_CONFIG_TABLE}, &gc2};
+
+    ::testing::InSequence seq;
+    EXPECT_CALL(*g_jsonParserMock, mon_list_process(_, StrEq(expected_uuid), RdkbTableMatch(&expected1)))
+        .WillOnce(Return(OVS_SUCCESS_STATUS));
+    EXPECT_CALL(*g_jsonParserMock, mon_list_process(_, StrEq(expected_uuid), RdkbTableMatch(&expected2)))
+        .WillOnce(Return(OVS_SUCCESS_STATUS));
+
+    EXPECT_EQ(OVS_SUCCESS_STATUS, ovsdb_parse_msg(example_update.c_str(), example_update.length(), &m_target));
+}
+
+TEST_F(JsonParserTestFixture, malformed_update_is_rejected_test)
+{
+    const std::string example_update = "{\"id\":null,\"method\":\"update\",\"params\":[\"2\",{\"Feedback\":{\"e4bb63ed\":{\"new\":{\"status\":0,}}}}]}";
+
+    EXPECT_CALL(*g_jsonParserMock, mon_list_process(_, _, _)).Times(0);
+
+    EXPECT_EQ(OVS_FAILED_STATUS, ovsdb_parse_msg(example_update.c_str(), example_update.length(), &m_target));
+}
+
+TEST_F(JsonParserTestFixture, monitor_update2_rows_decoded_from_stream_test)
+{
+    // deletes and modify deltas are not full rows and are not delivered
+    const std::string example_update = "{\"id\":null,\"method\":\"update2\",\"params\":[\"2006\",{\"Feedback\":{"
+        "\"e4bb63ed-988a-4951-848f-d8374f4972fd\":{\"initial\":{\"req_uuid\":\"18ca5061-c9ef-42dc-9579-f9e3167a1ae7\",\"status\":0}},"
+        "\"3c55d061-0942-4470-a99e-d37b0f243e4c\":{\"delete\":null},"
+        "\"8a5caead-d266-422c-a184-1848a7fbff7d\":{\"modify\":{\"status\":1}},"
+        "\"570e2da2-2adb-4dd7-bc2d-944d065c53c0\":{\"insert\":{\"req_uuid\":\"f7d3d0e6-4ce7-4164-9134-0b5af9ce1b86\",\"status\":2}}}}]}";
+    Feedback fb1 = {OVS_SUCCESS_STATUS, "18ca5061-c9ef-42dc-9579-f9e3167a1ae7"};
+    Feedback fb2 = {OVS_FAILED_STATUS, "f7d3d0e6-4ce7-4164-9134-0b5af9ce1b86"};
+    Rdkb_Table_Config expected1 = {{OVS_FEEDBACK_TABLE}, &fb1};
+    Rdkb_Table_Config expected2 = {{OVS_FEEDBACK_TABLE}, &fb2};
+
+    ::testing::InSequence seq;
+    EXPECT_CALL(*g_jsonParserMock, mon_list_process(_, StrEq("2006"), RdkbTableMatch(&expected1)))
+        .WillOnce(Return(OVS_SUCCESS_STATUS));
+    EXPECT_CALL(*g_jsonParserMock, mon_list_process(_, StrEq("2006"), RdkbTableMatch(&expected2)))
+        .WillOnce(Return(OVS_SUCCESS_STATUS));
+
+    EXPECT_EQ(OVS_SUCCESS_STATUS, ovsdb_parse_msg(example_update.c_str(), example_update.length(), &m_target));
+}
+
+TEST_F(JsonParserTestFixture, monitor_update3_records_last_txn_test)
+{
+    const std::string example_update = "{\"id\":null,\"method\":\"update3\",\"params\":[\"2006\","
+        "\"d2f0a9bc-5bd3-4d21-94a1-2d8c1e1f1f0b\",{\"Feedback\":{"
+        "\"570e2da2-2adb-4dd7-bc2d-944d065c53c0\":{\"insert\":{\"req_uuid\":\"f7d3d0e6-4ce7-4164-9134-0b5af9ce1b86\",\"status\":2}}}}]}";
+    Feedback fb = {OVS_FAILED_STATUS, "f7d3d0e6-4ce7-4164-9134-0b5af9ce1b86"};
+    Rdkb_Table_Config expected = {{OVS_FEEDBACK_TABLE}, &fb};
+
+    EXPECT_CALL(*g_jsonParserMock, mon_list_process(_, StrEq("2006"), RdkbTableMatch(&expected)))
+        .WillOnce(::testing::DoAll(
+            // the transaction is recorded only after its rows are delivered
+            ::testing::Invoke([this](mon_list*, const char*, Rdkb_Table_Config*) {
+                EXPECT_EQ("", m_lastTxnId);
+            }),
+            Return(OVS_SUCCESS_STATUS)));
+
+    EXPECT_EQ(OVS_SUCCESS_STATUS, ovsdb_parse_msg(example_update.c_str(), example_update.length(), &m_target));
+    EXPECT_EQ("d2f0a9bc-5bd3-4d21-94a1-2d8c1e1f1f0b", m_lastTxnId);
 }
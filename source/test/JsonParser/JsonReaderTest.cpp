@@ -0,0 +1,142 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+
+#include <string.h>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "OvsDbApi/json_parser/json_reader.h"
+}
+
+namespace {
+    std::vector<json_token_type> Tokens(const std::string& json)
+    {
+        std::vector<json_token_type> types;
+        json_reader reader;
+        json_token token;
+
+        json_reader_init(&reader, json.c_str(), json.size());
+        do
+        {
+            types.push_back(json_reader_next(&reader, &token));
+        } while (token.type != JSON_TOKEN_EOF && token.type != JSON_TOKEN_ERROR);
+        return types;
+    }
+}
+
+TEST(JsonReaderTest, TokenStream)
+{
+    const std::vector<json_token_type> expected = {
+        JSON_TOKEN_OBJECT_START,
+        JSON_TOKEN_KEY, JSON_TOKEN_STRING,
+        JSON_TOKEN_KEY, JSON_TOKEN_ARRAY_START, JSON_TOKEN_NUMBER, JSON_TOKEN_NUMBER,
+            JSON_TOKEN_TRUE, JSON_TOKEN_FALSE, JSON_TOKEN_NULL, JSON_TOKEN_ARRAY_END,
+        JSON_TOKEN_KEY, JSON_TOKEN_OBJECT_START, JSON_TOKEN_OBJECT_END,
+        JSON_TOKEN_KEY, JSON_TOKEN_ARRAY_START, JSON_TOKEN_ARRAY_END,
+        JSON_TOKEN_OBJECT_END,
+        JSON_TOKEN_EOF
+    };
+
+    EXPECT_EQ(expected, Tokens("{ \"a\" : \"x\", \"b\":[1,-2.5e3,true,false,null],\"c\":{},\"d\":[] }"));
+}
+
+TEST(JsonReaderTest, MalformedInputIsRejected)
+{
+    EXPECT_EQ(JSON_TOKEN_ERROR, Tokens("{\"a\":1,}").back());
+    EXPECT_EQ(JSON_TOKEN_ERROR, Tokens("{\"a\" 1}").back());
+    EXPECT_EQ(JSON_TOKEN_ERROR, Tokens("[1 2]").back());
+    EXPECT_EQ(JSON_TOKEN_ERROR, Tokens("[1}").back());
+    EXPECT_EQ(JSON_TOKEN_ERROR, Tokens("{1:2}").back());
+    EXPECT_EQ(JSON_TOKEN_ERROR, Tokens("[01]").back());
+    EXPECT_EQ(JSON_TOKEN_ERROR, Tokens("[tru]").back());
+    EXPECT_EQ(JSON_TOKEN_ERROR, Tokens("[\"abc").back());
+    EXPECT_EQ(JSON_TOKEN_ERROR, Tokens("{\"a\":[1,2]").back());
+    EXPECT_EQ(JSON_TOKEN_ERROR, Tokens(std::string(JSON_READER_MAX_DEPTH + 1, '[')).back());
+}
+
+TEST(JsonReaderTest, SkipValue)
+{
+    const std::string json = "[{\"a\":[1,{\"b\":\"]}\"}]},\"next\"]";
+    json_reader reader;
+    json_token token;
+
+    json_reader_init(&reader, json.c_str(), json.size());
+    ASSERT_EQ(JSON_TOKEN_ARRAY_START, json_reader_next(&reader, &token));
+    ASSERT_EQ(JSON_TOKEN_OBJECT_START, json_reader_next(&reader, &token));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, json_reader_skip(&reader, &token));
+    ASSERT_EQ(JSON_TOKEN_STRING, json_reader_next(&reader, &token));
+    EXPECT_TRUE(json_token_equals(&token, "next"));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, json_reader_skip(&reader, &token));
+    EXPECT_EQ(JSON_TOKEN_ARRAY_END, json_reader_next(&reader, &token));
+    EXPECT_EQ(JSON_TOKEN_EOF, json_reader_next(&reader, &token));
+}
+
+TEST(JsonReaderTest, CopyString)
+{
+    const std::string json = "[\"plain\",\"a\\\"b\\\\c\\/\\n\",\"\\u00e9\\ud83d\\ude00\",\"\\ud83d\"]";
+    json_reader reader;
+    json_token token;
+    char buf[16];
+
+    json_reader_init(&reader, json.c_str(), json.size());
+    ASSERT_EQ(JSON_TOKEN_ARRAY_START, json_reader_next(&reader, &token));
+
+    ASSERT_EQ(JSON_TOKEN_STRING, json_reader_next(&reader, &token));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, json_token_copy(&token, buf, sizeof(buf)));
+    EXPECT_STREQ("plain", buf);
+    EXPECT_EQ(OVS_FAILED_STATUS, json_token_copy(&token, buf, 4));
+    EXPECT_STREQ("pla", buf);
+
+    ASSERT_EQ(JSON_TOKEN_STRING, json_reader_next(&reader, &token));
+    EXPECT_TRUE(token.escaped);
+    EXPECT_FALSE(json_token_equals(&token, "a\"b\\c/\n"));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, json_token_copy(&token, buf, sizeof(buf)));
+    EXPECT_STREQ("a\"b\\c/\n", buf);
+
+    ASSERT_EQ(JSON_TOKEN_STRING, json_reader_next(&reader, &token));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, json_token_copy(&token, buf, sizeof(buf)));
+    EXPECT_STREQ("\xc3\xa9\xf0\x9f\x98\x80", buf);
+
+    // a lone high surrogate is invalid
+    ASSERT_EQ(JSON_TOKEN_STRING, json_reader_next(&reader, &token));
+    EXPECT_EQ(OVS_FAILED_STATUS, json_token_copy(&token, buf, sizeof(buf)));
+}
+
+TEST(JsonReaderTest, Integers)
+{
+    const std::string json = "[42,-7,1.5,99999999999]";
+    json_reader reader;
+    json_token token;
+    int value = 0;
+
+    json_reader_init(&reader, json.c_str(), json.size());
+    ASSERT_EQ(JSON_TOKEN_ARRAY_START, json_reader_next(&reader, &token));
+    ASSERT_EQ(JSON_TOKEN_NUMBER, json_reader_next(&reader, &token));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, json_token_to_int(&token, &value));
+    EXPECT_EQ(42, value);
+    ASSERT_EQ(JSON_TOKEN_NUMBER, json_reader_next(&reader, &token));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, json_token_to_int(&token, &value));
+    EXPECT_EQ(-7, value);
+    ASSERT_EQ(JSON_TOKEN_NUMBER, json_reader_next(&reader, &token));
+    EXPECT_EQ(OVS_FAILED_STATUS, json_token_to_int(&token, &value));
+    ASSERT_EQ(JSON_TOKEN_NUMBER, json_reader_next(&reader, &token));
+    EXPECT_EQ(OVS_FAILED_STATUS, json_token_to_int(&token, &value));
+}
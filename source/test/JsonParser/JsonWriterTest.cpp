@@ -0,0 +1,262 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+#include <string.h>
+#include <string>
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "OvsDbApi/ovsdb_parser.h"
+#include "OvsDbApi/json_parser/json_writer.h"
+}
+
+class JsonWriterTest : public ::testing::Test
+{
+    protected:
+        char buf[JSON_WRITER_STACK_SIZE];
+        json_writer writer;
+
+        virtual void SetUp()
+        {
+            json_writer_init(&writer, buf, sizeof(buf));
+        }
+
+        virtual void TearDown()
+        {
+            json_writer_release(&writer);
+        }
+
+        std::string Text()
+        {
+            return std::string(writer.buf, writer.len);
+        }
+};
+
+// the expected strings are what json_dumps(JSON_COMPACT) produced for the same requests
+TEST_F(JsonWriterTest, GatewayConfigInsert)
+{
+    Gateway_Config gc = {"br\"0\\x", "10.0.0.1", "255.0.0.0", "1.2.3.4", "5.6.7.8", "eth\n0",
+        "brlan\x01", -1500, 2147483647, OVS_VLAN_IF_TYPE, OVS_BR_REMOVE_CMD};
+    Rdkb_Table_Config config = {{OVS_GW_CONFIG_TABLE}, &gc};
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_insert_to_json(&writer, &config, "12345"));
+    EXPECT_EQ("{\"method\":\"transact\",\"id\":\"12345\",\"params\":[\"Open_vSwitch\",{\"op\":\"insert\","
+        "\"table\":\"Gateway_Config\",\"row\":{\"gre_ifname\":\"null\",\"if_name\":\"br\\\"0\\\\x\","
+        "\"if_type\":4,\"if_cmd\":3,\"inet_addr\":\"10.0.0.1\",\"netmask\":\"255.0.0.0\","
+        "\"gre_remote_inet_addr\":\"1.2.3.4\",\"gre_local_inet_addr\":\"5.6.7.8\","
+        "\"parent_ifname\":\"eth\\n0\",\"mtu\":-1500,\"parent_bridge\":\"brlan\\u0001\","
+        "\"vlan_id\":2147483647}}]}", Text());
+    EXPECT_EQ(buf, writer.buf);
+    EXPECT_EQ('\0', writer.buf[writer.len]);
+}
+
+TEST_F(JsonWriterTest, FeedbackInsert)
+{
+    Feedback fb = {OVS_FAILED_STATUS, "18ca5061-c9ef-42dc-9579-f9e3167a1ae7"};
+    Rdkb_Table_Config config = {{OVS_FEEDBACK_TABLE}, &fb};
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_insert_to_json(&writer, &config, "4294967295"));
+    EXPECT_EQ("{\"method\":\"transact\",\"id\":\"4294967295\",\"params\":[\"Open_vSwitch\","
+        "{\"op\":\"insert\",\"table\":\"Feedback\",\"row\":{\"req_uuid\":"
+        "\"18ca5061-c9ef-42dc-9579-f9e3167a1ae7\",\"status\":2}}]}", Text());
+}
+
+TEST_F(JsonWriterTest, BatchInsert)
+{
+    Feedback fbs[] = {{OVS_SUCCESS_STATUS, "18ca5061-c9ef-42dc-9579-f9e3167a1ae7"},
+        {OVS_FAILED_STATUS, "0f4bd4c4-9a67-4a4c-8a3c-8f5c2a0e1d11"}};
+    Rdkb_Table_Config configs[] = {{{OVS_FEEDBACK_TABLE}, &fbs[0]},
+        {{OVS_FEEDBACK_TABLE}, &fbs[1]}};
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_insert_batch_to_json(&writer, configs, 2, "77"));
+    EXPECT_EQ("{\"method\":\"transact\",\"id\":\"77\",\"params\":[\"Open_vSwitch\","
+        "{\"op\":\"insert\",\"table\":\"Feedback\",\"row\":{\"req_uuid\":"
+        "\"18ca5061-c9ef-42dc-9579-f9e3167a1ae7\",\"status\":0}},"
+        "{\"op\":\"insert\",\"table\":\"Feedback\",\"row\":{\"req_uuid\":"
+        "\"0f4bd4c4-9a67-4a4c-8a3c-8f5c2a0e1d11\",\"status\":2}}]}", Text());
+    EXPECT_EQ(OVS_FAILED_STATUS, ovsdb_insert_batch_to_json(&writer, configs, 0, "78"));
+}
+
+TEST_F(JsonWriterTest, MonitorCancelAndEcho)
+{
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_monitor_to_json(&writer, OVS_GW_CONFIG_TABLE, NULL, "7", "8"));
+    EXPECT_EQ("{\"method\":\"monitor\",\"params\":[\"Open_vSwitch\",\"8\",{\"Gateway_Config\":{}}],"
+        "\"id\":\"7\"}", Text());
+
+    json_writer_init(&writer, buf, sizeof(buf));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_monitor_cancel_to_json(&writer, "8", "9"));
+    EXPECT_EQ("{\"method\":\"monitor_cancel\",\"params\":[\"8\"],\"id\":\"9\"}", Text());
+
+    json_writer_init(&writer, buf, sizeof(buf));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_echo_to_json(&writer, "echo"));
+    EXPECT_EQ("{\"method\":\"echo\",\"params\":[],\"id\":\"echo\"}", Text());
+
+    json_writer_init(&writer, buf, sizeof(buf));
+    EXPECT_EQ(OVS_FAILED_STATUS, ovsdb_monitor_to_json(&writer, (OVS_TABLE) 99, NULL, "7", "8"));
+}
+
+TEST_F(JsonWriterTest, GrowsPastCallerBuffer)
+{
+    char small[16];
+    const std::string value(3000, 'v');
+
+    json_writer_init(&writer, small, sizeof(small));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_delete_to_json(&writer, OVS_FEEDBACK_TABLE, "11",
+        "if_\"name", value.c_str()));
+    EXPECT_TRUE(writer.allocated);
+    EXPECT_EQ("{\"method\":\"transact\",\"params\":[\"Open_vSwitch\",{\"op\":\"delete\","
+        "\"table\":\"Feedback\",\"where\":[[\"if_\\\"name\",\"==\",\"" + value + "\"]]}],"
+        "\"id\":\"11\"}", Text());
+}
+
+TEST_F(JsonWriterTest, Strings)
+{
+    json_writer_string(&writer, "a/b\tc\x1f\x7f\xc3\xa9\xf0\x9f\x98\x80");
+    ASSERT_EQ(OVS_SUCCESS_STATUS, json_writer_finish(&writer));
+    EXPECT_EQ("\"a/b\\tc\\u001F\x7f\xc3\xa9\xf0\x9f\x98\x80\"", Text());
+
+    // invalid UTF-8 is refused rather than sent
+    json_writer_init(&writer, buf, sizeof(buf));
+    json_writer_string(&writer, "\xc3");
+    EXPECT_EQ(OVS_FAILED_STATUS, json_writer_finish(&writer));
+    json_writer_init(&writer, buf, sizeof(buf));
+    json_writer_string(&writer, "\xc0\xaf");
+    EXPECT_EQ(OVS_FAILED_STATUS, json_writer_finish(&writer));
+}
+
+TEST_F(JsonWriterTest, MonitorCond)
+{
+    const OvsDb_Condition where[] = {
+        {"req_uuid", OVSDB_COND_EQ, "18ca5061-c9ef-42dc-9579-f9e3167a1ae7", 0},
+        {"status", OVSDB_COND_NE, NULL, 2}
+    };
+    std::string cond;
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_where_to_json(&writer, OVS_FEEDBACK_TABLE, where, 2));
+    cond = Text();
+    EXPECT_EQ("[[\"req_uuid\",\"==\",\"18ca5061-c9ef-42dc-9579-f9e3167a1ae7\"],"
+        "[\"status\",\"!=\",2]]", cond);
+
+    json_writer_init(&writer, buf, sizeof(buf));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_monitor_cond_to_json(&writer, OVS_FEEDBACK_TABLE,
+        NULL, cond.c_str(), "7", "8"));
+    EXPECT_EQ("{\"method\":\"monitor_cond\",\"params\":[\"Open_vSwitch\",\"8\",{\"Feedback\":"
+        "[{\"where\":" + cond + "}]}],\"id\":\"7\"}", Text());
+
+    json_writer_init(&writer, buf, sizeof(buf));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_monitor_cond_change_to_json(&writer, OVS_FEEDBACK_TABLE,
+        "[false]", "8", "9"));
+    EXPECT_EQ("{\"method\":\"monitor_cond_change\",\"params\":[\"8\",\"8\",{\"Feedback\":"
+        "[{\"where\":[false]}]}],\"id\":\"9\"}", Text());
+
+    // no clause matches no row
+    json_writer_init(&writer, buf, sizeof(buf));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_where_to_json(&writer, OVS_FEEDBACK_TABLE, NULL, 0));
+    EXPECT_EQ("[false]", Text());
+}
+
+TEST_F(JsonWriterTest, MonitorCondSince)
+{
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_monitor_cond_since_to_json(&writer, OVS_GW_CONFIG_TABLE,
+        NULL, NULL, "d2f0a9bc-5bd3-4d21-94a1-2d8c1e1f1f0b", "8", "8"));
+    EXPECT_EQ("{\"method\":\"monitor_cond_since\",\"params\":[\"Open_vSwitch\",\"8\",{\"Gateway_Config\":"
+        "[{\"where\":[true]}]},\"d2f0a9bc-5bd3-4d21-94a1-2d8c1e1f1f0b\"],\"id\":\"8\"}", Text());
+
+    json_writer_init(&writer, buf, sizeof(buf));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_monitor_cond_since_to_json(&writer, OVS_FEEDBACK_TABLE,
+        NULL, "[[\"status\",\"==\",0]]", "00000000-0000-0000-0000-000000000000", "9", "8"));
+    EXPECT_EQ("{\"method\":\"monitor_cond_since\",\"params\":[\"Open_vSwitch\",\"8\",{\"Feedback\":"
+        "[{\"where\":[[\"status\",\"==\",0]]}]},\"00000000-0000-0000-0000-000000000000\"],\"id\":\"9\"}",
+        Text());
+}
+
+TEST_F(JsonWriterTest, MonitorTables)
+{
+    // every table is listed, those not asked for match no row
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_monitor_tables_to_json(&writer,
+        1u << OVS_FEEDBACK_TABLE, NULL, "7", "8"));
+    EXPECT_EQ("{\"method\":\"monitor_cond\",\"params\":[\"Open_vSwitch\",\"8\",{"
+        "\"Gateway_Config\":[{\"where\":[false]}],\"Feedback\":[{\"where\":[true]}]}],"
+        "\"id\":\"7\"}", Text());
+
+    json_writer_init(&writer, buf, sizeof(buf));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_monitor_tables_to_json(&writer,
+        (1u << OVS_FEEDBACK_TABLE) | (1u << OVS_GW_CONFIG_TABLE),
+        "8c2f5c0e-3c3e-4e0b-9f43-6f0b6c1b2a10", "8", "8"));
+    EXPECT_EQ("{\"method\":\"monitor_cond_since\",\"params\":[\"Open_vSwitch\",\"8\",{"
+        "\"Gateway_Config\":[{\"where\":[true]}],\"Feedback\":[{\"where\":[true]}]},"
+        "\"8c2f5c0e-3c3e-4e0b-9f43-6f0b6c1b2a10\"],\"id\":\"8\"}", Text());
+}
+
+TEST_F(JsonWriterTest, MonitorSelect)
+{
+    const char * const columns[] = {"req_uuid", "status"};
+    const OvsDb_Monitor_Select inserts = {columns, 2, OVSDB_SELECT_INSERT};
+    const OvsDb_Monitor_Select everything = {NULL, 0, OVSDB_SELECT_ALL};
+    std::string select;
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_select_to_json(&writer, OVS_FEEDBACK_TABLE, &inserts));
+    select = Text();
+    EXPECT_EQ("\"columns\":[\"req_uuid\",\"status\"],\"select\":{\"initial\":false,"
+        "\"insert\":true,\"delete\":false,\"modify\":false}", select);
+
+    json_writer_init(&writer, buf, sizeof(buf));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_monitor_to_json(&writer, OVS_FEEDBACK_TABLE,
+        select.c_str(), "7", "8"));
+    EXPECT_EQ("{\"method\":\"monitor\",\"params\":[\"Open_vSwitch\",\"8\",{\"Feedback\":{"
+        + select + "}}],\"id\":\"7\"}", Text());
+
+    json_writer_init(&writer, buf, sizeof(buf));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_monitor_cond_to_json(&writer, OVS_FEEDBACK_TABLE,
+        select.c_str(), "[false]", "7", "8"));
+    EXPECT_EQ("{\"method\":\"monitor_cond\",\"params\":[\"Open_vSwitch\",\"8\",{\"Feedback\":"
+        "[{" + select + ",\"where\":[false]}]}],\"id\":\"7\"}", Text());
+
+    // asking for everything is the default and leaves the request as it was
+    json_writer_init(&writer, buf, sizeof(buf));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_select_to_json(&writer, OVS_FEEDBACK_TABLE, &everything));
+    EXPECT_EQ("", Text());
+    json_writer_init(&writer, buf, sizeof(buf));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_select_to_json(&writer, OVS_FEEDBACK_TABLE, NULL));
+    EXPECT_EQ("", Text());
+}
+
+TEST_F(JsonWriterTest, MonitorSelectRejectsUnknownColumns)
+{
+    const char * const columns[] = {"req_uuid", "if_name"};
+    const OvsDb_Monitor_Select unknown_column = {columns, 2, 0};
+    const OvsDb_Monitor_Select unknown_update = {NULL, 0, 0x10};
+
+    EXPECT_EQ(OVS_FAILED_STATUS, ovsdb_select_to_json(&writer, OVS_FEEDBACK_TABLE, &unknown_column));
+    json_writer_init(&writer, buf, sizeof(buf));
+    EXPECT_EQ(OVS_FAILED_STATUS, ovsdb_select_to_json(&writer, OVS_FEEDBACK_TABLE, &unknown_update));
+}
+
+TEST_F(JsonWriterTest, MonitorCondRejectsInvalidClauses)
+{
+    const OvsDb_Condition unknown_column = {"uuid", OVSDB_COND_EQ, "x", 0};
+    const OvsDb_Condition wrong_type = {"status", OVSDB_COND_EQ, "0", 0};
+    const OvsDb_Condition string_order = {"req_uuid", OVSDB_COND_LT, "x", 0};
+
+    EXPECT_EQ(OVS_FAILED_STATUS, ovsdb_where_to_json(&writer, OVS_FEEDBACK_TABLE, &unknown_column, 1));
+    json_writer_init(&writer, buf, sizeof(buf));
+    EXPECT_EQ(OVS_FAILED_STATUS, ovsdb_where_to_json(&writer, OVS_FEEDBACK_TABLE, &wrong_type, 1));
+    json_writer_init(&writer, buf, sizeof(buf));
+    EXPECT_EQ(OVS_FAILED_STATUS, ovsdb_where_to_json(&writer, OVS_FEEDBACK_TABLE, &string_order, 1));
+    json_writer_init(&writer, buf, sizeof(buf));
+    EXPECT_EQ(OVS_FAILED_STATUS, ovsdb_where_to_json(&writer, OVS_NOTIFY_TABLE, NULL, 0));
+}
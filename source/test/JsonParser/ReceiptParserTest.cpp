@@ -29,7 +29,7 @@ extern "C" {
 TEST(ReceiptParserTest, insert_receipt_parser_test)
 {
     json_t* example_result = json_loads("[{\"uuid\":[\"uuid\",\"f8ecdbd4-0c07-42a9-91ff-819bbf2f4196\"]}]", 0, NULL);
-    const OvsDb_Base_Receipt* base_receipt =  ovsdb_parse_result(OVSDB_INSERT_RECEIPT_ID, example_result);
+    const OvsDb_Base_Receipt* base_receipt =  ovsdb_parse_result(OVSDB_INSERT_RECEIPT_ID, example_result, NULL);
     ASSERT_EQ(OVSDB_INSERT_RECEIPT_ID, base_receipt->receipt_id);
 
     const OvsDb_Insert_Receipt* insert_receipt = (OvsDb_Insert_Receipt*) base_receipt;
@@ -40,10 +40,115 @@ TEST(ReceiptParserTest, insert_receipt_parser_test)
 TEST(ReceiptParserTest, delete_receipt_parser_test)
 {
     json_t* example_result = json_loads("[{\"count\":1}]", 0, NULL);
-    const OvsDb_Base_Receipt* base_receipt =  ovsdb_parse_result(OVSDB_DELETE_RECEIPT_ID, example_result);
+    const OvsDb_Base_Receipt* base_receipt =  ovsdb_parse_result(OVSDB_DELETE_RECEIPT_ID, example_result, NULL);
     ASSERT_EQ(OVSDB_DELETE_RECEIPT_ID, base_receipt->receipt_id);
 
     const OvsDb_Delete_Receipt* delete_receipt = (OvsDb_Delete_Receipt*) base_receipt;
     ASSERT_STREQ("", delete_receipt->error);
     ASSERT_EQ(1, delete_receipt->count);
 }
+
+TEST(ReceiptParserTest, insert_batch_receipt_parser_test)
+{
+    json_t* example_result = json_loads("[{\"uuid\":[\"uuid\",\"f8ecdbd4-0c07-42a9-91ff-819bbf2f4196\"]},"
+        "{\"uuid\":[\"uuid\",\"18ca5061-c9ef-42dc-9579-f9e3167a1ae7\"]}]", 0, NULL);
+    OvsDb_Base_Receipt* base_receipt = ovsdb_parse_result(OVSDB_INSERT_BATCH_RECEIPT_ID, example_result, NULL);
+    ASSERT_TRUE(base_receipt != NULL);
+    ASSERT_EQ(OVSDB_INSERT_BATCH_RECEIPT_ID, base_receipt->receipt_id);
+
+    const OvsDb_Insert_Batch_Receipt* batch_receipt = (OvsDb_Insert_Batch_Receipt*) base_receipt;
+    EXPECT_EQ(OVS_SUCCESS_STATUS, batch_receipt->status);
+    EXPECT_EQ(-1, batch_receipt->failed_row);
+    ASSERT_EQ(2u, batch_receipt->count);
+    EXPECT_STREQ("f8ecdbd4-0c07-42a9-91ff-819bbf2f4196", batch_receipt->uuids[0]);
+    EXPECT_STREQ("18ca5061-c9ef-42dc-9579-f9e3167a1ae7", batch_receipt->uuids[1]);
+    free(base_receipt);
+    json_decref(example_result);
+}
+
+TEST(ReceiptParserTest, insert_batch_receipt_parser_failed_row_test)
+{
+    // OVSDB stops at the refused row, nothing of the transaction is applied
+    json_t* example_result = json_loads("[{\"uuid\":[\"uuid\",\"f8ecdbd4-0c07-42a9-91ff-819bbf2f4196\"]},"
+        "{\"error\":\"constraint violation\",\"details\":\"duplicate\"},null]", 0, NULL);
+    OvsDb_Base_Receipt* base_receipt = ovsdb_parse_result(OVSDB_INSERT_BATCH_RECEIPT_ID, example_result, NULL);
+    ASSERT_TRUE(base_receipt != NULL);
+
+    const OvsDb_Insert_Batch_Receipt* batch_receipt = (OvsDb_Insert_Batch_Receipt*) base_receipt;
+    EXPECT_EQ(OVS_FAILED_STATUS, batch_receipt->status);
+    EXPECT_EQ(1, batch_receipt->failed_row);
+    EXPECT_EQ(0u, batch_receipt->count);
+    EXPECT_STREQ("constraint violation", batch_receipt->error);
+    free(base_receipt);
+    json_decref(example_result);
+}
+
+TEST(ReceiptParserTest, monitor_cond_since_receipt_parser_error_test)
+{
+    json_t* example_error = json_loads("{\"error\":\"unknown method\",\"details\":\"monitor_cond_since\"}", 0, NULL);
+    OvsDb_Base_Receipt* base_receipt = ovsdb_parse_result(OVSDB_MONITOR_COND_SINCE_RECEIPT_ID,
+        json_null(), example_error);
+    ASSERT_TRUE(base_receipt != NULL);
+    EXPECT_EQ(OVSDB_MONITOR_COND_SINCE_RECEIPT_ID, base_receipt->receipt_id);
+    EXPECT_EQ(OVS_FAILED_STATUS, base_receipt->status);
+    EXPECT_STREQ("unknown method", base_receipt->error);
+    EXPECT_FALSE(((OvsDb_Monitor_Receipt*) base_receipt)->resumed);
+    free(base_receipt);
+    json_decref(example_error);
+}
+
+TEST(ReceiptParserTest, monitor_receipt_parser_error_test)
+{
+    json_t* example_error = json_string("unknown table");
+    OvsDb_Base_Receipt* base_receipt = ovsdb_parse_result(OVSDB_MONITOR_RECEIPT_ID,
+        NULL, example_error);
+    ASSERT_TRUE(base_receipt != NULL);
+    EXPECT_EQ(OVSDB_MONITOR_RECEIPT_ID, base_receipt->receipt_id);
+    EXPECT_EQ(OVS_FAILED_STATUS, base_receipt->status);
+    EXPECT_STREQ("unknown table", base_receipt->error);
+    free(base_receipt);
+    json_decref(example_error);
+
+    json_t* example_result = json_loads("{}", 0, NULL);
+    base_receipt = ovsdb_parse_result(OVSDB_MONITOR_RECEIPT_ID, example_result, json_null());
+    ASSERT_TRUE(base_receipt != NULL);
+    EXPECT_EQ(OVS_SUCCESS_STATUS, base_receipt->status);
+    free(base_receipt);
+    json_decref(example_result);
+}
+
+TEST(ReceiptParserTest, insert_receipt_parser_refused_test)
+{
+    json_t* example_result = json_loads("[{\"error\":\"constraint violation\",\"details\":\"duplicate\"}]", 0, NULL);
+    OvsDb_Base_Receipt* base_receipt = ovsdb_parse_result(OVSDB_INSERT_RECEIPT_ID, example_result, json_null());
+    ASSERT_TRUE(base_receipt != NULL);
+    EXPECT_EQ(OVSDB_INSERT_RECEIPT_ID, base_receipt->receipt_id);
+    EXPECT_EQ(OVS_FAILED_STATUS, base_receipt->status);
+    EXPECT_STREQ("constraint violation", base_receipt->error);
+    EXPECT_STREQ("", ((OvsDb_Insert_Receipt*) base_receipt)->uuid);
+    free(base_receipt);
+    json_decref(example_result);
+
+    // the insert went through but the transaction as a whole did not
+    example_result = json_loads("[{\"uuid\":[\"uuid\",\"f8ecdbd4-0c07-42a9-91ff-819bbf2f4196\"]},"
+        "{\"error\":\"timed out\"}]", 0, NULL);
+    base_receipt = ovsdb_parse_result(OVSDB_INSERT_RECEIPT_ID, example_result, json_null());
+    ASSERT_TRUE(base_receipt != NULL);
+    EXPECT_EQ(OVS_FAILED_STATUS, base_receipt->status);
+    EXPECT_STREQ("timed out", base_receipt->error);
+    free(base_receipt);
+    json_decref(example_result);
+}
+
+TEST(ReceiptParserTest, delete_receipt_parser_error_test)
+{
+    json_t* example_error = json_loads("{\"error\":\"unknown database\",\"details\":\"Open_vSwitch\"}", 0, NULL);
+    OvsDb_Base_Receipt* base_receipt = ovsdb_parse_result(OVSDB_DELETE_RECEIPT_ID, json_null(), example_error);
+    ASSERT_TRUE(base_receipt != NULL);
+    EXPECT_EQ(OVSDB_DELETE_RECEIPT_ID, base_receipt->receipt_id);
+    EXPECT_EQ(OVS_FAILED_STATUS, base_receipt->status);
+    EXPECT_STREQ("unknown database", base_receipt->error);
+    EXPECT_EQ(0, ((OvsDb_Delete_Receipt*) base_receipt)->count);
+    free(base_receipt);
+    json_decref(example_error);
+}
@@ -18,6 +18,8 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
 #include <string>
 #include <gtest/gtest.h>
 
@@ -86,3 +88,76 @@ TEST(TableParserTest, gwconfig_vlan_test)
     EXPECT_STREQ("", gw_config->gre_local_inet_addr);
     EXPECT_STREQ("", gw_config->inet_addr);
 }
+
+TEST(TableParserTest, generated_descriptors)
+{
+    const table_desc* desc = table_desc_get(OVS_GW_CONFIG_TABLE);
+    ASSERT_TRUE(desc != NULL);
+    EXPECT_EQ(desc, table_desc_find("Gateway_Config", 14));
+    EXPECT_EQ(table_desc_get(OVS_FEEDBACK_TABLE), table_desc_find("Feedback", 8));
+    EXPECT_TRUE(table_desc_find("Open_vSwitch", 12) == NULL);
+    EXPECT_TRUE(table_desc_find("Gateway_Config", 7) == NULL);
+    EXPECT_TRUE(table_desc_get(OVS_LOGBOOK_TABLE) == NULL);
+
+    for (size_t t = 0; t < OVSDB_SCHEMA_TABLE_COUNT; t++)
+    {
+        const table_desc* table = &ovsdb_schema_tables[t];
+        EXPECT_EQ(table, table_desc_find(table->name, strlen(table->name)));
+        EXPECT_EQ(table, table_desc_get(table->id));
+
+        for (size_t i = 0; i < table->num_columns; i++)
+        {
+            const table_column* column = &table->columns[i];
+            EXPECT_EQ(table_name_hash(column->name, strlen(column->name)), column->hash);
+            EXPECT_EQ(column, table_column_find(table, column->name, strlen(column->name)));
+        }
+    }
+
+    const table_column* vlan_id = table_column_find(desc, "vlan_id", 7);
+    ASSERT_TRUE(vlan_id != NULL);
+    EXPECT_EQ(offsetof(Gateway_Config, vlan_id), vlan_id->offset);
+    EXPECT_EQ(TABLE_COLUMN_INTEGER, vlan_id->type);
+    EXPECT_TRUE(table_column_find(desc, "vlan", 4) == NULL);
+    EXPECT_TRUE(table_column_find(desc, "gre_ifname", 10) == NULL);
+}
+
+TEST(TableParserTest, modify_delta_test)
+{
+    const table_desc* desc = table_desc_get(OVS_GW_CONFIG_TABLE);
+    // mtu is set, netmask loses its value and inet_addr goes from one to another
+    const std::string modify = "{\"mtu\":1400,\"netmask\":\"255.255.255.0\","
+        "\"inet_addr\":[\"set\",[\"192.168.106.1\",\"192.168.107.1\"]],\"_version\":[\"uuid\","
+        "\"f47e0d9d-e529-46f8-99d3-922fa3fa9584\"]}";
+    ovsdb_row_delta delta;
+    ovsdb_table_row row;
+    json_reader reader;
+    json_token token;
+
+    memset(&row, 0, sizeof(row));
+    strcpy(row.gateway_config.if_name, "brlan0");
+    strcpy(row.gateway_config.inet_addr, "192.168.107.1");
+    strcpy(row.gateway_config.netmask, "255.255.255.0");
+    row.gateway_config.mtu = 1500;
+
+    json_reader_init(&reader, modify.c_str(), modify.length());
+    ASSERT_EQ(JSON_TOKEN_OBJECT_START, json_reader_next(&reader, &token));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, parse_table_delta(desc, &reader, &token, &delta));
+
+    uint32_t mtu = 1u << (table_column_find(desc, "mtu", 3) - desc->columns);
+    uint32_t netmask = 1u << (table_column_find(desc, "netmask", 7) - desc->columns);
+    uint32_t inet_addr = 1u << (table_column_find(desc, "inet_addr", 9) - desc->columns);
+    EXPECT_EQ(mtu | netmask | inet_addr, delta.present);
+    EXPECT_EQ(inet_addr, delta.pairs);
+
+    EXPECT_EQ(mtu | netmask | inet_addr, apply_table_delta(desc, &row, &delta));
+    EXPECT_EQ(1400, row.gateway_config.mtu);
+    EXPECT_STREQ("", row.gateway_config.netmask);
+    EXPECT_STREQ("192.168.106.1", row.gateway_config.inet_addr);
+    EXPECT_STREQ("brlan0", row.gateway_config.if_name);
+
+    // a set can't hold more than the old and the new value
+    const std::string invalid = "{\"inet_addr\":[\"set\",[\"1.1.1.1\",\"2.2.2.2\",\"3.3.3.3\"]]}";
+    json_reader_init(&reader, invalid.c_str(), invalid.length());
+    ASSERT_EQ(JSON_TOKEN_OBJECT_START, json_reader_next(&reader, &token));
+    EXPECT_EQ(OVS_FAILED_STATUS, parse_table_delta(desc, &reader, &token, &delta));
+}
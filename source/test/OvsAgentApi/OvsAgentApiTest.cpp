@@ -19,6 +19,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <time.h>
+#include <pthread.h>
+#include <atomic>
+#include <vector>
+#include <poll.h>
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include "test/mocks/MockOvsDbApi.h"
@@ -31,6 +36,7 @@ extern "C" {
 using ::testing::_;
 using ::testing::Return;
 using ::testing::StrEq;
+using ::testing::SaveArg;
 
 OvsDbApiMock * g_ovsDbApiMock = NULL;  /* This is the actual definition of the mock obj */
 
@@ -100,3 +106,759 @@ TEST_F(OvsAgentApiTestFixture, ovs_agent_api_init_deinit)
     ASSERT_EQ(true, ovs_agent_api_deinit());
 }
 
+
+namespace{
+    int g_completed = 0;
+
+    void CountCompletions(OVS_STATUS status, Rdkb_Table_Config * table_config)
+    {
+        EXPECT_EQ(OVS_SUCCESS_STATUS, status);
+        EXPECT_EQ(OVS_GW_CONFIG_TABLE, table_config->table.id);
+        g_completed++;
+    }
+
+    Rdkb_Table_Config NewGatewayConfig()
+    {
+        Rdkb_Table_Config table_config;
+        table_config.table.id = OVS_GW_CONFIG_TABLE;
+        table_config.config = calloc(1, sizeof(Gateway_Config));
+        return table_config;
+    }
+}
+
+TEST(OvsAgentApiTransactions, thousands_in_flight)
+{
+    const int count = 5000;
+    char rid[16];
+    char uuid[MAX_UUID_LEN + 1];
+    int i;
+
+    g_completed = 0;
+    ASSERT_TRUE(init_transaction_manager());
+    for (i = 0; i < count; i++)
+    {
+        Rdkb_Table_Config table_config = NewGatewayConfig();
+        snprintf(rid, sizeof(rid), "%d", 1000 + i);
+        ASSERT_TRUE(insert_transaction(rid, CountCompletions, &table_config, NULL));
+    }
+    for (i = 0; i < count; i++)
+    {
+        snprintf(rid, sizeof(rid), "%d", 1000 + i);
+        snprintf(uuid, sizeof(uuid), "00000000-0000-0000-0000-%012d", i);
+        ASSERT_TRUE(update_transaction(rid, uuid));
+    }
+    // Feedback rows do not come back in request order
+    for (i = count - 1; i >= 0; i--)
+    {
+        snprintf(uuid, sizeof(uuid), "00000000-0000-0000-0000-%012d", i);
+        ASSERT_TRUE(complete_transaction(uuid, OVS_SUCCESS_STATUS));
+    }
+    EXPECT_EQ(count, g_completed);
+    EXPECT_FALSE(complete_transaction(uuid, OVS_SUCCESS_STATUS));
+    deinit_transaction_manager();
+}
+
+TEST(OvsAgentApiTransactions, duplicate_id_keeps_the_one_in_flight)
+{
+    Rdkb_Table_Config first = NewGatewayConfig();
+    Rdkb_Table_Config second = NewGatewayConfig();
+    char rid[] = "7";
+
+    g_completed = 0;
+    ASSERT_TRUE(init_transaction_manager());
+    ASSERT_TRUE(insert_transaction(rid, CountCompletions, &first, NULL));
+    EXPECT_FALSE(insert_transaction(rid, CountCompletions, &second, NULL));
+    free(second.config);
+
+    ASSERT_TRUE(update_transaction(rid, "f2381729-42ac-40a8-aa38-50d6d7805f2b"));
+    EXPECT_TRUE(complete_transaction((char *)"f2381729-42ac-40a8-aa38-50d6d7805f2b",
+        OVS_SUCCESS_STATUS));
+    EXPECT_EQ(1, g_completed);
+    deinit_transaction_manager();
+}
+
+TEST(OvsAgentApiTransactions, deleted_transaction_is_not_completed)
+{
+    Rdkb_Table_Config table_config = NewGatewayConfig();
+    char rid[] = "8";
+    char uuid[] = "f2381729-42ac-40a8-aa38-50d6d7805f2b";
+
+    g_completed = 0;
+    ASSERT_TRUE(init_transaction_manager());
+    ASSERT_TRUE(insert_transaction(rid, CountCompletions, &table_config, NULL));
+    ASSERT_TRUE(update_transaction(rid, uuid));
+    EXPECT_TRUE(delete_transaction(rid));
+    EXPECT_FALSE(delete_transaction(rid));
+    EXPECT_FALSE(complete_transaction(uuid, OVS_SUCCESS_STATUS));
+    EXPECT_EQ(0, g_completed);
+    deinit_transaction_manager();
+}
+
+namespace{
+    std::atomic<int> g_writes(0);
+
+    void* InteractBlocked(void* result)
+    {
+        ovs_interact_request request = {};
+
+        request.block_mode = OVS_ENABLE_BLOCK_MODE;
+        request.method = OVS_TRANSACT_METHOD;
+        request.operation = OVS_INSERT_OPERATION;
+        request.table_config.table.id = OVS_GW_CONFIG_TABLE;
+        request.table_config.config = calloc(1, sizeof(Gateway_Config));
+        *(bool *)result = ovs_agent_api_interact(&request, NULL);
+        return NULL;
+    }
+
+    void SendFeedback(ovsdb_mon_cb mon_cb, const char * uuid, OVS_STATUS status)
+    {
+        Feedback feedback = {};
+        Rdkb_Table_Config table_config;
+
+        feedback.status = status;
+        snprintf(feedback.req_uuid, sizeof(feedback.req_uuid), "%s", uuid);
+        table_config.table.id = OVS_FEEDBACK_TABLE;
+        table_config.config = &feedback;
+        mon_cb(OVS_SUCCESS_STATUS, &table_config);
+    }
+}
+
+TEST_F(OvsAgentApiTestFixture, ovs_agent_api_blocked_interacts_wake_independently)
+{
+    const char * uuids[] = {"f2381729-42ac-40a8-aa38-50d6d7805f2b",
+        "0f4bd4c4-9a67-4a4c-8a3c-8f5c2a0e1d11"};
+    ovsdb_receipt_cb receipt_cb = NULL;
+    ovsdb_mon_cb mon_cb = NULL;
+    pthread_t threads[2];
+    bool results[2] = {false, false};
+    struct timespec start, end;
+    int i;
+
+    g_writes = 0;
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_init(_))
+        .WillOnce(Return(OVS_SUCCESS_STATUS));
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_deinit())
+        .WillOnce(Return(OVS_SUCCESS_STATUS));
+    EXPECT_CALL(*g_ovsDbApiMock, id_generate())
+        .WillOnce(Return(1001))
+        .WillOnce(Return(1002));
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_write(_, _, _))
+        .Times(2)
+        .WillRepeatedly(::testing::DoAll(SaveArg<2>(&receipt_cb),
+            ::testing::InvokeWithoutArgs([]() { g_writes++; }),
+            Return(OVS_SUCCESS_STATUS)));
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_monitor_select(OVS_FEEDBACK_TABLE, _, _, _))
+        .WillOnce(::testing::DoAll(SaveArg<2>(&mon_cb), Return(OVS_SUCCESS_STATUS)));
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_delete(_, _, _))
+        .WillRepeatedly(Return(OVS_SUCCESS_STATUS));
+
+    ASSERT_TRUE(ovs_agent_api_init(OVS_TEST_APP_COMPONENT_ID));
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < 2; i++)
+    {
+        ASSERT_EQ(0, pthread_create(&threads[i], NULL, InteractBlocked, &results[i]));
+    }
+    for (i = 0; i < 100 && g_writes < 2; i++)
+    {
+        usleep(10000);
+    }
+    ASSERT_EQ(2, g_writes);
+
+    // OVSDB answers both writes, then the agent reports them in reverse order
+    for (i = 0; i < 2; i++)
+    {
+        OvsDb_Insert_Receipt receipt = {};
+        char rid[16];
+
+        receipt.receipt_id = OVSDB_INSERT_RECEIPT_ID;
+        receipt.status = OVS_SUCCESS_STATUS;
+        snprintf(receipt.uuid, sizeof(receipt.uuid), "%s", uuids[i]);
+        snprintf(rid, sizeof(rid), "%d", 1001 + i);
+        receipt_cb(rid, (OvsDb_Base_Receipt *)&receipt);
+    }
+    ASSERT_TRUE(mon_cb != NULL);
+    SendFeedback(mon_cb, uuids[1], OVS_FAILED_STATUS);
+    SendFeedback(mon_cb, uuids[0], OVS_SUCCESS_STATUS);
+
+    for (i = 0; i < 2; i++)
+    {
+        EXPECT_EQ(0, pthread_join(threads[i], NULL));
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    // each woke on its own Feedback, neither waited for the timeout
+    EXPECT_LT(end.tv_sec - start.tv_sec, 3);
+    EXPECT_NE(results[0], results[1]);
+
+    ASSERT_TRUE(ovs_agent_api_deinit());
+}
+
+namespace{
+    std::atomic<int> g_finished(0);
+    std::atomic<int> g_finished_status(OVS_UNKNOWN_STATUS);
+
+    void RecordFinish(OVS_STATUS status, Rdkb_Table_Config * table_config)
+    {
+        g_finished_status = status;
+        g_finished++;
+    }
+
+    bool WaitFinished(int count)
+    {
+        int i;
+        for (i = 0; i < 200 && g_finished < count; i++)
+        {
+            usleep(10000);
+        }
+        return g_finished == count;
+    }
+}
+
+TEST(OvsAgentApiTransactions, failed_transaction_ends_once)
+{
+    Rdkb_Table_Config table_config = NewGatewayConfig();
+    char rid[] = "9";
+    char uuid[] = "f2381729-42ac-40a8-aa38-50d6d7805f2b";
+
+    g_finished = 0;
+    ASSERT_TRUE(init_transaction_manager());
+    ASSERT_TRUE(insert_transaction(rid, RecordFinish, &table_config, NULL));
+    ASSERT_TRUE(update_transaction(rid, uuid));
+    EXPECT_TRUE(fail_transaction(rid, OVS_FAILED_STATUS));
+    EXPECT_FALSE(fail_transaction(rid, OVS_FAILED_STATUS));
+    EXPECT_FALSE(complete_transaction(uuid, OVS_SUCCESS_STATUS));
+    EXPECT_EQ(1, g_finished);
+    EXPECT_EQ(OVS_FAILED_STATUS, g_finished_status);
+    deinit_transaction_manager();
+}
+
+TEST(OvsAgentApiTransactions, transaction_without_feedback_times_out)
+{
+    char rid[16];
+    int i;
+
+    g_finished = 0;
+    ASSERT_TRUE(init_transaction_manager());
+    set_transaction_timeout(50);
+    for (i = 0; i < 3; i++)
+    {
+        Rdkb_Table_Config table_config = NewGatewayConfig();
+        snprintf(rid, sizeof(rid), "%d", 20 + i);
+        ASSERT_TRUE(insert_transaction(rid, RecordFinish, &table_config, NULL));
+    }
+    ASSERT_TRUE(WaitFinished(3));
+    EXPECT_EQ(OVS_TIMED_OUT_STATUS, g_finished_status);
+    EXPECT_FALSE(delete_transaction(rid));
+    EXPECT_FALSE(fail_transaction(rid, OVS_FAILED_STATUS));
+    deinit_transaction_manager();
+    EXPECT_EQ(3, g_finished);
+}
+
+TEST(OvsAgentApiTransactions, deinit_fails_those_in_flight)
+{
+    Rdkb_Table_Config table_config = NewGatewayConfig();
+    char rid[] = "10";
+
+    g_finished = 0;
+    ASSERT_TRUE(init_transaction_manager());
+    ASSERT_TRUE(insert_transaction(rid, RecordFinish, &table_config, NULL));
+    deinit_transaction_manager();
+    EXPECT_EQ(1, g_finished);
+    EXPECT_EQ(OVS_FAILED_STATUS, g_finished_status);
+}
+
+TEST_F(OvsAgentApiTestFixture, ovs_agent_api_unblocked_interact_reports_write_timeout)
+{
+    ovs_interact_request request = {};
+    ovsdb_receipt_cb receipt_cb = NULL;
+    OvsDb_Insert_Receipt receipt = {};
+
+    g_finished = 0;
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_init(_))
+        .WillOnce(Return(OVS_SUCCESS_STATUS));
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_deinit())
+        .WillOnce(Return(OVS_SUCCESS_STATUS));
+    EXPECT_CALL(*g_ovsDbApiMock, id_generate())
+        .WillOnce(Return(1003));
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_write(StrEq("1003"), _, _))
+        .WillOnce(::testing::DoAll(SaveArg<2>(&receipt_cb), Return(OVS_SUCCESS_STATUS)));
+
+    ASSERT_TRUE(ovs_agent_api_init(OVS_TEST_APP_COMPONENT_ID));
+    request.block_mode = OVS_DISABLE_BLOCK_MODE;
+    request.method = OVS_TRANSACT_METHOD;
+    request.operation = OVS_INSERT_OPERATION;
+    request.table_config = NewGatewayConfig();
+    ASSERT_TRUE(ovs_agent_api_interact(&request, RecordFinish));
+    EXPECT_EQ(0, g_finished);
+
+    // OVSDB never answered the write
+    receipt.receipt_id = OVSDB_INSERT_RECEIPT_ID;
+    receipt.status = OVS_TIMED_OUT_STATUS;
+    ASSERT_TRUE(receipt_cb != NULL);
+    receipt_cb("1003", (OvsDb_Base_Receipt *)&receipt);
+    receipt_cb("1003", (OvsDb_Base_Receipt *)&receipt);
+    EXPECT_EQ(1, g_finished);
+    EXPECT_EQ(OVS_TIMED_OUT_STATUS, g_finished_status);
+
+    ASSERT_TRUE(ovs_agent_api_deinit());
+    EXPECT_EQ(1, g_finished);
+}
+
+TEST_F(OvsAgentApiTestFixture, ovs_agent_api_unblocked_interact_reports_refused_write)
+{
+    ovs_interact_request request = {};
+    ovsdb_receipt_cb receipt_cb = NULL;
+    OvsDb_Insert_Receipt receipt = {};
+    struct timespec start;
+    struct timespec end;
+
+    g_finished = 0;
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_init(_))
+        .WillOnce(Return(OVS_SUCCESS_STATUS));
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_deinit())
+        .WillOnce(Return(OVS_SUCCESS_STATUS));
+    EXPECT_CALL(*g_ovsDbApiMock, id_generate())
+        .WillOnce(Return(1004));
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_write(StrEq("1004"), _, _))
+        .WillOnce(::testing::DoAll(SaveArg<2>(&receipt_cb), Return(OVS_SUCCESS_STATUS)));
+
+    ASSERT_TRUE(ovs_agent_api_init(OVS_TEST_APP_COMPONENT_ID));
+    request.block_mode = OVS_DISABLE_BLOCK_MODE;
+    request.method = OVS_TRANSACT_METHOD;
+    request.operation = OVS_INSERT_OPERATION;
+    request.table_config = NewGatewayConfig();
+    ASSERT_TRUE(ovs_agent_api_interact(&request, RecordFinish));
+    EXPECT_EQ(0, g_finished);
+
+    // OVSDB answered [{"error":"constraint violation"}], the receipt the parser makes of it
+    receipt.receipt_id = OVSDB_INSERT_RECEIPT_ID;
+    receipt.status = OVS_FAILED_STATUS;
+    snprintf(receipt.error, sizeof(receipt.error), "constraint violation");
+    ASSERT_TRUE(receipt_cb != NULL);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    receipt_cb("1004", (OvsDb_Base_Receipt *)&receipt);
+    ASSERT_TRUE(WaitFinished(1));
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    EXPECT_EQ(OVS_FAILED_STATUS, g_finished_status);
+    // well before the transaction would have expired
+    EXPECT_LT(end.tv_sec - start.tv_sec, 2);
+
+    ASSERT_TRUE(ovs_agent_api_deinit());
+    EXPECT_EQ(1, g_finished);
+}
+
+namespace{
+    bool FdReadable(int fd)
+    {
+        struct pollfd pfd = {fd, POLLIN, 0};
+        return poll(&pfd, 1, 0) == 1 && (pfd.revents & POLLIN);
+    }
+
+    void PushCompletions(completion_queue * queue, uint64_t first, int count)
+    {
+        ovs_agent_api_completion completion = {};
+        int i;
+
+        for (i = 0; i < count; i++)
+        {
+            completion.user_data = first + i;
+            completion.status = OVS_SUCCESS_STATUS;
+            completion.table_config.table.id = OVS_GW_CONFIG_TABLE;
+            completion.table_config.config = NULL;
+            ASSERT_TRUE(completion_queue_push(queue, &completion));
+        }
+    }
+}
+
+TEST(OvsAgentApiCompletions, reaped_in_order_across_growth)
+{
+    completion_queue * queue = completion_queue_create();
+    ovs_agent_api_completion completions[32];
+    uint64_t next = 0;
+    size_t reaped = 0;
+    size_t i;
+
+    ASSERT_TRUE(queue != NULL);
+    EXPECT_FALSE(FdReadable(completion_queue_fd(queue)));
+    EXPECT_EQ(0u, completion_queue_reap(queue, completions, 32));
+
+    // wrap the ring around before it has to grow
+    PushCompletions(queue, 0, COMPLETION_QUEUE_MIN_SIZE - 8);
+    ASSERT_TRUE(FdReadable(completion_queue_fd(queue)));
+    ASSERT_EQ(32u, completion_queue_reap(queue, completions, 32));
+    for (i = 0; i < 32; i++)
+    {
+        EXPECT_EQ(next++, completions[i].user_data);
+    }
+    PushCompletions(queue, COMPLETION_QUEUE_MIN_SIZE - 8, 3 * COMPLETION_QUEUE_MIN_SIZE);
+
+    while ((reaped = completion_queue_reap(queue, completions, 32)) > 0)
+    {
+        for (i = 0; i < reaped; i++)
+        {
+            EXPECT_EQ(next++, completions[i].user_data);
+        }
+        // readable for as long as some are left
+        EXPECT_EQ(next < 4u * COMPLETION_QUEUE_MIN_SIZE - 8,
+            FdReadable(completion_queue_fd(queue)));
+    }
+    EXPECT_EQ(4u * COMPLETION_QUEUE_MIN_SIZE - 8, next);
+    EXPECT_FALSE(FdReadable(completion_queue_fd(queue)));
+    completion_queue_destroy(queue);
+}
+
+TEST_F(OvsAgentApiTestFixture, ovs_agent_api_queued_interacts_complete_through_fd)
+{
+    const char * uuids[] = {"f2381729-42ac-40a8-aa38-50d6d7805f2b",
+        "0f4bd4c4-9a67-4a4c-8a3c-8f5c2a0e1d11"};
+    ovsdb_receipt_cb receipt_cb = NULL;
+    ovsdb_mon_cb mon_cb = NULL;
+    ovs_agent_api_completion completions[4];
+    ovs_interact_request request = {};
+    int fd = -1;
+    int i;
+
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_init(_))
+        .WillOnce(Return(OVS_SUCCESS_STATUS));
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_deinit())
+        .WillOnce(Return(OVS_SUCCESS_STATUS));
+    EXPECT_CALL(*g_ovsDbApiMock, id_generate())
+        .WillOnce(Return(1004))
+        .WillOnce(Return(1005));
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_write(_, _, _))
+        .Times(2)
+        .WillRepeatedly(::testing::DoAll(SaveArg<2>(&receipt_cb), Return(OVS_SUCCESS_STATUS)));
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_monitor_select(OVS_FEEDBACK_TABLE, _, _, _))
+        .WillOnce(::testing::DoAll(SaveArg<2>(&mon_cb), Return(OVS_SUCCESS_STATUS)));
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_delete(_, _, _))
+        .WillRepeatedly(Return(OVS_SUCCESS_STATUS));
+
+    EXPECT_EQ(-1, ovs_agent_api_get_completion_fd());
+    ASSERT_TRUE(ovs_agent_api_init(OVS_TEST_APP_COMPONENT_ID));
+    fd = ovs_agent_api_get_completion_fd();
+    ASSERT_GE(fd, 0);
+
+    request.method = OVS_TRANSACT_METHOD;
+    request.operation = OVS_INSERT_OPERATION;
+    request.block_mode = OVS_ENABLE_BLOCK_MODE;
+    EXPECT_FALSE(ovs_agent_api_interact_queued(&request, 1));
+    request.block_mode = OVS_DISABLE_BLOCK_MODE;
+    for (i = 0; i < 2; i++)
+    {
+        request.table_config = NewGatewayConfig();
+        ASSERT_TRUE(ovs_agent_api_interact_queued(&request, 500 + i));
+    }
+
+    for (i = 0; i < 2; i++)
+    {
+        OvsDb_Insert_Receipt receipt = {};
+        char rid[16];
+
+        receipt.receipt_id = OVSDB_INSERT_RECEIPT_ID;
+        receipt.status = OVS_SUCCESS_STATUS;
+        snprintf(receipt.uuid, sizeof(receipt.uuid), "%s", uuids[i]);
+        snprintf(rid, sizeof(rid), "%d", 1004 + i);
+        receipt_cb(rid, (OvsDb_Base_Receipt *)&receipt);
+    }
+    EXPECT_FALSE(FdReadable(fd));
+    ASSERT_TRUE(mon_cb != NULL);
+    SendFeedback(mon_cb, uuids[1], OVS_FAILED_STATUS);
+    SendFeedback(mon_cb, uuids[0], OVS_SUCCESS_STATUS);
+
+    ASSERT_TRUE(FdReadable(fd));
+    ASSERT_EQ(2u, ovs_agent_api_reap_completions(completions, 4));
+    EXPECT_FALSE(FdReadable(fd));
+    EXPECT_EQ(501u, completions[0].user_data);
+    EXPECT_EQ(OVS_FAILED_STATUS, completions[0].status);
+    EXPECT_EQ(500u, completions[1].user_data);
+    EXPECT_EQ(OVS_SUCCESS_STATUS, completions[1].status);
+    for (i = 0; i < 2; i++)
+    {
+        EXPECT_EQ(OVS_GW_CONFIG_TABLE, completions[i].table_config.table.id);
+        EXPECT_TRUE(completions[i].table_config.config != NULL);
+        free(completions[i].table_config.config);
+    }
+
+    ASSERT_TRUE(ovs_agent_api_deinit());
+}
+
+namespace{
+    std::atomic<int> g_batches(0);
+    OVS_STATUS g_batch_status = OVS_UNKNOWN_STATUS;
+    std::vector<OVS_STATUS> g_row_status;
+
+    void RecordBatch(OVS_STATUS status, const OVS_STATUS * row_status,
+        Rdkb_Table_Config * table_configs, size_t count)
+    {
+        size_t i;
+
+        g_batch_status = status;
+        g_row_status.assign(row_status, row_status + count);
+        for (i = 0; i < count; i++)
+        {
+            EXPECT_EQ(OVS_GW_CONFIG_TABLE, table_configs[i].table.id);
+            EXPECT_TRUE(table_configs[i].config != NULL);
+        }
+        g_batches++;
+    }
+
+    const char g_row_uuids[3][MAX_UUID_LEN + 1] = {
+        "f2381729-42ac-40a8-aa38-50d6d7805f2b",
+        "0f4bd4c4-9a67-4a4c-8a3c-8f5c2a0e1d11",
+        "18ca5061-c9ef-42dc-9579-f9e3167a1ae7"};
+}
+
+TEST(OvsAgentApiTransactions, batch_completes_with_its_last_row)
+{
+    Rdkb_Table_Config table_configs[3];
+    char rid[] = "30";
+    int i;
+
+    g_batches = 0;
+    ASSERT_TRUE(init_transaction_manager());
+    for (i = 0; i < 3; i++)
+    {
+        table_configs[i] = NewGatewayConfig();
+    }
+    ASSERT_TRUE(insert_batch_transaction(rid, RecordBatch, table_configs, 3, NULL));
+    EXPECT_FALSE(update_batch_transaction(rid, g_row_uuids, 2));
+    ASSERT_TRUE(update_batch_transaction(rid, g_row_uuids, 3));
+    EXPECT_FALSE(update_batch_transaction(rid, g_row_uuids, 3));
+
+    // Feedback rows do not come back in request order
+    EXPECT_TRUE(complete_transaction((char *)g_row_uuids[2], OVS_SUCCESS_STATUS));
+    EXPECT_TRUE(complete_transaction((char *)g_row_uuids[0], OVS_FAILED_STATUS));
+    EXPECT_FALSE(complete_transaction((char *)g_row_uuids[0], OVS_SUCCESS_STATUS));
+    EXPECT_EQ(0, g_batches);
+    EXPECT_TRUE(complete_transaction((char *)g_row_uuids[1], OVS_SUCCESS_STATUS));
+
+    EXPECT_EQ(1, g_batches);
+    EXPECT_EQ(OVS_FAILED_STATUS, g_batch_status);
+    EXPECT_EQ(std::vector<OVS_STATUS>({OVS_FAILED_STATUS, OVS_SUCCESS_STATUS,
+        OVS_SUCCESS_STATUS}), g_row_status);
+    EXPECT_FALSE(fail_transaction(rid, OVS_FAILED_STATUS));
+    deinit_transaction_manager();
+}
+
+TEST(OvsAgentApiTransactions, batch_rows_without_feedback_time_out)
+{
+    Rdkb_Table_Config table_configs[3];
+    char rid[] = "31";
+    int i;
+
+    g_batches = 0;
+    ASSERT_TRUE(init_transaction_manager());
+    set_transaction_timeout(50);
+    for (i = 0; i < 3; i++)
+    {
+        table_configs[i] = NewGatewayConfig();
+    }
+    ASSERT_TRUE(insert_batch_transaction(rid, RecordBatch, table_configs, 3, NULL));
+    ASSERT_TRUE(update_batch_transaction(rid, g_row_uuids, 3));
+    EXPECT_TRUE(complete_transaction((char *)g_row_uuids[1], OVS_SUCCESS_STATUS));
+
+    for (i = 0; i < 200 && g_batches == 0; i++)
+    {
+        usleep(10000);
+    }
+    ASSERT_EQ(1, g_batches);
+    EXPECT_EQ(OVS_TIMED_OUT_STATUS, g_batch_status);
+    EXPECT_EQ(std::vector<OVS_STATUS>({OVS_TIMED_OUT_STATUS, OVS_SUCCESS_STATUS,
+        OVS_TIMED_OUT_STATUS}), g_row_status);
+    // the rows left the uuid index along with the batch
+    EXPECT_FALSE(complete_transaction((char *)g_row_uuids[0], OVS_SUCCESS_STATUS));
+    deinit_transaction_manager();
+}
+
+TEST_F(OvsAgentApiTestFixture, ovs_agent_api_batch_writes_rows_in_one_transact)
+{
+    ovsdb_receipt_cb receipt_cb = NULL;
+    ovsdb_mon_cb mon_cb = NULL;
+    ovs_interact_request requests[3] = {};
+    char uuids[3][MAX_UUID_LEN + 1];
+    OvsDb_Insert_Batch_Receipt receipt = {};
+    int i;
+
+    g_batches = 0;
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_init(_))
+        .WillOnce(Return(OVS_SUCCESS_STATUS));
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_deinit())
+        .WillOnce(Return(OVS_SUCCESS_STATUS));
+    EXPECT_CALL(*g_ovsDbApiMock, id_generate())
+        .WillOnce(Return(1006));
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_write(_, _, _))
+        .Times(0);
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_write_batch(StrEq("1006"), _, 3, _))
+        .WillOnce(::testing::DoAll(SaveArg<3>(&receipt_cb), Return(OVS_SUCCESS_STATUS)));
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_monitor_select(OVS_FEEDBACK_TABLE, _, _, _))
+        .WillOnce(::testing::DoAll(SaveArg<2>(&mon_cb), Return(OVS_SUCCESS_STATUS)));
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_delete(_, _, _))
+        .WillRepeatedly(Return(OVS_SUCCESS_STATUS));
+
+    ASSERT_TRUE(ovs_agent_api_init(OVS_TEST_APP_COMPONENT_ID));
+    for (i = 0; i < 3; i++)
+    {
+        requests[i].block_mode = OVS_DISABLE_BLOCK_MODE;
+        requests[i].method = OVS_TRANSACT_METHOD;
+        requests[i].operation = OVS_INSERT_OPERATION;
+        requests[i].table_config = NewGatewayConfig();
+    }
+    requests[1].block_mode = OVS_ENABLE_BLOCK_MODE;
+    EXPECT_FALSE(ovs_agent_api_interact_batch(requests, 3, RecordBatch));
+    requests[1].block_mode = OVS_DISABLE_BLOCK_MODE;
+    ASSERT_TRUE(ovs_agent_api_interact_batch(requests, 3, RecordBatch));
+
+    memcpy(uuids, g_row_uuids, sizeof(uuids));
+    receipt.receipt_id = OVSDB_INSERT_BATCH_RECEIPT_ID;
+    receipt.status = OVS_SUCCESS_STATUS;
+    receipt.failed_row = -1;
+    receipt.count = 3;
+    receipt.uuids = uuids;
+    ASSERT_TRUE(receipt_cb != NULL);
+    receipt_cb("1006", (OvsDb_Base_Receipt *)&receipt);
+
+    ASSERT_TRUE(mon_cb != NULL);
+    for (i = 2; i >= 0; i--)
+    {
+        EXPECT_EQ(0, g_batches);
+        SendFeedback(mon_cb, g_row_uuids[i], OVS_SUCCESS_STATUS);
+    }
+    EXPECT_EQ(1, g_batches);
+    EXPECT_EQ(OVS_SUCCESS_STATUS, g_batch_status);
+    EXPECT_EQ(std::vector<OVS_STATUS>(3, OVS_SUCCESS_STATUS), g_row_status);
+
+    ASSERT_TRUE(ovs_agent_api_deinit());
+}
+
+namespace{
+    // OVSDB refuses the second row, so none is inserted
+    OVS_STATUS RefuseBatch(const char * rid, Rdkb_Table_Config * table_configs, size_t count,
+        ovsdb_receipt_cb receipt_cb)
+    {
+        OvsDb_Insert_Batch_Receipt receipt = {};
+
+        receipt.receipt_id = OVSDB_INSERT_BATCH_RECEIPT_ID;
+        receipt.status = OVS_FAILED_STATUS;
+        receipt.failed_row = 1;
+        snprintf(receipt.error, sizeof(receipt.error), "constraint violation");
+        receipt_cb(rid, (OvsDb_Base_Receipt *)&receipt);
+        return OVS_SUCCESS_STATUS;
+    }
+}
+
+TEST_F(OvsAgentApiTestFixture, ovs_agent_api_blocked_batch_returns_refused_write)
+{
+    ovs_interact_request requests[2] = {};
+    struct timespec start, end;
+    int i;
+
+    g_batches = 0;
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_init(_))
+        .WillOnce(Return(OVS_SUCCESS_STATUS));
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_deinit())
+        .WillOnce(Return(OVS_SUCCESS_STATUS));
+    EXPECT_CALL(*g_ovsDbApiMock, id_generate())
+        .WillOnce(Return(1007));
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_write_batch(StrEq("1007"), _, 2, _))
+        .WillOnce(::testing::Invoke(RefuseBatch));
+
+    ASSERT_TRUE(ovs_agent_api_init(OVS_TEST_APP_COMPONENT_ID));
+    for (i = 0; i < 2; i++)
+    {
+        requests[i].block_mode = OVS_ENABLE_BLOCK_MODE;
+        requests[i].method = OVS_TRANSACT_METHOD;
+        requests[i].operation = OVS_INSERT_OPERATION;
+        requests[i].table_config = NewGatewayConfig();
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    EXPECT_FALSE(ovs_agent_api_interact_batch(requests, 2, RecordBatch));
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    EXPECT_LT(end.tv_sec - start.tv_sec, 3);
+    EXPECT_EQ(1, g_batches);
+    EXPECT_EQ(std::vector<OVS_STATUS>(2, OVS_FAILED_STATUS), g_row_status);
+
+    ASSERT_TRUE(ovs_agent_api_deinit());
+}
+
+namespace{
+    std::atomic<ovsdb_receipt_cb> g_batch_receipt_cb(NULL);
+
+    OVS_STATUS SaveBatch(const char * rid, Rdkb_Table_Config * table_configs, size_t count,
+        ovsdb_receipt_cb receipt_cb)
+    {
+        g_batch_receipt_cb = receipt_cb;
+        return OVS_SUCCESS_STATUS;
+    }
+
+    void* InteractBatchBlocked(void* result)
+    {
+        ovs_interact_request requests[3] = {};
+        int i;
+
+        for (i = 0; i < 3; i++)
+        {
+            requests[i].block_mode = OVS_ENABLE_BLOCK_MODE;
+            requests[i].method = OVS_TRANSACT_METHOD;
+            requests[i].operation = OVS_INSERT_OPERATION;
+            requests[i].table_config = NewGatewayConfig();
+        }
+        *(bool *)result = ovs_agent_api_interact_batch(requests, 3, RecordBatch);
+        return NULL;
+    }
+}
+
+TEST_F(OvsAgentApiTestFixture, ovs_agent_api_blocked_batch_outwaits_single_row_timeout)
+{
+    ovsdb_mon_cb mon_cb = NULL;
+    char uuids[3][MAX_UUID_LEN + 1];
+    OvsDb_Insert_Batch_Receipt receipt = {};
+    pthread_t thread;
+    bool result = false;
+    int i;
+
+    g_batches = 0;
+    g_batch_receipt_cb = NULL;
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_init(_))
+        .WillOnce(Return(OVS_SUCCESS_STATUS));
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_deinit())
+        .WillOnce(Return(OVS_SUCCESS_STATUS));
+    EXPECT_CALL(*g_ovsDbApiMock, id_generate())
+        .WillOnce(Return(1008));
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_write_batch(StrEq("1008"), _, 3, _))
+        .WillOnce(::testing::Invoke(SaveBatch));
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_monitor_select(OVS_FEEDBACK_TABLE, _, _, _))
+        .WillOnce(::testing::DoAll(SaveArg<2>(&mon_cb), Return(OVS_SUCCESS_STATUS)));
+    EXPECT_CALL(*g_ovsDbApiMock, ovsdb_delete(_, _, _))
+        .WillRepeatedly(Return(OVS_SUCCESS_STATUS));
+
+    ASSERT_TRUE(ovs_agent_api_init(OVS_TEST_APP_COMPONENT_ID));
+    ASSERT_EQ(0, pthread_create(&thread, NULL, InteractBatchBlocked, &result));
+    for (i = 0; i < 100 && g_batch_receipt_cb == NULL; i++)
+    {
+        usleep(10000);
+    }
+    ASSERT_TRUE(g_batch_receipt_cb != NULL);
+
+    memcpy(uuids, g_row_uuids, sizeof(uuids));
+    receipt.receipt_id = OVSDB_INSERT_BATCH_RECEIPT_ID;
+    receipt.status = OVS_SUCCESS_STATUS;
+    receipt.failed_row = -1;
+    receipt.count = 3;
+    receipt.uuids = uuids;
+    g_batch_receipt_cb.load()("1008", (OvsDb_Base_Receipt *)&receipt);
+
+    // the last Feedback comes in after a single row would have given up
+    ASSERT_TRUE(mon_cb != NULL);
+    SendFeedback(mon_cb, g_row_uuids[0], OVS_SUCCESS_STATUS);
+    SendFeedback(mon_cb, g_row_uuids[1], OVS_SUCCESS_STATUS);
+    usleep(3500000);
+    EXPECT_EQ(0, g_batches);
+    SendFeedback(mon_cb, g_row_uuids[2], OVS_SUCCESS_STATUS);
+
+    ASSERT_EQ(0, pthread_join(thread, NULL));
+    EXPECT_TRUE(result);
+    EXPECT_EQ(1, g_batches);
+    EXPECT_EQ(OVS_SUCCESS_STATUS, g_batch_status);
+
+    ASSERT_TRUE(ovs_agent_api_deinit());
+}
@@ -0,0 +1,76 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+
+#include <string.h>
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "OvsDbApi/ovsdb_echo.h"
+}
+
+class EchoTest : public ::testing::Test
+{
+    protected:
+        ovsdb_rtt_window window;
+        OvsDb_Echo_Stats stats;
+
+        virtual void SetUp()
+        {
+            ovsdb_rtt_window_reset(&window);
+            memset(&stats, 0, sizeof(stats));
+        }
+};
+
+TEST_F(EchoTest, EmptyWindow)
+{
+    ovsdb_rtt_window_stats(&window, &stats);
+    EXPECT_EQ(0u, stats.samples);
+    EXPECT_EQ(0u, stats.min_usecs);
+    EXPECT_EQ(0u, stats.max_usecs);
+}
+
+TEST_F(EchoTest, Percentiles)
+{
+    // added in reverse order, the stats must not depend on arrival order
+    for (unsigned int usecs = 100; usecs > 0; usecs--)
+    {
+        ovsdb_rtt_window_add(&window, usecs);
+    }
+
+    ovsdb_rtt_window_stats(&window, &stats);
+    EXPECT_EQ(100u, stats.samples);
+    EXPECT_EQ(1u, stats.min_usecs);
+    EXPECT_EQ(50u, stats.p50_usecs);
+    EXPECT_EQ(90u, stats.p90_usecs);
+    EXPECT_EQ(99u, stats.p99_usecs);
+    EXPECT_EQ(100u, stats.max_usecs);
+}
+
+TEST_F(EchoTest, OldSamplesAreDropped)
+{
+    for (unsigned int usecs = 1; usecs <= OVSDB_ECHO_WINDOW_SIZE + 10; usecs++)
+    {
+        ovsdb_rtt_window_add(&window, usecs);
+    }
+
+    ovsdb_rtt_window_stats(&window, &stats);
+    EXPECT_EQ((unsigned int)OVSDB_ECHO_WINDOW_SIZE, stats.samples);
+    EXPECT_EQ(11u, stats.min_usecs);
+    EXPECT_EQ((unsigned int)OVSDB_ECHO_WINDOW_SIZE + 10, stats.max_usecs);
+}
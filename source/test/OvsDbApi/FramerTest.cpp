@@ -0,0 +1,172 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "OvsDbApi/ovsdb_framer.h"
+}
+
+namespace{
+    const std::string g_receipt = "{\"id\":\"2\",\"result\":[{\"uuid\":[\"uuid\",\"f2381729-42ac-40a8-aa39-50d6d7805f2b\"]}],\"error\":null}";
+    const std::string g_update = "{\"id\":null,\"method\":\"update\",\"params\":[\"2\",{\"Feedback\":{\"e4bb63ed-988a-4951-848f-d8374f4972fd\":{\"new\":{\"req_uuid\":\"18ca5061-c9ef-42dc-9579-f9e3167a1ae7\",\"status\":0}}}}]}";
+
+    void collect_msg(const char * msg, size_t len, void * data)
+    {
+        std::vector<std::string> * msgs = (std::vector<std::string> *) data;
+        msgs->push_back(std::string(msg, len));
+    }
+}
+
+class FramerTest : public ::testing::Test
+{
+    protected:
+        ovsdb_framer framer;
+        std::vector<std::string> msgs;
+
+        virtual void SetUp()
+        {
+            ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_framer_init(&framer));
+        }
+
+        virtual void TearDown()
+        {
+            ovsdb_framer_deinit(&framer);
+        }
+
+        OVS_STATUS Feed(const std::string& data)
+        {
+            return ovsdb_framer_feed(&framer, data.c_str(), data.size(),
+                collect_msg, &msgs);
+        }
+};
+
+TEST_F(FramerTest, SingleMessage)
+{
+    ASSERT_EQ(OVS_SUCCESS_STATUS, Feed(g_receipt));
+    ASSERT_EQ(1u, msgs.size());
+    EXPECT_EQ(g_receipt, msgs[0]);
+}
+
+TEST_F(FramerTest, MultipleMessagesInOneRead)
+{
+    ASSERT_EQ(OVS_SUCCESS_STATUS, Feed(g_receipt + "\n" + g_update + g_receipt));
+    ASSERT_EQ(3u, msgs.size());
+    EXPECT_EQ(g_receipt, msgs[0]);
+    EXPECT_EQ(g_update, msgs[1]);
+    EXPECT_EQ(g_receipt, msgs[2]);
+}
+
+TEST_F(FramerTest, MessageSplitAcrossReads)
+{
+    const std::string stream = g_update + g_receipt;
+
+    for (size_t i = 0; i < stream.size(); i++)
+    {
+        ASSERT_EQ(OVS_SUCCESS_STATUS, Feed(stream.substr(i, 1)));
+        if (i + 1 < g_update.size())
+        {
+            ASSERT_EQ(0u, msgs.size());
+        }
+    }
+    ASSERT_EQ(2u, msgs.size());
+    EXPECT_EQ(g_update, msgs[0]);
+    EXPECT_EQ(g_receipt, msgs[1]);
+}
+
+TEST_F(FramerTest, BracesAndEscapesInsideStrings)
+{
+    const std::string msg = "{\"id\":\"1\",\"result\":[{\"details\":\"a}b]\\\"{c\\\\\"}],\"error\":null}";
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, Feed(msg.substr(0, 30)));
+    ASSERT_EQ(0u, msgs.size());
+    ASSERT_EQ(OVS_SUCCESS_STATUS, Feed(msg.substr(30)));
+    ASSERT_EQ(1u, msgs.size());
+    EXPECT_EQ(msg, msgs[0]);
+}
+
+TEST_F(FramerTest, MessageLargerThanInitialBuffer)
+{
+    std::string msg = "{\"id\":\"1\",\"result\":\"";
+    msg.append(OVSDB_FRAMER_INITIAL_SIZE * 3, 'x');
+    msg += "\",\"error\":null}";
+
+    for (size_t i = 0; i < msg.size(); i += 4096)
+    {
+        ASSERT_EQ(OVS_SUCCESS_STATUS, Feed(msg.substr(i, 4096)));
+    }
+    ASSERT_EQ(1u, msgs.size());
+    EXPECT_EQ(msg, msgs[0]);
+}
+
+TEST_F(FramerTest, GarbageIsRejected)
+{
+    EXPECT_EQ(OVS_FAILED_STATUS, Feed("xyz"));
+    EXPECT_EQ(OVS_FAILED_STATUS, Feed("}"));
+    EXPECT_EQ(0u, msgs.size());
+
+    // the framer recovers once the stream is back on a message boundary
+    ASSERT_EQ(OVS_SUCCESS_STATUS, Feed(g_receipt));
+    ASSERT_EQ(1u, msgs.size());
+    EXPECT_EQ(g_receipt, msgs[0]);
+}
+
+TEST_F(FramerTest, ReceiveInPlace)
+{
+    size_t avail = 0;
+    char * space = ovsdb_framer_get_space(&framer, OVSDB_FRAMER_MIN_READ, &avail);
+
+    ASSERT_TRUE(space != NULL);
+    ASSERT_LE((size_t)OVSDB_FRAMER_MIN_READ, avail);
+    memcpy(space, g_receipt.c_str(), g_receipt.size());
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_framer_commit(&framer, g_receipt.size(),
+        collect_msg, &msgs));
+    ASSERT_EQ(1u, msgs.size());
+    EXPECT_EQ(g_receipt, msgs[0]);
+
+    // the next read reuses the start of the buffer
+    EXPECT_EQ(space, ovsdb_framer_get_space(&framer, OVSDB_FRAMER_MIN_READ, &avail));
+}
+
+TEST_F(FramerTest, ShrinksOnceIdle)
+{
+    std::string msg = "{\"id\":\"1\",\"result\":\"";
+    msg.append(OVSDB_FRAMER_INITIAL_SIZE * 3, 'x');
+    msg += "\",\"error\":null}";
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, Feed(msg.substr(0, 100)));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, Feed(msg.substr(100)));
+    ASSERT_EQ(1u, msgs.size());
+    EXPECT_LT((size_t)OVSDB_FRAMER_INITIAL_SIZE, framer.size);
+
+    ovsdb_framer_shrink(&framer);
+    EXPECT_EQ((size_t)OVSDB_FRAMER_INITIAL_SIZE, framer.size);
+
+    // a pending partial message is kept
+    ASSERT_EQ(OVS_SUCCESS_STATUS, Feed(msg.substr(0, OVSDB_FRAMER_INITIAL_SIZE + 1)));
+    ovsdb_framer_shrink(&framer);
+    EXPECT_LT((size_t)OVSDB_FRAMER_INITIAL_SIZE, framer.size);
+    ASSERT_EQ(OVS_SUCCESS_STATUS, Feed(msg.substr(OVSDB_FRAMER_INITIAL_SIZE + 1)));
+    ASSERT_EQ(2u, msgs.size());
+    EXPECT_EQ(msg, msgs[1]);
+}
@@ -18,7 +18,9 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <string>
+#include <vector>
 #include <gtest/gtest.h>
 
 extern "C" {
@@ -30,7 +32,24 @@ namespace{
     const char* g_uuid = "f8ecdbd4-0c07-42a9-91ff-819bbf2f4196";
 }
 
-TEST(MonitorList, MonitorUpdateSingle)
+class MonitorList : public ::testing::Test
+{
+    protected:
+        mon_list* list;
+
+        virtual void SetUp()
+        {
+            list = mon_list_create();
+            ASSERT_TRUE(list != NULL);
+        }
+
+        virtual void TearDown()
+        {
+            mon_list_destroy(list);
+        }
+};
+
+TEST_F(MonitorList, MonitorUpdateSingle)
 {
     Feedback feedback = {OVS_SUCCESS_STATUS, {}};
     strncpy(feedback.req_uuid, g_uuid, sizeof(feedback.req_uuid));
@@ -44,6 +63,392 @@ TEST(MonitorList, MonitorUpdateSingle)
         EXPECT_STREQ(g_uuid,fb->req_uuid);
     };
 
-    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_add(g_rID, mon_cb));
-    EXPECT_EQ(OVS_SUCCESS_STATUS, mon_list_process(g_rID, &table_config));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_add(list, g_rID, OVS_FEEDBACK_TABLE, mon_cb));
+    EXPECT_EQ(OVS_SUCCESS_STATUS, mon_list_process(list, g_rID, &table_config));
+}
+
+TEST_F(MonitorList, MonitorForeachAfterRemove)
+{
+    std::vector<std::pair<std::string, OVS_TABLE>> monitors;
+    ovsdb_mon_cb mon_cb = [](OVS_STATUS status, Rdkb_Table_Config* table_config){};
+    mon_list_foreach_cb collect = [](const char* uuid, OVS_TABLE table, const char* select,
+        const char* where, bool resume, char* rid, void* data){
+        ((std::vector<std::pair<std::string, OVS_TABLE>>*)data)->push_back(
+            std::make_pair(std::string(uuid), table));
+    };
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_add(list, "1", OVS_FEEDBACK_TABLE, mon_cb));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_add(list, "2", OVS_GW_CONFIG_TABLE, mon_cb));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_add(list, "3", OVS_FEEDBACK_TABLE, mon_cb));
+    // removing from the middle of the list
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_remove(list, "2"));
+    ASSERT_EQ(OVS_FAILED_STATUS, mon_list_remove(list, "2"));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_foreach(list, collect, &monitors));
+    ASSERT_EQ(2u, monitors.size());
+    EXPECT_EQ("1", monitors[0].first);
+    EXPECT_EQ(OVS_FEEDBACK_TABLE, monitors[0].second);
+    EXPECT_EQ("3", monitors[1].first);
+    EXPECT_EQ(OVS_FEEDBACK_TABLE, monitors[1].second);
+    EXPECT_EQ(OVS_SUCCESS_STATUS, mon_list_clear(list));
+}
+
+TEST_F(MonitorList, ListsAreIndependent)
+{
+    mon_list* other = mon_list_create();
+    Rdkb_Table_Config table_config = {OVS_FEEDBACK_TABLE, NULL};
+    ovsdb_mon_cb mon_cb = [](OVS_STATUS status, Rdkb_Table_Config* table_config){};
+
+    ASSERT_TRUE(other != NULL);
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_add(list, "1", OVS_FEEDBACK_TABLE, mon_cb));
+    EXPECT_EQ(OVS_FAILED_STATUS, mon_list_process(other, "1", &table_config));
+    EXPECT_EQ(OVS_SUCCESS_STATUS, mon_list_process(list, "1", &table_config));
+    mon_list_destroy(other);
+}
+
+TEST_F(MonitorList, ConditionIsKeptForReplay)
+{
+    std::vector<std::string> conditions;
+    OVS_TABLE table = OVS_GW_CONFIG_TABLE;
+    ovsdb_mon_cb mon_cb = [](OVS_STATUS status, Rdkb_Table_Config* table_config){};
+    mon_list_foreach_cb collect = [](const char* uuid, OVS_TABLE table, const char* select,
+        const char* where, bool resume, char* rid, void* data){
+        ((std::vector<std::string>*)data)->push_back(where ? where : "plain");
+    };
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_add(list, "1", OVS_GW_CONFIG_TABLE, mon_cb));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_add_cond(list, "2", OVS_FEEDBACK_TABLE, "[false]", mon_cb));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_get_table(list, "2", &table));
+    EXPECT_EQ(OVS_FEEDBACK_TABLE, table);
+    EXPECT_EQ(OVS_FAILED_STATUS, mon_list_get_table(list, "3", &table));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_set_where(list, "2", "[[\"status\",\"==\",0]]"));
+    // a plain monitor has no condition to change
+    EXPECT_EQ(OVS_FAILED_STATUS, mon_list_set_where(list, "1", "[false]"));
+    EXPECT_EQ(OVS_FAILED_STATUS, mon_list_set_where(list, "3", "[false]"));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_foreach(list, collect, &conditions));
+    ASSERT_EQ(2u, conditions.size());
+    EXPECT_EQ("plain", conditions[0]);
+    EXPECT_EQ("[[\"status\",\"==\",0]]", conditions[1]);
+}
+
+TEST_F(MonitorList, SelectIsKeptForReplay)
+{
+    std::vector<std::string> selects;
+    ovsdb_mon_cb mon_cb = [](OVS_STATUS status, Rdkb_Table_Config* table_config){};
+    mon_list_foreach_cb collect = [](const char* uuid, OVS_TABLE table, const char* select,
+        const char* where, bool resume, char* rid, void* data){
+        ((std::vector<std::string>*)data)->push_back(select ? select : "all");
+    };
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_add(list, "1", OVS_GW_CONFIG_TABLE, mon_cb));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_add_select(list, "2", OVS_FEEDBACK_TABLE,
+        "\"columns\":[\"status\"]", NULL, mon_cb));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_foreach(list, collect, &selects));
+    ASSERT_EQ(2u, selects.size());
+    EXPECT_EQ("all", selects[0]);
+    EXPECT_EQ("\"columns\":[\"status\"]", selects[1]);
+}
+
+namespace{
+    std::vector<Feedback> g_delivered;
+    std::vector<std::pair<OVSDB_MONITOR_SELECT, uint32_t>> g_changes;
+    std::vector<Feedback> g_changedRows;
+}
+
+TEST_F(MonitorList, RowsAreCachedForDeltas)
+{
+    const table_desc* desc = table_desc_get(OVS_FEEDBACK_TABLE);
+    const char* row_uuid = "570e2da2-2adb-4dd7-bc2d-944d065c53c0";
+    ovsdb_mon_cb mon_cb = [](OVS_STATUS status, Rdkb_Table_Config* table_config){
+        g_delivered.push_back(*(Feedback*) table_config->config);
+    };
+    ovsdb_row_cb row_cb = [](const OvsDb_Row_Update* update){
+        g_changes.push_back(std::make_pair(update->type, update->changed));
+        g_changedRows.push_back(*(Feedback*) update->table_config->config);
+    };
+    ovsdb_table_row row;
+    ovsdb_row_delta delta;
+    mon_row_change change;
+
+    g_delivered.clear();
+    g_changes.clear();
+    g_changedRows.clear();
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_add_rows(list, "1", OVS_FEEDBACK_TABLE, NULL, NULL,
+        OVSDB_SELECT_ALL, mon_cb, row_cb));
+
+    // the initial row is only cached and told to the row callback
+    memset(&row, 0, sizeof(row));
+    strcpy(row.feedback.req_uuid, g_uuid);
+    memset(&change, 0, sizeof(change));
+    change.type = OVSDB_SELECT_INITIAL;
+    change.uuid = row_uuid;
+    change.desc = desc;
+    change.row = &row;
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_update(list, "1", &change));
+    EXPECT_EQ(0u, g_delivered.size());
+
+    // an update2 modify only has the status
+    memset(&delta, 0, sizeof(delta));
+    delta.first.feedback.status = OVS_FAILED_STATUS;
+    delta.present = 1u << (table_column_find(desc, "status", 6) - desc->columns);
+    change.type = OVSDB_SELECT_MODIFY;
+    change.row = NULL;
+    change.delta = &delta;
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_update(list, "1", &change));
+    ASSERT_EQ(1u, g_delivered.size());
+    EXPECT_STREQ(g_uuid, g_delivered[0].req_uuid);
+    EXPECT_EQ(OVS_FAILED_STATUS, g_delivered[0].status);
+
+    // and an update2 delete nothing, the row is its last contents
+    change.type = OVSDB_SELECT_DELETE;
+    change.delta = NULL;
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_update(list, "1", &change));
+    EXPECT_EQ(1u, g_delivered.size());
+
+    ASSERT_EQ(3u, g_changes.size());
+    EXPECT_EQ(OVSDB_SELECT_INITIAL, g_changes[0].first);
+    EXPECT_EQ(OVSDB_SELECT_MODIFY, g_changes[1].first);
+    EXPECT_EQ(delta.present, g_changes[1].second);
+    EXPECT_EQ(OVSDB_SELECT_DELETE, g_changes[2].first);
+    EXPECT_STREQ(g_uuid, g_changedRows[2].req_uuid);
+    EXPECT_EQ(OVS_FAILED_STATUS, g_changedRows[2].status);
+
+    // once deleted the row is no longer known, a delta only has its own columns
+    change.type = OVSDB_SELECT_MODIFY;
+    change.delta = &delta;
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_update(list, "1", &change));
+    EXPECT_EQ(1u, g_delivered.size());
+    ASSERT_EQ(4u, g_changes.size());
+    EXPECT_STREQ("", g_changedRows[3].req_uuid);
+    EXPECT_EQ(OVS_FAILED_STATUS, g_changedRows[3].status);
+
+    EXPECT_EQ(OVS_FAILED_STATUS, mon_list_update(list, "2", &change));
+}
+
+TEST_F(MonitorList, MissedRowIsResynced)
+{
+    const table_desc* desc = table_desc_get(OVS_FEEDBACK_TABLE);
+    const char* row_uuids[] = { "570e2da2-2adb-4dd7-bc2d-944d065c53c0",
+        "2d1e6a3c-7e1b-4b40-9a55-2b0a4c5d9e11" };
+    ovsdb_mon_cb mon_cb = [](OVS_STATUS status, Rdkb_Table_Config* table_config){
+        g_delivered.push_back(*(Feedback*) table_config->config);
+    };
+    ovsdb_row_cb row_cb = [](const OvsDb_Row_Update* update){
+        g_changes.push_back(std::make_pair(update->type, update->changed));
+    };
+    ovsdb_table_row row;
+    ovsdb_row_delta delta;
+    mon_row_change change;
+
+    g_delivered.clear();
+    g_changes.clear();
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_add_rows(list, "1", OVS_FEEDBACK_TABLE, NULL, NULL,
+        OVSDB_SELECT_ALL, mon_cb, row_cb));
+    EXPECT_FALSE(mon_list_can_resume(list, "1"));
+
+    memset(&row, 0, sizeof(row));
+    strcpy(row.feedback.req_uuid, "a");
+    memset(&change, 0, sizeof(change));
+    change.type = OVSDB_SELECT_INITIAL;
+    change.uuid = row_uuids[0];
+    change.desc = desc;
+    change.row = &row;
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_update(list, "1", &change));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_set_synced(list, "1"));
+    EXPECT_TRUE(mon_list_can_resume(list, "1"));
+    EXPECT_FALSE(mon_list_take_resync(list, "1"));
+
+    // a delta of a row that is not cached asks for the contents once
+    memset(&delta, 0, sizeof(delta));
+    delta.first.feedback.status = OVS_FAILED_STATUS;
+    delta.present = 1u << (table_column_find(desc, "status", 6) - desc->columns);
+    change.type = OVSDB_SELECT_MODIFY;
+    change.uuid = row_uuids[1];
+    change.row = NULL;
+    change.delta = &delta;
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_update(list, "1", &change));
+    EXPECT_EQ(0u, g_delivered.size());
+    EXPECT_FALSE(mon_list_can_resume(list, "1"));
+    EXPECT_TRUE(mon_list_take_resync(list, "1"));
+    EXPECT_FALSE(mon_list_take_resync(list, "1"));
+
+    // the contents tell what changed since the rows were cached
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_reset_rows(list, "1"));
+    change.type = OVSDB_SELECT_INITIAL;
+    change.row = &row;
+    change.delta = NULL;
+    change.uuid = row_uuids[0];
+    row.feedback.status = OVS_FAILED_STATUS;
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_update(list, "1", &change));
+    change.uuid = row_uuids[1];
+    strcpy(row.feedback.req_uuid, "b");
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_update(list, "1", &change));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_set_synced(list, "1"));
+    EXPECT_TRUE(mon_list_can_resume(list, "1"));
+
+    ASSERT_EQ(2u, g_delivered.size());
+    EXPECT_STREQ("a", g_delivered[0].req_uuid);
+    EXPECT_EQ(OVS_FAILED_STATUS, g_delivered[0].status);
+    EXPECT_STREQ("b", g_delivered[1].req_uuid);
+    ASSERT_EQ(4u, g_changes.size());
+    EXPECT_EQ(OVSDB_SELECT_MODIFY, g_changes[2].first);
+    EXPECT_EQ(delta.present, g_changes[2].second);
+    EXPECT_EQ(OVSDB_SELECT_INSERT, g_changes[3].first);
+
+    // once synced the contents are initial rows again
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_reset_rows(list, "1"));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_update(list, "1", &change));
+    EXPECT_EQ(2u, g_delivered.size());
+    EXPECT_EQ(OVSDB_SELECT_INITIAL, g_changes[4].first);
+}
+
+TEST_F(MonitorList, MonitorIsFoundByRequest)
+{
+    char uuid[MAX_UUID_LEN + 1] = { 0 };
+    ovsdb_mon_cb mon_cb = [](OVS_STATUS status, Rdkb_Table_Config* table_config){};
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_add(list, "1", OVS_FEEDBACK_TABLE, mon_cb));
+    EXPECT_EQ(OVS_FAILED_STATUS, mon_list_find_request(list, "2", uuid));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_set_request(list, "1", "2"));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_find_request(list, "2", uuid));
+    EXPECT_STREQ("1", uuid);
+    EXPECT_EQ(OVS_FAILED_STATUS, mon_list_set_request(list, "3", "4"));
+}
+
+namespace{
+    std::vector<std::vector<std::pair<OVSDB_MONITOR_SELECT, std::string>>> g_batches;
+}
+
+TEST_F(MonitorList, BatchHoldsRowsUntilFlush)
+{
+    const table_desc* desc = table_desc_get(OVS_FEEDBACK_TABLE);
+    const char* row_uuids[] = { "570e2da2-2adb-4dd7-bc2d-944d065c53c0",
+        "2d1e6a3c-7e1b-4b40-9a55-2b0a4c5d9e11", "8b9f0d47-51c2-4f2e-a3b6-6c7d8e9f0a1b" };
+    ovsdb_batch_cb batch_cb = [](const OvsDb_Row_Update* updates, size_t count){
+        std::vector<std::pair<OVSDB_MONITOR_SELECT, std::string>> batch;
+        for (size_t i = 0; i < count; i++)
+        {
+            EXPECT_STREQ(updates[i].uuid,
+                ((OvsAgent_Table_Config*) updates[i].table_config)->uuid);
+            batch.push_back(std::make_pair(updates[i].type,
+                ((Feedback*) updates[i].table_config->config)->req_uuid));
+        }
+        g_batches.push_back(batch);
+    };
+    ovsdb_table_row rows[3];
+    mon_row_change change;
+
+    g_batches.clear();
+    EXPECT_EQ(OVS_FAILED_STATUS, mon_list_add_batch(list, "1", OVS_FEEDBACK_TABLE, NULL,
+        NULL, OVSDB_SELECT_ALL, NULL));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_add_batch(list, "1", OVS_FEEDBACK_TABLE, NULL,
+        NULL, OVSDB_SELECT_ALL, batch_cb));
+
+    // nothing to hand over yet
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_flush(list, "1"));
+    EXPECT_EQ(0u, g_batches.size());
+
+    memset(&change, 0, sizeof(change));
+    change.type = OVSDB_SELECT_INITIAL;
+    change.desc = desc;
+    for (int i = 0; i < 3; i++)
+    {
+        memset(&rows[i], 0, sizeof(rows[i]));
+        snprintf(rows[i].feedback.req_uuid, sizeof(rows[i].feedback.req_uuid), "req%d", i);
+        change.uuid = row_uuids[i];
+        change.row = &rows[i];
+        ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_update(list, "1", &change));
+    }
+    EXPECT_EQ(0u, g_batches.size());
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_flush(list, "1"));
+    ASSERT_EQ(1u, g_batches.size());
+    ASSERT_EQ(3u, g_batches[0].size());
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(OVSDB_SELECT_INITIAL, g_batches[0][i].first);
+        EXPECT_EQ("req" + std::to_string(i), g_batches[0][i].second);
+    }
+
+    // the next update is a batch of its own, a delete has the cached row
+    change.type = OVSDB_SELECT_DELETE;
+    change.uuid = row_uuids[1];
+    change.row = NULL;
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_update(list, "1", &change));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_flush(list, "1"));
+    ASSERT_EQ(2u, g_batches.size());
+    ASSERT_EQ(1u, g_batches[1].size());
+    EXPECT_EQ(OVSDB_SELECT_DELETE, g_batches[1][0].first);
+    EXPECT_EQ("req1", g_batches[1][0].second);
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_flush(list, "1"));
+    EXPECT_EQ(2u, g_batches.size());
+    EXPECT_EQ(OVS_FAILED_STATUS, mon_list_flush(list, "2"));
+}
+
+namespace{
+    std::vector<std::pair<std::string, OVS_TABLE>> g_members;
+}
+
+TEST_F(MonitorList, SessionMonitorDispatchesByTable)
+{
+    char uuid[MAX_UUID_LEN + 1] = { 0 };
+    ovsdb_mon_cb gw_cb = [](OVS_STATUS status, Rdkb_Table_Config* table_config){
+        g_members.push_back(std::make_pair(std::string("gw"), table_config->table.id));
+    };
+    ovsdb_mon_cb fb_cb = [](OVS_STATUS status, Rdkb_Table_Config* table_config){
+        g_members.push_back(std::make_pair(std::string("fb"), table_config->table.id));
+    };
+    mon_list_foreach_cb collect = [](const char* uuid, OVS_TABLE table, const char* select,
+        const char* where, bool resume, char* rid, void* data){
+        ((std::vector<std::string>*)data)->push_back(uuid);
+    };
+    std::vector<std::string> replayed;
+    ovsdb_table_row row;
+    mon_row_change change;
+
+    g_members.clear();
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_add_member(list, "2", "1", OVS_GW_CONFIG_TABLE,
+        gw_cb));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_add_member(list, "3", "1", OVS_FEEDBACK_TABLE,
+        fb_cb));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_add(list, "4", OVS_FEEDBACK_TABLE, fb_cb));
+    EXPECT_EQ((1u << OVS_GW_CONFIG_TABLE) | (1u << OVS_FEEDBACK_TABLE),
+        mon_list_group_tables(list, "1"));
+    EXPECT_EQ(0u, mon_list_group_tables(list, "4"));
+
+    // the session monitor's reply is found for it, not for a member
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_set_request(list, "1", "5"));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_find_request(list, "5", uuid));
+    EXPECT_STREQ("1", uuid);
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_get_group(list, "3", uuid));
+    EXPECT_STREQ("1", uuid);
+    EXPECT_EQ(OVS_FAILED_STATUS, mon_list_get_group(list, "4", uuid));
+
+    memset(&row, 0, sizeof(row));
+    memset(&change, 0, sizeof(change));
+    change.type = OVSDB_SELECT_INSERT;
+    change.uuid = "570e2da2-2adb-4dd7-bc2d-944d065c53c0";
+    change.row = &row;
+    change.desc = table_desc_get(OVS_FEEDBACK_TABLE);
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_update(list, "1", &change));
+    change.desc = table_desc_get(OVS_GW_CONFIG_TABLE);
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_update(list, "1", &change));
+    ASSERT_EQ(2u, g_members.size());
+    EXPECT_EQ("fb", g_members[0].first);
+    EXPECT_EQ(OVS_FEEDBACK_TABLE, g_members[0].second);
+    EXPECT_EQ("gw", g_members[1].first);
+    EXPECT_EQ(OVS_GW_CONFIG_TABLE, g_members[1].second);
+
+    // members are re-issued with the session monitor, not one by one
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_foreach(list, collect, &replayed));
+    ASSERT_EQ(1u, replayed.size());
+    EXPECT_EQ("4", replayed[0]);
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, mon_list_remove(list, "2"));
+    EXPECT_EQ(1u << OVS_FEEDBACK_TABLE, mon_list_group_tables(list, "1"));
+    EXPECT_EQ(OVS_FAILED_STATUS, mon_list_update(list, "1", &change));
 }
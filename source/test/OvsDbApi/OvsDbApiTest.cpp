@@ -19,8 +19,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string>
-#include <queue>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <atomic>
 #include <mutex>
+#include <vector>
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include "test/mocks/mock_ovsdb_socket.h"
@@ -28,12 +32,16 @@
 
 extern "C" {
 #include "OvsDbApi/OvsDbApi.h"
+#include "OvsDbApi/ovsdb_echo.h"
+#include "OvsDbApi/ovsdb_framer.h"
+#include "OvsDbApi/receipt_list.h"
 #include "common/OvsAgentLog.h"
 }
 
 using ::testing::_;
 using ::testing::Return;
 using ::testing::StrEq;
+using ::testing::HasSubstr;
 
 OvsDbSocketMock * g_ovsDbSocketMock = NULL; /* This is the actual definition of the mock obj */
 OvsDbReceiptCallbackMock * g_ovsDbReceiptCallbackMock = NULL;
@@ -43,18 +51,26 @@ class OvsDbApiTestFixture : public ::testing::Test
     protected:
         OvsDbSocketMock mockedOvsDbSocket;
         OvsDbReceiptCallbackMock mockedOvsDbReceiptCallback;
-        std::queue<std::string> m_responseQueue;
-        std::mutex m_lock;
+        int m_sockFds[2];   // [0] is handed to OvsDbApi, [1] plays the OVSDB server
+        int m_monFds[2];    // same for the monitor session
 
         OvsDbApiTestFixture()
         {
             g_ovsDbSocketMock = &mockedOvsDbSocket;
             g_ovsDbReceiptCallbackMock = &mockedOvsDbReceiptCallback;
+            m_sockFds[0] = m_sockFds[1] = -1;
+            m_monFds[0] = m_monFds[1] = -1;
+            (void)socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, m_sockFds);
+            (void)socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, m_monFds);
         }
         virtual ~OvsDbApiTestFixture()
         {
             g_ovsDbSocketMock = NULL;
             g_ovsDbReceiptCallbackMock = NULL;
+            close(m_sockFds[0]);
+            close(m_sockFds[1]);
+            close(m_monFds[0]);
+            close(m_monFds[1]);
         }
 
         virtual void SetUp()
@@ -101,24 +117,58 @@ class OvsDbApiTestFixture : public ::testing::Test
 
             g_ovsDbReceiptCallbackMock->notify();
         }
+        static ssize_t ReadFromSocket(int fd, char * buffer, size_t size)
+        {
+            ssize_t len = recv(fd, buffer, size, 0);
+            if (len < 0)
+            {
+                return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -2;
+            }
+            if (len == 0)
+            {
+                return -3;
+            }
+            return len;
+        }
+        /* The monitor session connects first, then the transact session. */
+        void ExpectSessions(int transactFd)
+        {
+            EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_connect())
+                .Times(2)
+                .WillOnce(Return(m_monFds[0]))
+                .WillOnce(Return(transactFd));
+            EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(m_monFds[0]))
+                .WillOnce(Return(0));
+        }
+        /* Plays an ovsdb-server answering echo requests. */
+        ssize_t AnswerEcho(int fd, const char * buffer, size_t size)
+        {
+            const std::string req(buffer, size);
+            const std::string key = "\"id\":\"";
+            size_t start = req.find(key) + key.size();
+            std::string reply = "{\"id\":\"" +
+                req.substr(start, req.find('"', start) - start) +
+                "\",\"result\":[],\"error\":null}";
+
+            (void)send((fd == m_monFds[0]) ? m_monFds[1] : m_sockFds[1],
+                reply.c_str(), reply.size(), 0);
+            return size;
+        }
         void SendMessage(const std::string& json_msg)
         {
-            m_lock.lock();
-            m_responseQueue.push(json_msg);
-            m_lock.unlock();
+            ASSERT_EQ((ssize_t)json_msg.size(),
+                send(m_sockFds[1], json_msg.c_str(), json_msg.size(), 0));
         }
 };
 
 TEST_F(OvsDbApiTestFixture, ovsdb_api_init_deinit)
 {
-    const int sock_fd = 10;
+    const int sock_fd = m_sockFds[0];
 
-    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_connect())
-        .Times(1)
-        .WillOnce(Return(sock_fd));
-    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_listen(sock_fd, _, _, _))
+    ExpectSessions(sock_fd);
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(sock_fd, _, _))
         .Times(::testing::AnyNumber())
-        .WillRepeatedly(Return(0));
+        .WillRepeatedly(::testing::Invoke(ReadFromSocket));
     EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(sock_fd))
         .Times(1)
         .WillOnce(Return(0));
@@ -130,14 +180,12 @@ TEST_F(OvsDbApiTestFixture, ovsdb_api_init_deinit)
 TEST_F(OvsDbApiTestFixture, ovsdb_api_id_generate)
 {
     const unsigned int startingId = 0;
-    const int sock_fd = 10;
+    const int sock_fd = m_sockFds[0];
 
-    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_connect())
-        .Times(1)
-        .WillOnce(Return(sock_fd));
-    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_listen(sock_fd, _, _, _))
+    ExpectSessions(sock_fd);
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(sock_fd, _, _))
         .Times(::testing::AnyNumber())
-        .WillRepeatedly(Return(0));
+        .WillRepeatedly(::testing::Invoke(ReadFromSocket));
     EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(sock_fd))
         .Times(1)
         .WillOnce(Return(0));
@@ -147,26 +195,9 @@ TEST_F(OvsDbApiTestFixture, ovsdb_api_id_generate)
     ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_deinit());
 }
 
-ACTION_TEMPLATE(CopyStringFromQueue, HAS_1_TEMPLATE_PARAMS(unsigned, uIndex), AND_3_VALUE_PARAMS(pQueue, pLock, pSize))
-{
-    if(pQueue->empty())
-    {
-        *pSize = 0;
-    }
-    else
-    {
-        pLock->lock();
-        std::string json_msg = pQueue->front();
-        pQueue->pop();
-        memcpy(std::get<uIndex>(args), json_msg.c_str(), json_msg.size());
-        *pSize = json_msg.size();
-        pLock->unlock();
-    }
-}
-
 TEST_F(OvsDbApiTestFixture, ovsdb_api_write_gateway_config_table_with_receipt_cb)
 {
-    const int sock_fd = 10;
+    const int sock_fd = m_sockFds[0];
     const unsigned int startingId = 0;
     const char* rId = "1";
     struct Gateway_Config gatewayConfig = {
@@ -174,26 +205,20 @@ TEST_F(OvsDbApiTestFixture, ovsdb_api_write_gateway_config_table_with_receipt_cb
         "Brlan0PIface", "Brlan0PBridge", 1480, 100, OVS_BRIDGE_IF_TYPE, OVS_IF_UP_CMD};
     const std::string actualJsonReq = "{\"method\":\"transact\",\"id\":\"1\",\"params\":[\"Open_vSwitch\",{\"op\":\"insert\",\"table\":\"Gateway_Config\",\"row\":{\"gre_ifname\":\"null\",\"if_name\":\"Brlan0\",\"if_type\":1,\"if_cmd\":0,\"inet_addr\":\"10.0.0.1\",\"netmask\":\"255.255.255.0\",\"gre_remote_inet_addr\":\"10.100.0.1\",\"gre_local_inet_addr\":\"10.0.100.1\",\"parent_ifname\":\"Brlan0PIface\",\"mtu\":1480,\"parent_bridge\":\"Brlan0PBridge\",\"vlan_id\":100}}]}";
     const std::string expectedJsonResp = "{\"id\":\"1\",\"result\":[{\"uuid\":[\"uuid\",\"f2381729-42ac-40a8-aa38-50d6d7805f2b\"]}],\"error\":null}";
-    ssize_t json_len = 0;
 
     Rdkb_Table_Config tableConfig;
     tableConfig.table.id = OVS_GW_CONFIG_TABLE;
     tableConfig.config = &gatewayConfig;
 
-    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_connect())
-        .Times(1)
-        .WillOnce(Return(sock_fd));
+    ExpectSessions(sock_fd);
 
     EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(sock_fd, StrEq(actualJsonReq.c_str()), actualJsonReq.length()))
         .Times(1)
         .WillOnce(Return(actualJsonReq.length()));
 
-    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_listen(sock_fd, _, _, _))
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(sock_fd, _, _))
         .Times(::testing::AtLeast(1))
-        .WillRepeatedly(::testing::DoAll(
-            CopyStringFromQueue<1>(&m_responseQueue, &m_lock, &json_len),
-            ::testing::ReturnPointee(&json_len)
-            ));
+        .WillRepeatedly(::testing::Invoke(ReadFromSocket));
 
     EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(sock_fd))
         .Times(1)
@@ -217,11 +242,10 @@ TEST_F(OvsDbApiTestFixture, ovsdb_api_write_gateway_config_table_with_receipt_cb
 
 TEST_F(OvsDbApiTestFixture, ovsdb_api_write_feedback_table_with_receipt_cb)
 {
-    const int sock_fd = 10;
+    const int sock_fd = m_sockFds[0];
     const unsigned int startingId = 1;
     const char * rID = "2";
     struct Feedback feedback = {OVS_SUCCESS_STATUS, "f7d3d0e6-4ce7-4164-9134-0b5af9ce1b86"};
-    ssize_t json_len = 0;
     const std::string actualJsonReq =
         "{\"method\":\"transact\",\"id\":\"2\",\"params\":[\"Open_vSwitch\",{\"op\":\"insert\",\"table\":\"Feedback\",\"row\":{\"req_uuid\":\"f7d3d0e6-4ce7-4164-9134-0b5af9ce1b86\",\"status\":0}}]}";
     std::string expectedJsonResp = "{\"id\":\"2\",\"result\":[{\"uuid\":[\"uuid\",\"f2381729-42ac-40a8-aa39-50d6d7805f2b\"]}],\"error\":null}";
@@ -230,20 +254,15 @@ TEST_F(OvsDbApiTestFixture, ovsdb_api_write_feedback_table_with_receipt_cb)
     tableConfig.table.id = OVS_FEEDBACK_TABLE;
     tableConfig.config = &feedback;
 
-    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_connect())
-        .Times(1)
-        .WillOnce(Return(sock_fd));
+    ExpectSessions(sock_fd);
 
     EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(sock_fd, StrEq(actualJsonReq.c_str()), actualJsonReq.length()))
         .Times(1)
         .WillOnce(Return(actualJsonReq.length()));
 
-    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_listen(sock_fd, _, _, _))
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(sock_fd, _, _))
         .Times(::testing::AtLeast(1))
-        .WillRepeatedly(::testing::DoAll(
-            CopyStringFromQueue<1>(&m_responseQueue, &m_lock, &json_len),
-            ::testing::ReturnPointee(&json_len)
-            ));
+        .WillRepeatedly(::testing::Invoke(ReadFromSocket));
 
     EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(sock_fd))
         .Times(1)
@@ -268,12 +287,11 @@ TEST_F(OvsDbApiTestFixture, ovsdb_api_write_feedback_table_with_receipt_cb)
 
 TEST_F(OvsDbApiTestFixture, ovsdb_multiple_write)
 {
-    const int sock_fd = 10;
+    const int sock_fd = m_sockFds[0];
     const unsigned int startingId = 1;
     const char * rID = "2";
     const char * rID2 = "3";
     const char * rID3 = "4";
-    ssize_t json_len = 0;
 
     struct Feedback feedback = {OVS_SUCCESS_STATUS, "f7d3d0e6-4ce7-4164-9134-0b5af9ce1b86"};
     struct Feedback feedback2 = {OVS_SUCCESS_STATUS, "g7d3d0e6-4ce7-4164-9134-0b5af9ce1b86"};
@@ -302,9 +320,7 @@ TEST_F(OvsDbApiTestFixture, ovsdb_multiple_write)
     tableConfig3.table.id = OVS_FEEDBACK_TABLE;
     tableConfig3.config = &feedback3;
 
-    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_connect())
-        .Times(1)
-        .WillOnce(Return(sock_fd));
+    ExpectSessions(sock_fd);
 
     EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(sock_fd, StrEq(actualJsonReq.c_str()), actualJsonReq.length()))
         .Times(1)
@@ -318,12 +334,9 @@ TEST_F(OvsDbApiTestFixture, ovsdb_multiple_write)
         .Times(1)
         .WillOnce(Return(actualJsonReq3.length()));
 
-    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_listen(sock_fd, _, _, _))
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(sock_fd, _, _))
         .Times(::testing::AtLeast(1))
-        .WillRepeatedly(::testing::DoAll(
-            CopyStringFromQueue<1>(&m_responseQueue, &m_lock, &json_len),
-            ::testing::ReturnPointee(&json_len)
-            ));
+        .WillRepeatedly(::testing::Invoke(ReadFromSocket));
 
     EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(sock_fd))
         .Times(1)
@@ -356,3 +369,1255 @@ TEST_F(OvsDbApiTestFixture, ovsdb_multiple_write)
 
     ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_deinit());
 }
+
+TEST_F(OvsDbApiTestFixture, ovsdb_api_write_receipt_split_across_reads)
+{
+    const int sock_fd = m_sockFds[0];
+    const unsigned int startingId = 1;
+    const char * rID = "2";
+    struct Feedback feedback = {OVS_SUCCESS_STATUS, "f7d3d0e6-4ce7-4164-9134-0b5af9ce1b86"};
+    const std::string actualJsonReq =
+        "{\"method\":\"transact\",\"id\":\"2\",\"params\":[\"Open_vSwitch\",{\"op\":\"insert\",\"table\":\"Feedback\",\"row\":{\"req_uuid\":\"f7d3d0e6-4ce7-4164-9134-0b5af9ce1b86\",\"status\":0}}]}";
+    const std::string expectedJsonResp = "{\"id\":\"2\",\"result\":[{\"uuid\":[\"uuid\",\"f2381729-42ac-40a8-aa39-50d6d7805f2b\"]}],\"error\":null}";
+
+    Rdkb_Table_Config tableConfig;
+    tableConfig.table.id = OVS_FEEDBACK_TABLE;
+    tableConfig.config = &feedback;
+
+    ExpectSessions(sock_fd);
+
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(sock_fd, StrEq(actualJsonReq.c_str()), actualJsonReq.length()))
+        .Times(1)
+        .WillOnce(Return(actualJsonReq.length()));
+
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(sock_fd, _, _))
+        .Times(::testing::AtLeast(1))
+        .WillRepeatedly(::testing::Invoke(ReadFromSocket));
+
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(sock_fd))
+        .Times(1)
+        .WillOnce(Return(0));
+
+    EXPECT_CALL(*g_ovsDbReceiptCallbackMock,
+            OvsDbReceiptCallback(StrEq("2"), OVSDB_INSERT_RECEIPT_ID, StrEq("f2381729-42ac-40a8-aa39-50d6d7805f2b")))
+        .Times(1);
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_init(startingId));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_write(rID, &tableConfig, OvsDbReceiptCallback));
+
+    // The response arrives in two reads, the receipt must only be processed once complete
+    SendMessage(expectedJsonResp.substr(0, 40));
+    usleep(10000);
+    SendMessage(expectedJsonResp.substr(40));
+
+    // Wait for the Receipt callback to be invoked
+    g_ovsDbReceiptCallbackMock->wait(500);
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_deinit());
+}
+
+TEST_F(OvsDbApiTestFixture, ovsdb_api_write_resumes_partial_send)
+{
+    const int sock_fd = m_sockFds[0];
+    const unsigned int startingId = 1;
+    const char * rID = "2";
+    struct Feedback feedback = {OVS_SUCCESS_STATUS, "f7d3d0e6-4ce7-4164-9134-0b5af9ce1b86"};
+    const std::string actualJsonReq =
+        "{\"method\":\"transact\",\"id\":\"2\",\"params\":[\"Open_vSwitch\",{\"op\":\"insert\",\"table\":\"Feedback\",\"row\":{\"req_uuid\":\"f7d3d0e6-4ce7-4164-9134-0b5af9ce1b86\",\"status\":0}}]}";
+    const std::string expectedJsonResp = "{\"id\":\"2\",\"result\":[{\"uuid\":[\"uuid\",\"f2381729-42ac-40a8-aa39-50d6d7805f2b\"]}],\"error\":null}";
+
+    Rdkb_Table_Config tableConfig;
+    tableConfig.table.id = OVS_FEEDBACK_TABLE;
+    tableConfig.config = &feedback;
+
+    ExpectSessions(sock_fd);
+
+    // the socket only takes part of the request, the rest is sent once it is writable
+    ::testing::Sequence seq;
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(sock_fd, StrEq(actualJsonReq.c_str()), actualJsonReq.length()))
+        .InSequence(seq)
+        .WillOnce(Return(32));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(sock_fd, StrEq(actualJsonReq.substr(32).c_str()), actualJsonReq.length() - 32))
+        .InSequence(seq)
+        .WillOnce(Return(actualJsonReq.length() - 32));
+
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(sock_fd, _, _))
+        .Times(::testing::AtLeast(1))
+        .WillRepeatedly(::testing::Invoke(ReadFromSocket));
+
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(sock_fd))
+        .Times(1)
+        .WillOnce(Return(0));
+
+    EXPECT_CALL(*g_ovsDbReceiptCallbackMock,
+            OvsDbReceiptCallback(StrEq("2"), OVSDB_INSERT_RECEIPT_ID, StrEq("f2381729-42ac-40a8-aa39-50d6d7805f2b")))
+        .Times(1);
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_init(startingId));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_write(rID, &tableConfig, OvsDbReceiptCallback));
+
+    SendMessage(expectedJsonResp);
+
+    // Wait for the Receipt callback to be invoked
+    g_ovsDbReceiptCallbackMock->wait(500);
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_deinit());
+}
+
+TEST_F(OvsDbApiTestFixture, ovsdb_api_reconnect_replays_monitors)
+{
+    int newSockFds[2];
+    const unsigned int startingId = 0;
+    const char * rID = "10";
+    struct Feedback feedback = {OVS_SUCCESS_STATUS, "f7d3d0e6-4ce7-4164-9134-0b5af9ce1b86"};
+    // the table is part of the session monitor "1", which lists every table
+    const std::string monitorReq =
+        "{\"method\":\"monitor_cond\",\"params\":[\"Open_vSwitch\",\"1\",{\"Gateway_Config\":"
+        "[{\"where\":[false]}],\"Feedback\":[{\"where\":[true]}]}],\"id\":\"2\"}";
+    const std::string insertReq =
+        "{\"method\":\"transact\",\"id\":\"10\",\"params\":[\"Open_vSwitch\",{\"op\":\"insert\",\"table\":\"Feedback\",\"row\":{\"req_uuid\":\"f7d3d0e6-4ce7-4164-9134-0b5af9ce1b86\",\"status\":0}}]}";
+    const std::string insertResp = "{\"id\":\"10\",\"result\":[{\"uuid\":[\"uuid\",\"f2381729-42ac-40a8-aa39-50d6d7805f2b\"]}],\"error\":null}";
+    // the monitor keeps its monitor id "1" and gets a new request id
+    const std::string replayReq =
+        "{\"method\":\"monitor_cond\",\"params\":[\"Open_vSwitch\",\"1\",{\"Gateway_Config\":"
+        "[{\"where\":[false]}],\"Feedback\":[{\"where\":[true]}]}],\"id\":\"4\"}";
+    std::atomic<bool> replayed(false);
+
+    Rdkb_Table_Config tableConfig;
+    tableConfig.table.id = OVS_FEEDBACK_TABLE;
+    tableConfig.config = &feedback;
+
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, newSockFds));
+
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_connect())
+        .Times(3)
+        .WillOnce(Return(m_monFds[0]))
+        .WillOnce(Return(m_sockFds[0]))
+        .WillOnce(Return(newSockFds[0]));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(m_monFds[0], StrEq(monitorReq.c_str()), monitorReq.length()))
+        .WillOnce(Return(monitorReq.length()));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(m_sockFds[0], StrEq(insertReq.c_str()), insertReq.length()))
+        .WillOnce(Return(insertReq.length()));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(newSockFds[0], StrEq(replayReq.c_str()), replayReq.length()))
+        .WillOnce(::testing::DoAll(
+            ::testing::Assign(&replayed, true),
+            Return(replayReq.length())));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(_, _, _))
+        .Times(::testing::AnyNumber())
+        .WillRepeatedly(::testing::Invoke(ReadFromSocket));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(m_monFds[0]))
+        .WillOnce(Return(0));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(m_sockFds[0]))
+        .WillOnce(Return(0));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(newSockFds[0]))
+        .WillOnce(Return(0));
+
+    // the insert is on the transact session, which is not affected
+    EXPECT_CALL(*g_ovsDbReceiptCallbackMock,
+            OvsDbReceiptCallback(StrEq("10"), OVSDB_INSERT_RECEIPT_ID, StrEq("f2381729-42ac-40a8-aa39-50d6d7805f2b")))
+        .Times(1);
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_init(startingId));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_monitor(OVS_FEEDBACK_TABLE, OvsDbMonitorCallback, NULL));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_write(rID, &tableConfig, OvsDbReceiptCallback));
+
+    // ovsdb-server drops the monitor connection
+    close(m_monFds[1]);
+    m_monFds[1] = -1;
+
+    for (int i = 0; i < 200 && !replayed; i++)
+    {
+        usleep(10000);
+    }
+    EXPECT_TRUE(replayed);
+
+    SendMessage(insertResp);
+    g_ovsDbReceiptCallbackMock->wait(500);
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_deinit());
+    close(newSockFds[0]);
+    close(newSockFds[1]);
+}
+
+TEST_F(OvsDbApiTestFixture, ovsdb_api_reconnect_replays_monitor_of_its_own)
+{
+    int newSockFds[2];
+    const OvsDb_Condition none[] = { {"req_uuid", OVSDB_COND_EQ, "x", 0} };
+    const std::string monitorReq =
+        "{\"method\":\"monitor_cond\",\"params\":[\"Open_vSwitch\",\"1\",{\"Feedback\":"
+        "[{\"where\":[false]}]}],\"id\":\"2\"}";
+    const std::string replayReq =
+        "{\"method\":\"monitor_cond\",\"params\":[\"Open_vSwitch\",\"1\",{\"Feedback\":"
+        "[{\"where\":[false]}]}],\"id\":\"3\"}";
+    std::atomic<bool> replayed(false);
+
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, newSockFds));
+
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_connect())
+        .Times(3)
+        .WillOnce(Return(m_monFds[0]))
+        .WillOnce(Return(m_sockFds[0]))
+        .WillOnce(Return(newSockFds[0]));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(m_monFds[0], StrEq(monitorReq.c_str()), monitorReq.length()))
+        .WillOnce(Return(monitorReq.length()));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(newSockFds[0], StrEq(replayReq.c_str()), replayReq.length()))
+        .WillOnce(::testing::DoAll(
+            ::testing::Assign(&replayed, true),
+            Return(replayReq.length())));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(_, _, _))
+        .Times(::testing::AnyNumber())
+        .WillRepeatedly(::testing::Invoke(ReadFromSocket));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(m_monFds[0]))
+        .WillOnce(Return(0));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(m_sockFds[0]))
+        .WillOnce(Return(0));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(newSockFds[0]))
+        .WillOnce(Return(0));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_init(0));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_monitor_cond(OVS_FEEDBACK_TABLE, NULL, none, 0,
+        OvsDbMonitorCallback, NULL, NULL));
+
+    // re-issued from the monitor list, which the monitor is looked up in again
+    close(m_monFds[1]);
+    m_monFds[1] = -1;
+
+    for (int i = 0; i < 200 && !replayed; i++)
+    {
+        usleep(10000);
+    }
+    EXPECT_TRUE(replayed);
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_deinit());
+    close(newSockFds[0]);
+    close(newSockFds[1]);
+}
+
+TEST_F(OvsDbApiTestFixture, ovsdb_api_echo_measures_rtt)
+{
+    const int sock_fd = m_sockFds[0];
+    OvsDb_Echo_Stats stats = {0};
+
+    ExpectSessions(sock_fd);
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(_, HasSubstr("\"method\":\"echo\""), _))
+        .Times(::testing::AtLeast(3))
+        .WillRepeatedly(::testing::Invoke(this, &OvsDbApiTestFixture::AnswerEcho));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(_, _, _))
+        .Times(::testing::AnyNumber())
+        .WillRepeatedly(::testing::Invoke(ReadFromSocket));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(sock_fd))
+        .WillOnce(Return(0));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_set_echo_interval(10));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_init(0));
+
+    for (int i = 0; i < 200 && stats.received < 3; i++)
+    {
+        usleep(10000);
+        ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_get_echo_stats(&stats));
+    }
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_deinit());
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_set_echo_interval(OVSDB_ECHO_INTERVAL_MSECS));
+
+    EXPECT_LE(3u, stats.received);
+    EXPECT_LE(stats.received, stats.sent);
+    EXPECT_EQ(stats.received, stats.samples);
+    EXPECT_LE(stats.min_usecs, stats.p50_usecs);
+    EXPECT_LE(stats.p50_usecs, stats.p99_usecs);
+    EXPECT_LE(stats.p99_usecs, stats.max_usecs);
+}
+
+TEST_F(OvsDbApiTestFixture, ovsdb_api_echo_timeout_reconnects)
+{
+    std::atomic<bool> reconnected(false);
+    OvsDb_Echo_Stats stats = {0};
+
+    // ovsdb-server accepts the echo requests but never answers them, and
+    // is gone by the time the sessions try to reconnect
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_connect())
+        .Times(::testing::AtLeast(3))
+        .WillOnce(Return(m_monFds[0]))
+        .WillOnce(Return(m_sockFds[0]))
+        .WillRepeatedly(::testing::DoAll(
+            ::testing::Assign(&reconnected, true),
+            Return(-1)));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(_, HasSubstr("\"method\":\"echo\""), _))
+        .Times(::testing::AtLeast(1))
+        .WillRepeatedly(::testing::ReturnArg<2>());
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(_, _, _))
+        .Times(::testing::AnyNumber())
+        .WillRepeatedly(::testing::Invoke(ReadFromSocket));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(_))
+        .Times(::testing::AtLeast(2))
+        .WillRepeatedly(Return(0));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_set_echo_interval(10));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_init(0));
+
+    for (int i = 0; i < 200 && !reconnected; i++)
+    {
+        usleep(10000);
+    }
+    EXPECT_TRUE(reconnected);
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_get_echo_stats(&stats));
+    EXPECT_LE((unsigned int)OVSDB_ECHO_MAX_MISSED, stats.missed);
+    EXPECT_EQ(0u, stats.received);
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_deinit());
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_set_echo_interval(OVSDB_ECHO_INTERVAL_MSECS));
+}
+
+TEST_F(OvsDbApiTestFixture, ovsdb_api_answers_server_echo)
+{
+    const int sock_fd = m_sockFds[0];
+    const std::string echoReq = "{\"id\":\"echo\",\"method\":\"echo\",\"params\":[]}";
+    const std::string echoReply = "{\"id\":\"echo\",\"result\":[],\"error\":null}";
+    std::atomic<bool> answered(false);
+
+    ExpectSessions(sock_fd);
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(sock_fd, StrEq(echoReply.c_str()), echoReply.length()))
+        .WillOnce(::testing::DoAll(
+            ::testing::Assign(&answered, true),
+            Return(echoReply.length())));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(sock_fd, _, _))
+        .Times(::testing::AnyNumber())
+        .WillRepeatedly(::testing::Invoke(ReadFromSocket));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(sock_fd))
+        .WillOnce(Return(0));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_init(0));
+    SendMessage(echoReq);
+
+    for (int i = 0; i < 200 && !answered; i++)
+    {
+        usleep(10000);
+    }
+    EXPECT_TRUE(answered);
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_deinit());
+}
+
+TEST_F(OvsDbApiTestFixture, ovsdb_ctx_independent_contexts)
+{
+    int monFds[2];
+    int sockFds[2];
+    struct Feedback feedback = {OVS_SUCCESS_STATUS, "f7d3d0e6-4ce7-4164-9134-0b5af9ce1b86"};
+    const std::string insertReq =
+        "{\"method\":\"transact\",\"id\":\"7\",\"params\":[\"Open_vSwitch\",{\"op\":\"insert\",\"table\":\"Feedback\",\"row\":{\"req_uuid\":\"f7d3d0e6-4ce7-4164-9134-0b5af9ce1b86\",\"status\":0}}]}";
+    // both contexts use request id "7", each response must reach its own context
+    const std::string respA = "{\"id\":\"7\",\"result\":[{\"uuid\":[\"uuid\",\"a2381729-42ac-40a8-aa39-50d6d7805f2b\"]}],\"error\":null}";
+    const std::string respB = "{\"id\":\"7\",\"result\":[{\"uuid\":[\"uuid\",\"b2381729-42ac-40a8-aa39-50d6d7805f2b\"]}],\"error\":null}";
+
+    Rdkb_Table_Config tableConfig;
+    tableConfig.table.id = OVS_FEEDBACK_TABLE;
+    tableConfig.config = &feedback;
+
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, monFds));
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, sockFds));
+
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_connect())
+        .Times(4)
+        .WillOnce(Return(m_monFds[0]))
+        .WillOnce(Return(m_sockFds[0]))
+        .WillOnce(Return(monFds[0]))
+        .WillOnce(Return(sockFds[0]));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(m_sockFds[0], StrEq(insertReq.c_str()), insertReq.length()))
+        .WillOnce(Return(insertReq.length()));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(sockFds[0], StrEq(insertReq.c_str()), insertReq.length()))
+        .WillOnce(Return(insertReq.length()));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(_, _, _))
+        .Times(::testing::AnyNumber())
+        .WillRepeatedly(::testing::Invoke(ReadFromSocket));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(_))
+        .Times(4)
+        .WillRepeatedly(Return(0));
+
+    EXPECT_CALL(*g_ovsDbReceiptCallbackMock,
+            OvsDbReceiptCallback(StrEq("7"), OVSDB_INSERT_RECEIPT_ID, StrEq("a2381729-42ac-40a8-aa39-50d6d7805f2b")))
+        .Times(1);
+    EXPECT_CALL(*g_ovsDbReceiptCallbackMock,
+            OvsDbReceiptCallback(StrEq("7"), OVSDB_INSERT_RECEIPT_ID, StrEq("b2381729-42ac-40a8-aa39-50d6d7805f2b")))
+        .Times(1);
+
+    ovsdb_ctx * ctxA = ovsdb_ctx_create(0);
+    ASSERT_TRUE(ctxA != NULL);
+    ovsdb_ctx * ctxB = ovsdb_ctx_create(100);
+    ASSERT_TRUE(ctxB != NULL);
+    EXPECT_EQ(1u, ovsdb_ctx_id_generate(ctxA));
+    EXPECT_EQ(101u, ovsdb_ctx_id_generate(ctxB));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_ctx_write(ctxA, "7", &tableConfig, OvsDbReceiptCallback));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_ctx_write(ctxB, "7", &tableConfig, OvsDbReceiptCallback));
+
+    ASSERT_EQ((ssize_t)respB.size(), send(sockFds[1], respB.c_str(), respB.size(), 0));
+    g_ovsDbReceiptCallbackMock->wait(500);
+    SendMessage(respA);
+    g_ovsDbReceiptCallbackMock->wait(500);
+
+    EXPECT_EQ(OVS_SUCCESS_STATUS, ovsdb_ctx_destroy(ctxA));
+    EXPECT_EQ(OVS_SUCCESS_STATUS, ovsdb_ctx_destroy(ctxB));
+    close(monFds[0]);
+    close(monFds[1]);
+    close(sockFds[0]);
+    close(sockFds[1]);
+}
+
+TEST_F(OvsDbApiTestFixture, ovsdb_api_monitor_cond_and_change)
+{
+    char monitorId[MAX_UUID_LEN + 1] = { 0 };
+    const OvsDb_Condition pending[] = {
+        {"req_uuid", OVSDB_COND_EQ, "f7d3d0e6-4ce7-4164-9134-0b5af9ce1b86", 0}
+    };
+    const std::string monitorReq =
+        "{\"method\":\"monitor_cond\",\"params\":[\"Open_vSwitch\",\"1\",{\"Feedback\":"
+        "[{\"where\":[false]}]}],\"id\":\"2\"}";
+    const std::string changeReq =
+        "{\"method\":\"monitor_cond_change\",\"params\":[\"1\",\"1\",{\"Feedback\":"
+        "[{\"where\":[[\"req_uuid\",\"==\",\"f7d3d0e6-4ce7-4164-9134-0b5af9ce1b86\"]]}]}],\"id\":\"3\"}";
+
+    ExpectSessions(m_sockFds[0]);
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(m_monFds[0], StrEq(monitorReq.c_str()), monitorReq.length()))
+        .WillOnce(Return(monitorReq.length()));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(m_monFds[0], StrEq(changeReq.c_str()), changeReq.length()))
+        .WillOnce(Return(changeReq.length()));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(_, _, _))
+        .Times(::testing::AnyNumber())
+        .WillRepeatedly(::testing::Invoke(ReadFromSocket));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(m_sockFds[0]))
+        .WillOnce(Return(0));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_init(0));
+    // nothing is pending yet, the monitor starts out matching no row
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_monitor_cond(OVS_FEEDBACK_TABLE, NULL, pending, 0,
+        OvsDbMonitorCallback, NULL, monitorId));
+    EXPECT_STREQ("1", monitorId);
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_monitor_cond_change(monitorId, pending, 1, NULL));
+
+    // clauses are checked against the monitored table
+    const OvsDb_Condition wrong = {"if_name", OVSDB_COND_EQ, "br0", 0};
+    EXPECT_EQ(OVS_FAILED_STATUS, ovsdb_monitor_cond_change(monitorId, &wrong, 1, NULL));
+    EXPECT_EQ(OVS_FAILED_STATUS, ovsdb_monitor_cond_change("42", pending, 1, NULL));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_deinit());
+}
+
+namespace {
+    std::atomic<int> g_sinceRows(0);
+    std::atomic<int> g_sinceReceipts(0);
+    OvsDb_Monitor_Receipt g_sinceReceipt;
+
+    void SinceMonitorCallback(OVS_STATUS status, Rdkb_Table_Config * table_config)
+    {
+        g_sinceRows++;
+    }
+
+    void SinceReceiptCallback(const char * rID, const OvsDb_Base_Receipt * receipt)
+    {
+        g_sinceReceipt = *(const OvsDb_Monitor_Receipt *)receipt;
+        g_sinceReceipts++;
+    }
+
+    std::string ReadStateFile(const std::string& path)
+    {
+        char line[64] = { 0 };
+        FILE * file = fopen(path.c_str(), "r");
+
+        if (!file)
+        {
+            return "";
+        }
+        if (!fgets(line, sizeof(line), file))
+        {
+            line[0] = '\0';
+        }
+        fclose(file);
+        return line;
+    }
+}
+
+TEST_F(OvsDbApiTestFixture, ovsdb_api_monitor_resumes_from_state_file)
+{
+    const std::string statePath = "/tmp/OvsDbApiTest_txn_" + std::to_string(getpid());
+    // only sees inserts, it has no rows to lose and resumes right away
+    const OvsDb_Monitor_Select inserts = { NULL, 0, OVSDB_SELECT_INSERT };
+    // the monitor's id "1" doubles as the request id so the reply reaches it
+    const std::string sinceReq =
+        "{\"method\":\"monitor_cond_since\",\"params\":[\"Open_vSwitch\",\"1\",{\"Feedback\":"
+        "[{\"select\":{\"initial\":false,\"insert\":true,\"delete\":false,\"modify\":false},"
+        "\"where\":[true]}]},\"8c2f5c0e-3c3e-4e0b-9f43-6f0b6c1b2a10\"],\"id\":\"1\"}";
+    // a row inserted while the agent was away
+    const std::string sinceResp =
+        "{\"id\":\"1\",\"result\":[true,\"1b7d4f5c-0f6d-4a51-8f32-0d5f4a6b9e21\",{\"Feedback\":{"
+        "\"570e2da2-2adb-4dd7-bc2d-944d065c53c0\":{\"insert\":{\"req_uuid\":\"f7d3d0e6-4ce7-4164-9134-0b5af9ce1b86\",\"status\":0}}}}],"
+        "\"error\":null}";
+    const std::string update3 =
+        "{\"id\":null,\"method\":\"update3\",\"params\":[\"1\",\"e9a1c3d4-7b2f-4c6e-a0d8-3f5e7b9c1a42\",{\"Feedback\":{"
+        "\"3c55d061-0942-4470-a99e-d37b0f243e4c\":{\"insert\":{\"req_uuid\":\"18ca5061-c9ef-42dc-9579-f9e3167a1ae7\",\"status\":1}}}}]}";
+    FILE * state = fopen(statePath.c_str(), "w");
+
+    ASSERT_TRUE(state != NULL);
+    fputs("8c2f5c0e-3c3e-4e0b-9f43-6f0b6c1b2a10\n", state);
+    fclose(state);
+    g_sinceRows = 0;
+    g_sinceReceipts = 0;
+
+    ExpectSessions(m_sockFds[0]);
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(m_monFds[0], StrEq(sinceReq.c_str()), sinceReq.length()))
+        .WillOnce(Return(sinceReq.length()));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(_, _, _))
+        .Times(::testing::AnyNumber())
+        .WillRepeatedly(::testing::Invoke(ReadFromSocket));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(m_sockFds[0]))
+        .WillOnce(Return(0));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_set_state_file(statePath.c_str()));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_init(0));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_monitor_select(OVS_FEEDBACK_TABLE, &inserts,
+        SinceMonitorCallback, SinceReceiptCallback));
+
+    ASSERT_EQ((ssize_t)sinceResp.size(), send(m_monFds[1], sinceResp.c_str(), sinceResp.size(), 0));
+    for (int i = 0; i < 200 && g_sinceReceipts == 0; i++)
+    {
+        usleep(10000);
+    }
+    ASSERT_EQ(1, g_sinceReceipts);
+    EXPECT_EQ(OVSDB_MONITOR_COND_SINCE_RECEIPT_ID, g_sinceReceipt.receipt_id);
+    EXPECT_TRUE(g_sinceReceipt.resumed);
+    EXPECT_EQ(1, g_sinceReceipt.update_count);
+    EXPECT_EQ(1, g_sinceRows);
+    // written a moment later, off the path of the replies
+    for (int i = 0; i < 300 && ReadStateFile(statePath) == "8c2f5c0e-3c3e-4e0b-9f43-6f0b6c1b2a10\n"; i++)
+    {
+        usleep(10000);
+    }
+    EXPECT_EQ("1b7d4f5c-0f6d-4a51-8f32-0d5f4a6b9e21\n", ReadStateFile(statePath));
+
+    ASSERT_EQ((ssize_t)update3.size(), send(m_monFds[1], update3.c_str(), update3.size(), 0));
+    for (int i = 0; i < 200 && g_sinceRows < 2; i++)
+    {
+        usleep(10000);
+    }
+    EXPECT_EQ(2, g_sinceRows);
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_deinit());
+    // written at the latest when the context is destroyed
+    EXPECT_EQ("e9a1c3d4-7b2f-4c6e-a0d8-3f5e7b9c1a42\n", ReadStateFile(statePath));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_set_state_file(NULL));
+    unlink(statePath.c_str());
+}
+
+namespace {
+    std::mutex g_restartMutex;
+    std::vector<Gateway_Config> g_restartRows;
+
+    void RestartMonitorCallback(OVS_STATUS status, Rdkb_Table_Config * table_config)
+    {
+        std::lock_guard<std::mutex> lock(g_restartMutex);
+        g_restartRows.push_back(*(Gateway_Config *)table_config->config);
+    }
+
+    size_t RestartRows()
+    {
+        std::lock_guard<std::mutex> lock(g_restartMutex);
+        return g_restartRows.size();
+    }
+}
+
+TEST_F(OvsDbApiTestFixture, ovsdb_api_monitor_restarts_with_rows_to_cache)
+{
+    const std::string statePath = "/tmp/OvsDbApiTest_txn_" + std::to_string(getpid());
+    // its rows are cached, the cache of a new process starts empty
+    const std::string sinceReq =
+        "{\"method\":\"monitor_cond_since\",\"params\":[\"Open_vSwitch\",\"1\",{\"Gateway_Config\":"
+        "[{\"where\":[true]}],\"Feedback\":[{\"where\":[false]}]},"
+        "\"00000000-0000-0000-0000-000000000000\"],\"id\":\"1\"}";
+    const std::string sinceResp =
+        "{\"id\":\"1\",\"result\":[false,\"1b7d4f5c-0f6d-4a51-8f32-0d5f4a6b9e21\",{\"Gateway_Config\":{"
+        "\"2d1e6a3c-7e1b-4b40-9a55-2b0a4c5d9e11\":{\"initial\":{\"if_name\":\"brlan0\",\"mtu\":1500}}}}],"
+        "\"error\":null}";
+    // a row that existed before the restart
+    const std::string update3 =
+        "{\"id\":null,\"method\":\"update3\",\"params\":[\"1\",\"e9a1c3d4-7b2f-4c6e-a0d8-3f5e7b9c1a42\",{\"Gateway_Config\":{"
+        "\"2d1e6a3c-7e1b-4b40-9a55-2b0a4c5d9e11\":{\"modify\":{\"mtu\":1480}}}}]}";
+    FILE * state = fopen(statePath.c_str(), "w");
+
+    ASSERT_TRUE(state != NULL);
+    fputs("8c2f5c0e-3c3e-4e0b-9f43-6f0b6c1b2a10\n", state);
+    fclose(state);
+    g_restartRows.clear();
+    g_sinceReceipts = 0;
+
+    ExpectSessions(m_sockFds[0]);
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(m_monFds[0], StrEq(sinceReq.c_str()), sinceReq.length()))
+        .WillOnce(Return(sinceReq.length()));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(_, _, _))
+        .Times(::testing::AnyNumber())
+        .WillRepeatedly(::testing::Invoke(ReadFromSocket));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(m_sockFds[0]))
+        .WillOnce(Return(0));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_set_state_file(statePath.c_str()));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_init(0));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_monitor(OVS_GW_CONFIG_TABLE, RestartMonitorCallback,
+        SinceReceiptCallback));
+
+    ASSERT_EQ((ssize_t)sinceResp.size(), send(m_monFds[1], sinceResp.c_str(), sinceResp.size(), 0));
+    for (int i = 0; i < 200 && g_sinceReceipts == 0; i++)
+    {
+        usleep(10000);
+    }
+    ASSERT_EQ(1, g_sinceReceipts);
+    EXPECT_FALSE(g_sinceReceipt.resumed);
+    EXPECT_EQ(1, g_sinceReceipt.update_count);
+    EXPECT_EQ(0u, RestartRows());
+
+    ASSERT_EQ((ssize_t)update3.size(), send(m_monFds[1], update3.c_str(), update3.size(), 0));
+    for (int i = 0; i < 200 && RestartRows() == 0; i++)
+    {
+        usleep(10000);
+    }
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_deinit());
+
+    ASSERT_EQ(1u, g_restartRows.size());
+    EXPECT_STREQ("brlan0", g_restartRows[0].if_name);
+    EXPECT_EQ(1480, g_restartRows[0].mtu);
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_set_state_file(NULL));
+    unlink(statePath.c_str());
+}
+
+TEST_F(OvsDbApiTestFixture, ovsdb_api_monitor_without_monitor_cond_since)
+{
+    const std::string statePath = "/tmp/OvsDbApiTest_txn_" + std::to_string(getpid());
+    // an ovsdb-server release without monitor_cond_since
+    const std::string sinceResp =
+        "{\"id\":\"1\",\"result\":null,\"error\":\"unknown method\"}";
+    const std::string update2 =
+        "{\"id\":null,\"method\":\"update2\",\"params\":[\"1\",{\"Feedback\":{"
+        "\"3c55d061-0942-4470-a99e-d37b0f243e4c\":{\"insert\":{\"req_uuid\":\"18ca5061-c9ef-42dc-9579-f9e3167a1ae7\",\"status\":1}}}}]}";
+    std::atomic<bool> reissued(false);
+    FILE * state = fopen(statePath.c_str(), "w");
+
+    ASSERT_TRUE(state != NULL);
+    fputs("8c2f5c0e-3c3e-4e0b-9f43-6f0b6c1b2a10\n", state);
+    fclose(state);
+    g_sinceRows = 0;
+    g_sinceReceipts = 0;
+
+    ExpectSessions(m_sockFds[0]);
+    {
+        ::testing::InSequence seq;
+        EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(m_monFds[0], HasSubstr("\"method\":\"monitor_cond_since\""), _))
+            .WillOnce(::testing::ReturnArg<2>());
+        // re-issued as the monitor_cond it is without a state file
+        EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(m_monFds[0],
+                HasSubstr("{\"method\":\"monitor_cond\",\"params\":[\"Open_vSwitch\",\"1\","), _))
+            .WillOnce(::testing::DoAll(
+                ::testing::Assign(&reissued, true),
+                ::testing::ReturnArg<2>()));
+    }
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(_, _, _))
+        .Times(::testing::AnyNumber())
+        .WillRepeatedly(::testing::Invoke(ReadFromSocket));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(m_sockFds[0]))
+        .WillOnce(Return(0));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_set_state_file(statePath.c_str()));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_init(0));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_monitor(OVS_FEEDBACK_TABLE, SinceMonitorCallback,
+        SinceReceiptCallback));
+
+    ASSERT_EQ((ssize_t)sinceResp.size(), send(m_monFds[1], sinceResp.c_str(), sinceResp.size(), 0));
+    for (int i = 0; i < 200 && !reissued; i++)
+    {
+        usleep(10000);
+    }
+    EXPECT_TRUE(reissued);
+    ASSERT_EQ(1, g_sinceReceipts);
+    EXPECT_EQ(OVSDB_MONITOR_COND_SINCE_RECEIPT_ID, g_sinceReceipt.receipt_id);
+    EXPECT_EQ(OVS_FAILED_STATUS, g_sinceReceipt.status);
+    EXPECT_STREQ("unknown method", g_sinceReceipt.error);
+    EXPECT_FALSE(g_sinceReceipt.resumed);
+
+    // the monitor keeps its id and callback
+    ASSERT_EQ((ssize_t)update2.size(), send(m_monFds[1], update2.c_str(), update2.size(), 0));
+    for (int i = 0; i < 200 && g_sinceRows == 0; i++)
+    {
+        usleep(10000);
+    }
+    EXPECT_EQ(1, g_sinceRows);
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_deinit());
+    EXPECT_EQ("8c2f5c0e-3c3e-4e0b-9f43-6f0b6c1b2a10\n", ReadStateFile(statePath));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_set_state_file(NULL));
+    unlink(statePath.c_str());
+}
+
+namespace {
+    std::mutex g_rowsMutex;
+    std::vector<OvsDb_Row_Update> g_rowUpdates;
+    std::vector<Feedback> g_rowContents;
+    std::atomic<int> g_rowReceipts(0);
+
+    void RowCallback(const OvsDb_Row_Update * update)
+    {
+        std::lock_guard<std::mutex> lock(g_rowsMutex);
+        g_rowUpdates.push_back(*update);
+        g_rowContents.push_back(*(Feedback *)update->table_config->config);
+    }
+
+    void RowReceiptCallback(const char * rID, const OvsDb_Base_Receipt * receipt)
+    {
+        g_rowReceipts++;
+    }
+
+    size_t RowUpdates()
+    {
+        std::lock_guard<std::mutex> lock(g_rowsMutex);
+        return g_rowUpdates.size();
+    }
+
+    void SelectMonitorCallback(OVS_STATUS status, Rdkb_Table_Config * table_config)
+    {
+        std::lock_guard<std::mutex> lock(g_rowsMutex);
+        g_rowContents.push_back(*(Feedback *)table_config->config);
+    }
+
+    size_t RowContents()
+    {
+        std::lock_guard<std::mutex> lock(g_rowsMutex);
+        return g_rowContents.size();
+    }
+}
+
+TEST_F(OvsDbApiTestFixture, ovsdb_api_monitor_select_caches_rows_for_deltas)
+{
+    const std::string statePath = "/tmp/OvsDbApiTest_txn_" + std::to_string(getpid());
+    // as the agent watches Feedback, it needs the rows its modify deltas apply to
+    const char * const columns[] = { "req_uuid", "status" };
+    const OvsDb_Monitor_Select select = { columns, 2,
+        OVSDB_SELECT_INSERT | OVSDB_SELECT_MODIFY };
+    const std::string sinceReq =
+        "{\"method\":\"monitor_cond_since\",\"params\":[\"Open_vSwitch\",\"1\",{\"Feedback\":"
+        "[{\"columns\":[\"req_uuid\",\"status\"],\"where\":[true]}]},"
+        "\"00000000-0000-0000-0000-000000000000\"],\"id\":\"1\"}";
+    const std::string sinceResp =
+        "{\"id\":\"1\",\"result\":[false,\"1b7d4f5c-0f6d-4a51-8f32-0d5f4a6b9e21\",{\"Feedback\":{"
+        "\"570e2da2-2adb-4dd7-bc2d-944d065c53c0\":{\"initial\":{\"req_uuid\":\"a\",\"status\":0}}}}],"
+        "\"error\":null}";
+    // the delete only keeps the cache up to date
+    const std::string update3 =
+        "{\"id\":null,\"method\":\"update3\",\"params\":[\"1\",\"e9a1c3d4-7b2f-4c6e-a0d8-3f5e7b9c1a42\",{\"Feedback\":{"
+        "\"570e2da2-2adb-4dd7-bc2d-944d065c53c0\":{\"modify\":{\"status\":2}}}}]}"
+        "{\"id\":null,\"method\":\"update3\",\"params\":[\"1\",\"5f0c2b8e-9d14-4a7b-b6e3-1c2d3e4f5a6b\",{\"Feedback\":{"
+        "\"570e2da2-2adb-4dd7-bc2d-944d065c53c0\":{\"delete\":null}}}]}";
+
+    g_rowContents.clear();
+    g_sinceReceipts = 0;
+    ExpectSessions(m_sockFds[0]);
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(m_monFds[0], StrEq(sinceReq.c_str()), sinceReq.length()))
+        .WillOnce(Return(sinceReq.length()));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(_, _, _))
+        .Times(::testing::AnyNumber())
+        .WillRepeatedly(::testing::Invoke(ReadFromSocket));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(m_sockFds[0]))
+        .WillOnce(Return(0));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_set_state_file(statePath.c_str()));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_init(0));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_monitor_select(OVS_FEEDBACK_TABLE, &select,
+        SelectMonitorCallback, SinceReceiptCallback));
+
+    ASSERT_EQ((ssize_t)sinceResp.size(), send(m_monFds[1], sinceResp.c_str(), sinceResp.size(), 0));
+    for (int i = 0; i < 200 && g_sinceReceipts == 0; i++)
+    {
+        usleep(10000);
+    }
+    ASSERT_EQ(1, g_sinceReceipts);
+    ASSERT_EQ((ssize_t)update3.size(), send(m_monFds[1], update3.c_str(), update3.size(), 0));
+    for (int i = 0; i < 300 && ReadStateFile(statePath) != "5f0c2b8e-9d14-4a7b-b6e3-1c2d3e4f5a6b\n"; i++)
+    {
+        usleep(10000);
+    }
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_deinit());
+
+    ASSERT_EQ(1u, g_rowContents.size());
+    EXPECT_STREQ("a", g_rowContents[0].req_uuid);
+    EXPECT_EQ(OVS_FAILED_STATUS, g_rowContents[0].status);
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_set_state_file(NULL));
+    unlink(statePath.c_str());
+}
+
+TEST_F(OvsDbApiTestFixture, ovsdb_api_monitor_resyncs_when_a_row_is_not_cached)
+{
+    const OvsDb_Condition where[] = { {"req_uuid", OVSDB_COND_NE, "x", 0} };
+    const std::string monitorReq =
+        "{\"method\":\"monitor_cond\",\"params\":[\"Open_vSwitch\",\"1\",{\"Feedback\":"
+        "[{\"where\":[[\"req_uuid\",\"!=\",\"x\"]]}]}],\"id\":\"2\"}";
+    const std::string monitorResp =
+        "{\"id\":\"2\",\"result\":{\"Feedback\":{\"570e2da2-2adb-4dd7-bc2d-944d065c53c0\":"
+        "{\"initial\":{\"req_uuid\":\"a\",\"status\":0}}}},\"error\":null}";
+    // a modify of a row the monitor was never sent
+    const std::string update2 =
+        "{\"id\":null,\"method\":\"update2\",\"params\":[\"1\",{\"Feedback\":{"
+        "\"2d1e6a3c-7e1b-4b40-9a55-2b0a4c5d9e11\":{\"modify\":{\"status\":2}}}}]}";
+    // the monitor is cancelled and set up again under its id
+    const std::string cancelReq =
+        "{\"method\":\"monitor_cancel\",\"params\":[\"1\"],\"id\":\"3\"}";
+    const std::string resyncReq =
+        "{\"method\":\"monitor_cond\",\"params\":[\"Open_vSwitch\",\"1\",{\"Feedback\":"
+        "[{\"where\":[[\"req_uuid\",\"!=\",\"x\"]]}]}],\"id\":\"4\"}";
+    const std::string resyncResp =
+        "{\"id\":\"3\",\"result\":{},\"error\":null}"
+        "{\"id\":\"4\",\"result\":{\"Feedback\":{"
+        "\"570e2da2-2adb-4dd7-bc2d-944d065c53c0\":{\"initial\":{\"req_uuid\":\"a\",\"status\":2}},"
+        "\"2d1e6a3c-7e1b-4b40-9a55-2b0a4c5d9e11\":{\"initial\":{\"req_uuid\":\"b\",\"status\":2}}}},"
+        "\"error\":null}";
+    std::atomic<bool> resynced(false);
+
+    g_rowContents.clear();
+    ExpectSessions(m_sockFds[0]);
+    {
+        ::testing::InSequence seq;
+        EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(m_monFds[0], StrEq(monitorReq.c_str()), monitorReq.length()))
+            .WillOnce(Return(monitorReq.length()));
+        EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(m_monFds[0], StrEq(cancelReq.c_str()), cancelReq.length()))
+            .WillOnce(Return(cancelReq.length()));
+        EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(m_monFds[0], StrEq(resyncReq.c_str()), resyncReq.length()))
+            .WillOnce(::testing::DoAll(
+                ::testing::Assign(&resynced, true),
+                Return(resyncReq.length())));
+    }
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(_, _, _))
+        .Times(::testing::AnyNumber())
+        .WillRepeatedly(::testing::Invoke(ReadFromSocket));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(m_sockFds[0]))
+        .WillOnce(Return(0));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_init(0));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_monitor_cond(OVS_FEEDBACK_TABLE, NULL, where, 1,
+        SelectMonitorCallback, NULL, NULL));
+
+    ASSERT_EQ((ssize_t)monitorResp.size(), send(m_monFds[1], monitorResp.c_str(), monitorResp.size(), 0));
+    ASSERT_EQ((ssize_t)update2.size(), send(m_monFds[1], update2.c_str(), update2.size(), 0));
+    for (int i = 0; i < 200 && !resynced; i++)
+    {
+        usleep(10000);
+    }
+    ASSERT_TRUE(resynced);
+    EXPECT_EQ(0u, RowContents());
+
+    // the rows that changed meanwhile reach the callback in full
+    ASSERT_EQ((ssize_t)resyncResp.size(), send(m_monFds[1], resyncResp.c_str(), resyncResp.size(), 0));
+    for (int i = 0; i < 200 && RowContents() < 2; i++)
+    {
+        usleep(10000);
+    }
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_deinit());
+
+    ASSERT_EQ(2u, g_rowContents.size());
+    EXPECT_STREQ("a", g_rowContents[0].req_uuid);
+    EXPECT_EQ(OVS_FAILED_STATUS, g_rowContents[0].status);
+    EXPECT_STREQ("b", g_rowContents[1].req_uuid);
+    EXPECT_EQ(OVS_FAILED_STATUS, g_rowContents[1].status);
+}
+
+TEST_F(OvsDbApiTestFixture, ovsdb_api_monitor_rows_applies_update2_deltas)
+{
+    char monitorId[MAX_UUID_LEN + 1] = { 0 };
+    const std::string monitorReq =
+        "{\"method\":\"monitor_cond\",\"params\":[\"Open_vSwitch\",\"1\",{\"Feedback\":"
+        "[{\"where\":[true]}]}],\"id\":\"2\"}";
+    const std::string monitorResp =
+        "{\"id\":\"2\",\"result\":{\"Feedback\":{\"570e2da2-2adb-4dd7-bc2d-944d065c53c0\":"
+        "{\"initial\":{\"req_uuid\":\"f7d3d0e6-4ce7-4164-9134-0b5af9ce1b86\",\"status\":0}}}},"
+        "\"error\":null}";
+    // only the changed column is sent, then the row is deleted
+    const std::string update2 =
+        "{\"id\":null,\"method\":\"update2\",\"params\":[\"1\",{\"Feedback\":{"
+        "\"570e2da2-2adb-4dd7-bc2d-944d065c53c0\":{\"modify\":{\"status\":2}}}}]}"
+        "{\"id\":null,\"method\":\"update2\",\"params\":[\"1\",{\"Feedback\":{"
+        "\"570e2da2-2adb-4dd7-bc2d-944d065c53c0\":{\"delete\":null}}}]}";
+
+    g_rowUpdates.clear();
+    g_rowContents.clear();
+    g_rowReceipts = 0;
+    ExpectSessions(m_sockFds[0]);
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(m_monFds[0], StrEq(monitorReq.c_str()), monitorReq.length()))
+        .WillOnce(Return(monitorReq.length()));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(_, _, _))
+        .Times(::testing::AnyNumber())
+        .WillRepeatedly(::testing::Invoke(ReadFromSocket));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(m_sockFds[0]))
+        .WillOnce(Return(0));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_init(0));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_monitor_rows(OVS_FEEDBACK_TABLE, NULL, NULL, 0,
+        RowCallback, RowReceiptCallback, monitorId));
+    EXPECT_STREQ("1", monitorId);
+
+    ASSERT_EQ((ssize_t)monitorResp.size(), send(m_monFds[1], monitorResp.c_str(), monitorResp.size(), 0));
+    for (int i = 0; i < 200 && g_rowReceipts == 0; i++)
+    {
+        usleep(10000);
+    }
+    ASSERT_EQ(1, g_rowReceipts);
+    ASSERT_EQ((ssize_t)update2.size(), send(m_monFds[1], update2.c_str(), update2.size(), 0));
+    for (int i = 0; i < 200 && RowUpdates() < 3; i++)
+    {
+        usleep(10000);
+    }
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_deinit());
+
+    ASSERT_EQ(3u, g_rowUpdates.size());
+    EXPECT_EQ(OVSDB_SELECT_INITIAL, g_rowUpdates[0].type);
+    EXPECT_EQ(OVS_SUCCESS_STATUS, g_rowContents[0].status);
+    EXPECT_EQ(OVSDB_SELECT_MODIFY, g_rowUpdates[1].type);
+    EXPECT_EQ(ovsdb_column_mask(OVS_FEEDBACK_TABLE, "status"), g_rowUpdates[1].changed);
+    EXPECT_STREQ("f7d3d0e6-4ce7-4164-9134-0b5af9ce1b86", g_rowContents[1].req_uuid);
+    EXPECT_EQ(OVS_FAILED_STATUS, g_rowContents[1].status);
+    EXPECT_EQ(OVSDB_SELECT_DELETE, g_rowUpdates[2].type);
+    EXPECT_STREQ("f7d3d0e6-4ce7-4164-9134-0b5af9ce1b86", g_rowContents[2].req_uuid);
+    EXPECT_EQ(0u, ovsdb_column_mask(OVS_FEEDBACK_TABLE, "if_name"));
+}
+
+namespace {
+    std::vector<size_t> g_batchSizes;
+
+    void BatchCallback(const OvsDb_Row_Update * updates, size_t count)
+    {
+        std::lock_guard<std::mutex> lock(g_rowsMutex);
+        g_batchSizes.push_back(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            g_rowUpdates.push_back(updates[i]);
+            g_rowContents.push_back(*(Feedback *)updates[i].table_config->config);
+        }
+    }
+}
+
+TEST_F(OvsDbApiTestFixture, ovsdb_api_monitor_batch_delivers_each_update_at_once)
+{
+    const std::string monitorReq =
+        "{\"method\":\"monitor_cond\",\"params\":[\"Open_vSwitch\",\"1\",{\"Feedback\":"
+        "[{\"where\":[true]}]}],\"id\":\"2\"}";
+    const std::string monitorResp =
+        "{\"id\":\"2\",\"result\":{\"Feedback\":{"
+        "\"570e2da2-2adb-4dd7-bc2d-944d065c53c0\":{\"initial\":{\"req_uuid\":\"a\",\"status\":0}},"
+        "\"2d1e6a3c-7e1b-4b40-9a55-2b0a4c5d9e11\":{\"initial\":{\"req_uuid\":\"b\",\"status\":0}}}},"
+        "\"error\":null}";
+    const std::string update2 =
+        "{\"id\":null,\"method\":\"update2\",\"params\":[\"1\",{\"Feedback\":{"
+        "\"570e2da2-2adb-4dd7-bc2d-944d065c53c0\":{\"modify\":{\"status\":2}},"
+        "\"2d1e6a3c-7e1b-4b40-9a55-2b0a4c5d9e11\":{\"delete\":null},"
+        "\"8b9f0d47-51c2-4f2e-a3b6-6c7d8e9f0a1b\":{\"insert\":{\"req_uuid\":\"c\",\"status\":0}}}}]}";
+
+    g_rowUpdates.clear();
+    g_rowContents.clear();
+    g_batchSizes.clear();
+    g_rowReceipts = 0;
+    ExpectSessions(m_sockFds[0]);
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(m_monFds[0], StrEq(monitorReq.c_str()), monitorReq.length()))
+        .WillOnce(Return(monitorReq.length()));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(_, _, _))
+        .Times(::testing::AnyNumber())
+        .WillRepeatedly(::testing::Invoke(ReadFromSocket));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(m_sockFds[0]))
+        .WillOnce(Return(0));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_init(0));
+    ASSERT_EQ(OVS_FAILED_STATUS, ovsdb_monitor_batch(OVS_FEEDBACK_TABLE, NULL, NULL, 0,
+        NULL, RowReceiptCallback, NULL));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_monitor_batch(OVS_FEEDBACK_TABLE, NULL, NULL, 0,
+        BatchCallback, RowReceiptCallback, NULL));
+
+    ASSERT_EQ((ssize_t)monitorResp.size(), send(m_monFds[1], monitorResp.c_str(), monitorResp.size(), 0));
+    for (int i = 0; i < 200 && g_rowReceipts == 0; i++)
+    {
+        usleep(10000);
+    }
+    ASSERT_EQ(1, g_rowReceipts);
+    ASSERT_EQ((ssize_t)update2.size(), send(m_monFds[1], update2.c_str(), update2.size(), 0));
+    for (int i = 0; i < 200 && RowUpdates() < 5; i++)
+    {
+        usleep(10000);
+    }
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_deinit());
+
+    ASSERT_EQ(2u, g_batchSizes.size());
+    EXPECT_EQ(2u, g_batchSizes[0]);
+    EXPECT_EQ(3u, g_batchSizes[1]);
+    ASSERT_EQ(5u, g_rowUpdates.size());
+    EXPECT_EQ(OVSDB_SELECT_INITIAL, g_rowUpdates[0].type);
+    EXPECT_EQ(OVSDB_SELECT_INITIAL, g_rowUpdates[1].type);
+    EXPECT_EQ(OVSDB_SELECT_MODIFY, g_rowUpdates[2].type);
+    EXPECT_STREQ("a", g_rowContents[2].req_uuid);
+    EXPECT_EQ(OVS_FAILED_STATUS, g_rowContents[2].status);
+    EXPECT_EQ(OVSDB_SELECT_DELETE, g_rowUpdates[3].type);
+    EXPECT_STREQ("b", g_rowContents[3].req_uuid);
+    EXPECT_EQ(OVSDB_SELECT_INSERT, g_rowUpdates[4].type);
+    EXPECT_STREQ("c", g_rowContents[4].req_uuid);
+}
+
+namespace {
+    std::atomic<int> g_sessionFeedbackRows(0);
+    std::atomic<int> g_sessionGatewayRows(0);
+
+    void SessionMonitorCallback(OVS_STATUS status, Rdkb_Table_Config * table_config)
+    {
+        if (table_config->table.id == OVS_FEEDBACK_TABLE)
+        {
+            g_sessionFeedbackRows++;
+        }
+        else if (table_config->table.id == OVS_GW_CONFIG_TABLE)
+        {
+            g_sessionGatewayRows++;
+        }
+    }
+}
+
+TEST_F(OvsDbApiTestFixture, ovsdb_api_monitors_share_session_monitor)
+{
+    const std::string monitorReq =
+        "{\"method\":\"monitor_cond\",\"params\":[\"Open_vSwitch\",\"1\",{\"Gateway_Config\":"
+        "[{\"where\":[false]}],\"Feedback\":[{\"where\":[true]}]}],\"id\":\"2\"}";
+    // the next table is added to the same monitor
+    const std::string changeReq =
+        "{\"method\":\"monitor_cond_change\",\"params\":[\"1\",\"1\",{\"Gateway_Config\":"
+        "[{\"where\":[true]}]}],\"id\":\"4\"}";
+    // a table that is already part of it gets a monitor of its own
+    const std::string ownReq =
+        "{\"method\":\"monitor\",\"params\":[\"Open_vSwitch\",\"6\",{\"Feedback\":{}}],\"id\":\"7\"}";
+    const std::string update2 =
+        "{\"id\":null,\"method\":\"update2\",\"params\":[\"1\",{\"Feedback\":{"
+        "\"570e2da2-2adb-4dd7-bc2d-944d065c53c0\":{\"insert\":{\"req_uuid\":\"a\",\"status\":0}}},"
+        "\"Gateway_Config\":{"
+        "\"2d1e6a3c-7e1b-4b40-9a55-2b0a4c5d9e11\":{\"insert\":{\"if_name\":\"brlan0\"}}}}]}";
+
+    g_sessionFeedbackRows = 0;
+    g_sessionGatewayRows = 0;
+    ExpectSessions(m_sockFds[0]);
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(m_monFds[0], StrEq(monitorReq.c_str()), monitorReq.length()))
+        .WillOnce(Return(monitorReq.length()));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(m_monFds[0], StrEq(changeReq.c_str()), changeReq.length()))
+        .WillOnce(Return(changeReq.length()));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(m_monFds[0], StrEq(ownReq.c_str()), ownReq.length()))
+        .WillOnce(Return(ownReq.length()));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(_, _, _))
+        .Times(::testing::AnyNumber())
+        .WillRepeatedly(::testing::Invoke(ReadFromSocket));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(m_sockFds[0]))
+        .WillOnce(Return(0));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_init(0));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_monitor(OVS_FEEDBACK_TABLE, SessionMonitorCallback, NULL));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_monitor(OVS_GW_CONFIG_TABLE, SessionMonitorCallback, NULL));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_monitor(OVS_FEEDBACK_TABLE, SessionMonitorCallback, NULL));
+
+    // one update of the session monitor, each row goes to the monitor of its table
+    ASSERT_EQ((ssize_t)update2.size(), send(m_monFds[1], update2.c_str(), update2.size(), 0));
+    for (int i = 0; i < 200 && (g_sessionFeedbackRows == 0 || g_sessionGatewayRows == 0); i++)
+    {
+        usleep(10000);
+    }
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_deinit());
+
+    EXPECT_EQ(1, g_sessionFeedbackRows);
+    EXPECT_EQ(1, g_sessionGatewayRows);
+}
+
+TEST_F(OvsDbApiTestFixture, ovsdb_api_write_times_out_without_response)
+{
+    static std::atomic<int> timedOut(0);
+    ovsdb_receipt_cb timeoutCallback = [](const char* rID, const OvsDb_Base_Receipt* receipt)
+    {
+        EXPECT_STREQ("1", rID);
+        EXPECT_EQ(OVSDB_INSERT_RECEIPT_ID, receipt->receipt_id);
+        EXPECT_EQ(OVS_TIMED_OUT_STATUS, receipt->status);
+        timedOut++;
+    };
+    const int sock_fd = m_sockFds[0];
+    struct Gateway_Config gatewayConfig = {
+        "Brlan0", "10.0.0.1", "255.255.255.0", "10.100.0.1", "10.0.100.1",
+        "Brlan0PIface", "Brlan0PBridge", 1480, 100, OVS_BRIDGE_IF_TYPE, OVS_IF_UP_CMD};
+    Rdkb_Table_Config tableConfig;
+    tableConfig.table.id = OVS_GW_CONFIG_TABLE;
+    tableConfig.config = &gatewayConfig;
+
+    ExpectSessions(sock_fd);
+
+    // ovsdb-server takes the request but never answers it
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(sock_fd, HasSubstr("\"method\":\"transact\""), _))
+        .Times(1)
+        .WillOnce(::testing::ReturnArg<2>());
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(_, _, _))
+        .Times(::testing::AnyNumber())
+        .WillRepeatedly(::testing::Invoke(ReadFromSocket));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(sock_fd))
+        .Times(1)
+        .WillOnce(Return(0));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_set_request_timeout(50));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_init(0));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_write("1", &tableConfig, timeoutCallback));
+
+    for (int i = 0; i < 100 && timedOut == 0; i++)
+    {
+        usleep(10000);
+    }
+    EXPECT_EQ(1, timedOut);
+
+    // a late response finds no receipt and is dropped
+    SendMessage("{\"id\":\"1\",\"result\":[{\"uuid\":[\"uuid\",\"f2381729-42ac-40a8-aa38-50d6d7805f2b\"]}],\"error\":null}");
+    usleep(20000);
+    EXPECT_EQ(1, timedOut);
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_deinit());
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_set_request_timeout(RECEIPT_LIST_TIMEOUT_MSECS));
+}
+
+TEST_F(OvsDbApiTestFixture, ovsdb_api_oversized_message_drops_connection)
+{
+    static std::atomic<int> failed(0);
+    static std::atomic<int> succeeded(0);
+    ovsdb_receipt_cb receiptCallback = [](const char* rID, const OvsDb_Base_Receipt* receipt)
+    {
+        EXPECT_STREQ("1", rID);
+        if (receipt->status == OVS_SUCCESS_STATUS)
+        {
+            succeeded++;
+        }
+        else
+        {
+            failed++;
+        }
+    };
+    const int sock_fd = m_sockFds[0];
+    // a reply larger than the framer may grow, followed by the reply to the write
+    const std::string head = "{\"id\":\"9\",\"result\":\"";
+    const std::string tail = "\"}{\"id\":\"1\",\"result\":[{\"uuid\":[\"uuid\",\"f2381729-42ac-40a8-aa38-50d6d7805f2b\"]}],\"error\":null}";
+    const size_t fill = OVSDB_FRAMER_MAX_SIZE + OVSDB_FRAMER_MIN_READ;
+    std::atomic<bool> reconnected(false);
+    size_t served = 0;
+    struct Feedback feedback = {OVS_SUCCESS_STATUS, "f7d3d0e6-4ce7-4164-9134-0b5af9ce1b86"};
+    Rdkb_Table_Config tableConfig;
+    tableConfig.table.id = OVS_FEEDBACK_TABLE;
+    tableConfig.config = &feedback;
+
+    failed = 0;
+    succeeded = 0;
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_connect())
+        .Times(::testing::AtLeast(3))
+        .WillOnce(Return(m_monFds[0]))
+        .WillOnce(Return(sock_fd))
+        .WillRepeatedly(::testing::DoAll(
+            ::testing::Assign(&reconnected, true),
+            Return(-1)));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(sock_fd, HasSubstr("\"method\":\"transact\""), _))
+        .Times(1)
+        .WillOnce(::testing::ReturnArg<2>());
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(m_monFds[0], _, _))
+        .Times(::testing::AnyNumber())
+        .WillRepeatedly(::testing::Invoke(ReadFromSocket));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(sock_fd, _, _))
+        .Times(::testing::AtLeast(1))
+        .WillRepeatedly(::testing::Invoke([&](int fd, char * buffer, size_t size) -> ssize_t
+        {
+            size_t len = 0;
+
+            for (; len < size && served < head.size() + fill + tail.size(); len++, served++)
+            {
+                if (served < head.size())
+                {
+                    buffer[len] = head[served];
+                }
+                else if (served < head.size() + fill)
+                {
+                    buffer[len] = 'a';
+                }
+                else
+                {
+                    buffer[len] = tail[served - head.size() - fill];
+                }
+            }
+            return len;
+        }));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(sock_fd))
+        .Times(1)
+        .WillOnce(Return(0));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(m_monFds[0]))
+        .WillOnce(Return(0));
+    // from the reconnect attempts that fail
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(-1))
+        .Times(::testing::AnyNumber())
+        .WillRepeatedly(Return(0));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_init(0));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_write("1", &tableConfig, receiptCallback));
+    // wakes the session up, the data itself comes from the read mock
+    SendMessage(" ");
+
+    for (int i = 0; i < 500 && (failed == 0 || !reconnected); i++)
+    {
+        usleep(10000);
+    }
+    // the reply must not be framed out of the middle of the oversized message
+    EXPECT_EQ(1, failed);
+    EXPECT_EQ(0, succeeded);
+    EXPECT_TRUE(reconnected);
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_deinit());
+}
+
+TEST_F(OvsDbApiTestFixture, ovsdb_api_write_refused_fails_receipt)
+{
+    static std::atomic<int> refused(0);
+    ovsdb_receipt_cb refusedCallback = [](const char* rID, const OvsDb_Base_Receipt* receipt)
+    {
+        EXPECT_STREQ("1", rID);
+        EXPECT_EQ(OVSDB_INSERT_RECEIPT_ID, receipt->receipt_id);
+        EXPECT_EQ(OVS_FAILED_STATUS, receipt->status);
+        EXPECT_STREQ("constraint violation", receipt->error);
+        refused++;
+    };
+    const int sock_fd = m_sockFds[0];
+    struct Feedback feedback = {OVS_SUCCESS_STATUS, "f7d3d0e6-4ce7-4164-9134-0b5af9ce1b86"};
+    Rdkb_Table_Config tableConfig;
+    tableConfig.table.id = OVS_FEEDBACK_TABLE;
+    tableConfig.config = &feedback;
+
+    refused = 0;
+    ExpectSessions(sock_fd);
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(sock_fd, HasSubstr("\"method\":\"transact\""), _))
+        .Times(2)
+        .WillRepeatedly(::testing::ReturnArg<2>());
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_read(_, _, _))
+        .Times(::testing::AnyNumber())
+        .WillRepeatedly(::testing::Invoke(ReadFromSocket));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_disconnect(sock_fd))
+        .WillOnce(Return(0));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_init(0));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_write("1", &tableConfig, refusedCallback));
+    SendMessage("{\"id\":\"1\",\"result\":[{\"error\":\"constraint violation\",\"details\":\"duplicate\"}],\"error\":null}");
+    for (int i = 0; i < 100 && refused == 0; i++)
+    {
+        usleep(10000);
+    }
+    EXPECT_EQ(1, refused);
+
+    // a JSON-RPC error reply fails it the same way
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_write("1", &tableConfig, refusedCallback));
+    SendMessage("{\"id\":\"1\",\"result\":null,\"error\":{\"error\":\"constraint violation\"}}");
+    for (int i = 0; i < 100 && refused == 1; i++)
+    {
+        usleep(10000);
+    }
+    EXPECT_EQ(2, refused);
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_deinit());
+}
@@ -0,0 +1,189 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+
+#include <stdio.h>
+#include <unistd.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "OvsDbApi/ovsdb_reactor.h"
+}
+
+namespace{
+    struct ReactorEvents
+    {
+        ovsdb_reactor * reactor;
+        std::atomic<int> reads;
+        std::atomic<int> wakeups;
+        std::atomic<int> timeouts;
+        int stop_after;     // stops the reactor once this many timer ticks were seen
+    };
+
+    void * run_reactor(void * data)
+    {
+        static OVS_STATUS status;
+        status = ovsdb_reactor_run((ovsdb_reactor *) data);
+        return &status;
+    }
+
+    void read_cb(int fd, uint32_t events, void * data)
+    {
+        ReactorEvents * ev = (ReactorEvents *) data;
+        char buf[64];
+
+        while (read(fd, buf, sizeof(buf)) > 0)
+        {
+            ev->reads++;
+        }
+    }
+
+    void wakeup_cb(int fd, uint32_t events, void * data)
+    {
+        ((ReactorEvents *) data)->wakeups++;
+    }
+
+    void timer_cb(int fd, uint32_t events, void * data)
+    {
+        ReactorEvents * ev = (ReactorEvents *) data;
+
+        if (++ev->timeouts == ev->stop_after)
+        {
+            (void)ovsdb_reactor_stop(ev->reactor);
+        }
+    }
+
+    template <typename Pred>
+    bool wait_for(Pred pred, int msecs)
+    {
+        for (int i = 0; i < msecs && !pred(); i++)
+        {
+            usleep(1000);
+        }
+        return pred();
+    }
+}
+
+class ReactorTest : public ::testing::Test
+{
+    protected:
+        ovsdb_reactor * reactor;
+        ReactorEvents events;
+        pthread_t thread;
+
+        virtual void SetUp()
+        {
+            reactor = ovsdb_reactor_create();
+            ASSERT_TRUE(reactor != NULL);
+            events.reactor = reactor;
+            events.reads = 0;
+            events.wakeups = 0;
+            events.timeouts = 0;
+            events.stop_after = -1;
+        }
+
+        virtual void TearDown()
+        {
+            ovsdb_reactor_destroy(reactor);
+        }
+
+        void Start()
+        {
+            ASSERT_EQ(0, pthread_create(&thread, NULL, run_reactor, reactor));
+        }
+
+        OVS_STATUS Join()
+        {
+            void * status = NULL;
+            EXPECT_EQ(0, pthread_join(thread, &status));
+            return *(OVS_STATUS *) status;
+        }
+};
+
+TEST_F(ReactorTest, StopWakesIdleReactorImmediately)
+{
+    Start();
+    usleep(10000);
+
+    auto begin = std::chrono::steady_clock::now();
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_reactor_stop(reactor));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, Join());
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - begin);
+    EXPECT_LT(elapsed.count(), 50);
+}
+
+TEST_F(ReactorTest, WakeupRunsCallbackOnReactorThread)
+{
+    ovsdb_reactor_set_wakeup_cb(reactor, wakeup_cb, &events);
+    Start();
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_reactor_wakeup(reactor));
+    EXPECT_TRUE(wait_for([&]{ return events.wakeups >= 1; }, 1000));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_reactor_stop(reactor));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, Join());
+}
+
+TEST_F(ReactorTest, DispatchesReadableFd)
+{
+    int fds[2];
+
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds));
+    ASSERT_EQ(OVS_SUCCESS_STATUS,
+        ovsdb_reactor_add(reactor, fds[0], EPOLLIN, read_cb, &events));
+    // the same fd cannot be watched twice
+    EXPECT_EQ(OVS_FAILED_STATUS,
+        ovsdb_reactor_add(reactor, fds[0], EPOLLIN, read_cb, &events));
+    Start();
+
+    ASSERT_EQ(1, write(fds[1], "x", 1));
+    EXPECT_TRUE(wait_for([&]{ return events.reads == 1; }, 1000));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_reactor_remove(reactor, fds[0]));
+    ASSERT_EQ(1, write(fds[1], "y", 1));
+    usleep(20000);
+    EXPECT_EQ(1, events.reads);
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_reactor_stop(reactor));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, Join());
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST_F(ReactorTest, PeriodicTimer)
+{
+    int timer_fd = ovsdb_reactor_timer_create(reactor, timer_cb, &events);
+
+    ASSERT_LE(0, timer_fd);
+    events.stop_after = 3;
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_reactor_timer_arm(timer_fd, 5, 5));
+    Start();
+
+    // the timer callback stops the reactor on its third tick
+    ASSERT_EQ(OVS_SUCCESS_STATUS, Join());
+    EXPECT_EQ(3, events.timeouts);
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_reactor_timer_arm(timer_fd, 0, 0));
+    EXPECT_EQ(OVS_SUCCESS_STATUS, ovsdb_reactor_timer_destroy(reactor, timer_fd));
+}
@@ -18,6 +18,9 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <atomic>
 #include <string>
 #include <gtest/gtest.h>
 
@@ -39,27 +42,238 @@ namespace{
     };
 }
 
-TEST(ReceiptListTest, OvsDbWriteReceiptSingle)
+class ReceiptListTest : public ::testing::Test
+{
+    protected:
+        receipt_list* list;
+
+        virtual void SetUp()
+        {
+            list = receipt_list_create();
+            ASSERT_TRUE(list != NULL);
+        }
+
+        virtual void TearDown()
+        {
+            receipt_list_destroy(list);
+        }
+};
+
+TEST_F(ReceiptListTest, OvsDbWriteReceiptSingle)
+{
+    json_t* result = json_loads(insert_receipt.c_str(), 0, NULL);
+
+    ASSERT_EQ(OVS_FAILED_STATUS, receipt_list_process(list, "WRONGRID", result, NULL));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, receipt_list_add(list, g_rID, OVSDB_INSERT_RECEIPT_ID, receipt_cb, 0));
+    ASSERT_EQ(OVS_FAILED_STATUS, receipt_list_process(list, "WRONGRID", result, NULL));
+    ASSERT_EQ(OVS_SUCCESS_STATUS, receipt_list_process(list, g_rID, result, NULL));
+    ASSERT_EQ(OVS_FAILED_STATUS, receipt_list_process(list, g_rID, result, NULL));
+}
+
+TEST_F(ReceiptListTest, OvsDbWriteReceiptMultiple)
 {
     json_t* result = json_loads(insert_receipt.c_str(), 0, NULL);
 
-    ASSERT_EQ(OVS_FAILED_STATUS, receipt_list_process("WRONGRID", result));
-    ASSERT_EQ(OVS_SUCCESS_STATUS, receipt_list_add(g_rID, OVSDB_INSERT_RECEIPT_ID, receipt_cb));
-    ASSERT_EQ(OVS_FAILED_STATUS, receipt_list_process("WRONGRID", result));
-    ASSERT_EQ(OVS_SUCCESS_STATUS, receipt_list_process(g_rID, result));
-    ASSERT_EQ(OVS_FAILED_STATUS, receipt_list_process(g_rID, result));
+    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_add(list, "WRONGRID", OVSDB_INSERT_RECEIPT_ID, receipt_cb, 0));
+    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_add(list, "WRONGRID2", OVSDB_INSERT_RECEIPT_ID, receipt_cb, 0));
+    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_add(list, g_rID, OVSDB_INSERT_RECEIPT_ID, receipt_cb, 0));
+    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_add(list, "WRONGRID3", OVSDB_INSERT_RECEIPT_ID, receipt_cb, 0));
+
+    EXPECT_EQ(OVS_FAILED_STATUS, receipt_list_process(list, "WRONGRID4", result, NULL));
+    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_process(list, g_rID, result, NULL));
+    EXPECT_EQ(OVS_FAILED_STATUS, receipt_list_process(list, g_rID, result, NULL));
 }
 
-TEST(ReceiptListTest, OvsDbWriteReceiptMultiple)
+TEST_F(ReceiptListTest, OvsDbFailAllPendingReceipts)
 {
+    static int failed = 0;
+    ovsdb_receipt_cb fail_cb = [](const char* rID, const OvsDb_Base_Receipt* receipt)
+    {
+        ASSERT_EQ(OVSDB_INSERT_RECEIPT_ID, receipt->receipt_id);
+        EXPECT_EQ(OVS_FAILED_STATUS, receipt->status);
+        EXPECT_STREQ("connection lost", receipt->error);
+        EXPECT_STREQ("", ((OvsDb_Insert_Receipt*) receipt)->uuid);
+        failed++;
+    };
     json_t* result = json_loads(insert_receipt.c_str(), 0, NULL);
 
-    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_add("WRONGRID", OVSDB_INSERT_RECEIPT_ID, receipt_cb));
-    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_add("WRONGRID2", OVSDB_INSERT_RECEIPT_ID, receipt_cb));
-    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_add(g_rID, OVSDB_INSERT_RECEIPT_ID, receipt_cb));
-    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_add("WRONGRID3", OVSDB_INSERT_RECEIPT_ID, receipt_cb));
+    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_add(list, "1", OVSDB_INSERT_RECEIPT_ID, fail_cb, 0));
+    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_add(list, "2", OVSDB_INSERT_RECEIPT_ID, fail_cb, 0));
+
+    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_fail_all(list, OVS_FAILED_STATUS, "connection lost"));
+    EXPECT_EQ(2, failed);
+    // failed receipts are gone, a late response is not delivered again
+    EXPECT_EQ(OVS_FAILED_STATUS, receipt_list_process(list, "1", result, NULL));
+    json_decref(result);
+}
+
+TEST_F(ReceiptListTest, OvsDbFailSessionReceipts)
+{
+    static int failed = 0;
+    ovsdb_receipt_cb fail_cb = [](const char* rID, const OvsDb_Base_Receipt* receipt)
+    {
+        EXPECT_STREQ("2", rID);
+        EXPECT_EQ(OVS_FAILED_STATUS, receipt->status);
+        failed++;
+    };
+    json_t* result = json_loads(insert_receipt.c_str(), 0, NULL);
+
+    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_add(list, g_rID, OVSDB_INSERT_RECEIPT_ID, receipt_cb, 0));
+    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_add(list, "2", OVSDB_INSERT_RECEIPT_ID, fail_cb, 1));
+
+    // only requests sent on the broken session are failed
+    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_fail_session(list, 1, OVS_FAILED_STATUS, "connection lost"));
+    EXPECT_EQ(1, failed);
+    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_process(list, g_rID, result, NULL));
+    EXPECT_EQ(OVS_FAILED_STATUS, receipt_list_process(list, "2", result, NULL));
+    json_decref(result);
+}
+
+TEST_F(ReceiptListTest, OvsDbReusedRidAnsweredOldestFirst)
+{
+    static int order = 0;
+    receipt_list_data_cb first_cb = [](const char* rID, const OvsDb_Base_Receipt* receipt, void* data)
+    {
+        EXPECT_EQ(0, order++);
+        EXPECT_EQ(OVSDB_INSERT_RECEIPT_ID, receipt->receipt_id);
+    };
+    receipt_list_data_cb second_cb = [](const char* rID, const OvsDb_Base_Receipt* receipt, void* data)
+    {
+        EXPECT_EQ(1, order++);
+        EXPECT_EQ(OVSDB_DELETE_RECEIPT_ID, receipt->receipt_id);
+    };
+    OVSDB_RECEIPT_ID receipt_id = OVSDB_UNKNOWN_RECEIPT_ID;
+    OvsDb_Base_Receipt receipt = {};
+
+    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_add_data(list, "17", OVSDB_INSERT_RECEIPT_ID, first_cb, NULL, 0));
+    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_add_data(list, "17", OVSDB_DELETE_RECEIPT_ID, second_cb, NULL, 0));
+
+    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_get_type(list, "17", &receipt_id));
+    EXPECT_EQ(OVSDB_INSERT_RECEIPT_ID, receipt_id);
+    receipt.receipt_id = OVSDB_INSERT_RECEIPT_ID;
+    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_complete(list, "17", &receipt));
+    receipt.receipt_id = OVSDB_DELETE_RECEIPT_ID;
+    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_complete(list, "17", &receipt));
+    EXPECT_EQ(2, order);
+    EXPECT_EQ(OVS_FAILED_STATUS, receipt_list_get_type(list, "17", &receipt_id));
+}
+
+namespace{
+    const int g_threads = 8;
+    const int g_receipts_per_thread = 2000;
+
+    struct receipt_thread_args
+    {
+        receipt_list* list;
+        int first_rid;
+        std::atomic<int>* completed;
+    };
+
+    void* add_and_complete_receipts(void* arg)
+    {
+        receipt_thread_args* args = (receipt_thread_args*) arg;
+        receipt_list_data_cb count_cb = [](const char* rID, const OvsDb_Base_Receipt* receipt, void* data)
+        {
+            (*(std::atomic<int>*) data)++;
+        };
+        OvsDb_Base_Receipt receipt = {};
+        char rid[16];
+        int i;
+
+        receipt.receipt_id = OVSDB_INSERT_RECEIPT_ID;
+        for (i = 0; i < g_receipts_per_thread; i++)
+        {
+            snprintf(rid, sizeof(rid), "%d", args->first_rid + i);
+            EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_add_data(args->list, rid,
+                OVSDB_INSERT_RECEIPT_ID, count_cb, args->completed, 0));
+        }
+        for (i = 0; i < g_receipts_per_thread; i++)
+        {
+            snprintf(rid, sizeof(rid), "%d", args->first_rid + i);
+            EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_complete(args->list, rid, &receipt));
+        }
+        return NULL;
+    }
+}
+
+TEST_F(ReceiptListTest, OvsDbConcurrentReceipts)
+{
+    pthread_t threads[g_threads];
+    receipt_thread_args args[g_threads];
+    std::atomic<int> completed(0);
+    int i;
+
+    for (i = 0; i < g_threads; i++)
+    {
+        args[i] = {list, 1 + i * g_receipts_per_thread, &completed};
+        ASSERT_EQ(0, pthread_create(&threads[i], NULL, add_and_complete_receipts, &args[i]));
+    }
+    for (i = 0; i < g_threads; i++)
+    {
+        EXPECT_EQ(0, pthread_join(threads[i], NULL));
+    }
+
+    EXPECT_EQ(g_threads * g_receipts_per_thread, completed.load());
+    EXPECT_EQ(OVS_FAILED_STATUS, receipt_list_remove(list, "1"));
+}
+
+TEST_F(ReceiptListTest, OvsDbReceiptsTimeOut)
+{
+    static int timed_out = 0;
+    ovsdb_receipt_cb timeout_cb = [](const char* rID, const OvsDb_Base_Receipt* receipt)
+    {
+        EXPECT_STREQ("1", rID);
+        EXPECT_EQ(OVSDB_DELETE_RECEIPT_ID, receipt->receipt_id);
+        EXPECT_EQ(OVS_TIMED_OUT_STATUS, receipt->status);
+        EXPECT_STREQ("request timed out", receipt->error);
+        timed_out++;
+    };
+    json_t* result = json_loads(insert_receipt.c_str(), 0, NULL);
+    size_t pending = 0;
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, receipt_list_set_timeout(list, 2 * RECEIPT_LIST_TICK_MSECS));
+    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_add(list, "1", OVSDB_DELETE_RECEIPT_ID, timeout_cb, 0));
+    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_add(list, g_rID, OVSDB_INSERT_RECEIPT_ID, receipt_cb, 0));
+    // answered in time, its deadline goes with it
+    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_process(list, g_rID, result, NULL));
+
+    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_expire(list, &pending));
+    EXPECT_EQ(0, timed_out);
+    EXPECT_EQ(1u, pending);
+
+    usleep(3 * RECEIPT_LIST_TICK_MSECS * 1000);
+    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_expire(list, &pending));
+    EXPECT_EQ(1, timed_out);
+    EXPECT_EQ(0u, pending);
+    EXPECT_EQ(OVS_FAILED_STATUS, receipt_list_remove(list, "1"));
+
+    // without a timeout receipts wait for their response
+    ASSERT_EQ(OVS_SUCCESS_STATUS, receipt_list_set_timeout(list, 0));
+    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_add(list, "1", OVSDB_DELETE_RECEIPT_ID, timeout_cb, 0));
+    usleep(3 * RECEIPT_LIST_TICK_MSECS * 1000);
+    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_expire(list, &pending));
+    EXPECT_EQ(1, timed_out);
+    EXPECT_EQ(0u, pending);
+    json_decref(result);
+}
+
+TEST_F(ReceiptListTest, OvsDbUnexpectedResponseFailsReceipt)
+{
+    static int failed = 0;
+    ovsdb_receipt_cb fail_cb = [](const char* rID, const OvsDb_Base_Receipt* receipt)
+    {
+        EXPECT_STREQ("1", rID);
+        EXPECT_EQ(OVSDB_INSERT_RECEIPT_ID, receipt->receipt_id);
+        EXPECT_EQ(OVS_FAILED_STATUS, receipt->status);
+        failed++;
+    };
+    json_t* result = json_loads("[{\"count\":1}]", 0, NULL);
 
-    EXPECT_EQ(OVS_FAILED_STATUS, receipt_list_process("WRONGRID4", result));
-    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_process(g_rID, result));
-    EXPECT_EQ(OVS_FAILED_STATUS, receipt_list_process(g_rID, result));
+    EXPECT_EQ(OVS_SUCCESS_STATUS, receipt_list_add(list, "1", OVSDB_INSERT_RECEIPT_ID, fail_cb, 0));
+    // the request is off its deadline by then, it must not be left without an answer
+    EXPECT_EQ(OVS_FAILED_STATUS, receipt_list_process(list, "1", result, NULL));
+    EXPECT_EQ(1, failed);
+    EXPECT_EQ(OVS_FAILED_STATUS, receipt_list_process(list, "1", result, NULL));
+    EXPECT_EQ(1, failed);
+    json_decref(result);
 }
@@ -0,0 +1,151 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+#include <stdlib.h>
+#include <vector>
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "OvsDbApi/timer_wheel.h"
+}
+
+namespace{
+    std::vector<timer_wheel_entry*> expired_entries(timer_wheel_entry* expired)
+    {
+        std::vector<timer_wheel_entry*> entries;
+
+        for (; expired != NULL; expired = expired->next)
+        {
+            EXPECT_TRUE(expired->pprev == NULL);
+            entries.push_back(expired);
+        }
+        return entries;
+    }
+}
+
+class TimerWheelTest : public ::testing::Test
+{
+    protected:
+        timer_wheel wheel;
+
+        virtual void SetUp()
+        {
+            timer_wheel_init(&wheel, 1000);
+        }
+};
+
+TEST_F(TimerWheelTest, ExpiresOnItsTick)
+{
+    timer_wheel_entry entry = {};
+
+    timer_wheel_add(&wheel, &entry, 1010);
+    EXPECT_EQ(1u, wheel.count);
+    EXPECT_TRUE(expired_entries(timer_wheel_advance(&wheel, 1009)).empty());
+
+    std::vector<timer_wheel_entry*> expired = expired_entries(timer_wheel_advance(&wheel, 1010));
+    ASSERT_EQ(1u, expired.size());
+    EXPECT_EQ(&entry, expired[0]);
+    EXPECT_EQ(0u, wheel.count);
+}
+
+TEST_F(TimerWheelTest, RemovedEntryDoesNotExpire)
+{
+    timer_wheel_entry first = {};
+    timer_wheel_entry second = {};
+
+    timer_wheel_add(&wheel, &first, 1005);
+    timer_wheel_add(&wheel, &second, 1005);
+    timer_wheel_remove(&wheel, &first);
+    // removing twice is harmless
+    timer_wheel_remove(&wheel, &first);
+    EXPECT_EQ(1u, wheel.count);
+
+    std::vector<timer_wheel_entry*> expired = expired_entries(timer_wheel_advance(&wheel, 2000));
+    ASSERT_EQ(1u, expired.size());
+    EXPECT_EQ(&second, expired[0]);
+}
+
+TEST_F(TimerWheelTest, PastAndFarTicksAreClamped)
+{
+    timer_wheel_entry past = {};
+    timer_wheel_entry far = {};
+
+    timer_wheel_add(&wheel, &past, 10);
+    EXPECT_EQ(1001u, past.expires);
+    timer_wheel_add(&wheel, &far, 1000 + 2 * TIMER_WHEEL_MAX_TICKS);
+    EXPECT_EQ(1000 + TIMER_WHEEL_MAX_TICKS - 1, far.expires);
+
+    EXPECT_EQ(1u, expired_entries(timer_wheel_advance(&wheel, 1001)).size());
+    EXPECT_EQ(1u, wheel.count);
+}
+
+TEST_F(TimerWheelTest, EntriesOnEveryLevelExpireOnTheirTick)
+{
+    const uint64_t start = 1000;
+    std::vector<timer_wheel_entry> entries(2000);
+    uint64_t now = start;
+    size_t expired = 0;
+    size_t i;
+
+    srand(7);
+    for (i = 0; i < entries.size(); i++)
+    {
+        // spread over all levels, with a bias towards the lower ones
+        uint64_t span = (uint64_t)1 << (TIMER_WHEEL_SLOT_BITS * (1 + i % TIMER_WHEEL_LEVELS));
+        entries[i] = timer_wheel_entry();
+        timer_wheel_add(&wheel, &entries[i], start + 1 + (uint64_t)rand() % (span - 1));
+    }
+
+    // uneven steps, the wheel must not skip slots it jumps over
+    while (wheel.count > 0)
+    {
+        uint64_t before = now;
+
+        now += 1 + (uint64_t)rand() % 5000;
+        for (timer_wheel_entry* entry = timer_wheel_advance(&wheel, now); entry != NULL;
+            entry = entry->next)
+        {
+            EXPECT_GT(entry->expires, before);
+            EXPECT_LE(entry->expires, now);
+            expired++;
+        }
+        EXPECT_EQ(now, wheel.now);
+    }
+    EXPECT_EQ(entries.size(), expired);
+}
+
+TEST_F(TimerWheelTest, EntriesExpireInOrder)
+{
+    std::vector<timer_wheel_entry> entries(TIMER_WHEEL_SLOTS * TIMER_WHEEL_SLOTS + 10);
+    uint64_t now = 1000;
+    size_t i;
+
+    for (i = 0; i < entries.size(); i++)
+    {
+        entries[i] = timer_wheel_entry();
+        timer_wheel_add(&wheel, &entries[i], 1001 + i);
+    }
+
+    for (i = 0; i < entries.size(); i++)
+    {
+        std::vector<timer_wheel_entry*> expired = expired_entries(timer_wheel_advance(&wheel, ++now));
+        ASSERT_EQ(1u, expired.size());
+        EXPECT_EQ(&entries[i], expired[0]);
+    }
+    EXPECT_EQ(0u, wheel.count);
+}
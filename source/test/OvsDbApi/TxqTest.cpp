@@ -0,0 +1,176 @@
+/*
+* Copyright 2020 Comcast Cable Communications Management, LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "test/mocks/mock_ovsdb_socket.h"
+
+extern "C" {
+#include "OvsDbApi/ovsdb_txq.h"
+}
+
+using ::testing::_;
+using ::testing::Return;
+using ::testing::StrEq;
+
+extern OvsDbSocketMock * g_ovsDbSocketMock;
+
+namespace{
+    const int g_fd = 10;
+    const std::string g_msg1 = "{\"method\":\"transact\",\"id\":\"1\",\"params\":[]}";
+    const std::string g_msg2 = "{\"method\":\"transact\",\"id\":\"2\",\"params\":[]}";
+}
+
+class TxqTest : public ::testing::Test
+{
+    protected:
+        OvsDbSocketMock mockedOvsDbSocket;
+        ovsdb_txq txq;
+
+        TxqTest()
+        {
+            g_ovsDbSocketMock = &mockedOvsDbSocket;
+        }
+        virtual ~TxqTest()
+        {
+            g_ovsDbSocketMock = NULL;
+        }
+
+        virtual void SetUp()
+        {
+            ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_txq_init(&txq, OVSDB_TXQ_DEFAULT_HIGH_WATER));
+        }
+
+        virtual void TearDown()
+        {
+            ovsdb_txq_deinit(&txq);
+        }
+
+        OVS_STATUS Send(const std::string& msg, bool * queued)
+        {
+            return ovsdb_txq_send(&txq, g_fd, msg.c_str(), msg.size(), queued);
+        }
+};
+
+TEST_F(TxqTest, CompleteWriteIsNotQueued)
+{
+    bool queued = true;
+
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(g_fd, StrEq(g_msg1), g_msg1.size()))
+        .Times(1)
+        .WillOnce(Return(g_msg1.size()));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, Send(g_msg1, &queued));
+    EXPECT_FALSE(queued);
+    EXPECT_EQ(0u, ovsdb_txq_pending(&txq));
+}
+
+TEST_F(TxqTest, PartialWriteIsResumedInOrder)
+{
+    bool queued = false;
+    bool empty = false;
+    const std::string rest = g_msg1.substr(10) + g_msg2;
+
+    ::testing::InSequence seq;
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(g_fd, StrEq(g_msg1), g_msg1.size()))
+        .WillOnce(Return(10));
+    // flush sends both queued messages in one gathered write, the socket takes part of it
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(g_fd, StrEq(rest), rest.size()))
+        .WillOnce(Return(5));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(g_fd, StrEq(rest.substr(5)), rest.size() - 5))
+        .WillOnce(Return(rest.size() - 5));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, Send(g_msg1, &queued));
+    EXPECT_TRUE(queued);
+    // must not overtake the queued remainder of the first message
+    ASSERT_EQ(OVS_SUCCESS_STATUS, Send(g_msg2, &queued));
+    EXPECT_TRUE(queued);
+    EXPECT_EQ(rest.size(), ovsdb_txq_pending(&txq));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_txq_flush(&txq, g_fd, &empty));
+    EXPECT_FALSE(empty);
+    EXPECT_EQ(rest.size() - 5, ovsdb_txq_pending(&txq));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_txq_flush(&txq, g_fd, &empty));
+    EXPECT_TRUE(empty);
+    EXPECT_EQ(0u, ovsdb_txq_pending(&txq));
+}
+
+TEST_F(TxqTest, HighWaterMarkRefusesMessage)
+{
+    bool queued = false;
+
+    ovsdb_txq_set_high_water(&txq, g_msg1.size() + 10);
+
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(g_fd, StrEq(g_msg1), g_msg1.size()))
+        .WillOnce(Return(0));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, Send(g_msg1, &queued));
+    EXPECT_TRUE(queued);
+    // nothing of the refused message may reach the socket
+    EXPECT_EQ(OVS_BUSY_STATUS, Send(g_msg2, &queued));
+    EXPECT_FALSE(queued);
+    EXPECT_EQ(g_msg1.size(), ovsdb_txq_pending(&txq));
+
+    ovsdb_txq_reset(&txq);
+    EXPECT_EQ(0u, ovsdb_txq_pending(&txq));
+}
+
+TEST_F(TxqTest, WriteErrorFails)
+{
+    bool queued = false;
+
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(g_fd, _, _))
+        .WillOnce(Return(-1));
+
+    EXPECT_EQ(OVS_FAILED_STATUS, Send(g_msg1, &queued));
+    EXPECT_FALSE(queued);
+    EXPECT_EQ(0u, ovsdb_txq_pending(&txq));
+}
+
+TEST_F(TxqTest, FlushDrainsMoreThanOneWritev)
+{
+    const int messages = OVSDB_TXQ_MAX_IOV + OVSDB_TXQ_MAX_IOV / 2;
+    bool queued = false;
+    bool empty = false;
+    int i;
+
+    ::testing::InSequence seq;
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(g_fd, StrEq(g_msg1), g_msg1.size()))
+        .WillOnce(Return(0));
+    // the socket takes everything once writable, one writev per OVSDB_TXQ_MAX_IOV buffers
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(g_fd, _, OVSDB_TXQ_MAX_IOV * g_msg1.size()))
+        .WillOnce(Return(OVSDB_TXQ_MAX_IOV * g_msg1.size()));
+    EXPECT_CALL(*g_ovsDbSocketMock, ovsdb_socket_write(g_fd, _, (messages - OVSDB_TXQ_MAX_IOV) * g_msg1.size()))
+        .WillOnce(Return((messages - OVSDB_TXQ_MAX_IOV) * g_msg1.size()));
+
+    for (i = 0; i < messages; i++)
+    {
+        ASSERT_EQ(OVS_SUCCESS_STATUS, Send(g_msg1, &queued));
+        EXPECT_TRUE(queued);
+    }
+    EXPECT_EQ(messages * g_msg1.size(), ovsdb_txq_pending(&txq));
+
+    ASSERT_EQ(OVS_SUCCESS_STATUS, ovsdb_txq_flush(&txq, g_fd, &empty));
+    EXPECT_TRUE(empty);
+    EXPECT_EQ(0u, ovsdb_txq_pending(&txq));
+}
@@ -19,6 +19,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
+#include <errno.h>
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include "test/mocks/mock_fd.h"
@@ -96,3 +98,53 @@ TEST_F(OvsDbSocketTestFixture, ovsdb_socket_connect_disconnect)
     ASSERT_EQ(0, ovsdb_socket_disconnect(sock_fd));
 }
 
+
+ACTION_P(CopyToRecvBuffer, str)
+{
+    memcpy(arg1, str, strlen(str));
+    return strlen(str);
+}
+
+TEST_F(OvsDbSocketTestFixture, ovsdb_socket_read)
+{
+    int sock_fd = 10;
+    char buffer[64];
+    const char * msg = "{\"id\":\"1\",\"result\":[]}";
+
+    EXPECT_CALL(*g_socketMock, recv(sock_fd, _, sizeof(buffer), _))
+        .Times(4)
+        .WillOnce(CopyToRecvBuffer(msg))
+        .WillOnce(::testing::SetErrnoAndReturn(EAGAIN, -1))
+        .WillOnce(::testing::SetErrnoAndReturn(ECONNRESET, -1))
+        .WillOnce(Return(0));
+
+    ASSERT_EQ((ssize_t)strlen(msg), ovsdb_socket_read(sock_fd, buffer, sizeof(buffer)));
+    EXPECT_EQ(0, memcmp(msg, buffer, strlen(msg)));
+    // nothing left to read on the non-blocking socket
+    ASSERT_EQ(0, ovsdb_socket_read(sock_fd, buffer, sizeof(buffer)));
+    ASSERT_GT(0, ovsdb_socket_read(sock_fd, buffer, sizeof(buffer)));
+    // peer closed the connection
+    ASSERT_GT(0, ovsdb_socket_read(sock_fd, buffer, sizeof(buffer)));
+}
+
+TEST_F(OvsDbSocketTestFixture, ovsdb_socket_write_would_block)
+{
+    int sock_fd = 10;
+    const char * msg = "{\"id\":\"1\",\"method\":\"echo\",\"params\":[]}";
+    struct iovec iov[2] = {{(void *)msg, 10}, {(void *)(msg + 10), strlen(msg) - 10}};
+
+    EXPECT_CALL(*g_socketMock, send(sock_fd, _, strlen(msg), _))
+        .Times(2)
+        .WillOnce(Return(7))
+        .WillOnce(::testing::SetErrnoAndReturn(EAGAIN, -1));
+    EXPECT_CALL(*g_socketMock, sendmsg(sock_fd, _, _))
+        .Times(2)
+        .WillOnce(Return(strlen(msg)))
+        .WillOnce(::testing::SetErrnoAndReturn(EPIPE, -1));
+
+    // short and blocked writes are not errors, the caller queues the rest
+    ASSERT_EQ(7, ovsdb_socket_write(sock_fd, msg, strlen(msg)));
+    ASSERT_EQ(0, ovsdb_socket_write(sock_fd, msg, strlen(msg)));
+    ASSERT_EQ((ssize_t)strlen(msg), ovsdb_socket_writev(sock_fd, iov, 2));
+    ASSERT_EQ(-1, ovsdb_socket_writev(sock_fd, iov, 2));
+}
@@ -16,18 +16,21 @@
 * SPDX-License-Identifier: Apache-2.0
 */
 
+#include <stdio.h>
+#include <string.h>
 #include <jansson.h>
 #include "test/mocks/MockJsonParser.h"
 
 extern JsonParserMock * g_jsonParserMock;
 
-extern "C" OVS_STATUS receipt_list_process(const char* rid, json_t* result)
+extern "C" OVS_STATUS receipt_list_process(receipt_list* list, const char* rid, json_t* result,
+    json_t* error)
 {
     if(!g_jsonParserMock)
     {
         return OVS_FAILED_STATUS;
     }
-    return g_jsonParserMock->receipt_list_process(rid, result);
+    return g_jsonParserMock->receipt_list_process(list, rid, result, error);
 }
 
 extern "C" OVS_STATUS ovsdb_parse_params(json_t* params)
@@ -48,11 +51,38 @@ extern "C" OVS_STATUS ovsdb_parse_monitor_update(const char * uuid, json_t* upda
     return g_jsonParserMock->ovsdb_parse_monitor_update(uuid, update);
 }
 
-extern "C" OVS_STATUS mon_list_process(const char* rid, Rdkb_Table_Config* table_config)
+extern "C" OVS_STATUS mon_list_process(mon_list* list, const char* rid, Rdkb_Table_Config* table_config)
 {
     if(!g_jsonParserMock)
     {
         return OVS_FAILED_STATUS;
     }
-    return g_jsonParserMock->mon_list_process(rid, table_config);
+    return g_jsonParserMock->mon_list_process(list, rid, table_config);
+}
+
+/**
+ * The monitor list keeps no rows here, the changes that carry the whole
+ * row and reach a monitor's callback go to mon_list_process().
+**/
+extern "C" OVS_STATUS mon_list_update(mon_list* list, const char* uuid, const mon_row_change* change)
+{
+    OvsAgent_Table_Config table_config;
+
+    if(!g_jsonParserMock)
+    {
+        return OVS_FAILED_STATUS;
+    }
+    g_jsonParserMock->mon_list_update(list, uuid, change);
+
+    if (!change->row ||
+        (change->type != OVSDB_SELECT_INSERT && change->type != OVSDB_SELECT_MODIFY))
+    {
+        return OVS_SUCCESS_STATUS;
+    }
+
+    memset(&table_config, 0, sizeof(table_config));
+    table_config.table.id = change->desc->id;
+    table_config.config = (void*) change->row;
+    snprintf(table_config.uuid, sizeof(table_config.uuid), "%s", change->uuid);
+    return g_jsonParserMock->mon_list_process(list, uuid, (Rdkb_Table_Config*) &table_config);
 }
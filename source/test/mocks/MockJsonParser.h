@@ -24,24 +24,31 @@
 #include <jansson.h>
 #include "OvsDbApi/OvsDbDefs.h"
 
+extern "C" {
+#include "OvsDbApi/receipt_list.h"
+#include "OvsDbApi/mon_update_list.h"
+}
+
 class JsonParserInterface
 {
     public:
         virtual ~JsonParserInterface() {}
-        virtual OVS_STATUS receipt_list_process(const char*, json_t*) = 0;
+        virtual OVS_STATUS receipt_list_process(receipt_list*, const char*, json_t*, json_t*) = 0;
         virtual OVS_STATUS ovsdb_parse_params(json_t*) = 0;
         virtual OVS_STATUS ovsdb_parse_monitor_update(const char*, json_t*) = 0;
-        virtual OVS_STATUS mon_list_process(const char*, Rdkb_Table_Config*) = 0;
+        virtual OVS_STATUS mon_list_process(mon_list*, const char*, Rdkb_Table_Config*) = 0;
+        virtual void mon_list_update(mon_list*, const char*, const mon_row_change*) = 0;
 };
 
 class JsonParserMock : public JsonParserInterface
 {
     public:
         virtual ~JsonParserMock() {}
-        MOCK_METHOD2(receipt_list_process, OVS_STATUS(const char*, json_t*));
+        MOCK_METHOD4(receipt_list_process, OVS_STATUS(receipt_list*, const char*, json_t*, json_t*));
         MOCK_METHOD1(ovsdb_parse_params, OVS_STATUS(json_t*));
         MOCK_METHOD2(ovsdb_parse_monitor_update, OVS_STATUS(const char*, json_t*));
-        MOCK_METHOD2(mon_list_process, OVS_STATUS(const char*, Rdkb_Table_Config*));
+        MOCK_METHOD3(mon_list_process, OVS_STATUS(mon_list*, const char*, Rdkb_Table_Config*));
+        MOCK_METHOD3(mon_list_update, void(mon_list*, const char*, const mon_row_change*));
 };
 
 #endif
@@ -49,6 +49,16 @@ extern "C" OVS_STATUS ovsdb_write(const char * rID, Rdkb_Table_Config * table_co
     return g_ovsDbApiMock->ovsdb_write(rID, table_config, receipt_cb);
 }
 
+extern "C" OVS_STATUS ovsdb_write_batch(const char * rID, Rdkb_Table_Config * table_configs,
+    size_t count, ovsdb_receipt_cb receipt_cb)
+{
+    if (!g_ovsDbApiMock)
+    {
+        return OVS_FAILED_STATUS;
+    }
+    return g_ovsDbApiMock->ovsdb_write_batch(rID, table_configs, count, receipt_cb);
+}
+
 extern "C" OVS_STATUS ovsdb_monitor(OVS_TABLE ovsdb_table, ovsdb_mon_cb mon_cb, ovsdb_receipt_cb receipt_cb)
 {
     if (!g_ovsDbApiMock)
@@ -58,6 +68,16 @@ extern "C" OVS_STATUS ovsdb_monitor(OVS_TABLE ovsdb_table, ovsdb_mon_cb mon_cb,
     return g_ovsDbApiMock->ovsdb_monitor(ovsdb_table, mon_cb, receipt_cb);
 }
 
+extern "C" OVS_STATUS ovsdb_monitor_select(OVS_TABLE ovsdb_table,
+    const OvsDb_Monitor_Select * select, ovsdb_mon_cb mon_cb, ovsdb_receipt_cb receipt_cb)
+{
+    if (!g_ovsDbApiMock)
+    {
+        return OVS_FAILED_STATUS;
+    }
+    return g_ovsDbApiMock->ovsdb_monitor_select(ovsdb_table, select, mon_cb, receipt_cb);
+}
+
 extern "C" OVS_STATUS ovsdb_monitor_cancel(const char * rID, ovsdb_receipt_cb receipt_cb)
 {
     if (!g_ovsDbApiMock)
@@ -76,6 +96,15 @@ extern "C" OVS_STATUS ovsdb_delete(OVS_TABLE ovsdb_table, const char * key, cons
     return g_ovsDbApiMock->ovsdb_delete(ovsdb_table, key, value);
 }
 
+extern "C" OVS_STATUS ovsdb_set_state_file(const char * path)
+{
+    if (!g_ovsDbApiMock)
+    {
+        return OVS_FAILED_STATUS;
+    }
+    return g_ovsDbApiMock->ovsdb_set_state_file(path);
+}
+
 extern "C" unsigned int id_generate(void)
 {
     if (!g_ovsDbApiMock)
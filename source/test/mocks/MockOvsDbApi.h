@@ -30,9 +30,14 @@ class OvsDbApiInterface
         virtual OVS_STATUS ovsdb_init(unsigned int) = 0;
         virtual OVS_STATUS ovsdb_deinit() = 0;
         virtual OVS_STATUS ovsdb_write(const char *, Rdkb_Table_Config *, ovsdb_receipt_cb) = 0;
+        virtual OVS_STATUS ovsdb_write_batch(const char *, Rdkb_Table_Config *, size_t,
+            ovsdb_receipt_cb) = 0;
         virtual OVS_STATUS ovsdb_monitor(OVS_TABLE, ovsdb_mon_cb, ovsdb_receipt_cb) = 0;
+        virtual OVS_STATUS ovsdb_monitor_select(OVS_TABLE, const OvsDb_Monitor_Select *,
+            ovsdb_mon_cb, ovsdb_receipt_cb) = 0;
         virtual OVS_STATUS ovsdb_monitor_cancel(const char *, ovsdb_receipt_cb) = 0;
         virtual OVS_STATUS ovsdb_delete(OVS_TABLE, const char *, const char *) = 0;
+        virtual OVS_STATUS ovsdb_set_state_file(const char *) = 0;
         virtual unsigned int id_generate() = 0;
 };
 
@@ -43,9 +48,14 @@ class OvsDbApiMock : public OvsDbApiInterface
         MOCK_METHOD1(ovsdb_init, OVS_STATUS(unsigned int));
         MOCK_METHOD0(ovsdb_deinit, OVS_STATUS());
         MOCK_METHOD3(ovsdb_write, OVS_STATUS(const char *, Rdkb_Table_Config *, ovsdb_receipt_cb));
+        MOCK_METHOD4(ovsdb_write_batch, OVS_STATUS(const char *, Rdkb_Table_Config *, size_t,
+            ovsdb_receipt_cb));
         MOCK_METHOD3(ovsdb_monitor, OVS_STATUS(OVS_TABLE, ovsdb_mon_cb, ovsdb_receipt_cb));
+        MOCK_METHOD4(ovsdb_monitor_select, OVS_STATUS(OVS_TABLE, const OvsDb_Monitor_Select *,
+            ovsdb_mon_cb, ovsdb_receipt_cb));
         MOCK_METHOD2(ovsdb_monitor_cancel, OVS_STATUS(const char *, ovsdb_receipt_cb));
         MOCK_METHOD3(ovsdb_delete, OVS_STATUS(OVS_TABLE, const char *, const char *));
+        MOCK_METHOD1(ovsdb_set_state_file, OVS_STATUS(const char *));
         MOCK_METHOD0(id_generate, unsigned int());
 };
 
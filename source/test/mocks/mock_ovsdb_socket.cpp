@@ -17,6 +17,7 @@
 */
 
 #include <iostream>
+#include <string>
 #include "test/mocks/mock_ovsdb_socket.h"
 
 using namespace std;
@@ -46,15 +47,32 @@ extern "C" ssize_t ovsdb_socket_write(int fd, const char *buffer, size_t len)
     return g_ovsDbSocketMock->ovsdb_socket_write(fd, buffer, len);
 }
 
-extern "C" ssize_t ovsdb_socket_listen(int fd, char *buffer, size_t size, int timeout)
+/* Flattens the iovec so tests can keep matching whole messages on ovsdb_socket_write */
+extern "C" ssize_t ovsdb_socket_writev(int fd, const struct iovec *iov, int iovcnt)
 {
-    cout << __FILE__ << ":" << __FUNCTION__ << " fd=" << fd << ", size=" << size
-         << ", len=" << strlen(buffer) << ", buffer=" << buffer << endl;
+    std::string buffer;
+
+    for (int i = 0; i < iovcnt; i++)
+    {
+        buffer.append((const char *)iov[i].iov_base, iov[i].iov_len);
+    }
+    cout << __FILE__ << ":" << __FUNCTION__ << " fd=" << fd << ", iovcnt=" << iovcnt
+         << ", len=" << buffer.size() << endl;
+    if (!g_ovsDbSocketMock)
+    {
+        return -1;
+    }
+    return g_ovsDbSocketMock->ovsdb_socket_write(fd, buffer.c_str(), buffer.size());
+}
+
+extern "C" ssize_t ovsdb_socket_read(int fd, char *buffer, size_t size)
+{
+    cout << __FILE__ << ":" << __FUNCTION__ << " fd=" << fd << ", size=" << size << endl;
     if (!g_ovsDbSocketMock)
     {
         return -1;
     }
-    return g_ovsDbSocketMock->ovsdb_socket_listen(fd, buffer, size, timeout);
+    return g_ovsDbSocketMock->ovsdb_socket_read(fd, buffer, size);
 }
 
 extern "C" int ovsdb_socket_disconnect(int fd)
@@ -18,6 +18,7 @@
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <sys/uio.h>
 
 class OvsDbSocketInterface
 {
@@ -25,7 +26,7 @@ class OvsDbSocketInterface
         virtual ~OvsDbSocketInterface() {}
         virtual int ovsdb_socket_connect() = 0;
         virtual ssize_t ovsdb_socket_write(int, const char *, size_t) = 0;
-        virtual ssize_t ovsdb_socket_listen(int, char *, size_t, int) = 0;
+        virtual ssize_t ovsdb_socket_read(int, char *, size_t) = 0;
         virtual int ovsdb_socket_disconnect(int) = 0;
 };
 
@@ -35,6 +36,6 @@ class OvsDbSocketMock : public OvsDbSocketInterface
         virtual ~OvsDbSocketMock() {}
         MOCK_METHOD0(ovsdb_socket_connect, int());
         MOCK_METHOD3(ovsdb_socket_write, ssize_t(int, const char *, size_t));
-        MOCK_METHOD4(ovsdb_socket_listen, ssize_t(int, char *, size_t, int));
+        MOCK_METHOD3(ovsdb_socket_read, ssize_t(int, char *, size_t));
         MOCK_METHOD1(ovsdb_socket_disconnect, int(int));
 };
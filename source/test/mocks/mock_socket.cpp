@@ -56,15 +56,14 @@ extern "C" ssize_t send(int sockfd, const void *buf, size_t len, int flags)
     return g_socketMock->send(sockfd, buf, len, flags);
 }
 
-extern "C" int select(int nfds, fd_set *readfds, fd_set *writefds,
-                      fd_set *exceptfds, struct timeval *timeout)
+extern "C" ssize_t sendmsg(int sockfd, const struct msghdr *msg, int flags)
 {
-    //cout << __FILE__ << ":" << __FUNCTION__ << " nfds=" << nfds << endl;
+    //cout << __FILE__ << ":" << __FUNCTION__ << " fd=" << sockfd << endl;
     if (!g_socketMock)
     {
         return -1;
     }
-    return g_socketMock->select(nfds, readfds, writefds, exceptfds, timeout);
+    return g_socketMock->sendmsg(sockfd, msg, flags);
 }
 
 extern "C" ssize_t recv(int sockfd, void *buf, size_t len, int flags)
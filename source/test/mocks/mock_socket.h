@@ -18,6 +18,7 @@
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <sys/socket.h>
 
 class SocketInterface
 {
@@ -26,8 +27,7 @@ class SocketInterface
         virtual int socket(int, int, int) = 0;
         virtual int connect(int, const struct sockaddr *, socklen_t) = 0;
         virtual ssize_t send(int, const void *, size_t, int) = 0;
-        virtual int select(int nfds, fd_set *, fd_set *,
-                           fd_set *, struct timeval *) = 0;
+        virtual ssize_t sendmsg(int, const struct msghdr *, int) = 0;
         virtual ssize_t recv(int, void *, size_t, int) = 0;
         virtual int close(int) = 0;
 };
@@ -39,8 +39,7 @@ class SocketMock : public SocketInterface
         MOCK_METHOD3(socket, int(int, int, int));
         MOCK_METHOD3(connect, int(int, const struct sockaddr *, socklen_t));
         MOCK_METHOD4(send, ssize_t(int, const void *, size_t, int));
-        MOCK_METHOD5(select, int(int, fd_set *, fd_set *, fd_set *,
-                     struct timeval *));
+        MOCK_METHOD3(sendmsg, ssize_t(int, const struct msghdr *, int));
         MOCK_METHOD4(recv, ssize_t(int, void*, size_t, int));
         MOCK_METHOD1(close, int(int));
 